@@ -0,0 +1,41 @@
+#include "allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+std::atomic<size_t> allocation_counter::allocations{ 0 };
+std::atomic<size_t> allocation_counter::allocated_bytes{ 0 };
+
+void* operator new(const size_t size)
+{
+	allocation_counter::allocations.fetch_add(1, std::memory_order_relaxed);
+	allocation_counter::allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+	if(void* p = std::malloc(size == 0 ? 1 : size))
+		return p;
+	throw std::bad_alloc{ };
+}
+
+void* operator new[](const size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	std::free(p);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Global operator new and delete are replaced in allocation_counter.cpp,
+// so every heap allocation of the benchmark process is counted here.
+struct allocation_counter
+{
+	static std::atomic<size_t> allocations;
+	static std::atomic<size_t> allocated_bytes;
+
+	allocation_counter() noexcept
+		: allocations_origin_{ allocations.load() }
+		, allocated_bytes_origin_{ allocated_bytes.load() }
+	{ }
+
+	[[nodiscard]] size_t allocations_since() const noexcept
+	{
+		return allocations.load() - this->allocations_origin_;
+	}
+
+	[[nodiscard]] size_t allocated_bytes_since() const noexcept
+	{
+		return allocated_bytes.load() - this->allocated_bytes_origin_;
+	}
+
+private:
+	size_t allocations_origin_;
+	size_t allocated_bytes_origin_;
+};
@@ -0,0 +1,135 @@
+#include "pch.h"
+#include "case_insensitive.h"
+#include "allocation_counter.h"
+
+#include <string>
+#include <unordered_map>
+
+using namespace ostr;
+
+// What callers did before, lowercasing a copy one code unit at a time.
+static codeunit_sequence lowercase_copy(const codeunit_sequence_view& view)
+{
+	codeunit_sequence result;
+	result.reserve(view.size());
+	for(const char codeunit : view)
+		result.append(codeunit >= 'A' && codeunit <= 'Z' ? static_cast<char>(codeunit - 'A' + 'a') : codeunit);
+	return result;
+}
+
+// Header names of a HTTP request.
+static const std::array<codeunit_sequence_view, 12>& get_header_names()
+{
+	static const std::array<codeunit_sequence_view, 12> names
+	{
+		"Host"_cuqv, "User-Agent"_cuqv, "Accept"_cuqv, "Accept-Language"_cuqv, "Accept-Encoding"_cuqv, "Connection"_cuqv,
+		"Content-Type"_cuqv, "Content-Length"_cuqv, "Cache-Control"_cuqv, "Upgrade-Insecure-Requests"_cuqv, "X-Forwarded-For"_cuqv, "Authorization"_cuqv,
+	};
+	return names;
+}
+
+// A request of about 4KB, the header looked for is at the end.
+static const codeunit_sequence& get_request()
+{
+	static const codeunit_sequence request = []
+	{
+		codeunit_sequence result{ "GET /assets/textures/terrain/rock.png HTTP/1.1\r\n" };
+		for(u64 i = 0; result.size() < 4000; ++i)
+			format_to(result, "{}: Value-{} Of The Header\r\n"_cuqv, get_header_names()[i % 8], i);
+		result.append("X-FORWARDED-FOR: 10.0.0.1\r\n\r\n"_cuqv);
+		return result;
+	}();
+	return request;
+}
+
+void iequals_lowercase_copies(benchmark::State& state)
+{
+	const codeunit_sequence_view lhs = "Upgrade-Insecure-Requests"_cuqv;
+	const codeunit_sequence_view rhs = "upgrade-insecure-REQUESTS"_cuqv;
+	const allocation_counter counter;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(lowercase_copy(lhs) == lowercase_copy(rhs));
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void iequals(benchmark::State& state)
+{
+	codeunit_sequence_view lhs = "Upgrade-Insecure-Requests"_cuqv;
+	codeunit_sequence_view rhs = "upgrade-insecure-REQUESTS"_cuqv;
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(lhs);
+		benchmark::DoNotOptimize(rhs);
+		benchmark::DoNotOptimize(lhs.iequals(rhs));
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void iindex_of_lowercase_copy(benchmark::State& state)
+{
+	const codeunit_sequence& request = get_request();
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const codeunit_sequence lowercase = lowercase_copy(request.view());
+		benchmark::DoNotOptimize(lowercase.view().index_of("\r\nx-forwarded-for:"_cuqv));
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * request.size()));
+}
+
+void iindex_of(benchmark::State& state)
+{
+	const codeunit_sequence& request = get_request();
+	const allocation_counter counter;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(request.view().iindex_of("\r\nX-Forwarded-For:"_cuqv));
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * request.size()));
+}
+
+void ihash_lookup_lowercase_copy(benchmark::State& state)
+{
+	std::unordered_map<std::string, u64> headers;
+	for(const codeunit_sequence_view& name : get_header_names())
+	{
+		const codeunit_sequence lowercase = lowercase_copy(name);
+		headers.emplace(std::string{ lowercase.data(), lowercase.size() }, name.size());
+	}
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		u64 found = 0;
+		for(const codeunit_sequence_view& name : get_header_names())
+		{
+			const codeunit_sequence lowercase = lowercase_copy(name);
+			found += headers.find(std::string{ lowercase.data(), lowercase.size() })->second;
+		}
+		benchmark::DoNotOptimize(found);
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void ihash_lookup_policy(benchmark::State& state)
+{
+	std::unordered_map<codeunit_sequence_view, u64, ascii_case_insensitive_hash, ascii_case_insensitive_equal> headers;
+	for(const codeunit_sequence_view& name : get_header_names())
+		headers.emplace(name, name.size());
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		u64 found = 0;
+		for(const codeunit_sequence_view& name : get_header_names())
+			found += headers.find(name)->second;
+		benchmark::DoNotOptimize(found);
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(iequals_lowercase_copies);
+BENCHMARK(iequals);
+BENCHMARK(iindex_of_lowercase_copy);
+BENCHMARK(iindex_of);
+BENCHMARK(ihash_lookup_lowercase_copy);
+BENCHMARK(ihash_lookup_policy);
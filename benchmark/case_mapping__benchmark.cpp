@@ -0,0 +1,137 @@
+#include "pch.h"
+#include "case_mapping.h"
+#include "allocation_counter.h"
+
+#include <cstring>
+
+using namespace ostr;
+
+// Scripts of the texts mapped, as the argument of benchmarks.
+enum class case_mapping_script : i64
+{
+	ascii,
+	latin,
+	greek,
+	cyrillic,
+	cjk,
+};
+
+// Text of about 64KB in a script, repeating a sentence in mixed case.
+static const codeunit_sequence& get_script_text(const benchmark::State& state)
+{
+	static const std::array<codeunit_sequence, 5> texts = []
+	{
+		const std::array<codeunit_sequence_view, 5> sentences
+		{
+			"The Quick Brown Fox Jumps Over The Lazy Dog, And Then Runs Back Home Again. "_cuqv,
+			"Größere Äpfel Schmecken Süßer Als Kleine, Sagt Der Bäcker Aus Übersee. Ça Déçoit. "_cuqv,
+			"Η Γρήγορη Καφέ Αλεπού Πηδάει Πάνω Από Το Τεμπέλικο Σκυλί Και Γυρίζει Πίσω. "_cuqv,
+			"Быстрая Коричневая Лиса Прыгает Через Ленивую Собаку И Бежит Домой Обратно. "_cuqv,
+			"敏捷的棕色狐狸跳过了懒狗，然后又跑回家去了。春眠不觉晓，处处闻啼鸟。夜来风雨声，花落知多少。"_cuqv,
+		};
+		std::array<codeunit_sequence, 5> result;
+		for(u64 i = 0; i < sentences.size(); ++i)
+			while(result[i].size() < 64 * 1024)
+				result[i].append(sentences[i]);
+		return result;
+	}();
+	return texts[static_cast<u64>(state.range(0))];
+}
+
+static void set_script_counters(benchmark::State& state, const codeunit_sequence& source, const allocation_counter& counter)
+{
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * source.size()));
+}
+
+// Copying the text, as the lower bound of mapping it.
+void case_mapping_memcpy(benchmark::State& state)
+{
+	const codeunit_sequence& source = get_script_text(state);
+	std::vector<char> destination(source.size());
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		std::memcpy(destination.data(), source.data(), source.size());
+		benchmark::DoNotOptimize(destination.data());
+	}
+	set_script_counters(state, source, counter);
+}
+
+// Mapping one codepoint at a time, which is what callers did without text mappings.
+void case_mapping_by_codepoint(benchmark::State& state)
+{
+	const codeunit_sequence& source = get_script_text(state);
+	codeunit_sequence destination{ source.size() };
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		destination.empty();
+		for(const codepoint cp : text_view{ source.view() })
+		{
+			std::array<char32_t, unicode::CASE_MAPPING_MAXIMUM_LENGTH> mapped{ };
+			const u64 count = unicode::map_case(static_cast<char32_t>(cp), case_mapping::upper, mapped);
+			for(u64 i = 0; i < count; ++i)
+				destination.append(codepoint{ mapped[i] });
+		}
+		benchmark::DoNotOptimize(destination.data());
+	}
+	set_script_counters(state, source, counter);
+}
+
+template<case_mapping Mapping>
+void case_mapping_to(benchmark::State& state)
+{
+	const codeunit_sequence& source = get_script_text(state);
+	codeunit_sequence destination{ source.size() };
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		destination.empty();
+		map_case_to(destination, source.view(), Mapping);
+		benchmark::DoNotOptimize(destination.data());
+	}
+	set_script_counters(state, source, counter);
+}
+
+void case_mapping_to_upper_text(benchmark::State& state)
+{
+	const text source{ get_script_text(state).view() };
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const text upper = source.to_upper();
+		benchmark::DoNotOptimize(upper.c_str());
+	}
+	set_script_counters(state, get_script_text(state), counter);
+}
+
+void case_mapping_in_place(benchmark::State& state)
+{
+	codeunit_sequence sequence{ get_script_text(state).view() };
+	const allocation_counter counter;
+	bool upper = false;
+	for (auto _ : state)
+	{
+		upper = !upper;
+		map_case_in_place(sequence, upper ? case_mapping::upper : case_mapping::lower);
+		benchmark::DoNotOptimize(sequence.data());
+	}
+	set_script_counters(state, sequence, counter);
+}
+
+// Argument is the case_mapping_script of the text.
+static void case_mapping_scripts(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgName("script");
+	for(i64 script = 0; script <= static_cast<i64>(case_mapping_script::cjk); ++script)
+		benchmark->Arg(script);
+}
+
+BENCHMARK(case_mapping_memcpy)->Apply(case_mapping_scripts);
+BENCHMARK(case_mapping_by_codepoint)->Apply(case_mapping_scripts);
+BENCHMARK_TEMPLATE(case_mapping_to, case_mapping::lower)->Apply(case_mapping_scripts);
+BENCHMARK_TEMPLATE(case_mapping_to, case_mapping::upper)->Apply(case_mapping_scripts);
+BENCHMARK_TEMPLATE(case_mapping_to, case_mapping::fold)->Apply(case_mapping_scripts);
+BENCHMARK(case_mapping_to_upper_text)->Apply(case_mapping_scripts);
+BENCHMARK(case_mapping_in_place)->Apply(case_mapping_scripts);
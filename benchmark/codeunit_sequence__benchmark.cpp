@@ -14,9 +14,9 @@ void codeunit_sequence_construct(benchmark::State& state)
 {
 	for (auto _ : state)
 	{
-		easy::codeunit_sequence empty_sequence;
+		ostr::codeunit_sequence empty_sequence;
 	}
 }
 
 BENCHMARK(std_string_construct);
-BENCHMARK(codeunit_sequence_construct);
\ No newline at end of file
+BENCHMARK(codeunit_sequence_construct);
@@ -0,0 +1,128 @@
+#include "pch.h"
+#include "text.h"
+
+#include <string_view>
+
+using namespace ostr;
+
+// Where the second view differs from the first one, as the second argument of benchmarks.
+enum class mismatch_position : i64
+{
+	none,
+	first,
+	middle,
+	last,
+};
+
+// Two views of the same content in different buffers, which differ at the position given by the arguments.
+struct compared_views
+{
+	explicit compared_views(const benchmark::State& state)
+	{
+		const u64 size = static_cast<u64>(state.range(0));
+		for(u64 i = 0; i < size; ++i)
+			lhs.append(static_cast<char>('a' + i % 26));
+		rhs = lhs;
+		if(size > 0)
+		{
+			switch(static_cast<mismatch_position>(state.range(1)))
+			{
+			case mismatch_position::none:
+				break;
+			case mismatch_position::first:
+				rhs[0] = '#';
+				break;
+			case mismatch_position::middle:
+				rhs[size / 2] = '#';
+				break;
+			case mismatch_position::last:
+				rhs[size - 1] = '#';
+				break;
+			}
+		}
+	}
+
+	codeunit_sequence lhs;
+	codeunit_sequence rhs;
+};
+
+// The comparison before views compared through memcmp, as the baseline.
+static bool equal_by_codeunit(const codeunit_sequence_view& lhs, const codeunit_sequence_view& rhs)
+{
+	if(lhs.size() != rhs.size())
+		return false;
+	for(u64 i = 0; i < lhs.size(); ++i)
+		if(lhs.read_at(i) != rhs.read_at(i))
+			return false;
+	return true;
+}
+
+void view_equal_by_codeunit(benchmark::State& state)
+{
+	const compared_views views{ state };
+	codeunit_sequence_view lhs = views.lhs.view();
+	codeunit_sequence_view rhs = views.rhs.view();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(lhs);
+		benchmark::DoNotOptimize(rhs);
+		benchmark::DoNotOptimize(equal_by_codeunit(lhs, rhs));
+	}
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * lhs.size()));
+}
+
+void view_equal(benchmark::State& state)
+{
+	const compared_views views{ state };
+	codeunit_sequence_view lhs = views.lhs.view();
+	codeunit_sequence_view rhs = views.rhs.view();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(lhs);
+		benchmark::DoNotOptimize(rhs);
+		benchmark::DoNotOptimize(lhs == rhs);
+	}
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * lhs.size()));
+}
+
+void view_compare(benchmark::State& state)
+{
+	const compared_views views{ state };
+	codeunit_sequence_view lhs = views.lhs.view();
+	codeunit_sequence_view rhs = views.rhs.view();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(lhs);
+		benchmark::DoNotOptimize(rhs);
+		benchmark::DoNotOptimize(lhs.compare(rhs));
+	}
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * lhs.size()));
+}
+
+void std_string_view_compare(benchmark::State& state)
+{
+	const compared_views views{ state };
+	std::string_view lhs{ views.lhs.data(), views.lhs.size() };
+	std::string_view rhs{ views.rhs.data(), views.rhs.size() };
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(lhs);
+		benchmark::DoNotOptimize(rhs);
+		benchmark::DoNotOptimize(lhs.compare(rhs));
+	}
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * lhs.size()));
+}
+
+// Arguments are the size of views and the mismatch_position.
+static void compared_views_arguments(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgNames({ "size", "mismatch" });
+	for(const i64 size : { 0, 1, 7, 8, 15, 16, 31, 32, 64, 256, 1024, 4096 })
+		for(i64 position = 0; position <= static_cast<i64>(mismatch_position::last); ++position)
+			benchmark->Args({ size, position });
+}
+
+BENCHMARK(view_equal_by_codeunit)->Apply(compared_views_arguments);
+BENCHMARK(view_equal)->Apply(compared_views_arguments);
+BENCHMARK(view_compare)->Apply(compared_views_arguments);
+BENCHMARK(std_string_view_compare)->Apply(compared_views_arguments);
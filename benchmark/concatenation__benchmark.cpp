@@ -0,0 +1,73 @@
+#include "pch.h"
+#include "concatenation.h"
+#include "allocation_counter.h"
+
+using namespace ostr;
+
+static const codeunit_sequence directory{ "/home/player/.local/share/open_string" };
+static const codeunit_sequence file_name{ "ancient_dragon_of_the_northern_mountains" };
+
+void concatenate_by_append(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		codeunit_sequence path;
+		path.append(directory).append('/').append("saves"_cuqv).append('/').append(file_name).append('_').append(codepoint{ U'🐉' }).append(".sav");
+		benchmark::DoNotOptimize(path.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void concatenate_by_build(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const codeunit_sequence path = codeunit_sequence::build(directory, "/", "saves"_cuqv, "/", file_name, "_", "🐉", ".sav");
+		benchmark::DoNotOptimize(path.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void concatenate_by_expression(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const codeunit_sequence path = directory + '/' + "saves"_cuqv + '/' + file_name + '_' + codepoint{ U'🐉' } + ".sav";
+		benchmark::DoNotOptimize(path.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void concatenate_formatted_by_append(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		codeunit_sequence line{ file_name };
+		line.append(": ");
+		format_to(line, "{} hp, {:.1f}%"_cuqv, 4096, 87.5);
+		line.append('\n');
+		benchmark::DoNotOptimize(line.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void concatenate_formatted_by_expression(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const codeunit_sequence line = file_name + ": " + formatted("{} hp, {:.1f}%"_cuqv, 4096, 87.5) + '\n';
+		benchmark::DoNotOptimize(line.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(concatenate_by_append);
+BENCHMARK(concatenate_by_build);
+BENCHMARK(concatenate_by_expression);
+BENCHMARK(concatenate_formatted_by_append);
+BENCHMARK(concatenate_formatted_by_expression);
@@ -0,0 +1,76 @@
+#include "pch.h"
+#include "deferred_format.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+using namespace ostr;
+
+// Time every call on the calling thread, and report percentiles of latencies in nanoseconds.
+template<class Call>
+void measure_call_latencies(benchmark::State& state, Call&& call)
+{
+	std::vector<i64> latencies;
+	latencies.reserve(static_cast<size_t>(state.max_iterations));
+	for (auto _ : state)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		call();
+		const auto end = std::chrono::steady_clock::now();
+		latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+	if(latencies.empty())
+		return;
+	std::sort(latencies.begin(), latencies.end());
+	const auto percentile = [&latencies](const f64 ratio)
+	{
+		return static_cast<f64>(latencies[static_cast<size_t>(ratio * static_cast<f64>(latencies.size() - 1))]);
+	};
+	state.counters["p50_ns"] = percentile(0.5);
+	state.counters["p99_ns"] = percentile(0.99);
+	state.counters["p999_ns"] = percentile(0.999);
+}
+
+void format_on_calling_thread(benchmark::State& state)
+{
+	codeunit_sequence line;
+	measure_call_latencies(state, [&line]
+	{
+		line.empty();
+		format_to(line, OPEN_STRING_FORMAT_MOLD("Player {} hit {} for {} damage ({:x}) at {:.3f}.\n"), "繁星明"_cuqv, "slime", 42, 255, 12.5);
+		benchmark::DoNotOptimize(line.data());
+	});
+}
+
+void push_deferred_record(benchmark::State& state)
+{
+	deferred_format_queue queue{ 1 << 20, deferred_producer_mode::multiple, deferred_overflow_policy::drop };
+	format_sink counter{ nullptr, nullptr };
+	{
+		deferred_format_worker worker{ queue, counter, std::chrono::microseconds{ 50 } };
+		measure_call_latencies(state, [&queue]
+		{
+			queue.push(OPEN_STRING_FORMAT_MOLD("Player {} hit {} for {} damage ({:x}) at {:.3f}.\n"), "繁星明"_cuqv, "slime", 42, 255, 12.5);
+		});
+	}
+	state.counters["dropped"] = static_cast<f64>(queue.dropped());
+}
+
+void push_deferred_record_single_producer(benchmark::State& state)
+{
+	deferred_format_queue queue{ 1 << 20, deferred_producer_mode::single, deferred_overflow_policy::drop };
+	format_sink counter{ nullptr, nullptr };
+	{
+		deferred_format_worker worker{ queue, counter, std::chrono::microseconds{ 50 } };
+		measure_call_latencies(state, [&queue]
+		{
+			queue.push(OPEN_STRING_FORMAT_MOLD("Player {} hit {} for {} damage ({:x}) at {:.3f}.\n"), "繁星明"_cuqv, "slime", 42, 255, 12.5);
+		});
+	}
+	state.counters["dropped"] = static_cast<f64>(queue.dropped());
+}
+
+BENCHMARK(format_on_calling_thread);
+BENCHMARK(push_deferred_record);
+BENCHMARK(push_deferred_record_single_producer);
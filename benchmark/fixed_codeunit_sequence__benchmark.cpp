@@ -0,0 +1,110 @@
+#include "pch.h"
+#include "fixed_codeunit_sequence.h"
+#include "allocation_counter.h"
+
+#include <vector>
+
+using namespace ostr;
+
+static constexpr const char* name_literal = "Ancient Dragon of the Northern Mountains";
+
+// Copies of names stored in components, like a game entity would do.
+void copy_codeunit_sequence(benchmark::State& state)
+{
+	const codeunit_sequence name{ name_literal };
+	std::vector<codeunit_sequence> names(64);
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		for(codeunit_sequence& copied : names)
+			copied = name;
+		benchmark::DoNotOptimize(names.data());
+		benchmark::ClobberMemory();
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void copy_fixed_codeunit_sequence(benchmark::State& state)
+{
+	const fixed_codeunit_sequence<63> name{ name_literal };
+	std::vector<fixed_codeunit_sequence<63>> names(64);
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		for(fixed_codeunit_sequence<63>& copied : names)
+			copied = name;
+		benchmark::DoNotOptimize(names.data());
+		benchmark::ClobberMemory();
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+// Fresh copies, which allocate for every codeunit_sequence out of the inline storage.
+void copy_construct_codeunit_sequence(benchmark::State& state)
+{
+	const codeunit_sequence name{ name_literal };
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const codeunit_sequence copied = name;
+		benchmark::DoNotOptimize(copied.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void copy_construct_fixed_codeunit_sequence(benchmark::State& state)
+{
+	const fixed_codeunit_sequence<63> name{ name_literal };
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const fixed_codeunit_sequence<63> copied = name;
+		benchmark::DoNotOptimize(copied.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void append_codeunit_sequence(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		codeunit_sequence path;
+		path.append("assets").append('/').append("textures"_cuqv).append('/').append("dragon_diffuse"_cuqv).append(".png");
+		benchmark::DoNotOptimize(path.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void append_fixed_codeunit_sequence(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		fixed_codeunit_sequence<63> path;
+		path.append("assets").append('/').append("textures"_cuqv).append('/').append("dragon_diffuse"_cuqv).append(".png");
+		benchmark::DoNotOptimize(path.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void append_fixed_codeunit_sequence_heap(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		// The path does not fit in 15 code units, so it is moved to the heap once.
+		fixed_codeunit_sequence<15, fixed_overflow_policy::heap> path;
+		path.append("assets").append('/').append("textures"_cuqv).append('/').append("dragon_diffuse"_cuqv).append(".png");
+		benchmark::DoNotOptimize(path.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(copy_codeunit_sequence);
+BENCHMARK(copy_fixed_codeunit_sequence);
+BENCHMARK(copy_construct_codeunit_sequence);
+BENCHMARK(copy_construct_fixed_codeunit_sequence);
+BENCHMARK(append_codeunit_sequence);
+BENCHMARK(append_fixed_codeunit_sequence);
+BENCHMARK(append_fixed_codeunit_sequence_heap);
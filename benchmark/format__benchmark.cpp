@@ -1,5 +1,179 @@
 #include "pch.h"
 #include "format.h"
+#include "allocation_counter.h"
 
+#include <array>
+#include <cstdio>
+#include <random>
 
+using namespace ostr;
 
+void format_runtime_mold(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const codeunit_sequence result = format("Player {} hit {} for {} damage ({:x})."_cuqv, "繁星明"_cuqv, "slime"_cuqv, 42, 255);
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void format_compiled_mold(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const codeunit_sequence result = format(OPEN_STRING_FORMAT_MOLD("Player {} hit {} for {} damage ({:x})."), "繁星明"_cuqv, "slime"_cuqv, 42, 255);
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void format_inline_result(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const codeunit_sequence result = format("{}: {:04x}"_cuqv, "hp", 255);
+		benchmark::DoNotOptimize(result.data());
+	}
+	// The result fits inline, so nothing should be allocated.
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void format_to_reused_sequence(benchmark::State& state)
+{
+	codeunit_sequence result;
+	u64 allocations = 0;
+	for (auto _ : state)
+	{
+		result.empty();
+		const allocation_counter counter;
+		format_to(result, OPEN_STRING_FORMAT_MOLD("Player {} hit {} for {} damage ({:x})."), "繁星明"_cuqv, "slime"_cuqv, 42, 255);
+		allocations = counter.allocations_since();
+		benchmark::DoNotOptimize(result.data());
+	}
+	// Allocations in the last iteration, which should be zero once the sequence grows enough.
+	state.counters["allocations"] = static_cast<double>(allocations);
+}
+
+static constexpr std::array<const char*, 8> integer_specifications
+{
+	"{}", "{:x}", "{:o}", "{:b}", "{:#x}", "{:08}", "{: 12}", "{:#018x}"
+};
+
+void format_to_n_stack_buffer(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		// Truncated in the middle of "繁星明", which is dropped as a whole.
+		char buffer[16];
+		const format_to_n_result result = format_to_n(buffer, sizeof(buffer), OPEN_STRING_FORMAT_MOLD("Player {} hit {} for {} damage ({:x})."), "繁星明"_cuqv, "slime"_cuqv, 42, 255);
+		benchmark::DoNotOptimize(result);
+		benchmark::DoNotOptimize(buffer);
+	}
+	// Nothing should ever be allocated.
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void format_inline_buffer(benchmark::State& state)
+{
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const auto result = format_inline<64>(OPEN_STRING_FORMAT_MOLD("Player {} hit {} for {} damage ({:x})."), "繁星明"_cuqv, "slime"_cuqv, 42, 255);
+		benchmark::DoNotOptimize(result.c_str());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+template<class T>
+void format_integer(benchmark::State& state)
+{
+	const codeunit_sequence_view mold{ integer_specifications[state.range(0)] };
+	state.SetLabel(mold.data());
+	std::mt19937_64 engine{ 42 };
+	std::array<T, 1024> values;
+	for(T& value : values)
+	{
+		// Values spread over all digit counts.
+		value = static_cast<T>(engine() >> (engine() % 64));
+	}
+	codeunit_sequence result;
+	for (auto _ : state)
+	{
+		for(const T value : values)
+		{
+			result.empty();
+			format_to(result, mold, value);
+			benchmark::DoNotOptimize(result.data());
+		}
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * values.size()));
+}
+
+static constexpr std::array<const char*, 6> float_specifications
+{
+	"{}", "{:.3f}", "{:f}", "{:e}", "{:.6g}", "{:a}"
+};
+
+template<class T>
+std::array<T, 1024> make_random_floats()
+{
+	std::mt19937_64 engine{ 42 };
+	std::uniform_real_distribution<T> mantissa{ -1, 1 };
+	std::uniform_int_distribution<int> exponent{ -20, 20 };
+	std::array<T, 1024> values;
+	for(T& value : values)
+		value = std::ldexp(mantissa(engine), exponent(engine));
+	return values;
+}
+
+template<class T>
+void format_float(benchmark::State& state)
+{
+	const codeunit_sequence_view mold{ float_specifications[state.range(0)] };
+	state.SetLabel(mold.data());
+	const std::array<T, 1024> values = make_random_floats<T>();
+	codeunit_sequence result;
+	for (auto _ : state)
+	{
+		for(const T value : values)
+		{
+			result.empty();
+			format_to(result, mold, value);
+			benchmark::DoNotOptimize(result.data());
+		}
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * values.size()));
+}
+
+// Reference: snprintf with enough digits to round trip.
+void format_float_snprintf(benchmark::State& state)
+{
+	const std::array<f64, 1024> values = make_random_floats<f64>();
+	char buffer[64];
+	for (auto _ : state)
+	{
+		for(const f64 value : values)
+		{
+			std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+			benchmark::DoNotOptimize(buffer);
+		}
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * values.size()));
+}
+
+BENCHMARK(format_runtime_mold);
+BENCHMARK(format_compiled_mold);
+BENCHMARK(format_inline_result);
+BENCHMARK(format_to_reused_sequence);
+BENCHMARK(format_to_n_stack_buffer);
+BENCHMARK(format_inline_buffer);
+BENCHMARK_TEMPLATE(format_integer, u64)->DenseRange(0, integer_specifications.size() - 1);
+BENCHMARK_TEMPLATE(format_integer, i64)->DenseRange(0, integer_specifications.size() - 1);
+BENCHMARK_TEMPLATE(format_float, f64)->DenseRange(0, float_specifications.size() - 1);
+BENCHMARK_TEMPLATE(format_float, f32)->DenseRange(0, float_specifications.size() - 1);
+BENCHMARK(format_float_snprintf);
@@ -0,0 +1,109 @@
+#include "pch.h"
+#include "gap_buffer.h"
+#include "rope.h"
+#include "allocation_counter.h"
+
+using namespace ostr;
+
+// Buffer of about 1 MB, lines mixing code units of all the lengths.
+static const text& get_buffer()
+{
+	static const text buffer = []
+	{
+		codeunit_sequence sequence;
+		for(u64 i = 0; sequence.size() < 1'000'000; ++i)
+			format_to(sequence, "{}: 繁星明 chat message with emoji 🐉 and some words\n"_cuqv, i);
+		return text{ std::move(sequence) };
+	}();
+	return buffer;
+}
+
+static u64 next_random(u64& state)
+{
+	state = state * 6364136223846793005ull + 1442695040888963407ull;
+	return state >> 33;
+}
+
+static constexpr codepoint typed{ U'é' };
+
+// Each keystroke replaces the codepoint at the cursor with the typed codepoint and itself, then backspace.
+void keystroke_text(benchmark::State& state)
+{
+	text buffer = get_buffer();
+	const u64 cursor = buffer.size() / 2;
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		codeunit_sequence replacement{ codeunit_sequence_view{ typed } };
+		replacement.append(buffer.read_at(cursor));
+		buffer.replace(text_view{ replacement.view() }, cursor, 1);
+		buffer.replace(""_txtv, cursor, 1);
+		benchmark::DoNotOptimize(buffer.c_str());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+
+void keystroke_gap_buffer(benchmark::State& state)
+{
+	gap_buffer buffer{ get_buffer().view() };
+	buffer.set_cursor(buffer.size() / 2);
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		buffer.insert(typed);
+		buffer.erase_before();
+		benchmark::DoNotOptimize(buffer.cursor());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+
+void keystroke_rope(benchmark::State& state)
+{
+	rope buffer{ get_buffer() };
+	const u64 cursor = buffer.size() / 2;
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		buffer.insert(cursor, text_view{ typed });
+		buffer.erase(cursor, 1);
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// Arrow keys move the cursor by a few codepoints before typing.
+void navigate_gap_buffer(benchmark::State& state)
+{
+	gap_buffer buffer{ get_buffer().view() };
+	buffer.set_cursor(buffer.size() / 2);
+	u64 random = 42;
+	for (auto _ : state)
+	{
+		buffer.move_cursor(static_cast<i64>(next_random(random) % 64) - 32);
+		buffer.insert(typed);
+		buffer.erase_before();
+	}
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// Clicking anywhere moves the gap across up to the whole buffer.
+void jump_gap_buffer(benchmark::State& state)
+{
+	gap_buffer buffer{ get_buffer().view() };
+	u64 random = 42;
+	for (auto _ : state)
+	{
+		buffer.set_cursor(next_random(random) % buffer.size());
+		buffer.insert(typed);
+		buffer.erase_before();
+	}
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+
+BENCHMARK(keystroke_text)->Unit(benchmark::kMicrosecond);
+BENCHMARK(keystroke_gap_buffer)->Unit(benchmark::kNanosecond);
+BENCHMARK(keystroke_rope)->Unit(benchmark::kNanosecond);
+BENCHMARK(navigate_gap_buffer)->Unit(benchmark::kNanosecond);
+BENCHMARK(jump_gap_buffer)->Unit(benchmark::kMicrosecond);
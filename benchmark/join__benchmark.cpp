@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "codeunit_sequence.h"
+#include "allocation_counter.h"
+
+#include <iterator>
+#include <vector>
+
+using namespace ostr;
+
+static std::vector<codeunit_sequence_view> make_words(const u64 count)
+{
+	static constexpr std::array<codeunit_sequence_view, 8> pool
+	{
+		"alpha"_cuqv, "bravo"_cuqv, "charlie"_cuqv, "delta"_cuqv, "echo"_cuqv, "foxtrot"_cuqv, "繁星明"_cuqv, "🐉"_cuqv
+	};
+	std::vector<codeunit_sequence_view> words;
+	words.reserve(count);
+	for(u64 i = 0; i < count; ++i)
+		words.push_back(pool[i % pool.size()]);
+	return words;
+}
+
+// Iterator hiding the multi-pass ability of vector iterators, like a stream does.
+struct single_pass_iterator
+{
+	using iterator_category = std::input_iterator_tag;
+	using value_type = codeunit_sequence_view;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const codeunit_sequence_view*;
+	using reference = const codeunit_sequence_view&;
+
+	std::vector<codeunit_sequence_view>::const_iterator it;
+
+	reference operator*() const { return *this->it; }
+	single_pass_iterator& operator++() { ++this->it; return *this; }
+	bool operator==(const single_pass_iterator& rhs) const { return this->it == rhs.it; }
+	bool operator!=(const single_pass_iterator& rhs) const { return this->it != rhs.it; }
+};
+
+// The way join worked before, appending element by element into an empty result.
+void join_by_append(benchmark::State& state)
+{
+	const std::vector<codeunit_sequence_view> words = make_words(static_cast<u64>(state.range(0)));
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		codeunit_sequence result;
+		for(const codeunit_sequence_view& word : words)
+		{
+			if(!result.is_empty())
+				result += ", "_cuqv;
+			result.append(word);
+		}
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void join_sized(benchmark::State& state)
+{
+	const std::vector<codeunit_sequence_view> words = make_words(static_cast<u64>(state.range(0)));
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const codeunit_sequence result = codeunit_sequence::join(words, ", "_cuqv);
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void join_single_pass(benchmark::State& state)
+{
+	const std::vector<codeunit_sequence_view> words = make_words(static_cast<u64>(state.range(0)));
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const codeunit_sequence result = codeunit_sequence::join(single_pass_iterator{ words.begin() }, single_pass_iterator{ words.end() }, ", "_cuqv);
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(join_by_append)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(join_sized)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(join_single_pass)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,147 @@
+#include "pch.h"
+#include "line_reader.h"
+#include "format.h"
+#include "allocation_counter.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#if _WIN64
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace ostr;
+
+static const char* const data_file_path = "ostr_line_reader_1GB.log";
+static constexpr u64 data_file_size = 1ull << 30;
+
+// Data file is large, so it is removed at exit.
+static const struct log_file_cleaner
+{
+	~log_file_cleaner()
+	{
+		std::remove(data_file_path);
+	}
+} cleaner;
+
+// Log-like lines of different lengths, some of them ending with CRLF.
+static const char* get_data_file()
+{
+	if(std::FILE* existing = std::fopen(data_file_path, "rb"))
+	{
+		std::fseek(existing, 0, SEEK_END);
+		const bool complete = static_cast<u64>(std::ftell(existing)) == data_file_size;
+		std::fclose(existing);
+		if(complete)
+			return data_file_path;
+	}
+	codeunit_sequence block;
+	for(u64 i = 0; block.size() < (1 << 20); ++i)
+		format_to(block, "[{}] request {} served in {}us by worker {} 繁星明 🐉{}"_cuqv, i, i * 7919 % 100003, i * 31 % 997, i % 16, i % 5 == 0 ? "\r\n"_cuqv : "\n"_cuqv);
+	std::FILE* file = std::fopen(data_file_path, "wb");
+	for(u64 written = 0; written < data_file_size; written += block.size())
+		std::fwrite(block.data(), 1, minimum(block.size(), data_file_size - written), file);
+	std::fclose(file);
+	return data_file_path;
+}
+
+static int open_descriptor(const char* path)
+{
+#if _WIN64
+	return _open(path, _O_RDONLY | _O_BINARY);
+#else
+	return ::open(path, O_RDONLY);
+#endif
+}
+
+static void close_descriptor(const int descriptor)
+{
+#if _WIN64
+	_close(descriptor);
+#else
+	::close(descriptor);
+#endif
+}
+
+// Reading without looking for lines, which is the bandwidth to reach.
+void count_lines_read_only(benchmark::State& state)
+{
+	const char* path = get_data_file();
+	codeunit_sequence buffer;
+	buffer.append('\0', line_reader::BUFFER_SIZE_DEFAULT - 1);
+	for (auto _ : state)
+	{
+		const int descriptor = open_descriptor(path);
+#if _WIN64
+		while(_read(descriptor, buffer.data(), static_cast<unsigned>(buffer.size())) > 0)
+#else
+		while(::read(descriptor, buffer.data(), buffer.size()) > 0)
+#endif
+			benchmark::ClobberMemory();
+		close_descriptor(descriptor);
+	}
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * data_file_size));
+}
+
+void count_lines_getline(benchmark::State& state)
+{
+	const char* path = get_data_file();
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		std::ifstream stream{ path, std::ios::binary };
+		std::string line;
+		u64 count = 0;
+		while(std::getline(stream, line))
+			++count;
+		benchmark::DoNotOptimize(count);
+	}
+	state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(counter.allocated_bytes_since()), benchmark::Counter::kAvgIterations);
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * data_file_size));
+}
+
+void count_lines_line_reader_stream(benchmark::State& state)
+{
+	const char* path = get_data_file();
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		std::FILE* stream = std::fopen(path, "rb");
+		line_reader reader{ stream };
+		codeunit_sequence_view line;
+		while(reader.next(line))
+			benchmark::DoNotOptimize(line);
+		benchmark::DoNotOptimize(reader.get_line_count());
+		std::fclose(stream);
+	}
+	state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(counter.allocated_bytes_since()), benchmark::Counter::kAvgIterations);
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * data_file_size));
+}
+
+void count_lines_line_reader_descriptor(benchmark::State& state)
+{
+	const char* path = get_data_file();
+	const u64 buffer_size = static_cast<u64>(state.range(0));
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const int descriptor = open_descriptor(path);
+		line_reader reader{ descriptor, buffer_size };
+		for(const codeunit_sequence_view& line : reader.lines())
+			benchmark::DoNotOptimize(line);
+		benchmark::DoNotOptimize(reader.get_line_count());
+		close_descriptor(descriptor);
+	}
+	state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(counter.allocated_bytes_since()), benchmark::Counter::kAvgIterations);
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * data_file_size));
+}
+
+BENCHMARK(count_lines_read_only)->Unit(benchmark::kMillisecond);
+BENCHMARK(count_lines_getline)->Unit(benchmark::kMillisecond);
+BENCHMARK(count_lines_line_reader_stream)->Unit(benchmark::kMillisecond);
+BENCHMARK(count_lines_line_reader_descriptor)->Arg(64 << 10)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
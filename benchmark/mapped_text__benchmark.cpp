@@ -0,0 +1,116 @@
+#include "pch.h"
+#include "mapped_text.h"
+#include "allocation_counter.h"
+
+#include <cstdio>
+
+using namespace ostr;
+
+static constexpr codeunit_sequence_view needle = "needle at the end of the file"_cuqv;
+
+static const char* const data_file_paths[] = { "ostr_mapped_text_64MB.txt", "ostr_mapped_text_1GB.txt" };
+
+// Data files are large, so they are removed at exit.
+static const struct data_file_cleaner
+{
+	~data_file_cleaner()
+	{
+		for(const char* path : data_file_paths)
+			std::remove(path);
+	}
+} cleaner;
+
+// Data file of size code units, the needle is at the very end so that a search reads the whole file.
+static const char* get_data_file(const u64 size)
+{
+	const char* path = size < (1ull << 30) ? data_file_paths[0] : data_file_paths[1];
+	if(std::FILE* existing = std::fopen(path, "rb"))
+	{
+		std::fseek(existing, 0, SEEK_END);
+		const bool complete = static_cast<u64>(std::ftell(existing)) == size;
+		std::fclose(existing);
+		if(complete)
+			return path;
+	}
+	codeunit_sequence line;
+	for(u64 i = 0; line.size() < 4096; ++i)
+		format_to(line, "{}: vec4 color = texture(diffuse_map, uv) * tint; // 繁星明 🐉\n"_cuqv, i);
+	std::FILE* file = std::fopen(path, "wb");
+	for(u64 written = 0; written < size - needle.size(); written += line.size())
+		std::fwrite(line.data(), 1, minimum(line.size(), size - needle.size() - written), file);
+	std::fwrite(needle.data(), 1, needle.size(), file);
+	std::fclose(file);
+	return path;
+}
+
+// Loading the way it is done without mapping, reading into a sequence of the whole size.
+void first_search_read_buffer(benchmark::State& state)
+{
+	const u64 size = static_cast<u64>(state.range(0));
+	const char* path = get_data_file(size);
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		std::FILE* file = std::fopen(path, "rb");
+		codeunit_sequence buffer;
+		buffer.append('\0', size);
+		const u64 read = std::fread(buffer.data(), 1, size, file);
+		std::fclose(file);
+		benchmark::DoNotOptimize(read);
+		benchmark::DoNotOptimize(buffer.view().index_of(needle));
+	}
+	state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(counter.allocated_bytes_since()), benchmark::Counter::kAvgIterations);
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void first_search_mapped(benchmark::State& state)
+{
+	const u64 size = static_cast<u64>(state.range(0));
+	const char* path = get_data_file(size);
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const mapped_text mapped{ path };
+		benchmark::DoNotOptimize(mapped.raw().index_of(needle));
+	}
+	state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(counter.allocated_bytes_since()), benchmark::Counter::kAvgIterations);
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void first_search_mapped_sequential(benchmark::State& state)
+{
+	const u64 size = static_cast<u64>(state.range(0));
+	const char* path = get_data_file(size);
+	mapped_text_options options;
+	options.access = mapped_access_hint::sequential;
+	options.will_need = true;
+	options.huge_pages = true;
+	for (auto _ : state)
+	{
+		const mapped_text mapped{ path, options };
+		benchmark::DoNotOptimize(mapped.raw().index_of(needle));
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Cost of validation, which touches every page once before the search.
+void first_search_mapped_validated(benchmark::State& state)
+{
+	const u64 size = static_cast<u64>(state.range(0));
+	const char* path = get_data_file(size);
+	mapped_text_options options;
+	options.access = mapped_access_hint::sequential;
+	options.validate_utf8 = true;
+	options.strip_bom = true;
+	for (auto _ : state)
+	{
+		const mapped_text mapped{ path, options };
+		benchmark::DoNotOptimize(mapped.raw().index_of(needle));
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(first_search_read_buffer)->Arg(64 << 20)->Arg(1 << 30)->Unit(benchmark::kMillisecond);
+BENCHMARK(first_search_mapped)->Arg(64 << 20)->Arg(1 << 30)->Unit(benchmark::kMillisecond);
+BENCHMARK(first_search_mapped_sequential)->Arg(64 << 20)->Arg(1 << 30)->Unit(benchmark::kMillisecond);
+BENCHMARK(first_search_mapped_validated)->Arg(64 << 20)->Arg(1 << 30)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,138 @@
+#include "pch.h"
+#include "normalization.h"
+#include "allocation_counter.h"
+
+#include <cstring>
+
+using namespace ostr;
+
+// Corpora normalized, as the argument of benchmarks.
+enum class normalization_corpus : i64
+{
+	// Chat messages and player names mixing Latin, CJK and Hangul, in NFC as most text is.
+	mixed_nfc,
+	// The same text in NFD, as typed on some platforms.
+	mixed_nfd,
+	latin_nfc,
+	cjk_nfc,
+	hangul_nfc,
+};
+
+// Text of about 64KB of a corpus, repeating its lines.
+static const codeunit_sequence& get_corpus_text(const benchmark::State& state)
+{
+	static const std::array<codeunit_sequence, 5> texts = []
+	{
+		const std::array<codeunit_sequence_view, 3> latin
+		{
+			"[Zoë] gg, that was close! Anyone up for another round?\n"_cuqv,
+			"[José_Müller] Ça va, on se retrouve au café après le match. Größte Runde des Tages.\n"_cuqv,
+			"[Ångström] I'll queue again in 5 minutes, need to grab some coffee first.\n"_cuqv,
+		};
+		const std::array<codeunit_sequence_view, 2> cjk
+		{
+			"[桜井] 今日のイベントは何時から始まりますか？一緒に参加しましょう。\n"_cuqv,
+			"[王小明] 我们下一局换个地图吧，这张图太难了。\n"_cuqv,
+		};
+		const std::array<codeunit_sequence_view, 2> hangul
+		{
+			"[김민준] 안녕하세요 여러분, 오늘도 즐거운 게임 되세요!\n"_cuqv,
+			"[이서연] 방금 그 판 진짜 재밌었어요. 한 판 더 할까요?\n"_cuqv,
+		};
+		std::array<codeunit_sequence, 5> result;
+		for(u64 i = 0; result[0].size() < 64 * 1024; ++i)
+		{
+			result[0].append(latin[i % latin.size()]);
+			result[0].append(cjk[i % cjk.size()]);
+			result[0].append(hangul[i % hangul.size()]);
+		}
+		normalize_to(result[1], result[0].view(), normalization_form::nfd);
+		for(u64 i = 0; result[2].size() < 64 * 1024; ++i)
+			result[2].append(latin[i % latin.size()]);
+		for(u64 i = 0; result[3].size() < 64 * 1024; ++i)
+			result[3].append(cjk[i % cjk.size()]);
+		for(u64 i = 0; result[4].size() < 64 * 1024; ++i)
+			result[4].append(hangul[i % hangul.size()]);
+		return result;
+	}();
+	return texts[static_cast<u64>(state.range(0))];
+}
+
+static void set_corpus_counters(benchmark::State& state, const codeunit_sequence& source, const allocation_counter& counter)
+{
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * source.size()));
+}
+
+// Copying the text, as the lower bound of normalizing it.
+void normalization_memcpy(benchmark::State& state)
+{
+	const codeunit_sequence& source = get_corpus_text(state);
+	std::vector<char> destination(source.size());
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		std::memcpy(destination.data(), source.data(), source.size());
+		benchmark::DoNotOptimize(destination.data());
+	}
+	set_corpus_counters(state, source, counter);
+}
+
+template<normalization_form Form>
+void normalization_quick_check(benchmark::State& state)
+{
+	const codeunit_sequence& source = get_corpus_text(state);
+	const allocation_counter counter;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(quick_check_normalization(source.view(), Form));
+	set_corpus_counters(state, source, counter);
+}
+
+template<normalization_form Form>
+void normalization_to(benchmark::State& state)
+{
+	const codeunit_sequence& source = get_corpus_text(state);
+	codeunit_sequence destination{ source.size() * 2 };
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		destination.empty();
+		normalize_to(destination, source.view(), Form);
+		benchmark::DoNotOptimize(destination.data());
+	}
+	set_corpus_counters(state, source, counter);
+}
+
+// Normalizing the text in chunks of 4KB, as read from a file or a socket.
+void normalization_normalizer(benchmark::State& state)
+{
+	const codeunit_sequence& source = get_corpus_text(state);
+	codeunit_sequence destination{ source.size() * 2 };
+	normalizer stream{ normalization_form::nfc };
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		destination.empty();
+		for(u64 i = 0; i < source.size(); i += 4096)
+			stream.normalize_to(destination, source.subview(i, 4096));
+		stream.finish(destination);
+		benchmark::DoNotOptimize(destination.data());
+	}
+	set_corpus_counters(state, source, counter);
+}
+
+// Argument is the normalization_corpus of the text.
+static void normalization_corpora(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgName("corpus");
+	for(i64 corpus = 0; corpus <= static_cast<i64>(normalization_corpus::hangul_nfc); ++corpus)
+		benchmark->Arg(corpus);
+}
+
+BENCHMARK(normalization_memcpy)->Apply(normalization_corpora);
+BENCHMARK_TEMPLATE(normalization_quick_check, normalization_form::nfc)->Apply(normalization_corpora);
+BENCHMARK_TEMPLATE(normalization_quick_check, normalization_form::nfkc)->Apply(normalization_corpora);
+BENCHMARK_TEMPLATE(normalization_to, normalization_form::nfc)->Apply(normalization_corpora);
+BENCHMARK_TEMPLATE(normalization_to, normalization_form::nfd)->Apply(normalization_corpora);
+BENCHMARK_TEMPLATE(normalization_to, normalization_form::nfkc)->Apply(normalization_corpora);
+BENCHMARK(normalization_normalizer)->Apply(normalization_corpora);
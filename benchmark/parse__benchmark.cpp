@@ -0,0 +1,100 @@
+#include "pch.h"
+#include "format.h"
+#include "parse.h"
+
+#include <charconv>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace ostr;
+
+// A csv row of random numbers, 1024 numbers separated by commas.
+template<class T>
+codeunit_sequence make_random_row()
+{
+	std::mt19937_64 engine{ 42 };
+	codeunit_sequence row;
+	for(u64 i = 0; i < 1024; ++i)
+	{
+		if(i > 0)
+			row.append(',');
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			std::uniform_real_distribution<f64> mantissa{ -1, 1 };
+			std::uniform_int_distribution<int> exponent{ -10, 10 };
+			format_to(row, "{:.6g}"_cuqv, std::ldexp(mantissa(engine), exponent(engine)));
+		}
+		else
+		{
+			// Values spread over all digit counts.
+			format_to(row, "{}"_cuqv, static_cast<T>(engine() >> (engine() % 64)));
+		}
+	}
+	return row;
+}
+
+template<class T>
+void parse_delimited_numbers(benchmark::State& state)
+{
+	const codeunit_sequence row = make_random_row<T>();
+	std::vector<T> numbers(1024);
+	for (auto _ : state)
+	{
+		const parse_delimited_result result = parse_delimited(row.view(), ',', numbers.data(), numbers.size());
+		benchmark::DoNotOptimize(result);
+		benchmark::DoNotOptimize(numbers.data());
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * numbers.size()));
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * row.size()));
+}
+
+template<class T>
+void parse_with_from_chars(benchmark::State& state)
+{
+	const codeunit_sequence row = make_random_row<T>();
+	std::vector<T> numbers(1024);
+	for (auto _ : state)
+	{
+		const char* first = row.data();
+		const char* last = first + row.size();
+		for(T& number : numbers)
+		{
+			first = std::from_chars(first, last, number).ptr + 1;
+			if(first >= last)
+				break;
+		}
+		benchmark::DoNotOptimize(numbers.data());
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * numbers.size()));
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * row.size()));
+}
+
+void parse_with_strtod(benchmark::State& state)
+{
+	const codeunit_sequence row = make_random_row<f64>();
+	std::vector<f64> numbers(1024);
+	for (auto _ : state)
+	{
+		const char* first = row.c_str();
+		for(f64& number : numbers)
+		{
+			char* last = nullptr;
+			number = std::strtod(first, &last);
+			first = last + 1;
+		}
+		benchmark::DoNotOptimize(numbers.data());
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * numbers.size()));
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * row.size()));
+}
+
+BENCHMARK_TEMPLATE(parse_delimited_numbers, u64);
+BENCHMARK_TEMPLATE(parse_with_from_chars, u64);
+BENCHMARK_TEMPLATE(parse_delimited_numbers, i32);
+BENCHMARK_TEMPLATE(parse_with_from_chars, i32);
+BENCHMARK_TEMPLATE(parse_delimited_numbers, f64);
+BENCHMARK_TEMPLATE(parse_with_from_chars, f64);
+BENCHMARK(parse_with_strtod);
+BENCHMARK_TEMPLATE(parse_delimited_numbers, f32);
+BENCHMARK_TEMPLATE(parse_with_from_chars, f32);
@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "rope.h"
+#include "allocation_counter.h"
+
+using namespace ostr;
+
+// Document of about 10 MB, lines mixing code units of all the lengths.
+static const text& get_document()
+{
+	static const text document = []
+	{
+		codeunit_sequence sequence;
+		for(u64 i = 0; sequence.size() < 10'000'000; ++i)
+			format_to(sequence, "{}: vec4 color = texture(diffuse_map, uv) * tint; // 繁星明 🐉\n"_cuqv, i);
+		return text{ std::move(sequence) };
+	}();
+	return document;
+}
+
+static u64 next_random(u64& state)
+{
+	state = state * 6364136223846793005ull + 1442695040888963407ull;
+	return state >> 33;
+}
+
+static constexpr text_view inserted = "edit 星 "_txtv;
+
+// Insertion rebuilds the whole buffer when it grows, by replacing a codepoint with the inserted text and itself.
+void edit_text(benchmark::State& state)
+{
+	text document = get_document();
+	u64 random = 42;
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		const u64 index = next_random(random) % (document.size() - 1);
+		codeunit_sequence replacement{ inserted.raw() };
+		replacement.append(document.read_at(index));
+		document.replace(text_view{ replacement.view() }, index, 1);
+		document.replace(""_txtv, next_random(random) % (document.size() - inserted.size()), inserted.size());
+		benchmark::DoNotOptimize(document.c_str());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+
+void edit_rope(benchmark::State& state)
+{
+	rope document{ get_document() };
+	u64 random = 42;
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		document.insert(next_random(random) % document.size(), inserted);
+		document.erase(next_random(random) % (document.size() - inserted.size()), inserted.size());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// Edits spanning several leaves, which go through split and concatenation.
+void edit_rope_large(benchmark::State& state)
+{
+	rope document{ get_document() };
+	const text block{ get_document().subview(0, 5000) };
+	u64 random = 42;
+	for (auto _ : state)
+	{
+		document.insert(next_random(random) % document.size(), block.view());
+		document.erase(next_random(random) % (document.size() - block.size()), block.size());
+	}
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+
+void read_at_text(benchmark::State& state)
+{
+	const text& document = get_document();
+	u64 random = 42;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(document.read_at(next_random(random) % document.size()));
+}
+
+void read_at_rope(benchmark::State& state)
+{
+	const rope document{ get_document() };
+	u64 random = 42;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(document.read_at(next_random(random) % document.size()));
+}
+
+void split_append_rope(benchmark::State& state)
+{
+	rope document{ get_document() };
+	u64 random = 42;
+	for (auto _ : state)
+	{
+		rope rest = document.split(next_random(random) % document.size());
+		document.append(std::move(rest));
+	}
+}
+
+void build_rope(benchmark::State& state)
+{
+	const text& document = get_document();
+	for (auto _ : state)
+	{
+		const rope r{ document };
+		benchmark::DoNotOptimize(r.size());
+	}
+	state.SetBytesProcessed(state.iterations() * document.raw().size());
+}
+
+BENCHMARK(edit_text)->Unit(benchmark::kMicrosecond);
+BENCHMARK(edit_rope)->Unit(benchmark::kMicrosecond);
+BENCHMARK(edit_rope_large)->Unit(benchmark::kMicrosecond);
+BENCHMARK(read_at_text)->Unit(benchmark::kMicrosecond);
+BENCHMARK(read_at_rope)->Unit(benchmark::kMicrosecond);
+BENCHMARK(split_append_rope)->Unit(benchmark::kMicrosecond);
+BENCHMARK(build_rope)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,84 @@
+#include "pch.h"
+#include "string_builder.h"
+#include "allocation_counter.h"
+
+#include <cstdio>
+
+using namespace ostr;
+
+static constexpr codeunit_sequence_view line = "vec4 color = texture(diffuse_map, uv) * tint; // 繁星明\n"_cuqv;
+
+// Repeated append into one sequence, which copies everything on each growth.
+void build_by_sequence_append(benchmark::State& state)
+{
+	const u64 size = static_cast<u64>(state.range(0));
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		codeunit_sequence output;
+		while(output.size() + line.size() <= size)
+			output.append(line);
+		benchmark::DoNotOptimize(output.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(counter.allocated_bytes_since()), benchmark::Counter::kAvgIterations);
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void build_by_builder_finish(benchmark::State& state)
+{
+	const u64 size = static_cast<u64>(state.range(0));
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		string_builder builder;
+		while(builder.size() + line.size() <= size)
+			builder.append(line);
+		const codeunit_sequence output = builder.finish();
+		benchmark::DoNotOptimize(output.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(counter.allocated_bytes_since()), benchmark::Counter::kAvgIterations);
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void build_by_builder_chunks(benchmark::State& state)
+{
+	const u64 size = static_cast<u64>(state.range(0));
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		string_builder builder;
+		while(builder.size() + line.size() <= size)
+			builder.append(line);
+		const std::vector<codeunit_sequence> chunks = builder.finish_chunks();
+		benchmark::DoNotOptimize(chunks.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+	state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(counter.allocated_bytes_since()), benchmark::Counter::kAvgIterations);
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+#if !_WIN64
+void build_by_builder_write(benchmark::State& state)
+{
+	const u64 size = static_cast<u64>(state.range(0));
+	std::FILE* null_file = std::fopen("/dev/null", "wb");
+	for (auto _ : state)
+	{
+		string_builder builder;
+		while(builder.size() + line.size() <= size)
+			builder.append(line);
+		benchmark::DoNotOptimize(builder.write_to(fileno(null_file)));
+	}
+	std::fclose(null_file);
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+#endif
+
+BENCHMARK(build_by_sequence_append)->RangeMultiplier(16)->Range(1 << 20, 1 << 28)->Unit(benchmark::kMillisecond);
+BENCHMARK(build_by_builder_finish)->RangeMultiplier(16)->Range(1 << 20, 1 << 28)->Unit(benchmark::kMillisecond);
+BENCHMARK(build_by_builder_chunks)->RangeMultiplier(16)->Range(1 << 20, 1 << 28)->Unit(benchmark::kMillisecond);
+#if !_WIN64
+BENCHMARK(build_by_builder_write)->RangeMultiplier(16)->Range(1 << 20, 1 << 28)->Unit(benchmark::kMillisecond);
+#endif
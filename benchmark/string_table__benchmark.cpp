@@ -0,0 +1,121 @@
+#include "pch.h"
+#include "string_table.h"
+#include "allocation_counter.h"
+
+using namespace ostr;
+
+// Localisation keys and asset paths, most of which are too long for the small sequence optimization.
+static const std::vector<codeunit_sequence>& get_keys()
+{
+	static const std::vector<codeunit_sequence> keys = []
+	{
+		std::vector<codeunit_sequence> result;
+		result.reserve(1000000);
+		for(u64 i = 0; i < 1000000; ++i)
+			result.push_back(i % 2 == 0 ? format("ui/menu_{}/label"_cuqv, i) : format("tex/{}.png"_cuqv, i));
+		return result;
+	}();
+	return keys;
+}
+
+void hold_keys_sequence_vector(benchmark::State& state)
+{
+	const std::vector<codeunit_sequence>& keys = get_keys();
+	u64 bytes = 0;
+	for (auto _ : state)
+	{
+		const allocation_counter counter;
+		std::vector<codeunit_sequence> copy;
+		copy.reserve(keys.size());
+		for(const codeunit_sequence& key : keys)
+			copy.push_back(key);
+		bytes = counter.allocated_bytes_since();
+		benchmark::DoNotOptimize(copy);
+	}
+	state.counters["memory_bytes"] = static_cast<double>(bytes);
+	state.counters["bytes_per_key"] = static_cast<double>(bytes) / static_cast<double>(keys.size());
+}
+
+void hold_keys_string_table(benchmark::State& state)
+{
+	const std::vector<codeunit_sequence>& keys = get_keys();
+	u64 bytes = 0;
+	for (auto _ : state)
+	{
+		const allocation_counter counter;
+		const string_table table = string_table::build(keys);
+		bytes = counter.allocated_bytes_since();
+		benchmark::DoNotOptimize(table);
+	}
+	state.counters["memory_bytes"] = static_cast<double>(bytes);
+	state.counters["bytes_per_key"] = static_cast<double>(bytes) / static_cast<double>(keys.size());
+}
+
+void find_key_sequence_vector(benchmark::State& state)
+{
+	const std::vector<codeunit_sequence>& keys = get_keys();
+	const codeunit_sequence_view needle = keys.back().view();
+	for (auto _ : state)
+	{
+		u64 index = 0;
+		while(keys[index] != needle)
+			++index;
+		benchmark::DoNotOptimize(index);
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * keys.size()));
+}
+
+void find_key_string_table(benchmark::State& state)
+{
+	const std::vector<codeunit_sequence>& keys = get_keys();
+	const string_table table = string_table::build(keys);
+	const codeunit_sequence_view needle = keys.back().view();
+	for (auto _ : state)
+		benchmark::DoNotOptimize(table.index_of(needle));
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * keys.size()));
+}
+
+void hash_keys_sequence_vector(benchmark::State& state)
+{
+	const std::vector<codeunit_sequence>& keys = get_keys();
+	std::vector<u64> hashes(keys.size());
+	for (auto _ : state)
+	{
+		for(u64 i = 0; i < keys.size(); ++i)
+			hashes[i] = hash_sequence_crc64(keys[i].data(), keys[i].size());
+		benchmark::DoNotOptimize(hashes.data());
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * keys.size()));
+}
+
+void hash_keys_string_table(benchmark::State& state)
+{
+	const string_table table = string_table::build(get_keys());
+	std::vector<u64> hashes;
+	for (auto _ : state)
+	{
+		table.hash_all(hashes);
+		benchmark::DoNotOptimize(hashes.data());
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * table.size()));
+}
+
+void compare_keys_string_table(benchmark::State& state)
+{
+	const string_table table = string_table::build(get_keys());
+	std::vector<i32> results;
+	for (auto _ : state)
+	{
+		table.compare_all("ui/menu_5000/label"_cuqv, results);
+		benchmark::DoNotOptimize(results.data());
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * table.size()));
+}
+
+BENCHMARK(hold_keys_sequence_vector)->Unit(benchmark::kMillisecond);
+BENCHMARK(hold_keys_string_table)->Unit(benchmark::kMillisecond);
+BENCHMARK(find_key_sequence_vector)->Unit(benchmark::kMillisecond);
+BENCHMARK(find_key_string_table)->Unit(benchmark::kMillisecond);
+BENCHMARK(hash_keys_sequence_vector)->Unit(benchmark::kMillisecond);
+BENCHMARK(hash_keys_string_table)->Unit(benchmark::kMillisecond);
+BENCHMARK(compare_keys_string_table)->Unit(benchmark::kMillisecond);
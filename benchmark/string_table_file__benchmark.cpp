@@ -0,0 +1,151 @@
+#include "pch.h"
+#include "string_table_file.h"
+#include "line_reader.h"
+#include "allocation_counter.h"
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+
+#if _WIN64
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace ostr;
+
+static const char* const text_file_path = "ostr_localisation.txt";
+static const char* const table_file_path = "ostr_localisation.bin";
+static constexpr u64 entry_count = 200000;
+static constexpr u64 lookup_count = 1000;
+
+// Data files are removed at exit.
+static const struct localisation_file_cleaner
+{
+	~localisation_file_cleaner()
+	{
+		std::remove(text_file_path);
+		std::remove(table_file_path);
+	}
+} cleaner;
+
+static codeunit_sequence get_key(const u64 i)
+{
+	return format("ui.screen_{}.widget_{}.label"_cuqv, i / 100, i % 100);
+}
+
+// The same entries as "key=value" lines of text and as a string table file.
+static void create_data_files()
+{
+	static bool created = false;
+	if(created)
+		return;
+	created = true;
+	string_table_file_writer writer;
+	std::FILE* text_file = std::fopen(text_file_path, "wb");
+	for(u64 i = 0; i < entry_count; ++i)
+	{
+		const codeunit_sequence key = get_key(i);
+		const codeunit_sequence value = format("第{}个标签 label number {} 🏷", i, i);
+		writer.add(key.view(), value.view());
+		const codeunit_sequence line = format("{}={}\n"_cuqv, key, value);
+		std::fwrite(line.data(), 1, line.size(), text_file);
+	}
+	std::fclose(text_file);
+	(void)writer.write(table_file_path);
+}
+
+// Drop pages of the file from the page cache, so that the next startup reads it from the disk.
+static void evict_file(const char* path)
+{
+#if !_WIN64 && defined(POSIX_FADV_DONTNEED)
+	const int descriptor = ::open(path, O_RDONLY);
+	::fdatasync(descriptor);
+	::posix_fadvise(descriptor, 0, 0, POSIX_FADV_DONTNEED);
+	::close(descriptor);
+#else
+	(void)path;
+#endif
+}
+
+static u64 startup_parse_text(const std::vector<codeunit_sequence>& lookups)
+{
+	std::FILE* stream = std::fopen(text_file_path, "rb");
+	line_reader reader{ stream };
+	std::unordered_map<std::string, text> entries;
+	for(const codeunit_sequence_view& line : reader.lines())
+	{
+		const u64 separator = line.index_of('=');
+		entries.emplace(std::string{ line.data(), separator }, text{ line.subview(separator + 1) });
+	}
+	std::fclose(stream);
+	u64 found = 0;
+	for(const codeunit_sequence& key : lookups)
+		found += entries.find(std::string{ key.data(), key.size() })->second.size();
+	return found;
+}
+
+static u64 startup_string_table_file(const std::vector<codeunit_sequence>& lookups, const bool verify_checksum)
+{
+	string_table_file_options options;
+	options.verify_checksum = verify_checksum;
+	const string_table_file table{ table_file_path, options };
+	u64 found = 0;
+	for(const codeunit_sequence& key : lookups)
+		found += table.find(key.view()).size();
+	return found;
+}
+
+static std::vector<codeunit_sequence> get_lookups()
+{
+	std::vector<codeunit_sequence> lookups;
+	for(u64 i = 0; i < lookup_count; ++i)
+		lookups.push_back(get_key(i * 7919 % entry_count));
+	return lookups;
+}
+
+void startup_parse_text(benchmark::State& state)
+{
+	create_data_files();
+	const bool cold = state.range(0) != 0;
+	const std::vector<codeunit_sequence> lookups = get_lookups();
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		if(cold)
+		{
+			state.PauseTiming();
+			evict_file(text_file_path);
+			state.ResumeTiming();
+		}
+		benchmark::DoNotOptimize(startup_parse_text(lookups));
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void startup_string_table_file(benchmark::State& state)
+{
+	create_data_files();
+	const bool cold = state.range(0) != 0;
+	const bool verify_checksum = state.range(1) != 0;
+	const std::vector<codeunit_sequence> lookups = get_lookups();
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		if(cold)
+		{
+			state.PauseTiming();
+			evict_file(table_file_path);
+			state.ResumeTiming();
+		}
+		benchmark::DoNotOptimize(startup_string_table_file(lookups, verify_checksum));
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+// Arguments are whether the file is evicted from the page cache first, and whether the checksum is verified.
+BENCHMARK(startup_parse_text)->ArgName("cold")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(startup_string_table_file)->ArgNames({ "cold", "verify" })->Args({ 0, 0 })->Args({ 1, 0 })->Args({ 0, 1 })->Unit(benchmark::kMillisecond);
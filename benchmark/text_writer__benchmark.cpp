@@ -0,0 +1,172 @@
+#include "pch.h"
+#include "text_writer.h"
+#include "allocation_counter.h"
+
+#include <cstdio>
+#include <string>
+
+#if _WIN64
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace ostr;
+
+// Output is discarded, so that only the cost of producing and buffering is measured.
+#if _WIN64
+static const char* const null_device = "NUL";
+#else
+static const char* const null_device = "/dev/null";
+#endif
+
+static constexpr u64 line_count = 100000;
+
+static int open_null_descriptor()
+{
+#if _WIN64
+	return _open(null_device, _O_WRONLY | _O_BINARY);
+#else
+	return ::open(null_device, O_WRONLY);
+#endif
+}
+
+static void close_descriptor(const int descriptor)
+{
+#if _WIN64
+	_close(descriptor);
+#else
+	::close(descriptor);
+#endif
+}
+
+void write_lines_fwrite_string(benchmark::State& state)
+{
+	std::FILE* file = std::fopen(null_device, "wb");
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		for(u64 i = 0; i < line_count; ++i)
+		{
+			const std::string line = "request " + std::to_string(i) + " served in " + std::to_string(i % 997) + "us 繁星明\n";
+			std::fwrite(line.data(), 1, line.size(), file);
+		}
+		std::fflush(file);
+	}
+	state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(counter.allocated_bytes_since()), benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * line_count));
+	std::fclose(file);
+}
+
+void write_lines_text_writer(benchmark::State& state)
+{
+	const int descriptor = open_null_descriptor();
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		text_writer writer{ descriptor };
+		for(u64 i = 0; i < line_count; ++i)
+			writer.write_formatted("request {} served in {}us 繁星明\n"_cuqv, i, i % 997);
+	}
+	state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(counter.allocated_bytes_since()), benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * line_count));
+	close_descriptor(descriptor);
+}
+
+void write_lines_text_writer_compiled(benchmark::State& state)
+{
+	const int descriptor = open_null_descriptor();
+	for (auto _ : state)
+	{
+		text_writer writer{ descriptor };
+		for(u64 i = 0; i < line_count; ++i)
+			writer.write_formatted(OPEN_STRING_FORMAT_MOLD("request {} served in {}us 繁星明\n"), i, i % 997);
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * line_count));
+	close_descriptor(descriptor);
+}
+
+void write_lines_sequence(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		codeunit_sequence out;
+		for(u64 i = 0; i < line_count; ++i)
+			format_to(out, "request {} served in {}us 繁星明\n"_cuqv, i, i % 997);
+		benchmark::DoNotOptimize(out);
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * line_count));
+}
+
+void write_lines_text_writer_line_feed(benchmark::State& state)
+{
+	const int descriptor = open_null_descriptor();
+	for (auto _ : state)
+	{
+		text_writer writer{ descriptor, text_flush_policy::on_line_feed };
+		for(u64 i = 0; i < line_count; ++i)
+			writer.write_formatted("request {} served in {}us 繁星明\n"_cuqv, i, i % 997);
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * line_count));
+	close_descriptor(descriptor);
+}
+
+void write_lines_text_writer_background(benchmark::State& state)
+{
+	const int descriptor = open_null_descriptor();
+	for (auto _ : state)
+	{
+		text_writer writer{ descriptor };
+		writer.start_background_flush(std::chrono::milliseconds{ 1 });
+		for(u64 i = 0; i < line_count; ++i)
+			writer.write_formatted("request {} served in {}us 繁星明\n"_cuqv, i, i % 997);
+	}
+	state.SetItemsProcessed(static_cast<i64>(state.iterations() * line_count));
+	close_descriptor(descriptor);
+}
+
+// Payloads of the size, mixed with short headers.
+void write_payloads_fwrite(benchmark::State& state)
+{
+	const u64 size = static_cast<u64>(state.range(0));
+	const std::string payload(size, 'x');
+	std::FILE* file = std::fopen(null_device, "wb");
+	for (auto _ : state)
+	{
+		for(u64 i = 0; i < 64; ++i)
+		{
+			std::fwrite("header\n", 1, 7, file);
+			std::fwrite(payload.data(), 1, payload.size(), file);
+		}
+		std::fflush(file);
+	}
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * 64 * (size + 7)));
+	std::fclose(file);
+}
+
+void write_payloads_text_writer(benchmark::State& state)
+{
+	const u64 size = static_cast<u64>(state.range(0));
+	codeunit_sequence payload;
+	payload.append('x', size);
+	const int descriptor = open_null_descriptor();
+	for (auto _ : state)
+	{
+		text_writer writer{ descriptor };
+		for(u64 i = 0; i < 64; ++i)
+			writer << "header\n"_cuqv << payload.view();
+	}
+	state.SetBytesProcessed(static_cast<i64>(state.iterations() * 64 * (size + 7)));
+	close_descriptor(descriptor);
+}
+
+BENCHMARK(write_lines_fwrite_string);
+BENCHMARK(write_lines_text_writer);
+BENCHMARK(write_lines_text_writer_compiled);
+BENCHMARK(write_lines_sequence);
+BENCHMARK(write_lines_text_writer_line_feed);
+BENCHMARK(write_lines_text_writer_background);
+BENCHMARK(write_payloads_fwrite)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(write_payloads_text_writer)->Arg(1 << 10)->Arg(1 << 20);
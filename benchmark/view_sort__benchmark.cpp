@@ -0,0 +1,87 @@
+#include "pch.h"
+#include "view_sort.h"
+#include "allocation_counter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+using namespace ostr;
+
+// Asset manifest of shuffled paths, which share long directory prefixes.
+static const std::vector<codeunit_sequence>& get_manifest()
+{
+	static const std::vector<codeunit_sequence> manifest = []
+	{
+		const std::array<codeunit_sequence_view, 4> kinds{ "textures"_cuqv, "meshes"_cuqv, "materials"_cuqv, "动画"_cuqv };
+		std::vector<codeunit_sequence> result;
+		result.reserve(1000000);
+		for(u64 i = 0; i < 1000000; ++i)
+			result.push_back(format("assets/content/characters/npc_{}/{}/lod_{}/asset_{}.bin"_cuqv, i % 997, kinds[i % 4], i % 3, i));
+		std::shuffle(result.begin(), result.end(), std::mt19937{ 42 });
+		return result;
+	}();
+	return manifest;
+}
+
+template<class Sort>
+static void sort_manifest(benchmark::State& state, Sort&& sort)
+{
+	const std::vector<codeunit_sequence>& manifest = get_manifest();
+	std::vector<codeunit_sequence_view> shuffled;
+	for(const codeunit_sequence& path : manifest)
+		shuffled.push_back(path.view());
+	const allocation_counter counter;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		std::vector<codeunit_sequence_view> views = shuffled;
+		state.ResumeTiming();
+		sort(views);
+		benchmark::DoNotOptimize(views.data());
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(counter.allocations_since()), benchmark::Counter::kAvgIterations);
+}
+
+void sort_std_memcmp(benchmark::State& state)
+{
+	sort_manifest(state, [](std::vector<codeunit_sequence_view>& views)
+	{
+		std::sort(views.begin(), views.end(), [](const codeunit_sequence_view& lhs, const codeunit_sequence_view& rhs)
+		{
+			const int result = std::memcmp(lhs.data(), rhs.data(), minimum(lhs.size(), rhs.size()));
+			return result != 0 ? result < 0 : lhs.size() < rhs.size();
+		});
+	});
+}
+
+void sort_std_operator(benchmark::State& state)
+{
+	sort_manifest(state, [](std::vector<codeunit_sequence_view>& views)
+	{
+		std::sort(views.begin(), views.end());
+	});
+}
+
+void sort_views(benchmark::State& state)
+{
+	sort_manifest(state, [](std::vector<codeunit_sequence_view>& views)
+	{
+		sort_views(views);
+	});
+}
+
+void sort_views_parallel(benchmark::State& state)
+{
+	const u32 thread_count = static_cast<u32>(state.range(0));
+	sort_manifest(state, [thread_count](std::vector<codeunit_sequence_view>& views)
+	{
+		sort_views_parallel(views, thread_count);
+	});
+}
+
+BENCHMARK(sort_std_memcmp)->Unit(benchmark::kMillisecond);
+BENCHMARK(sort_std_operator)->Unit(benchmark::kMillisecond);
+BENCHMARK(sort_views)->Unit(benchmark::kMillisecond);
+// Argument is the count of threads, 0 for the count of hardware threads.
+BENCHMARK(sort_views_parallel)->Arg(2)->Arg(4)->Arg(0)->Unit(benchmark::kMillisecond);
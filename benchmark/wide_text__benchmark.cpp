@@ -0,0 +1,76 @@
+#include "pch.h"
+#include "allocation_counter.h"
+#include "text.h"
+#include "wide_text.h"
+
+using namespace ostr;
+
+namespace
+{
+	const wchar_t* wide_sample(const int64_t index) noexcept
+	{
+		static const wchar_t* samples[] =
+		{
+			L"abc",
+			L"The quick brown fox jumps over the lazy dog, again and again and again.",
+			L"繁星明在天空中闪烁，夜晚的风吹过山谷和河流，带来远方的消息。😙",
+		};
+		return samples[index];
+	}
+}
+
+void wide_text_memory(benchmark::State& state)
+{
+	const wchar_t* sample = wide_sample(state.range(0));
+	size_t bytes = 0;
+	for (auto _ : state)
+	{
+		const allocation_counter counter;
+		const wide_text wt{ sample };
+		benchmark::DoNotOptimize(wt.data());
+		bytes = sizeof(wide_text) + counter.allocated_bytes_since();
+	}
+	state.counters["bytes"] = static_cast<double>(bytes);
+}
+
+void wide_text_decode(benchmark::State& state)
+{
+	const wide_text wt{ wide_sample(state.range(0)) };
+	codeunit_sequence decoded;
+	for (auto _ : state)
+	{
+		wt.decode(decoded);
+		benchmark::DoNotOptimize(decoded.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * wt.size() * sizeof(wchar_t)));
+}
+
+void wide_text_encode(benchmark::State& state)
+{
+	const text t = text::from_wide(wide_sample(state.range(0)));
+	for (auto _ : state)
+	{
+		const wide_text wt{ t.raw().view() };
+		benchmark::DoNotOptimize(wt.data());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * t.raw().size()));
+}
+
+void format_wide_argument(benchmark::State& state)
+{
+	const wchar_t* sample = wide_sample(state.range(0));
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		const allocation_counter counter;
+		const codeunit_sequence result = format("{}"_cuqv, sample);
+		benchmark::DoNotOptimize(result.data());
+		allocations = counter.allocations_since();
+	}
+	state.counters["allocations"] = static_cast<double>(allocations);
+}
+
+BENCHMARK(wide_text_memory)->DenseRange(0, 2);
+BENCHMARK(wide_text_decode)->DenseRange(0, 2);
+BENCHMARK(wide_text_encode)->DenseRange(0, 2);
+BENCHMARK(format_wide_argument)->DenseRange(0, 2);
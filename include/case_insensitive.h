@@ -0,0 +1,47 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include "text.h"
+
+namespace ostr
+{
+	/**
+	 * \brief Policies of strings ignoring ASCII case, for codeunit_sequence, text, their views and literals, e.g.
+	 * std::unordered_map<codeunit_sequence, T, ascii_case_insensitive_hash, ascii_case_insensitive_equal>
+	 * std::map<text, T, ascii_case_insensitive_less>
+	 * They are transparent, so containers supporting heterogeneous lookup are looked up by views without copies.
+	 */
+	struct ascii_case_insensitive_hash
+	{
+		using is_transparent = void;
+
+		template<class T>
+		[[nodiscard]] u64 operator()(const T& value) const noexcept
+		{
+			return details::view_sequence(value).ihash();
+		}
+	};
+
+	struct ascii_case_insensitive_equal
+	{
+		using is_transparent = void;
+
+		template<class L, class R>
+		[[nodiscard]] bool operator()(const L& lhs, const R& rhs) const noexcept
+		{
+			return details::view_sequence(lhs).iequals(details::view_sequence(rhs));
+		}
+	};
+
+	struct ascii_case_insensitive_less
+	{
+		using is_transparent = void;
+
+		template<class L, class R>
+		[[nodiscard]] bool operator()(const L& lhs, const R& rhs) const noexcept
+		{
+			return details::view_sequence(lhs).icompare(details::view_sequence(rhs)) < 0;
+		}
+	};
+}
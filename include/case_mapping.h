@@ -0,0 +1,53 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include "text.h"
+
+namespace ostr
+{
+	/**
+	 * \brief Full case mappings of the Unicode Character Database, which may change the length of text, e.g. "ß" is upper cased to "SS".
+	 * They are the unconditional ones, mappings depending on the context or the language, like the final sigma or the dotless i of Turkish, are not applied.
+	 */
+	enum class case_mapping : u8
+	{
+		lower,
+		upper,
+		// Case folding for caseless matching, e.g. "Straße" and "STRASSE" are both folded to "strasse".
+		fold,
+	};
+
+	namespace unicode
+	{
+		static constexpr u64 CASE_MAPPING_MAXIMUM_LENGTH = 3;
+
+		/**
+		 * @param cp codepoint to map
+		 * @param mapping case mapping to apply
+		 * @param mapped codepoints cp is mapped to
+		 * @return count of codepoints written to mapped, which is 1 for most codepoints
+		 */
+		OPEN_STRING_API u64 map_case(char32_t cp, case_mapping mapping, std::array<char32_t, CASE_MAPPING_MAXIMUM_LENGTH>& mapped) noexcept;
+	}
+
+	/**
+	 * \brief Append the case mapped source to destination, in one pass over source.
+	 * Ill-formed code units are copied as they are.
+	 * @param destination sequence to append to
+	 * @param source utf-8 text to map
+	 * @param mapping case mapping to apply
+	 */
+	OPEN_STRING_API void map_case_to(codeunit_sequence& destination, const codeunit_sequence_view& source, case_mapping mapping) noexcept;
+
+	/**
+	 * \brief Map the case of sequence in place, which moves it to a new buffer only when mappings lengthen it.
+	 * @param sequence utf-8 text to map
+	 * @param mapping case mapping to apply
+	 */
+	OPEN_STRING_API void map_case_in_place(codeunit_sequence& sequence, case_mapping mapping) noexcept;
+
+	OPEN_STRING_API [[nodiscard]] text to_lower(const text_view& source) noexcept;
+	OPEN_STRING_API [[nodiscard]] text to_upper(const text_view& source) noexcept;
+	OPEN_STRING_API [[nodiscard]] text case_fold(const text_view& source) noexcept;
+}
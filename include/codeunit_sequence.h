@@ -2,12 +2,23 @@
 #pragma once
 #include "common/definitions.h"
 
+#include <cstring>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 
 #include "codeunit_sequence_view.h"
 
 namespace ostr
 {
+	class string_builder;
+	class format_sink;
+
+	namespace details
+	{
+		struct case_mapping_writer;
+	}
+
 	class OPEN_STRING_API codeunit_sequence
 	{
 	public:
@@ -33,8 +44,15 @@ namespace ostr
 
 		template<class...Args>
 		static codeunit_sequence build(const Args&... argument);
+		/**
+		 * Join elements with a separator between each two of them.
+		 * Elements of multi-pass ranges are measured first, so the result is allocated once;
+		 * elements of single-pass ranges are gathered in chunks, then copied once.
+		 */
 		template<typename Container>
 		static codeunit_sequence join(const Container& container, const codeunit_sequence_view& separator) noexcept;
+		template<typename Iterator, typename Sentinel>
+		static codeunit_sequence join(Iterator first, Sentinel last, const codeunit_sequence_view& separator) noexcept;
 
 		// code-region-end: constructors
 
@@ -112,6 +130,26 @@ namespace ostr
 		[[nodiscard]] bool operator!=(const codeunit_sequence& rhs) const noexcept;
 		[[nodiscard]] bool operator!=(const char* rhs) const noexcept;
 
+		/**
+		 * @param rhs Another codeunit sequence
+		 * @return Whether this codeunit sequence is ordered before or after another, in the order of codeunit_sequence_view::compare.
+		 */
+		[[nodiscard]] bool operator<(const codeunit_sequence_view& rhs) const noexcept;
+		[[nodiscard]] bool operator<(const codeunit_sequence& rhs) const noexcept;
+		[[nodiscard]] bool operator>(const codeunit_sequence_view& rhs) const noexcept;
+		[[nodiscard]] bool operator>(const codeunit_sequence& rhs) const noexcept;
+		[[nodiscard]] bool operator<=(const codeunit_sequence_view& rhs) const noexcept;
+		[[nodiscard]] bool operator<=(const codeunit_sequence& rhs) const noexcept;
+		[[nodiscard]] bool operator>=(const codeunit_sequence_view& rhs) const noexcept;
+		[[nodiscard]] bool operator>=(const codeunit_sequence& rhs) const noexcept;
+
+		/**
+		 * @param rhs Another codeunit sequence
+		 * @return negative if this is ordered before rhs, 0 if they are equal, positive if this is ordered after rhs
+		 */
+		[[nodiscard]] i32 compare(const codeunit_sequence_view& rhs) const noexcept;
+		[[nodiscard]] i32 compare(const codeunit_sequence& rhs) const noexcept;
+
 		/**
 		 * Append a codeunit sequence back.
 		 * @return ref of this codeunit sequence.
@@ -212,6 +250,13 @@ namespace ostr
 
 	private:
 
+		// Writes code units into chunks directly, and commits their sizes later.
+		friend class string_builder;
+		// Maps case into the buffer directly, and grows it only when mappings lengthen the text.
+		friend struct details::case_mapping_writer;
+		// Lends the space after the code units to formatters, growing it geometrically.
+		friend class format_sink;
+
 		static constexpr u8 SSO_SIZE_MAX = 14;
 		static bool is_short_size(u64 size) noexcept;
 
@@ -225,7 +270,7 @@ namespace ostr
 		struct norm
 		{
 			u32 alloc : 1;
-			u32 size : 15;
+			u32 size : 31;
 			u32 capacity;	// character capacity, which is 1 less than memory capacity
 			char* data;
 		};
@@ -284,19 +329,123 @@ namespace ostr
 		codeunit_sequence result(size);
 		for(const codeunit_sequence_view& a : arguments)
 			result.append(a);
-		return { result };
+		return result;
+	}
+
+	namespace details
+	{
+		template<class Iterator, class = void>
+		struct is_single_pass_iterator : std::false_type { };
+
+		// Iterators without a category, like linear_iterator, are taken as multi-pass.
+		template<class Iterator>
+		struct is_single_pass_iterator<Iterator, std::void_t<typename std::iterator_traits<Iterator>::iterator_category>>
+			: std::bool_constant<!std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>> { };
+
+		/// @return the code unit past the last one copied
+		inline char* copy_codeunits(char* destination, const codeunit_sequence_view& source) noexcept
+		{
+			if(!source.is_empty())
+				std::memcpy(destination, source.data(), source.size());
+			return destination + source.size();
+		}
+
+		/**
+		 * \brief Code units appended into chunks growing geometrically, which never moves code units appended before.
+		 */
+		class OPEN_STRING_API codeunit_chunk_list
+		{
+		public:
+			codeunit_chunk_list() noexcept = default;
+			~codeunit_chunk_list() noexcept;
+			codeunit_chunk_list(const codeunit_chunk_list&) = delete;
+			codeunit_chunk_list& operator=(const codeunit_chunk_list&) = delete;
+
+			void append(const codeunit_sequence_view& view) noexcept
+			{
+				const u64 view_size = view.size();
+				if(this->last_ && this->last_->capacity - this->last_->size >= view_size)
+				{
+					copy_codeunits(chunk_data(this->last_) + this->last_->size, view);
+					this->last_->size += view_size;
+					this->size_ += view_size;
+				}
+				else
+					this->append_chunks(view);
+			}
+
+			[[nodiscard]] u64 size() const noexcept;
+
+			/**
+			 * Copy all the code units in order.
+			 * @param destination where to copy, which holds size() code units at least
+			 */
+			void copy_to(char* destination) const noexcept;
+
+		private:
+			struct chunk
+			{
+				chunk* next = nullptr;
+				u64 size = 0;
+				u64 capacity = 0;
+			};
+
+			[[nodiscard]] static char* chunk_data(chunk* c) noexcept
+			{
+				return reinterpret_cast<char*>(c + 1);
+			}
+
+			// Append into new chunks, when the view does not fit in the last chunk.
+			void append_chunks(const codeunit_sequence_view& view) noexcept;
+
+			chunk* first_ = nullptr;
+			chunk* last_ = nullptr;
+			u64 size_ = 0;
+		};
 	}
 
 	template<typename Container>
 	codeunit_sequence codeunit_sequence::join(const Container& container, const codeunit_sequence_view& separator) noexcept
 	{
+		using std::begin;
+		using std::end;
+		return join(begin(container), end(container), separator);
+	}
+
+	template<typename Iterator, typename Sentinel>
+	codeunit_sequence codeunit_sequence::join(Iterator first, Sentinel last, const codeunit_sequence_view& separator) noexcept
+	{
+		if(first == last)
+			return { };
+		u64 size = 0;
 		codeunit_sequence result;
-		for(const auto& element : container)
+		// Views of elements are used inside single expressions, since elements may be temporaries.
+		if constexpr (details::is_single_pass_iterator<Iterator>::value)
+		{
+			details::codeunit_chunk_list chunks;
+			chunks.append(details::view_sequence(*first));
+			for(++first; first != last; ++first)
+			{
+				chunks.append(separator);
+				chunks.append(details::view_sequence(*first));
+			}
+			size = chunks.size();
+			result.reserve(size);
+			chunks.copy_to(result.data());
+		}
+		else
 		{
-			if(!result.is_empty())
-				result += separator;
-			result.append(details::view_sequence(element));
+			u64 count = 0;
+			for(Iterator it = first; it != last; ++it, ++count)
+				size += details::view_sequence(*it).size();
+			size += separator.size() * (count - 1);
+			result.reserve(size);
+			char* cursor = details::copy_codeunits(result.data(), details::view_sequence(*first));
+			for(++first; first != last; ++first)
+				cursor = details::copy_codeunits(details::copy_codeunits(cursor, separator), details::view_sequence(*first));
 		}
+		result.set_size(size);
+		result.data()[size] = '\0';
 		return result;
 	}
 
@@ -3,7 +3,13 @@
 #include "common/definitions.h"
 
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 #include <vector>
+#if _WIN64
+#include <intrin.h>
+#endif
 
 #include "common/basic_types.h"
 #include "common/constants.h"
@@ -81,6 +87,17 @@ namespace ostr
 		[[nodiscard]] constexpr bool operator==(const char* rhs) const noexcept;
 		[[nodiscard]] constexpr bool operator!=(const codeunit_sequence_view& rhs) const noexcept;
 		[[nodiscard]] constexpr bool operator!=(const char* rhs) const noexcept;
+		[[nodiscard]] constexpr bool operator<(const codeunit_sequence_view& rhs) const noexcept;
+		[[nodiscard]] constexpr bool operator>(const codeunit_sequence_view& rhs) const noexcept;
+		[[nodiscard]] constexpr bool operator<=(const codeunit_sequence_view& rhs) const noexcept;
+		[[nodiscard]] constexpr bool operator>=(const codeunit_sequence_view& rhs) const noexcept;
+
+		/**
+		 * \brief Three-way comparison of code units as unsigned bytes, with wide words at runtime.
+		 * For well-formed utf-8, this order is the same as the order of codepoints.
+		 * @return negative if this is ordered before rhs, 0 if they are equal, positive if this is ordered after rhs
+		 */
+		[[nodiscard]] constexpr i32 compare(const codeunit_sequence_view& rhs) const noexcept;
 
 		[[nodiscard]] constexpr u64 size() const noexcept;
 
@@ -130,6 +147,19 @@ namespace ostr
 		[[nodiscard]] constexpr bool starts_with(const codeunit_sequence_view& prefix) const noexcept;
 		[[nodiscard]] constexpr bool ends_with(const codeunit_sequence_view& suffix) const noexcept;
 
+		/**
+		 * \brief Case-insensitive variants, which fold ASCII letters only and keep other code units as they are,
+		 * so they are also correct for utf-8. Code units are folded a word at a time in registers without allocation.
+		 */
+		[[nodiscard]] constexpr bool iequals(const codeunit_sequence_view& rhs) const noexcept;
+		/// @return the same as compare, in the order of code units with ASCII letters folded to lower case
+		[[nodiscard]] constexpr i32 icompare(const codeunit_sequence_view& rhs) const noexcept;
+		[[nodiscard]] constexpr bool istarts_with(const codeunit_sequence_view& prefix) const noexcept;
+		[[nodiscard]] constexpr bool iends_with(const codeunit_sequence_view& suffix) const noexcept;
+		[[nodiscard]] constexpr u64 iindex_of(const codeunit_sequence_view& pattern, u64 from = 0, u64 size = SIZE_MAX) const noexcept;
+		/// @return hash which is the same for views equal by iequals
+		[[nodiscard]] constexpr u64 ihash() const noexcept;
+
 		[[nodiscard]] constexpr codeunit_sequence_view remove_prefix(const codeunit_sequence_view& prefix) const noexcept;
 		[[nodiscard]] constexpr codeunit_sequence_view remove_suffix(const codeunit_sequence_view& suffix) const noexcept;
 
@@ -155,6 +185,220 @@ namespace ostr
 				++count;
 			return count;
 		}
+
+		// Word of code units which is not necessarily aligned.
+		// Callers check the size before loading, but GCC cannot see that bound once a search over a small object,
+		// such as a codepoint, is inlined, and reports the load on paths which are never taken.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+		template<class Word>
+		[[nodiscard]] inline Word load_codeunit_word(const char* data) noexcept
+		{
+			Word word;
+			std::memcpy(&word, data, sizeof(Word));
+			return word;
+		}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+		// Word of code units swapped from little-endian, so that words are in the same order as their code units.
+		[[nodiscard]] inline u64 load_ordered_codeunit_word(const char* data) noexcept
+		{
+			const u64 word = load_codeunit_word<u64>(data);
+#if _WIN64
+			return _byteswap_uint64(word);
+#else
+			return __builtin_bswap64(word);
+#endif
+		}
+
+		[[nodiscard]] inline u32 load_ordered_codeunit_half_word(const char* data) noexcept
+		{
+			const u32 word = load_codeunit_word<u32>(data);
+#if _WIN64
+			return _byteswap_ulong(word);
+#else
+			return __builtin_bswap32(word);
+#endif
+		}
+
+		/**
+		 * \brief Compare code units as unsigned bytes, which is constexpr.
+		 * At runtime, code units are compared as words in registers, the last word overlapping the previous one,
+		 * so that there is no byte loop and no call.
+		 * @return negative if lhs is ordered before rhs, 0 if they are equal, positive if lhs is ordered after rhs
+		 */
+		[[nodiscard]] constexpr i32 compare_codeunits(const char* lhs, const char* rhs, const u64 size) noexcept
+		{
+			if(size == 0)
+				return 0;
+			if(!OPEN_STRING_IS_CONSTANT_EVALUATED())
+			{
+				u64 lhs_word = 0;
+				u64 rhs_word = 0;
+				if(size < 4)
+				{
+					// The first, the middle and the last code units, which cover all of them.
+					lhs_word = static_cast<u64>(static_cast<u8>(lhs[0])) << 16 | static_cast<u64>(static_cast<u8>(lhs[size / 2])) << 8 | static_cast<u8>(lhs[size - 1]);
+					rhs_word = static_cast<u64>(static_cast<u8>(rhs[0])) << 16 | static_cast<u64>(static_cast<u8>(rhs[size / 2])) << 8 | static_cast<u8>(rhs[size - 1]);
+				}
+				else if(size < 8)
+				{
+					lhs_word = static_cast<u64>(load_ordered_codeunit_half_word(lhs)) << 32 | load_ordered_codeunit_half_word(lhs + size - 4);
+					rhs_word = static_cast<u64>(load_ordered_codeunit_half_word(rhs)) << 32 | load_ordered_codeunit_half_word(rhs + size - 4);
+				}
+				else
+				{
+					// Whole words up to the last one, which overlaps the previous word whose code units are equal.
+					const u64 last = size - 8;
+					for(u64 i = 0; i < last; i += 8)
+					{
+						lhs_word = load_ordered_codeunit_word(lhs + i);
+						rhs_word = load_ordered_codeunit_word(rhs + i);
+						if(lhs_word != rhs_word)
+							return lhs_word < rhs_word ? -1 : 1;
+					}
+					lhs_word = load_ordered_codeunit_word(lhs + last);
+					rhs_word = load_ordered_codeunit_word(rhs + last);
+				}
+				return lhs_word < rhs_word ? -1 : lhs_word > rhs_word ? 1 : 0;
+			}
+			// char_traits<char> compares as unsigned char.
+			const int result = std::char_traits<char>::compare(lhs, rhs, size);
+			return result < 0 ? -1 : result > 0 ? 1 : 0;
+		}
+
+		/**
+		 * \brief Whether code units are equal, which is constexpr, on the same paths as compare_codeunits without ordering words.
+		 */
+		[[nodiscard]] constexpr bool equal_codeunits(const char* lhs, const char* rhs, const u64 size) noexcept
+		{
+			if(size == 0)
+				return true;
+			if(!OPEN_STRING_IS_CONSTANT_EVALUATED())
+			{
+				if(size < 4)
+					return lhs[0] == rhs[0] && lhs[size / 2] == rhs[size / 2] && lhs[size - 1] == rhs[size - 1];
+				if(size < 8)
+					return load_codeunit_word<u32>(lhs) == load_codeunit_word<u32>(rhs)
+						&& load_codeunit_word<u32>(lhs + size - 4) == load_codeunit_word<u32>(rhs + size - 4);
+				const u64 last = size - 8;
+				for(u64 i = 0; i < last; i += 8)
+					if(load_codeunit_word<u64>(lhs + i) != load_codeunit_word<u64>(rhs + i))
+						return false;
+				return load_codeunit_word<u64>(lhs + last) == load_codeunit_word<u64>(rhs + last);
+			}
+			return std::char_traits<char>::compare(lhs, rhs, size) == 0;
+		}
+
+		inline constexpr u64 CODEUNIT_WORD_ONES = 0x0101010101010101ull;
+
+		[[nodiscard]] inline u64 count_trailing_zeros(const u64 value) noexcept
+		{
+#if _WIN64
+			unsigned long index = 0;
+			_BitScanForward64(&index, value);
+			return static_cast<u64>(index);
+#else
+			return static_cast<u64>(__builtin_ctzll(value));
+#endif
+		}
+
+		// Word of count code units in little-endian, the missing code units are 0.
+		[[nodiscard]] constexpr u64 load_little_endian_codeunit_word(const char* data, const u64 count) noexcept
+		{
+			if(count == 8 && !OPEN_STRING_IS_CONSTANT_EVALUATED())
+				return load_codeunit_word<u64>(data);
+			u64 word = 0;
+			for(u64 i = 0; i < count; ++i)
+				word |= static_cast<u64>(static_cast<u8>(data[i])) << (8 * i);
+			return word;
+		}
+
+		[[nodiscard]] constexpr char fold_ascii_case(const char codeunit) noexcept
+		{
+			return codeunit >= 'A' && codeunit <= 'Z' ? static_cast<char>(codeunit + ('a' - 'A')) : codeunit;
+		}
+
+		/**
+		 * \brief Fold ASCII upper case letters in a word of code units to lower case, and keep other code units.
+		 * Each code unit is a lane of the word, and the sums never carry into the next lane.
+		 */
+		[[nodiscard]] constexpr u64 fold_ascii_case_word(const u64 word) noexcept
+		{
+			const u64 ascii = word & (CODEUNIT_WORD_ONES * 0x7f);
+			const u64 from_a = ascii + CODEUNIT_WORD_ONES * (0x80 - 'A');
+			const u64 after_z = ascii + CODEUNIT_WORD_ONES * (0x80 - 'Z' - 1);
+			const u64 upper = from_a & ~after_z & ~word & (CODEUNIT_WORD_ONES * 0x80);
+			return word | (upper >> 2);
+		}
+
+		[[nodiscard]] constexpr bool iequal_codeunits(const char* lhs, const char* rhs, const u64 size) noexcept
+		{
+			if(size >= 8 && !OPEN_STRING_IS_CONSTANT_EVALUATED())
+			{
+				u64 i = 0;
+				for(; i + 8 <= size; i += 8)
+					if(fold_ascii_case_word(load_codeunit_word<u64>(lhs + i)) != fold_ascii_case_word(load_codeunit_word<u64>(rhs + i)))
+						return false;
+				// The last word overlaps the previous one, whose code units are equal.
+				return i == size || fold_ascii_case_word(load_codeunit_word<u64>(lhs + size - 8)) == fold_ascii_case_word(load_codeunit_word<u64>(rhs + size - 8));
+			}
+			for(u64 i = 0; i < size; ++i)
+				if(fold_ascii_case(lhs[i]) != fold_ascii_case(rhs[i]))
+					return false;
+			return true;
+		}
+
+		[[nodiscard]] constexpr i32 icompare_codeunits(const char* lhs, const char* rhs, const u64 size) noexcept
+		{
+			if(size >= 8 && !OPEN_STRING_IS_CONSTANT_EVALUATED())
+			{
+				for(u64 i = 0; i < size; i += 8)
+				{
+					// The last word overlaps the previous one, whose code units are equal.
+					const u64 offset = minimum(i, size - 8);
+					const u64 lhs_word = fold_ascii_case_word(load_ordered_codeunit_word(lhs + offset));
+					const u64 rhs_word = fold_ascii_case_word(load_ordered_codeunit_word(rhs + offset));
+					if(lhs_word != rhs_word)
+						return lhs_word < rhs_word ? -1 : 1;
+				}
+				return 0;
+			}
+			for(u64 i = 0; i < size; ++i)
+			{
+				const u8 lhs_codeunit = static_cast<u8>(fold_ascii_case(lhs[i]));
+				const u8 rhs_codeunit = static_cast<u8>(fold_ascii_case(rhs[i]));
+				if(lhs_codeunit != rhs_codeunit)
+					return lhs_codeunit < rhs_codeunit ? -1 : 1;
+			}
+			return 0;
+		}
+
+		/**
+		 * \brief Hash of code units with ASCII letters folded to lower case, a word at a time,
+		 * which is the same at runtime and in constant evaluation.
+		 */
+		[[nodiscard]] constexpr u64 ihash_codeunits(const char* data, const u64 size) noexcept
+		{
+			u64 hash = size * 0x9e3779b97f4a7c15ull;
+			for(u64 i = 0; i < size; i += 8)
+			{
+				hash ^= fold_ascii_case_word(load_little_endian_codeunit_word(data + i, minimum(8, size - i)));
+				hash *= 0xff51afd7ed558ccdull;
+				hash ^= hash >> 32;
+			}
+			hash ^= hash >> 30;
+			hash *= 0xbf58476d1ce4e5b9ull;
+			hash ^= hash >> 27;
+			hash *= 0x94d049bb133111ebull;
+			hash ^= hash >> 31;
+			return hash;
+		}
 	}
 
 	constexpr codeunit_sequence_view::codeunit_sequence_view() noexcept = default;
@@ -338,10 +582,7 @@ namespace ostr
 	{
 		if (this->size() != rhs.size()) 
 			return false;
-		for(u64 i = 0; i < this->size(); ++i)
-			if(this->read_at(i) != rhs.read_at(i))
-				return false;
-		return true;
+		return details::equal_codeunits(this->data_, rhs.data_, this->size());
 	}
 
 	constexpr bool codeunit_sequence_view::operator==(const char* rhs) const noexcept
@@ -359,6 +600,35 @@ namespace ostr
 		return !this->operator==(rhs);
 	}
 
+	constexpr bool codeunit_sequence_view::operator<(const codeunit_sequence_view& rhs) const noexcept
+	{
+		return this->compare(rhs) < 0;
+	}
+
+	constexpr bool codeunit_sequence_view::operator>(const codeunit_sequence_view& rhs) const noexcept
+	{
+		return this->compare(rhs) > 0;
+	}
+
+	constexpr bool codeunit_sequence_view::operator<=(const codeunit_sequence_view& rhs) const noexcept
+	{
+		return this->compare(rhs) <= 0;
+	}
+
+	constexpr bool codeunit_sequence_view::operator>=(const codeunit_sequence_view& rhs) const noexcept
+	{
+		return this->compare(rhs) >= 0;
+	}
+
+	constexpr i32 codeunit_sequence_view::compare(const codeunit_sequence_view& rhs) const noexcept
+	{
+		if(const i32 result = details::compare_codeunits(this->data_, rhs.data_, minimum(this->size(), rhs.size())); result != 0)
+			return result;
+		if(this->size() == rhs.size())
+			return 0;
+		return this->size() < rhs.size() ? -1 : 1;
+	}
+
 	constexpr u64 codeunit_sequence_view::size() const noexcept
 	{
 		return this->size_;
@@ -399,7 +669,7 @@ namespace ostr
 	constexpr u64 codeunit_sequence_view::index_of(const codeunit_sequence_view& pattern, const u64 from, const u64 size) const noexcept
 	{
 		const codeunit_sequence_view view = this->subview(from, size);
-		if(view.size() < pattern.size())
+		if(pattern.is_empty() || view.size() < pattern.size())
 			return global_constant::INDEX_INVALID;
 		const char pattern_last = pattern.read_from_last(0);
 		u64 skip = 1;
@@ -557,6 +827,67 @@ namespace ostr
 		return this->subview(this_size - end_size, end_size) == suffix;
 	}
 
+	constexpr bool codeunit_sequence_view::iequals(const codeunit_sequence_view& rhs) const noexcept
+	{
+		return this->size() == rhs.size() && details::iequal_codeunits(this->data_, rhs.data_, this->size());
+	}
+
+	constexpr i32 codeunit_sequence_view::icompare(const codeunit_sequence_view& rhs) const noexcept
+	{
+		if(const i32 result = details::icompare_codeunits(this->data_, rhs.data_, minimum(this->size(), rhs.size())); result != 0)
+			return result;
+		if(this->size() == rhs.size())
+			return 0;
+		return this->size() < rhs.size() ? -1 : 1;
+	}
+
+	constexpr bool codeunit_sequence_view::istarts_with(const codeunit_sequence_view& prefix) const noexcept
+	{
+		return this->size() >= prefix.size() && details::iequal_codeunits(this->data_, prefix.data_, prefix.size());
+	}
+
+	constexpr bool codeunit_sequence_view::iends_with(const codeunit_sequence_view& suffix) const noexcept
+	{
+		return this->size() >= suffix.size() && details::iequal_codeunits(this->data_ + this->size() - suffix.size(), suffix.data_, suffix.size());
+	}
+
+	constexpr u64 codeunit_sequence_view::iindex_of(const codeunit_sequence_view& pattern, const u64 from, const u64 size) const noexcept
+	{
+		const codeunit_sequence_view view = this->subview(from, size);
+		if(pattern.is_empty() || view.size() < pattern.size())
+			return global_constant::INDEX_INVALID;
+		const char pattern_first = details::fold_ascii_case(pattern.read_at(0));
+		const u64 endpoint = view.size() - pattern.size() + 1;
+		u64 i = 0;
+		if(!OPEN_STRING_IS_CONSTANT_EVALUATED())
+		{
+			// Find candidates of 8 positions at once, lanes equal to the first code unit of the pattern become 0.
+			const u64 pattern_first_word = details::CODEUNIT_WORD_ONES * static_cast<u8>(pattern_first);
+			for(; i + 8 <= endpoint; i += 8)
+			{
+				const u64 difference = details::fold_ascii_case_word(details::load_codeunit_word<u64>(view.data_ + i)) ^ pattern_first_word;
+				// Lanes of 0 are marked, together with some lanes after them, which are filtered out by the verification.
+				u64 candidates = (difference - details::CODEUNIT_WORD_ONES) & ~difference & (details::CODEUNIT_WORD_ONES * 0x80);
+				while(candidates != 0)
+				{
+					const u64 index = i + details::count_trailing_zeros(candidates) / 8;
+					if(details::iequal_codeunits(view.data_ + index, pattern.data_, pattern.size()))
+						return index + from;
+					candidates &= candidates - 1;
+				}
+			}
+		}
+		for(; i < endpoint; ++i)
+			if(details::fold_ascii_case(view.read_at(i)) == pattern_first && details::iequal_codeunits(view.data_ + i, pattern.data_, pattern.size()))
+				return i + from;
+		return global_constant::INDEX_INVALID;
+	}
+
+	constexpr u64 codeunit_sequence_view::ihash() const noexcept
+	{
+		return details::ihash_codeunits(this->data_, this->size());
+	}
+
 	constexpr codeunit_sequence_view codeunit_sequence_view::remove_prefix(const codeunit_sequence_view& prefix) const noexcept
 	{
 		return this->starts_with(prefix) ? this->subview(prefix.size()) : *this;
@@ -16,6 +16,12 @@
 #define OPEN_STRING_STRINGIFY_EXPANDED(x) OPEN_STRING_STRINGIFY(x)
 #endif
 
+// Whether the call happens in constant evaluation, define it as true for compilers without the builtin,
+// which keeps everything on paths valid in constant evaluation.
+#ifndef OPEN_STRING_IS_CONSTANT_EVALUATED
+#define OPEN_STRING_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
 #ifndef OPEN_STRING_UNLIKELY
 #define OPEN_STRING_UNLIKELY(expression)    (!!(expression))
 #endif
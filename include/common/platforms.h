@@ -35,10 +35,14 @@
 // Visual Studio will not trigger the breakpoint during single-step debugging without __nop()
 #define OPEN_STRING_DEBUG_BREAK() (__nop(), __debugbreak())
 
+#define OPEN_STRING_NOINLINE __declspec(noinline)
+
 #elif defined(__linux__) || defined(__MACH__)
 
 #define OPEN_STRING_PRINT_SIMPLE_DEBUG_MESSAGE(...)
 #define OPEN_STRING_PRINT_FORMATTED_DEBUG_MESSAGE(...)
 #define OPEN_STRING_DEBUG_BREAK()
 
+#define OPEN_STRING_NOINLINE __attribute__((noinline))
+
 #endif
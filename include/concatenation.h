@@ -0,0 +1,341 @@
+
+#pragma once
+
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "codeunit_sequence.h"
+#include "text.h"
+#include "format.h"
+
+namespace ostr
+{
+	/**
+	 * \brief Pieces formatted lazily inside a concatenation, created by formatted(...).
+	 * The format mold and arguments are referred to, so it must be consumed in the same full expression.
+	 */
+	template<class Format, class...Args>
+	class formatted_piece
+	{
+	public:
+		// Results up to this size are formatted only once, when the concatenation is measured.
+		static constexpr u64 CACHE_CAPACITY = 127;
+
+		formatted_piece(const Format& format_mold, const Args&...args) noexcept
+			: format_mold_(format_mold)
+			, arguments_(args...)
+		{ }
+
+		/// @return size of the formatted result
+		[[nodiscard]] u64 size() const
+		{
+			if(!this->cache_)
+			{
+				this->cache_.emplace();
+				std::apply([this](const Args&...args) { this->cache_->format(this->format_mold_, args...); }, this->arguments_);
+			}
+			return this->cache_->formatted_size();
+		}
+
+		template<class Destination>
+		void append_to(Destination& destination) const
+		{
+			if(this->cache_ && !this->cache_->is_truncated())
+				destination.append(this->cache_->view());
+			else
+				std::apply([this, &destination](const Args&...args) { format_to(destination, this->format_mold_, args...); }, this->arguments_);
+		}
+
+	private:
+		const Format& format_mold_;
+		std::tuple<const Args&...> arguments_;
+		// Empty until measured, so copying the piece into enclosing nodes does not copy the buffer.
+		mutable std::optional<format_buffer<CACHE_CAPACITY>> cache_;
+	};
+
+	/**
+	 * \brief Format lazily as a piece of a concatenation, like: sequence = "hp: "_cuqv + formatted("{:04x}"_cuqv, hp) + '!';
+	 */
+	template<class Format, class...Args>
+	[[nodiscard]] formatted_piece<Format, Args...> formatted(const Format& format_mold, const Args&...args) noexcept
+	{
+		return { format_mold, args... };
+	}
+
+	template<class Lhs, class Rhs>
+	class concatenation;
+
+	namespace details
+	{
+		/**
+		 * \brief How a concatenation keeps an operand, measures it and appends it.
+		 * Strings are kept as views, so operands must live until the concatenation is materialized.
+		 */
+		template<class T, class = void>
+		struct concatenation_operand;
+
+		template<>
+		struct concatenation_operand<char>
+		{
+			using stored_type = char;
+
+			[[nodiscard]] static constexpr stored_type store(const char value) noexcept
+			{
+				return value;
+			}
+
+			[[nodiscard]] static constexpr u64 size(const stored_type) noexcept
+			{
+				return 1;
+			}
+
+			template<class Destination>
+			static void append_to(Destination& destination, const stored_type value)
+			{
+				destination.append(value, 1);
+			}
+		};
+
+		template<>
+		struct concatenation_operand<codepoint>
+		{
+			// The view of a codepoint refers to itself, so it is kept by value.
+			using stored_type = codepoint;
+
+			[[nodiscard]] static constexpr stored_type store(const codepoint& value) noexcept
+			{
+				return value;
+			}
+
+			[[nodiscard]] static constexpr u64 size(const stored_type& value) noexcept
+			{
+				return value.size();
+			}
+
+			template<class Destination>
+			static void append_to(Destination& destination, const stored_type& value)
+			{
+				destination.append(codeunit_sequence_view{ value });
+			}
+		};
+
+		struct concatenation_view_operand
+		{
+			using stored_type = codeunit_sequence_view;
+
+			[[nodiscard]] static constexpr u64 size(const stored_type& value) noexcept
+			{
+				return value.size();
+			}
+
+			template<class Destination>
+			static void append_to(Destination& destination, const stored_type& value)
+			{
+				destination.append(value);
+			}
+		};
+
+		template<>
+		struct concatenation_operand<const char*> : concatenation_view_operand
+		{
+			[[nodiscard]] static constexpr stored_type store(const char* value) noexcept
+			{
+				return codeunit_sequence_view{ value };
+			}
+		};
+
+		template<>
+		struct concatenation_operand<codeunit_sequence_view> : concatenation_view_operand
+		{
+			[[nodiscard]] static constexpr stored_type store(const codeunit_sequence_view& value) noexcept
+			{
+				return value;
+			}
+		};
+
+		template<>
+		struct concatenation_operand<codeunit_sequence> : concatenation_view_operand
+		{
+			[[nodiscard]] static stored_type store(const codeunit_sequence& value) noexcept
+			{
+				return value.view();
+			}
+		};
+
+		template<>
+		struct concatenation_operand<text_view> : concatenation_view_operand
+		{
+			[[nodiscard]] static constexpr stored_type store(const text_view& value) noexcept
+			{
+				return value.raw();
+			}
+		};
+
+		template<>
+		struct concatenation_operand<text> : concatenation_view_operand
+		{
+			[[nodiscard]] static stored_type store(const text& value) noexcept
+			{
+				return value.raw().view();
+			}
+		};
+
+		template<class Format, class...Args>
+		struct concatenation_operand<formatted_piece<Format, Args...>>
+		{
+			using stored_type = formatted_piece<Format, Args...>;
+
+			[[nodiscard]] static stored_type store(const stored_type& value) noexcept
+			{
+				return value;
+			}
+
+			[[nodiscard]] static u64 size(const stored_type& value)
+			{
+				return value.size();
+			}
+
+			template<class Destination>
+			static void append_to(Destination& destination, const stored_type& value)
+			{
+				value.append_to(destination);
+			}
+		};
+
+		template<class Lhs, class Rhs>
+		struct concatenation_operand<concatenation<Lhs, Rhs>>
+		{
+			// Nested nodes are small aggregates of views, so they are kept by value and never dangle.
+			using stored_type = concatenation<Lhs, Rhs>;
+
+			[[nodiscard]] static constexpr stored_type store(const stored_type& value) noexcept
+			{
+				return value;
+			}
+
+			[[nodiscard]] static constexpr u64 size(const stored_type& value)
+			{
+				return value.size();
+			}
+
+			template<class Destination>
+			static void append_to(Destination& destination, const stored_type& value)
+			{
+				value.append_to(destination);
+			}
+		};
+
+		// Arrays and pointers of code units are kept as the same type of operand.
+		template<class T>
+		using concatenation_operand_type = std::conditional_t<std::is_same_v<std::decay_t<T>, char*>, const char*, std::decay_t<T>>;
+
+		template<class T, class = void>
+		struct is_concatenation_operand : std::false_type { };
+
+		template<class T>
+		struct is_concatenation_operand<T, std::void_t<typename concatenation_operand<concatenation_operand_type<T>>::stored_type>> : std::true_type { };
+
+		// operator+ requires an operand of class type at least, so char and pointers keep their built-in meaning.
+		template<class T>
+		inline constexpr bool is_concatenation_class_operand_v = is_concatenation_operand<T>::value && std::is_class_v<T>;
+	}
+
+	/**
+	 * \brief Lazy concatenation of strings, code units, codepoints and formatted pieces, created by operator+.
+	 * Nothing is copied until it is materialized, which measures all the pieces first and allocates once.
+	 * Nested nodes are kept by value, while strings are viewed and formatted pieces refer to their arguments,
+	 * so those operands must live until it is materialized.
+	 */
+	template<class Lhs, class Rhs>
+	class concatenation
+	{
+		using lhs_operand = details::concatenation_operand<Lhs>;
+		using rhs_operand = details::concatenation_operand<Rhs>;
+
+	public:
+		constexpr concatenation(const Lhs& lhs, const Rhs& rhs) noexcept
+			: lhs_(lhs_operand::store(lhs))
+			, rhs_(rhs_operand::store(rhs))
+		{ }
+
+		/// @return count of code units of the result, which is a constant expression if all pieces are
+		[[nodiscard]] constexpr u64 size() const
+		{
+			return lhs_operand::size(this->lhs_) + rhs_operand::size(this->rhs_);
+		}
+
+		/**
+		 * \brief Append pieces in order, the destination is any type appending views and code units,
+		 * like codeunit_sequence and format_sink.
+		 */
+		template<class Destination>
+		void append_to(Destination& destination) const
+		{
+			lhs_operand::append_to(destination, this->lhs_);
+			rhs_operand::append_to(destination, this->rhs_);
+		}
+
+		[[nodiscard]] codeunit_sequence to_sequence() const
+		{
+			codeunit_sequence result{ this->size() };
+			this->append_to(result);
+			return result;
+		}
+
+		[[nodiscard]] operator codeunit_sequence() const
+		{
+			return this->to_sequence();
+		}
+
+		/// @note: Use copy initialization like text t = a + b, since text is constructible from codeunit_sequence as well.
+		[[nodiscard]] operator text() const
+		{
+			return text{ this->to_sequence() };
+		}
+
+	private:
+		typename lhs_operand::stored_type lhs_;
+		typename rhs_operand::stored_type rhs_;
+	};
+
+	template<class Lhs, class Rhs, std::enable_if_t<
+		details::is_concatenation_operand<Lhs>::value && details::is_concatenation_operand<Rhs>::value &&
+		(details::is_concatenation_class_operand_v<Lhs> || details::is_concatenation_class_operand_v<Rhs>), int> = 0>
+	[[nodiscard]] constexpr concatenation<details::concatenation_operand_type<Lhs>, details::concatenation_operand_type<Rhs>> operator+(const Lhs& lhs, const Rhs& rhs) noexcept
+	{
+		return { lhs, rhs };
+	}
+
+	/**
+	 * \brief Append a concatenation, growing the sequence once.
+	 */
+	template<class Lhs, class Rhs>
+	codeunit_sequence& operator+=(codeunit_sequence& lhs, const concatenation<Lhs, Rhs>& rhs)
+	{
+		lhs.reserve(lhs.size() + rhs.size());
+		rhs.append_to(lhs);
+		return lhs;
+	}
+
+	template<class Lhs, class Rhs>
+	text& operator+=(text& lhs, const concatenation<Lhs, Rhs>& rhs)
+	{
+		lhs.raw() += rhs;
+		return lhs;
+	}
+
+	template<class Lhs, class Rhs>
+	struct argument_formatter<concatenation<Lhs, Rhs>>
+	{
+		static void produce(format_sink& sink, const concatenation<Lhs, Rhs>& value, const codeunit_sequence_view& specification)
+		{
+			value.append_to(sink);
+		}
+
+		static u64 measure(const concatenation<Lhs, Rhs>& value, const codeunit_sequence_view& specification)
+		{
+			return value.size();
+		}
+	};
+}
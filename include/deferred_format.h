@@ -0,0 +1,354 @@
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <tuple>
+#include "common/platforms.h"
+#include "common/definitions.h"
+#include "format.h"
+#include "wide_text.h"
+
+namespace ostr
+{
+    /**
+     * \brief How to capture an argument into a deferred record, and how to read it back on the consumer thread.
+     * Values trivially copyable are copied as raw bytes, strings are copied with their sizes and wide strings are encoded into utf-8,
+     * specialize it for other types to make them capturable.
+     */
+    template<class T, class = void>
+    struct deferred_argument;
+
+    namespace details
+    {
+        template<class T>
+        struct is_deferred_string : std::false_type { };
+
+        template<> struct is_deferred_string<const char*> : std::true_type { };
+        template<> struct is_deferred_string<char*> : std::true_type { };
+        template<size_t N> struct is_deferred_string<char[N]> : std::true_type { };
+        template<> struct is_deferred_string<codeunit_sequence_view> : std::true_type { };
+        template<> struct is_deferred_string<codeunit_sequence> : std::true_type { };
+
+        template<class T>
+        [[nodiscard]] codeunit_sequence_view view_deferred_string(const T& value) noexcept
+        {
+            if constexpr (std::is_pointer_v<T>)
+                return value ? codeunit_sequence_view{ value } : codeunit_sequence_view{ };
+            else
+                return view_sequence(value);
+        }
+
+        // Wide strings are encoded into utf-8 when they are captured.
+        template<class T>
+        struct is_deferred_wide_string : std::false_type { };
+
+        template<> struct is_deferred_wide_string<const wchar_t*> : std::true_type { };
+        template<> struct is_deferred_wide_string<wchar_t*> : std::true_type { };
+        template<size_t N> struct is_deferred_wide_string<wchar_t[N]> : std::true_type { };
+        template<> struct is_deferred_wide_string<wide_text> : std::true_type { };
+
+        template<class T>
+        [[nodiscard]] const wchar_t* get_deferred_wide_data(const T& value) noexcept
+        {
+            if constexpr (std::is_same_v<T, wide_text>)
+                return value.data();
+            else
+                return value;
+        }
+
+        template<class T>
+        [[nodiscard]] u64 get_deferred_wide_length(const T& value) noexcept
+        {
+            if constexpr (std::is_same_v<T, wide_text>)
+                return value.size();
+            else
+                return get_sequence_length(value);
+        }
+
+        // Pointers are captured as raw bytes only if their formatter prints the address instead of reading through it.
+        template<class T, class = void>
+        struct is_address_formatted : std::false_type { };
+
+        template<class T>
+        struct is_address_formatted<T, std::enable_if_t<argument_formatter<T>::formats_address>> : std::true_type { };
+
+        /**
+         * \brief Reading of strings captured with their sizes.
+         */
+        struct deferred_string_decoder
+        {
+            // The view refers to code units inside the record, which lives until the record is rendered.
+            using decoded_type = codeunit_sequence_view;
+
+            [[nodiscard]] static codeunit_sequence_view decode(const byte*& data) noexcept
+            {
+                u64 view_size = 0;
+                std::memcpy(&view_size, data, sizeof(u64));
+                const codeunit_sequence_view view{ reinterpret_cast<const char*>(data + sizeof(u64)), view_size };
+                data += sizeof(u64) + view_size;
+                return view;
+            }
+        };
+    }
+
+    template<class T>
+    struct deferred_argument<T, std::enable_if_t<std::is_trivially_copyable_v<T> && !details::is_deferred_string<T>::value && !details::is_deferred_wide_string<T>::value>>
+    {
+        static_assert(!std::is_pointer_v<T> || details::is_address_formatted<T>::value, "Only the address would be captured, while its formatter reads through it when the record is rendered! Capture a copy instead.");
+
+        using decoded_type = T;
+
+        [[nodiscard]] static constexpr u64 size(const T&) noexcept
+        {
+            return sizeof(T);
+        }
+
+        /// @return the byte past the value encoded
+        static byte* encode(byte* data, const T& value) noexcept
+        {
+            std::memcpy(data, &value, sizeof(T));
+            return data + sizeof(T);
+        }
+
+        [[nodiscard]] static T decode(const byte*& data) noexcept
+        {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            data += sizeof(T);
+            return value;
+        }
+    };
+
+    template<class T>
+    struct deferred_argument<T, std::enable_if_t<details::is_deferred_string<T>::value>> : details::deferred_string_decoder
+    {
+        [[nodiscard]] static u64 size(const T& value) noexcept
+        {
+            return sizeof(u64) + details::view_deferred_string(value).size();
+        }
+
+        static byte* encode(byte* data, const T& value) noexcept
+        {
+            const codeunit_sequence_view view = details::view_deferred_string(value);
+            const u64 view_size = view.size();
+            std::memcpy(data, &view_size, sizeof(u64));
+            std::memcpy(data + sizeof(u64), view.data(), view_size);
+            return data + sizeof(u64) + view_size;
+        }
+    };
+
+    template<class T>
+    struct deferred_argument<T, std::enable_if_t<details::is_deferred_wide_string<T>::value>> : details::deferred_string_decoder
+    {
+        [[nodiscard]] static u64 size(const T& value) noexcept
+        {
+            return sizeof(u64) + details::get_utf8_size(details::get_deferred_wide_data(value), details::get_deferred_wide_length(value));
+        }
+
+        static byte* encode(byte* data, const T& value) noexcept
+        {
+            char* first = reinterpret_cast<char*>(data + sizeof(u64));
+            const char* last = details::encode_wide(first, details::get_deferred_wide_data(value), details::get_deferred_wide_length(value));
+            const u64 view_size = static_cast<u64>(last - first);
+            std::memcpy(data, &view_size, sizeof(u64));
+            return data + sizeof(u64) + view_size;
+        }
+    };
+
+    namespace details
+    {
+        /**
+         * \param sink sink to render the record into
+         * \param arguments argument bytes captured in the record
+         */
+        using deferred_render_function_type = void(*)(format_sink& sink, const byte* arguments);
+
+        /**
+         * \brief Renderer of records captured with a compiled format mold and argument types.
+         * The address of render is unique for each format mold and argument types,
+         * so it identifies the format plan of a record.
+         */
+        template<class MoldHolder, class...Args>
+        struct deferred_format_renderer
+        {
+            static void render(format_sink& sink, const byte* arguments)
+            {
+                // Braced initialization decodes arguments in order.
+                const std::tuple<typename deferred_argument<Args>::decoded_type...> values{ deferred_argument<Args>::decode(arguments)... };
+                std::apply([&sink](const auto&...decoded)
+                {
+                    produce_format(sink, compiled_format_mold<MoldHolder>::plan, decoded...);
+                }, values);
+            }
+        };
+    }
+
+    /**
+     * \brief Action of deferred_format_queue::push when the queue is full.
+     */
+    enum class deferred_overflow_policy : u8
+    {
+        // Drop the record and count it, never blocks the producer.
+        drop,
+        // Wait until the consumer frees enough space.
+        block
+    };
+
+    /**
+     * \brief Count of threads allowed to push into a deferred_format_queue at the same time.
+     */
+    enum class deferred_producer_mode : u8
+    {
+        single,
+        multiple
+    };
+
+    /**
+     * \brief Lock-free ring buffer of binary records, each of which is a compiled format mold with its arguments.
+     * Producers capture arguments as raw bytes without formatting,
+     * and a single consumer renders records in order later, usually on a background thread.
+     */
+    class OPEN_STRING_API deferred_format_queue
+    {
+    public:
+        static constexpr u64 RECORD_ALIGNMENT = 16;
+
+        // code-region-start: constructors
+
+        /**
+         * \param capacity size of the ring buffer in bytes, rounded up to a power of 2
+         * \param producer_mode whether multiple threads push at the same time
+         * \param overflow_policy action of push when the queue is full
+         */
+        explicit deferred_format_queue(u64 capacity, deferred_producer_mode producer_mode = deferred_producer_mode::multiple, deferred_overflow_policy overflow_policy = deferred_overflow_policy::drop) noexcept;
+        ~deferred_format_queue() noexcept;
+        deferred_format_queue(const deferred_format_queue&) = delete;
+        deferred_format_queue& operator=(const deferred_format_queue&) = delete;
+
+        // code-region-end: constructors
+
+        /**
+         * \brief Capture arguments into a record, nothing is formatted on the calling thread.
+         * Example: queue.push(OPEN_STRING_FORMAT_MOLD("{} hit {} for {} damage\n"), attacker, target, 42);
+         * \return false if the record is dropped because the queue is full
+         */
+        template<class MoldHolder, class...Args>
+        bool push(const compiled_format_mold<MoldHolder>&, const Args&...args) noexcept
+        {
+            static_assert(compiled_format_mold<MoldHolder>::plan.argument_count <= sizeof...(Args), "Count of arguments is less than the format mold requires!");
+            const u64 argument_size = (u64{ 0 } + ... + deferred_argument<Args>::size(args));
+            record_reservation reservation;
+            if(!this->reserve(argument_size, reservation))
+                return false;
+            [[maybe_unused]] byte* cursor = reservation.arguments;
+            ((cursor = deferred_argument<Args>::encode(cursor, args)), ...);
+            this->commit(reservation, details::deferred_format_renderer<MoldHolder, Args...>::render);
+            return true;
+        }
+
+        /**
+         * \brief Render records pushed so far in order, only a single thread is allowed to call it at the same time.
+         * \param sink sink to render records into, one after another
+         * \return count of records rendered
+         */
+        u64 render(format_sink& sink) noexcept;
+
+        /// @return count of records dropped since the queue was created
+        [[nodiscard]] u64 dropped() const noexcept;
+
+        [[nodiscard]] u64 capacity() const noexcept;
+
+    private:
+        struct record_reservation
+        {
+            // Offset of the record in the ring buffer.
+            u64 offset = 0;
+            // Size of the record in bytes, including its header.
+            u64 size = 0;
+            byte* arguments = nullptr;
+        };
+
+        /**
+         * \param argument_size count of bytes of arguments
+         * \param reservation receives the record reserved
+         * \return false if the record is dropped
+         */
+        [[nodiscard]] bool reserve(u64 argument_size, record_reservation& reservation) noexcept;
+        void commit(const record_reservation& reservation, details::deferred_render_function_type render_function) noexcept;
+
+        [[nodiscard]] std::atomic<u64>& word_at(u64 offset) const noexcept;
+
+        // Words of the ring buffer, the first word of a record is its size, which is 0 until the record is committed.
+        std::atomic<u64>* words_ = nullptr;
+        u64 capacity_ = 0;
+        deferred_producer_mode producer_mode_ = deferred_producer_mode::multiple;
+        deferred_overflow_policy overflow_policy_ = deferred_overflow_policy::drop;
+
+        // Positions never wrap, offsets in the buffer are positions masked by capacity - 1.
+        alignas(64) std::atomic<u64> write_position_{ 0 };
+        alignas(64) std::atomic<u64> read_position_{ 0 };
+        alignas(64) std::atomic<u64> dropped_{ 0 };
+    };
+
+    /**
+     * \brief Background thread rendering records of a queue into a sink, until it is destroyed.
+     * Records still in the queue are rendered before the thread exits.
+     */
+    class deferred_format_worker
+    {
+    public:
+        // code-region-start: constructors
+
+        /**
+         * \param queue queue to render records from, which must outlive the worker
+         * \param sink sink to render records into, which is only used by the worker thread
+         * \param idle_interval time to sleep when the queue is empty
+         */
+        deferred_format_worker(deferred_format_queue& queue, format_sink& sink, const std::chrono::microseconds idle_interval = std::chrono::microseconds{ 1000 }) noexcept
+            : queue_(queue)
+            , sink_(sink)
+            , idle_interval_(idle_interval)
+            , thread_([this] { this->run(); })
+        { }
+
+        ~deferred_format_worker() noexcept
+        {
+            this->stop();
+        }
+
+        deferred_format_worker(const deferred_format_worker&) = delete;
+        deferred_format_worker& operator=(const deferred_format_worker&) = delete;
+
+        // code-region-end: constructors
+
+        /**
+         * \brief Stop the thread after rendering all the records pushed before.
+         */
+        void stop() noexcept
+        {
+            this->running_.store(false, std::memory_order_release);
+            if(this->thread_.joinable())
+                this->thread_.join();
+        }
+
+    private:
+        void run() noexcept
+        {
+            while(this->running_.load(std::memory_order_acquire))
+            {
+                if(this->queue_.render(this->sink_) == 0)
+                    std::this_thread::sleep_for(this->idle_interval_);
+            }
+            this->queue_.render(this->sink_);
+        }
+
+        deferred_format_queue& queue_;
+        format_sink& sink_;
+        std::chrono::microseconds idle_interval_;
+        std::atomic<bool> running_{ true };
+        std::thread thread_;
+    };
+}
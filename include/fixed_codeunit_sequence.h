@@ -0,0 +1,662 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "common/adapters.h"
+#include "codeunit_sequence.h"
+#include "format.h"
+
+namespace ostr
+{
+	/**
+	 * \brief What a fixed-capacity sequence does when code units exceed its capacity.
+	 */
+	enum class fixed_overflow_policy : u8
+	{
+		// Keep the code units fitting in capacity, cut on a codepoint boundary, and drop later appends.
+		truncate,
+		// Report the overflow with OPEN_STRING_CHECK, then truncate.
+		check,
+		// Move the whole sequence to the heap, which makes the sequence not trivially copyable.
+		heap
+	};
+
+	namespace details
+	{
+		template<u64 Capacity>
+		using fixed_size_type = std::conditional_t<Capacity <= 0xFF, u8,
+			std::conditional_t<Capacity <= 0xFFFF, u16,
+			std::conditional_t<Capacity <= 0xFFFFFFFF, u32, u64>>>;
+
+		/**
+		 * \brief Inline code units with a null terminator, which is trivially copyable.
+		 */
+		template<u64 Capacity, bool Spillable>
+		class fixed_codeunit_storage
+		{
+		public:
+			[[nodiscard]] char* data() noexcept
+			{
+				return this->inline_.data();
+			}
+
+			[[nodiscard]] const char* data() const noexcept
+			{
+				return this->inline_.data();
+			}
+
+			[[nodiscard]] u64 size() const noexcept
+			{
+				return this->size_;
+			}
+
+			[[nodiscard]] static constexpr u64 capacity() noexcept
+			{
+				return Capacity;
+			}
+
+			[[nodiscard]] static constexpr bool is_spilled() noexcept
+			{
+				return false;
+			}
+
+		protected:
+			void set_size(const u64 size) noexcept
+			{
+				this->size_ = static_cast<fixed_size_type<Capacity>>(size);
+				this->inline_[size] = '\0';
+				this->inline_[Capacity] = '\0';
+			}
+
+			static constexpr void grow(u64) noexcept
+			{ }
+
+			/**
+			 * \brief Drop appends after a truncation, so the code units kept are always a prefix of all appended.
+			 * A full sequence drops appends anyway, otherwise the last slot is free and keeps the mark.
+			 */
+			void mark_truncated() noexcept
+			{
+				if(this->size_ < Capacity)
+					this->inline_[Capacity] = '\1';
+			}
+
+			[[nodiscard]] bool drops_appends() const noexcept
+			{
+				return this->inline_[Capacity] != '\0';
+			}
+
+		private:
+			std::array<char, Capacity + 1> inline_{ };
+			fixed_size_type<Capacity> size_ = 0;
+		};
+
+		/**
+		 * \brief Inline code units, moved to the heap once they exceed Capacity.
+		 */
+		template<u64 Capacity>
+		class fixed_codeunit_storage<Capacity, true>
+		{
+		public:
+			fixed_codeunit_storage() noexcept = default;
+
+			fixed_codeunit_storage(const fixed_codeunit_storage& other) noexcept
+			{
+				this->assign(other);
+			}
+
+			fixed_codeunit_storage(fixed_codeunit_storage&& other) noexcept
+			{
+				this->take(other);
+			}
+
+			fixed_codeunit_storage& operator=(const fixed_codeunit_storage& other) noexcept
+			{
+				if(this != &other)
+					this->assign(other);
+				return *this;
+			}
+
+			fixed_codeunit_storage& operator=(fixed_codeunit_storage&& other) noexcept
+			{
+				if(this != &other)
+				{
+					this->release();
+					this->take(other);
+				}
+				return *this;
+			}
+
+			~fixed_codeunit_storage() noexcept
+			{
+				this->release();
+			}
+
+			[[nodiscard]] char* data() noexcept
+			{
+				return this->heap_ ? this->heap_ : this->inline_.data();
+			}
+
+			[[nodiscard]] const char* data() const noexcept
+			{
+				return this->heap_ ? this->heap_ : this->inline_.data();
+			}
+
+			[[nodiscard]] u64 size() const noexcept
+			{
+				return this->size_;
+			}
+
+			[[nodiscard]] u64 capacity() const noexcept
+			{
+				return this->heap_ ? this->heap_capacity_ : Capacity;
+			}
+
+			/// @return whether code units are moved to the heap
+			[[nodiscard]] bool is_spilled() const noexcept
+			{
+				return this->heap_ != nullptr;
+			}
+
+		protected:
+			void set_size(const u64 size) noexcept
+			{
+				this->size_ = size;
+				this->data()[size] = '\0';
+			}
+
+			void grow(const u64 required) noexcept
+			{
+				const u64 capacity = maximum(required, this->capacity() * 2);
+				char* allocated = allocator<char>::allocate_array(capacity + 1);
+				std::copy_n(this->data(), this->size_ + 1, allocated);
+				this->release();
+				this->heap_ = allocated;
+				this->heap_capacity_ = capacity;
+			}
+
+			// Code units on the heap are never truncated.
+			static constexpr void mark_truncated() noexcept
+			{ }
+
+			[[nodiscard]] static constexpr bool drops_appends() noexcept
+			{
+				return false;
+			}
+
+		private:
+			void assign(const fixed_codeunit_storage& other) noexcept
+			{
+				if(other.size_ > this->capacity())
+					this->grow(other.size_);
+				std::copy_n(other.data(), other.size_ + 1, this->data());
+				this->size_ = other.size_;
+			}
+
+			void take(fixed_codeunit_storage& other) noexcept
+			{
+				this->inline_ = other.inline_;
+				this->size_ = other.size_;
+				this->heap_ = other.heap_;
+				this->heap_capacity_ = other.heap_capacity_;
+				other.heap_ = nullptr;
+				other.heap_capacity_ = 0;
+				other.set_size(0);
+			}
+
+			void release() noexcept
+			{
+				if(this->heap_)
+					allocator<char>::deallocate_array(this->heap_);
+				this->heap_ = nullptr;
+				this->heap_capacity_ = 0;
+			}
+
+			std::array<char, Capacity + 1> inline_{ };
+			u64 size_ = 0;
+			char* heap_ = nullptr;
+			u64 heap_capacity_ = 0;
+		};
+	}
+
+	/**
+	 * \brief Code units kept inline up to a fixed capacity, which never allocates unless the policy is heap.
+	 * It is trivially copyable unless the policy is heap, so it fits in packets and components.
+	 * \tparam Capacity count of code units kept, without the null terminator
+	 * \tparam Policy what to do when code units exceed Capacity
+	 */
+	template<u64 Capacity, fixed_overflow_policy Policy = fixed_overflow_policy::truncate>
+	class fixed_codeunit_sequence : public details::fixed_codeunit_storage<Capacity, Policy == fixed_overflow_policy::heap>
+	{
+		using storage_type = details::fixed_codeunit_storage<Capacity, Policy == fixed_overflow_policy::heap>;
+
+	public:
+
+		// code-region-start: constructors
+
+		fixed_codeunit_sequence() noexcept = default;
+
+		explicit fixed_codeunit_sequence(const char* data) noexcept
+		{
+			this->append(codeunit_sequence_view{ data });
+		}
+
+		fixed_codeunit_sequence(const char* data, const u64 count) noexcept
+		{
+			this->append(codeunit_sequence_view{ data, count });
+		}
+
+		explicit fixed_codeunit_sequence(const codeunit_sequence_view& view) noexcept
+		{
+			this->append(view);
+		}
+
+		fixed_codeunit_sequence& operator=(const codeunit_sequence_view& view) noexcept
+		{
+			if(view.data() != this->data())
+			{
+				this->empty();
+				this->append(view);
+			}
+			return *this;
+		}
+
+		// code-region-end: constructors
+
+		// code-region-start: iterators
+
+		using iterator = char*;
+		using const_iterator = codeunit_sequence_view::const_iterator;
+
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return this->data();
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return this->view().begin();
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return this->data() + this->size();
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return this->view().end();
+		}
+
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return this->begin();
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return this->end();
+		}
+
+		// code-region-end: iterators
+
+		[[nodiscard]] codeunit_sequence_view view() const noexcept
+		{
+			return { this->data(), this->size() };
+		}
+
+		[[nodiscard]] operator codeunit_sequence_view() const noexcept
+		{
+			return this->view();
+		}
+
+		[[nodiscard]] bool is_empty() const noexcept
+		{
+			return this->size() == 0;
+		}
+
+		[[nodiscard]] bool operator==(const codeunit_sequence_view& rhs) const noexcept
+		{
+			return this->view() == rhs;
+		}
+
+		[[nodiscard]] bool operator==(const char* rhs) const noexcept
+		{
+			return this->view() == rhs;
+		}
+
+		[[nodiscard]] bool operator!=(const codeunit_sequence_view& rhs) const noexcept
+		{
+			return this->view() != rhs;
+		}
+
+		[[nodiscard]] bool operator!=(const char* rhs) const noexcept
+		{
+			return this->view() != rhs;
+		}
+
+		/**
+		 * Append code units back, code units beyond capacity are handled by Policy.
+		 * Once code units are truncated, appends are dropped until the sequence is emptied or rebuilt.
+		 * @return ref of this sequence.
+		 */
+		fixed_codeunit_sequence& append(const codeunit_sequence_view& rhs) noexcept
+		{
+			if(this->drops_appends())
+				return *this;
+			const u64 self_size = this->size();
+			// rhs may be a part of this sequence, which moves if it grows to the heap.
+			const char* self_data = this->data();
+			const bool is_self = !std::less<const char*>{ }(rhs.data(), self_data) && std::less<const char*>{ }(rhs.data(), self_data + self_size);
+			const u64 self_offset = is_self ? static_cast<u64>(rhs.data() - self_data) : 0;
+			const u64 count = unicode::find_utf8_codepoint_boundary(rhs.data(), rhs.size(), this->request_size(self_size + rhs.size()) - self_size);
+			const char* source = is_self ? this->data() + self_offset : rhs.data();
+			std::copy_n(source, count, this->data() + self_size);
+			this->set_size(self_size + count);
+			if(count < rhs.size())
+				this->mark_truncated();
+			return *this;
+		}
+
+		fixed_codeunit_sequence& append(const codepoint& cp) noexcept
+		{
+			return this->append(codeunit_sequence_view{ cp });
+		}
+
+		fixed_codeunit_sequence& append(const char* rhs) noexcept
+		{
+			return this->append(codeunit_sequence_view{ rhs });
+		}
+
+		fixed_codeunit_sequence& append(const char codeunit, const u64 count = 1) noexcept
+		{
+			if(this->drops_appends())
+				return *this;
+			const u64 self_size = this->size();
+			const u64 actual_count = this->request_size(self_size + count) - self_size;
+			std::fill_n(this->data() + self_size, actual_count, codeunit);
+			this->set_size(self_size + actual_count);
+			if(actual_count < count)
+				this->mark_truncated();
+			return *this;
+		}
+
+		fixed_codeunit_sequence& operator+=(const codeunit_sequence_view& rhs) noexcept
+		{
+			return this->append(rhs);
+		}
+
+		fixed_codeunit_sequence& operator+=(const codepoint& cp) noexcept
+		{
+			return this->append(cp);
+		}
+
+		fixed_codeunit_sequence& operator+=(const char* rhs) noexcept
+		{
+			return this->append(rhs);
+		}
+
+		fixed_codeunit_sequence& operator+=(const char codeunit) noexcept
+		{
+			return this->append(codeunit);
+		}
+
+		[[nodiscard]] codeunit_sequence_view subview(const u64 from, const u64 size = SIZE_MAX) const noexcept
+		{
+			return this->view().subview(from, size);
+		}
+
+		/**
+		 * Make this a subsequence from specific range
+		 * @param from start index
+		 * @param size size of subsequence
+		 * @return ref of this sequence
+		 */
+		fixed_codeunit_sequence& subsequence(const u64 from, const u64 size = SIZE_MAX) noexcept
+		{
+			const u64 self_size = this->size();
+			if(from >= self_size)
+			{
+				this->empty();
+				return *this;
+			}
+			const u64 actual_size = minimum(size, self_size - from);
+			if(from != 0)
+				std::move(this->data() + from, this->data() + from + actual_size, this->data());
+			this->set_size(actual_size);
+			return *this;
+		}
+
+		[[nodiscard]] u64 index_of(const codeunit_sequence_view& pattern, const u64 from = 0, const u64 size = SIZE_MAX) const noexcept
+		{
+			return this->view().index_of(pattern, from, size);
+		}
+
+		[[nodiscard]] u64 last_index_of(const codeunit_sequence_view& pattern, const u64 from = 0, const u64 size = SIZE_MAX) const noexcept
+		{
+			return this->view().last_index_of(pattern, from, size);
+		}
+
+		[[nodiscard]] u64 count(const codeunit_sequence_view& pattern) const noexcept
+		{
+			return this->view().count(pattern);
+		}
+
+		[[nodiscard]] bool starts_with(const codeunit_sequence_view& pattern) const noexcept
+		{
+			return this->view().starts_with(pattern);
+		}
+
+		[[nodiscard]] bool ends_with(const codeunit_sequence_view& pattern) const noexcept
+		{
+			return this->view().ends_with(pattern);
+		}
+
+		/**
+		 * Empty the sequence, code units on the heap are kept for reuse.
+		 */
+		void empty() noexcept
+		{
+			this->set_size(0);
+		}
+
+		fixed_codeunit_sequence& write_at(const u64 index, const char codeunit) noexcept
+		{
+			this->data()[index] = codeunit;
+			return *this;
+		}
+
+		[[nodiscard]] const char& read_at(const u64 index) const noexcept
+		{
+			return this->data()[index];
+		}
+
+		[[nodiscard]] char& operator[](const u64 index) noexcept
+		{
+			return this->data()[index];
+		}
+
+		[[nodiscard]] const char& operator[](const u64 index) const noexcept
+		{
+			return this->data()[index];
+		}
+
+		fixed_codeunit_sequence& reverse(const u64 from = 0, const u64 size = SIZE_MAX) noexcept
+		{
+			const u64 self_size = this->size();
+			if(from >= self_size || size == 0)
+				return *this;
+			const u64 actual_size = minimum(size, self_size - from);
+			std::reverse(this->data() + from, this->data() + from + actual_size);
+			return *this;
+		}
+
+		u32 split(const codeunit_sequence_view& splitter, std::vector<codeunit_sequence_view>& pieces, const bool cull_empty = true) const noexcept
+		{
+			return this->view().split(splitter, pieces, cull_empty);
+		}
+
+		/**
+		 * Replace every source in range with destination, code units beyond capacity are handled by Policy.
+		 */
+		fixed_codeunit_sequence& replace(const codeunit_sequence_view& destination, const codeunit_sequence_view& source, const u64 from = 0, const u64 size = SIZE_MAX)
+		{
+			if(source.is_empty() || from >= this->size() || this->subview(from, size).count(source) == 0)
+				return *this;
+			// Replacements overwrite the original code units, so the part after from is copied first.
+			const origin_type origin{ this->view().subview(from) };
+			const codeunit_sequence_view origin_view{ origin.data(), origin.size() };
+			const u64 range_size = minimum(size, origin_view.size());
+			this->set_size(from);
+			u64 searched = 0;
+			while(true)
+			{
+				const u64 found = origin_view.index_of(source, searched, range_size - searched);
+				if(found == global_constant::INDEX_INVALID)
+					break;
+				this->append(origin_view.subview(searched, found - searched)).append(destination);
+				searched = found + source.size();
+			}
+			return this->append(origin_view.subview(searched));
+		}
+
+		/**
+		 * Replace code units in range with destination, code units beyond capacity are handled by Policy.
+		 */
+		fixed_codeunit_sequence& replace(const codeunit_sequence_view& destination, const u64 from, const u64 size = SIZE_MAX)
+		{
+			const u64 self_size = this->size();
+			if(from >= self_size || size == 0)
+				return *this;
+			const u64 actual_size = minimum(size, self_size - from);
+			const origin_type rest{ this->view().subview(from + actual_size) };
+			this->set_size(from);
+			return this->append(destination).append(codeunit_sequence_view{ rest.data(), rest.size() });
+		}
+
+		fixed_codeunit_sequence& self_remove_prefix(const codeunit_sequence_view& prefix) noexcept
+		{
+			return this->starts_with(prefix) ? this->subsequence(prefix.size()) : *this;
+		}
+
+		fixed_codeunit_sequence& self_remove_suffix(const codeunit_sequence_view& suffix) noexcept
+		{
+			return this->ends_with(suffix) ? this->subsequence(0, this->size() - suffix.size()) : *this;
+		}
+
+		[[nodiscard]] codeunit_sequence_view view_remove_prefix(const codeunit_sequence_view& prefix) const noexcept
+		{
+			return this->view().remove_prefix(prefix);
+		}
+
+		[[nodiscard]] codeunit_sequence_view view_remove_suffix(const codeunit_sequence_view& suffix) const noexcept
+		{
+			return this->view().remove_suffix(suffix);
+		}
+
+		fixed_codeunit_sequence& self_trim_start(const codeunit_sequence_view& characters = codeunit_sequence_view(" \t")) noexcept
+		{
+			const u64 self_size = this->size();
+			for(u64 i = 0; i < self_size; ++i)
+				if(!characters.contains(this->read_at(i)))
+					return this->subsequence(i);
+			this->empty();
+			return *this;
+		}
+
+		fixed_codeunit_sequence& self_trim_end(const codeunit_sequence_view& characters = codeunit_sequence_view(" \t")) noexcept
+		{
+			for(u64 i = this->size(); i > 0; --i)
+				if(!characters.contains(this->read_at(i - 1)))
+					return this->subsequence(0, i);
+			this->empty();
+			return *this;
+		}
+
+		fixed_codeunit_sequence& self_trim(const codeunit_sequence_view& characters = codeunit_sequence_view(" \t")) noexcept
+		{
+			// trim_end does not move code units, so it goes first
+			return this->self_trim_end(characters).self_trim_start(characters);
+		}
+
+		[[nodiscard]] codeunit_sequence_view view_trim_start(const codeunit_sequence_view& characters = codeunit_sequence_view(" \t")) const noexcept
+		{
+			return this->view().trim_start(characters);
+		}
+
+		[[nodiscard]] codeunit_sequence_view view_trim_end(const codeunit_sequence_view& characters = codeunit_sequence_view(" \t")) const noexcept
+		{
+			return this->view().trim_end(characters);
+		}
+
+		[[nodiscard]] codeunit_sequence_view view_trim(const codeunit_sequence_view& characters = codeunit_sequence_view(" \t")) const noexcept
+		{
+			return this->view().trim(characters);
+		}
+
+		[[nodiscard]] const char* c_str() const noexcept
+		{
+			return this->data();
+		}
+
+	private:
+		// Copy of code units to rebuild from, which only allocates if the policy is heap.
+		using origin_type = std::conditional_t<Policy == fixed_overflow_policy::heap, codeunit_sequence, fixed_codeunit_sequence<Capacity, fixed_overflow_policy::truncate>>;
+
+		/**
+		 * @param required count of code units required
+		 * @return count of code units allowed, which is less than required if they exceed the capacity
+		 */
+		u64 request_size(const u64 required) noexcept
+		{
+			if(required <= this->capacity())
+				return required;
+			if constexpr (Policy == fixed_overflow_policy::heap)
+			{
+				this->grow(required);
+				return required;
+			}
+			else
+			{
+				if constexpr (Policy == fixed_overflow_policy::check)
+					OPEN_STRING_CHECK(required <= Capacity, "Fixed codeunit sequence overflows: [{}] code units required, but the capacity is [{}]!", required, Capacity);
+				return Capacity;
+			}
+		}
+	};
+
+	template<u64 Capacity, fixed_overflow_policy Policy>
+	struct argument_formatter<fixed_codeunit_sequence<Capacity, Policy>>
+	{
+		static void produce(format_sink& sink, const fixed_codeunit_sequence<Capacity, Policy>& value, const codeunit_sequence_view& specification)
+		{
+			sink.append(value.view());
+		}
+
+		static u64 measure(const fixed_codeunit_sequence<Capacity, Policy>& value, const codeunit_sequence_view& specification)
+		{
+			return value.size();
+		}
+	};
+
+	/**
+	 * \brief Format and append the result after a fixed-capacity sequence, the overflow is handled by its policy.
+	 * \return out
+	 */
+	template<u64 Capacity, fixed_overflow_policy Policy, class Format, class...Args>
+	fixed_codeunit_sequence<Capacity, Policy>& format_to(fixed_codeunit_sequence<Capacity, Policy>& out, const Format& format_mold, const Args&...args)
+	{
+		format_sink sink{ &out, [](void* destination, const char* data, const u64 size)
+		{
+			static_cast<fixed_codeunit_sequence<Capacity, Policy>*>(destination)->append(codeunit_sequence_view{ data, size });
+		} };
+		format_to(sink, format_mold, args...);
+		return out;
+	}
+}
@@ -0,0 +1,361 @@
+
+#pragma once
+
+#include "text.h"
+#include "fixed_codeunit_sequence.h"
+
+namespace ostr
+{
+	/**
+	 * \brief Text kept inline up to a fixed capacity of code units, indexed by codepoints like text.
+	 * Truncation never cuts a codepoint, and it is trivially copyable unless the policy is heap.
+	 * \tparam Capacity count of code units kept, without the null terminator
+	 * \tparam Policy what to do when code units exceed Capacity
+	 */
+	template<u64 Capacity, fixed_overflow_policy Policy = fixed_overflow_policy::truncate>
+	class fixed_text
+	{
+	public:
+		using sequence_type = fixed_codeunit_sequence<Capacity, Policy>;
+
+		// code-region-start: constructors
+
+		fixed_text() noexcept = default;
+
+		fixed_text(const char* str) noexcept
+			: sequence_{ str }
+		{ }
+
+		fixed_text(const text_view& view) noexcept
+			: sequence_{ view.raw() }
+		{ }
+
+		fixed_text& operator=(const text_view& view) noexcept
+		{
+			this->sequence_ = view.raw();
+			return *this;
+		}
+
+		// code-region-end: constructors
+
+		// code-region-start: iterators
+
+		using const_iterator = text_view::const_iterator;
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return this->view().begin();
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return this->view().end();
+		}
+
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return this->view().cbegin();
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return this->view().cend();
+		}
+
+		// code-region-end: iterators
+
+		[[nodiscard]] sequence_type& raw() noexcept
+		{
+			return this->sequence_;
+		}
+
+		[[nodiscard]] const sequence_type& raw() const noexcept
+		{
+			return this->sequence_;
+		}
+
+		[[nodiscard]] text_view view() const noexcept
+		{
+			return text_view{ this->sequence_.view() };
+		}
+
+		[[nodiscard]] operator text_view() const noexcept
+		{
+			return this->view();
+		}
+
+		// Lets build and join take fixed texts like sequences.
+		[[nodiscard]] explicit operator codeunit_sequence_view() const noexcept
+		{
+			return this->sequence_.view();
+		}
+
+		/// @return count of codepoints
+		[[nodiscard]] u64 size() const noexcept
+		{
+			return this->view().size();
+		}
+
+		/// @return count of code units kept inline, or on the heap if the policy is heap
+		[[nodiscard]] u64 capacity() const noexcept
+		{
+			return this->sequence_.capacity();
+		}
+
+		[[nodiscard]] bool is_empty() const noexcept
+		{
+			return this->sequence_.is_empty();
+		}
+
+		[[nodiscard]] bool operator==(const text_view& rhs) const noexcept
+		{
+			return this->view() == rhs;
+		}
+
+		[[nodiscard]] bool operator==(const char* rhs) const noexcept
+		{
+			return this->view() == rhs;
+		}
+
+		[[nodiscard]] bool operator!=(const text_view& rhs) const noexcept
+		{
+			return this->view() != rhs;
+		}
+
+		[[nodiscard]] bool operator!=(const char* rhs) const noexcept
+		{
+			return this->view() != rhs;
+		}
+
+		fixed_text& append(const text_view& rhs) noexcept
+		{
+			this->sequence_.append(rhs.raw());
+			return *this;
+		}
+
+		fixed_text& append(const codepoint& cp) noexcept
+		{
+			this->sequence_.append(cp);
+			return *this;
+		}
+
+		fixed_text& append(const char* rhs) noexcept
+		{
+			this->sequence_.append(rhs);
+			return *this;
+		}
+
+		fixed_text& append(const char codeunit, const u64 count = 1) noexcept
+		{
+			this->sequence_.append(codeunit, count);
+			return *this;
+		}
+
+		fixed_text& operator+=(const text_view& rhs) noexcept
+		{
+			return this->append(rhs);
+		}
+
+		fixed_text& operator+=(const codepoint& cp) noexcept
+		{
+			return this->append(cp);
+		}
+
+		fixed_text& operator+=(const char* rhs) noexcept
+		{
+			return this->append(rhs);
+		}
+
+		fixed_text& operator+=(const char codeunit) noexcept
+		{
+			return this->append(codeunit);
+		}
+
+		[[nodiscard]] text_view subview(const u64 from, const u64 size = SIZE_MAX) const noexcept
+		{
+			return this->view().subview(from, size);
+		}
+
+		fixed_text& subtext(const u64 from, const u64 size = SIZE_MAX) noexcept
+		{
+			u64 raw_from = from;
+			u64 raw_size = size;
+			this->view().get_codeunit_range(raw_from, raw_size);
+			this->sequence_.subsequence(raw_from, raw_size);
+			return *this;
+		}
+
+		[[nodiscard]] u64 index_of(const text_view& pattern, const u64 from = 0, const u64 size = SIZE_MAX) const noexcept
+		{
+			return this->view().index_of(pattern, from, size);
+		}
+
+		[[nodiscard]] u64 last_index_of(const text_view& pattern, const u64 from = 0, const u64 size = SIZE_MAX) const noexcept
+		{
+			return this->view().last_index_of(pattern, from, size);
+		}
+
+		[[nodiscard]] u64 count(const text_view& pattern, const u64 from = 0, const u64 size = SIZE_MAX) const noexcept
+		{
+			return this->view().count(pattern, from, size);
+		}
+
+		[[nodiscard]] bool starts_with(const text_view& prefix) const noexcept
+		{
+			return this->view().starts_with(prefix);
+		}
+
+		[[nodiscard]] bool ends_with(const text_view& suffix) const noexcept
+		{
+			return this->view().ends_with(suffix);
+		}
+
+		void empty() noexcept
+		{
+			this->sequence_.empty();
+		}
+
+		fixed_text& write_at(const u64 index, const codepoint cp) noexcept
+		{
+			return this->replace(text_view{ cp }, index, 1);
+		}
+
+		[[nodiscard]] codepoint read_at(const u64 index) const noexcept
+		{
+			return this->view().read_at(index);
+		}
+
+		[[nodiscard]] codepoint operator[](const u64 index) const noexcept
+		{
+			return this->view().read_at(index);
+		}
+
+		fixed_text& reverse(const u64 from = 0, const u64 size = SIZE_MAX) noexcept
+		{
+			u64 raw_from = from;
+			u64 raw_size = size;
+			this->view().get_codeunit_range(raw_from, raw_size);
+			this->sequence_.reverse(raw_from, raw_size);
+			for(u64 i = 0; i < raw_size; ++i)
+				if(const u8 code_size = unicode::parse_utf8_length(this->sequence_.read_at(raw_from + i)); code_size != 0)
+					this->sequence_.reverse(raw_from + i + 1 - code_size, code_size);
+			return *this;
+		}
+
+		u32 split(const text_view& splitter, sequence<text_view>& pieces, const bool cull_empty = true) const noexcept
+		{
+			text_view view = this->view();
+			u32 count = 0;
+			while(true)
+			{
+				const auto [ left, right ] = view.split(splitter);
+				if(!cull_empty || !left.is_empty())
+					pieces.push_back(left);
+				++count;
+				if(right.is_empty())
+					break;
+				view = right;
+			}
+			return count;
+		}
+
+		fixed_text& replace(const text_view& destination, const text_view& source, const u64 from = 0, const u64 size = SIZE_MAX)
+		{
+			u64 raw_from = from;
+			u64 raw_size = size;
+			this->view().get_codeunit_range(raw_from, raw_size);
+			this->sequence_.replace(destination.raw(), source.raw(), raw_from, raw_size);
+			return *this;
+		}
+
+		fixed_text& replace(const text_view& destination, const u64 from = 0, const u64 size = SIZE_MAX)
+		{
+			u64 raw_from = from;
+			u64 raw_size = size;
+			this->view().get_codeunit_range(raw_from, raw_size);
+			this->sequence_.replace(destination.raw(), raw_from, raw_size);
+			return *this;
+		}
+
+		fixed_text& self_remove_prefix(const text_view& prefix) noexcept
+		{
+			this->sequence_.self_remove_prefix(prefix.raw());
+			return *this;
+		}
+
+		fixed_text& self_remove_suffix(const text_view& suffix) noexcept
+		{
+			this->sequence_.self_remove_suffix(suffix.raw());
+			return *this;
+		}
+
+		[[nodiscard]] text_view view_remove_prefix(const text_view& prefix) const noexcept
+		{
+			return this->view().remove_prefix(prefix);
+		}
+
+		[[nodiscard]] text_view view_remove_suffix(const text_view& suffix) const noexcept
+		{
+			return this->view().remove_suffix(suffix);
+		}
+
+		fixed_text& self_trim_start(const text_view& characters = text_view(" \t")) noexcept
+		{
+			// The view trimmed is a suffix of this text.
+			const u64 trimmed_size = this->view().trim_start(characters).raw().size();
+			this->sequence_.subsequence(this->sequence_.size() - trimmed_size);
+			return *this;
+		}
+
+		fixed_text& self_trim_end(const text_view& characters = text_view(" \t")) noexcept
+		{
+			// The view trimmed is a prefix of this text.
+			this->sequence_.subsequence(0, this->view().trim_end(characters).raw().size());
+			return *this;
+		}
+
+		fixed_text& self_trim(const text_view& characters = text_view(" \t")) noexcept
+		{
+			return this->self_trim_end(characters).self_trim_start(characters);
+		}
+
+		[[nodiscard]] text_view view_trim_start(const text_view& characters = text_view(" \t")) const noexcept
+		{
+			return this->view().trim_start(characters);
+		}
+
+		[[nodiscard]] text_view view_trim_end(const text_view& characters = text_view(" \t")) const noexcept
+		{
+			return this->view().trim_end(characters);
+		}
+
+		[[nodiscard]] text_view view_trim(const text_view& characters = text_view(" \t")) const noexcept
+		{
+			return this->view().trim(characters);
+		}
+
+		[[nodiscard]] const char* c_str() const noexcept
+		{
+			return this->sequence_.c_str();
+		}
+
+	private:
+
+		sequence_type sequence_{ };
+
+	};
+
+	template<u64 Capacity, fixed_overflow_policy Policy>
+	struct argument_formatter<fixed_text<Capacity, Policy>>
+	{
+		static void produce(format_sink& sink, const fixed_text<Capacity, Policy>& value, const codeunit_sequence_view& specification)
+		{
+			sink.append(value.raw().view());
+		}
+
+		static u64 measure(const fixed_text<Capacity, Policy>& value, const codeunit_sequence_view& specification)
+		{
+			return value.raw().size();
+		}
+	};
+}
@@ -1,51 +1,214 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <charconv>
+#include <tuple>
 #include "common/platforms.h"
 #include "common/definitions.h"
 #include "codeunit_sequence.h"
 
 namespace ostr
 {
+    /**
+     * \brief Destination of formatting, formatters write code units into it directly.
+     * A sink forwards code units to a write function without any intermediate buffer,
+     * so formatting into a sequence with enough capacity does not allocate at all.
+     */
+    class format_sink
+    {
+    public:
+        /**
+         * \param destination the destination passed to write_function
+         * \param data code units to write
+         * \param size count of code units to write
+         */
+        using write_function_type = void(*)(void* destination, const char* data, u64 size);
+
+        // code-region-start: constructors
+
+        /**
+         * \param destination the destination passed to write_function
+         * \param write_function function writing code units into destination,
+         * code units are only counted if it is nullptr
+         */
+        constexpr format_sink(void* destination, const write_function_type write_function) noexcept
+            : destination_(destination)
+            , write_function_(write_function)
+        { }
+
+        /**
+         * \param destination sequence to append code units after
+         */
+        explicit format_sink(codeunit_sequence& destination) noexcept
+            : destination_(&destination)
+            , write_function_(write_sequence)
+            , sequence_(&destination)
+        { }
+
+        // code-region-end: constructors
+
+        format_sink& append(const codeunit_sequence_view& view) noexcept
+        {
+            this->write(view.data(), view.size());
+            return *this;
+        }
+
+        format_sink& append(const char codeunit, const u64 count = 1) noexcept
+        {
+            static constexpr u64 FILL_BLOCK_SIZE = 16;
+            if(count <= 1)
+            {
+                this->write(&codeunit, count);
+                return *this;
+            }
+            std::array<char, FILL_BLOCK_SIZE> block{ };
+            block.fill(codeunit);
+            u64 remaining = count;
+            while(remaining > 0)
+            {
+                const u64 size = minimum(remaining, FILL_BLOCK_SIZE);
+                this->write(block.data(), size);
+                remaining -= size;
+            }
+            return *this;
+        }
+
+        /**
+         * \brief Space after the code units written so far, which a formatter writes code units into directly.
+         * Code units written into the space are kept by commit.
+         * \param size count of code units to write at most
+         * \return the space, or nullptr if the destination only receives code units by its write function
+         */
+        char* acquire(const u64 size) noexcept
+        {
+            if(!this->sequence_)
+                return nullptr;
+            // Grow geometrically, so acquiring again and again on a growing sequence reallocates rarely.
+            if(const u64 required = this->sequence_->size() + size; required > this->sequence_->get_capacity())
+                this->sequence_->reserve(maximum(required, this->sequence_->get_capacity() * 2));
+            return this->sequence_->data() + this->sequence_->size();
+        }
+
+        /// @param size count of code units written into the space acquired
+        void commit(const u64 size) noexcept
+        {
+            this->size_ += size;
+            // Appending '\0' grows the sequence without overwriting the code units.
+            this->sequence_->append('\0', size);
+        }
+
+        /// @return count of code units written into this sink so far
+        [[nodiscard]] constexpr u64 size() const noexcept
+        {
+            return this->size_;
+        }
+
+    private:
+        void write(const char* data, const u64 size) noexcept
+        {
+            this->size_ += size;
+            if(this->write_function_ && size > 0)
+                this->write_function_(this->destination_, data, size);
+        }
+
+        static void write_sequence(void* destination, const char* data, const u64 size) noexcept
+        {
+            static_cast<codeunit_sequence*>(destination)->append(codeunit_sequence_view{ data, size });
+        }
+
+        void* destination_ = nullptr;
+        write_function_type write_function_ = nullptr;
+        // Destination which is written into directly, if it is a sequence.
+        codeunit_sequence* sequence_ = nullptr;
+        u64 size_ = 0;
+    };
+
     namespace details
     {
-        codeunit_sequence OPEN_STRING_API format_integer(const u64& value, const codeunit_sequence_view& specification);
-        codeunit_sequence OPEN_STRING_API format_integer(const i64& value, const codeunit_sequence_view& specification);
-        codeunit_sequence OPEN_STRING_API format_float(const f64& value, const codeunit_sequence_view& specification);
+        OPEN_STRING_API void format_integer(format_sink& sink, const u64& value, const codeunit_sequence_view& specification);
+        OPEN_STRING_API void format_integer(format_sink& sink, const i64& value, const codeunit_sequence_view& specification);
+        OPEN_STRING_API void format_float(format_sink& sink, const f32& value, const codeunit_sequence_view& specification);
+        OPEN_STRING_API void format_float(format_sink& sink, const f64& value, const codeunit_sequence_view& specification);
+
+        /**
+         * \brief Write a float by snprintf and strtod, as format does where floating to_chars is missing.
+         * \param type 'e', 'f', 'g' or 'a', or 0 for the shortest representation
+         * \param precision digits after the dot, or SIZE_INVALID for the shortest representation
+         * \return end of the code units written, or nullptr if they do not fit
+         */
+        [[nodiscard]] OPEN_STRING_API char* write_float_portable(char* first, char* last, const f32& value, char type, u64 precision) noexcept;
+        [[nodiscard]] OPEN_STRING_API char* write_float_portable(char* first, char* last, const f64& value, char type, u64 precision) noexcept;
+
+        /// @return size of the formatted integer
+        [[nodiscard]] OPEN_STRING_API u64 measure_integer(const u64& value, const codeunit_sequence_view& specification);
+        /// @return size of the formatted integer
+        [[nodiscard]] OPEN_STRING_API u64 measure_integer(const i64& value, const codeunit_sequence_view& specification);
+        /// @return upper bound of size of the formatted float
+        [[nodiscard]] OPEN_STRING_API u64 measure_float(const f32& value, const codeunit_sequence_view& specification);
+        /// @return upper bound of size of the formatted float
+        [[nodiscard]] OPEN_STRING_API u64 measure_float(const f64& value, const codeunit_sequence_view& specification);
     }
     
     template<class Format, class...Args>
     [[nodiscard]] codeunit_sequence format(const Format& format_mold_literal, const Args&...args);
 
+    /**
+     * \brief Formatter of arguments, specialize it to make a type formattable.
+     * A formatter writes into a format_sink by a static function:
+     *     static void produce(format_sink& sink, const T& value, const codeunit_sequence_view& specification);
+     * A formatter returning the result instead is still supported, the result is appended to the sink:
+     *     static codeunit_sequence produce(const T& value, const codeunit_sequence_view& specification);
+     * A formatter may also report an upper bound of the size it produces, which lets format reserve once
+     * without running the formatter twice:
+     *     static u64 measure(const T& value, const codeunit_sequence_view& specification);
+     */
     template<class T, typename=void>
     struct argument_formatter
     {
-        static codeunit_sequence produce(const T& value, const codeunit_sequence_view& specification)
+        static void produce(format_sink& sink, const T& value, const codeunit_sequence_view& specification)
         {
             constexpr u64 size = sizeof(T);
             const auto reader = reinterpret_cast<const byte*>(&value);
-            codeunit_sequence raw;
-            for(u64 i = 0; i < size; ++i)
+            if(specification == "r"_cuqv)   // output raw memory bytes
             {
-                if(!raw.is_empty())
-                    raw += " "_cuqv;
-                const byte memory = reader[i];
-                raw += details::format_integer(static_cast<u64>(memory), "02x"_cuqv);
+                for(u64 i = 0; i < size; ++i)
+                {
+                    if(i > 0)
+                        sink.append(' ');
+                    details::format_integer(sink, static_cast<u64>(reader[i]), "02x"_cuqv);
+                }
+                return;
             }
-    
-            if(specification == "r"_cuqv)   // output raw memory bytes
-                return raw;
 
+            codeunit_sequence raw;
+            format_sink raw_sink{ raw };
+            produce(raw_sink, value, "r"_cuqv);
             OPEN_STRING_CHECK(false, "Undefined format with raw memory bytes:{}!", raw);
-            return { };
+        }
+
+        static u64 measure(const T& value, const codeunit_sequence_view& specification)
+        {
+            // Two digits and a space for each byte.
+            return sizeof(T) * 3;
         }
     };
 
     namespace details
     {
+        /**
+         * \brief Report an invalid format mold.
+         * This is not constexpr on purpose: when a format mold is compiled by OPEN_STRING_FORMAT_MOLD,
+         * reaching this function stops the compilation, and the message shows in the diagnostic.
+         */
+        template<class...Args>
+        void report_format_mold_error(const char* message, const Args&...args)
+        {
+            OPEN_STRING_CHECK(false, message, args...);
+        }
+
         class format_mold_view
         {
         public:
@@ -139,11 +302,16 @@ namespace ostr
                     }
                     if(from_index != index)
                         return { run_type::plain_text, from_index, index - from_index };
-                    if(format_mold.read_at(index) == format_mold.read_at(index + 1))
+                    if(index + 1 < format_mold.size() && format_mold.read_at(index) == format_mold.read_at(index + 1))
                         return { run_type::escaped_brace, index, 2 };
-                    OPEN_STRING_CHECK(format_mold.read_at(index) != '}', "Unclosed right brace is not allowed!");
+                    if(format_mold.read_at(index) == '}')
+                        report_format_mold_error("Unclosed right brace is not allowed!");
                     const u64 index_next = this->format_mold.index_of_any("{}"_cuqv, index + 1);
-                    OPEN_STRING_CHECK(index_next != global_constant::INDEX_INVALID && format_mold.read_at(index_next) != '{', "Unclosed left brace is not allowed!");
+                    if(index_next == global_constant::INDEX_INVALID || format_mold.read_at(index_next) == '{')
+                    {
+                        report_format_mold_error("Unclosed left brace is not allowed!");
+                        return { run_type::formatter, index, format_mold.size() - index };
+                    }
                     return { run_type::formatter, index, index_next - index + 1 };
                 }
             
@@ -179,91 +347,554 @@ namespace ostr
             codeunit_sequence_view format_mold_{ };
         };
 
+        template<class T, class = void>
+        struct is_sink_argument_formatter : std::false_type { };
+
+        template<class T>
+        struct is_sink_argument_formatter<T, std::void_t<decltype(argument_formatter<T>::produce(
+            std::declval<format_sink&>(), std::declval<const T&>(), std::declval<const codeunit_sequence_view&>()))>> : std::true_type { };
+
+        template<class T, class = void>
+        struct is_measurable_argument_formatter : std::false_type { };
+
+        template<class T>
+        struct is_measurable_argument_formatter<T, std::void_t<decltype(argument_formatter<T>::measure(
+            std::declval<const T&>(), std::declval<const codeunit_sequence_view&>()))>> : std::true_type { };
+
         template <class T>
-        codeunit_sequence format_argument_value(const void* value, const codeunit_sequence_view specification)
+        void format_argument_value(format_sink& sink, const void* value, const codeunit_sequence_view specification)
         {
-            return argument_formatter<T>::produce(*static_cast<const T*>(value), specification);
+            if constexpr (is_sink_argument_formatter<T>::value)
+                argument_formatter<T>::produce(sink, *static_cast<const T*>(value), specification);
+            else
+                sink.append(view_sequence(argument_formatter<T>::produce(*static_cast<const T*>(value), specification)));
+        }
+
+        template <class T>
+        u64 measure_argument_value(const void* value, const codeunit_sequence_view specification)
+        {
+            if constexpr (is_measurable_argument_formatter<T>::value)
+            {
+                return argument_formatter<T>::measure(*static_cast<const T*>(value), specification);
+            }
+            else
+            {
+                // Count the code units produced if the formatter does not report a size.
+                format_sink counter{ nullptr, nullptr };
+                format_argument_value<T>(counter, value, specification);
+                return counter.size();
+            }
         }
 
         struct argument_value_package
         {
-            using argument_value_formatter_type = codeunit_sequence(*)(const void* value, codeunit_sequence_view specification);
+            using argument_value_formatter_type = void(*)(format_sink& sink, const void* value, codeunit_sequence_view specification);
+            using argument_value_measurer_type = u64(*)(const void* value, codeunit_sequence_view specification);
 
             const void* value;
             argument_value_formatter_type argument_value_formatter;
+            argument_value_measurer_type argument_value_measurer;
 
             template<class T>
             explicit constexpr argument_value_package(const T& v) noexcept
                 : value(static_cast<const void*>(&v))
                 , argument_value_formatter(format_argument_value<T>)
+                , argument_value_measurer(measure_argument_value<T>)
             { }
 
-            [[nodiscard]] codeunit_sequence produce(const codeunit_sequence_view& specification) const
+            void produce(format_sink& sink, const codeunit_sequence_view& specification) const
+            {
+                this->argument_value_formatter(sink, this->value, specification);
+            }
+
+            [[nodiscard]] u64 measure(const codeunit_sequence_view& specification) const
             {
-                return this->argument_value_formatter(this->value, specification);
+                return this->argument_value_measurer(this->value, specification);
             }
         };
 
-        template<class...Args>
-        codeunit_sequence produce_format(const format_mold_view& format_mold, const Args&...args)
+        struct format_step
         {
-            constexpr u64 argument_count = sizeof...(Args);
-            const std::array<argument_value_package, argument_count> arguments {{ argument_value_package{ args } ... }};
+            enum class step_type : u8
+            {
+                plain_text,
+                argument
+            };
+
+            step_type type = step_type::plain_text;
+            u64 argument_index = 0;
+            // Text to output for plain text, or specification for argument.
+            codeunit_sequence_view view{ };
+        };
 
+        struct format_argument_indexing
+        {
             enum class indexing_type : u8
             {
                 unknown,
                 manual,
                 automatic
             };
-            indexing_type index_type = indexing_type::unknown;
+
+            /**
+             * @param run formatter run with braces, like {0:x}
+             * @return step to produce the argument
+             */
+            [[nodiscard]] constexpr format_step parse(const codeunit_sequence_view& run)
+            {
+                const auto [ index_run, specification ] = run.subview(1, run.size() - 2).split(":"_cuqv);
+                u64 current_index = this->next_index;
+                if (index_run.is_empty())
+                {
+                    if(this->type == indexing_type::manual)
+                        report_format_mold_error("Manual index is not allowed mixing with automatic index!");
+                    this->type = indexing_type::automatic;
+                    ++this->next_index;
+                }
+                else
+                {
+                    if(this->type == indexing_type::automatic)
+                        report_format_mold_error("Automatic index is not allowed mixing with manual index!");
+                    this->type = indexing_type::manual;
+                    current_index = 0;
+                    for(const char c : index_run)
+                    {
+                        if(c < '0' || c > '9')
+                        {
+                            report_format_mold_error("Invalid format index [{}]!", index_run);
+                            break;
+                        }
+                        current_index = current_index * 10 + (c - '0');
+                    }
+                }
+                this->argument_count = maximum(this->argument_count, current_index + 1);
+                return { format_step::step_type::argument, current_index, specification };
+            }
+
+            indexing_type type = indexing_type::unknown;
             u64 next_index = 0;
-            codeunit_sequence result;
-            for(const auto [ type, run ] : format_mold)
+            // Count of arguments required by parsed formatters.
+            u64 argument_count = 0;
+        };
+
+        /**
+         * \brief Split a format mold into steps of plain text and arguments.
+         * \param format_mold format mold to parse
+         * \param visitor callable receiving each format_step in order
+         * \return count of arguments required by the format mold
+         */
+        template<class Visitor>
+        constexpr u64 parse_format_mold(const codeunit_sequence_view& format_mold, Visitor&& visitor)
+        {
+            format_argument_indexing indexing;
+            for(const auto [ type, run ] : format_mold_view{ format_mold })
             {
-                switch (type) 
+                switch (type)
                 {
                 case format_mold_view::run_type::plain_text:
-                    result += run;
+                    visitor(format_step{ format_step::step_type::plain_text, 0, run });
                     break;
                 case format_mold_view::run_type::escaped_brace:
-                    result += run.read_at(0);
+                    visitor(format_step{ format_step::step_type::plain_text, 0, run.subview(0, 1) });
                     break;
                 case format_mold_view::run_type::formatter:
-                    {    
-                        const auto [ index_run, specification ] = run.subview(1, run.size() - 2).split(":"_cuqv);
-                        u64 current_index = next_index;
-                        if (index_run.is_empty())
-                        {
-                            OPEN_STRING_CHECK(index_type != indexing_type::manual, "Manual index is not allowed mixing with automatic index!");
-                            index_type = indexing_type::automatic;
-                            ++next_index;
-                        }
-                        else
-                        {
-                            OPEN_STRING_CHECK(index_type != indexing_type::automatic, "Automatic index is not allowed mixing with manual index!");
-                            index_type = indexing_type::manual;
-                            [[maybe_unused]] const auto [ last, error ] = 
-                                std::from_chars(index_run.data(), index_run.cend().data(), current_index);
-                            OPEN_STRING_CHECK(last == index_run.cend().data(), "Invalid format index [{}]!", index_run);
-                        }
-                        OPEN_STRING_CHECK(current_index < argument_count, "Invalid format index [{}]: Index should be less than count of argument [{}]!", current_index, argument_count);
-                        result += arguments[current_index].produce(specification);
-                    }
+                    visitor(indexing.parse(run));
                     break;
                 case format_mold_view::run_type::ending:
                     // Unreachable
                     break;
                 }
             }
-            return result;
+            return indexing.argument_count;
+        }
+
+        [[nodiscard]] constexpr u64 count_format_steps(const codeunit_sequence_view& format_mold)
+        {
+            u64 count = 0;
+            parse_format_mold(format_mold, [&count](const format_step&) { ++count; });
+            return count;
+        }
+
+        /**
+         * \brief Pre-parsed format mold, in which runs, argument indices and specifications are split already.
+         * \tparam StepCount count of steps in the format mold
+         */
+        template<u64 StepCount>
+        struct format_plan
+        {
+            std::array<format_step, StepCount> steps{ };
+            // Count of arguments required by the format mold.
+            u64 argument_count = 0;
+        };
+
+        template<u64 StepCount>
+        [[nodiscard]] constexpr format_plan<StepCount> compile_format_mold(const codeunit_sequence_view& format_mold)
+        {
+            format_plan<StepCount> plan;
+            u64 step_index = 0;
+            plan.argument_count = parse_format_mold(format_mold, [&plan, &step_index](const format_step& step)
+            {
+                plan.steps[step_index] = step;
+                ++step_index;
+            });
+            return plan;
+        }
+
+        /**
+         * \brief Steps of a format mold parsed at runtime, kept on stack to run them twice without parsing again.
+         */
+        struct runtime_format_plan
+        {
+            static constexpr u64 STEP_CAPACITY = 16;
+
+            std::array<format_step, STEP_CAPACITY> steps{ };
+            // Count of steps in the format mold, which may be more than the steps kept.
+            u64 step_count = 0;
+            // Count of arguments required by the format mold.
+            u64 argument_count = 0;
+
+            [[nodiscard]] constexpr bool is_complete() const noexcept
+            {
+                return this->step_count <= STEP_CAPACITY;
+            }
+        };
+
+        [[nodiscard]] constexpr runtime_format_plan plan_format_mold(const codeunit_sequence_view& format_mold)
+        {
+            runtime_format_plan plan;
+            plan.argument_count = parse_format_mold(format_mold, [&plan](const format_step& step)
+            {
+                if(plan.step_count < runtime_format_plan::STEP_CAPACITY)
+                    plan.steps[plan.step_count] = step;
+                ++plan.step_count;
+            });
+            return plan;
+        }
+
+        template<class Visitor>
+        constexpr void visit_format_steps(const codeunit_sequence_view& format_mold, Visitor&& visitor)
+        {
+            parse_format_mold(format_mold, visitor);
+        }
+
+        template<class Visitor>
+        constexpr void visit_format_steps(const runtime_format_plan& plan, Visitor&& visitor)
+        {
+            for(u64 i = 0; i < plan.step_count; ++i)
+                visitor(plan.steps[i]);
         }
+
+        template<u64 StepCount, class Visitor>
+        constexpr void visit_format_steps(const format_plan<StepCount>& plan, Visitor&& visitor)
+        {
+            for(const format_step& step : plan.steps)
+                visitor(step);
+        }
+
+        /**
+         * \param steps format mold, or a plan of it
+         * \param arguments arguments to format
+         * \return upper bound of size of the formatted result, if every formatter reports one
+         */
+        template<class Steps, u64 ArgumentCount>
+        [[nodiscard]] u64 measure_format_steps(const Steps& steps, const std::array<argument_value_package, ArgumentCount>& arguments)
+        {
+            u64 size = 0;
+            visit_format_steps(steps, [&size, &arguments](const format_step& step)
+            {
+                if(step.type == format_step::step_type::plain_text)
+                    size += step.view.size();
+                else if(step.argument_index < ArgumentCount)   // Invalid index is reported when producing.
+                    size += arguments[step.argument_index].measure(step.view);
+            });
+            return size;
+        }
+
+        template<class Steps, u64 ArgumentCount>
+        void produce_format_steps(format_sink& sink, const Steps& steps, const std::array<argument_value_package, ArgumentCount>& arguments)
+        {
+            visit_format_steps(steps, [&sink, &arguments](const format_step& step)
+            {
+                if(step.type == format_step::step_type::plain_text)
+                {
+                    sink.append(step.view);
+                    return;
+                }
+                OPEN_STRING_CHECK(step.argument_index < ArgumentCount, "Invalid format index [{}]: Index should be less than count of argument [{}]!", step.argument_index, ArgumentCount);
+                arguments[step.argument_index].produce(sink, step.view);
+            });
+        }
+
+        template<class Steps, class...Args>
+        void produce_format(format_sink& sink, const Steps& steps, const Args&...args)
+        {
+            const std::array<argument_value_package, sizeof...(Args)> arguments {{ argument_value_package{ args } ... }};
+            produce_format_steps(sink, steps, arguments);
+        }
+
+        /**
+         * \brief Measure the result first and reserve out once, then produce into out.
+         */
+        template<class Steps, class...Args>
+        void produce_format_sized(codeunit_sequence& out, const Steps& steps, const Args&...args)
+        {
+            const std::array<argument_value_package, sizeof...(Args)> arguments {{ argument_value_package{ args } ... }};
+            out.reserve(out.size() + measure_format_steps(steps, arguments));
+            format_sink sink{ out };
+            produce_format_steps(sink, steps, arguments);
+        }
+    }
+
+    /**
+     * \brief Format mold parsed at compile time, create it with OPEN_STRING_FORMAT_MOLD.
+     * \tparam MoldHolder type with a constexpr static function value() returning the mold literal
+     */
+    template<class MoldHolder>
+    struct compiled_format_mold
+    {
+        static constexpr codeunit_sequence_view mold = MoldHolder::value();
+        static constexpr details::format_plan<details::count_format_steps(mold)> plan = details::compile_format_mold<details::count_format_steps(mold)>(mold);
+    };
+
+    /**
+     * \brief Format into a sink, the basis of all the other format functions.
+     * \param sink sink to write into
+     * \param format_mold_literal format mold, like "{} is {:x}"
+     * \param args arguments to format
+     * \return the sink
+     */
+    template<class Format, class...Args>
+    format_sink& format_to(format_sink& sink, const Format& format_mold_literal, const Args&...args)
+    {
+        details::produce_format(sink, details::view_sequence(format_mold_literal), args...);
+        return sink;
+    }
+
+    /**
+     * \brief Format into a sink with a format mold parsed at compile time.
+     * Argument count is checked at compile time, and only the pre-parsed plan is executed at runtime.
+     * Example: format_to(sink, OPEN_STRING_FORMAT_MOLD("{} is {:x}"), name, 255);
+     */
+    template<class MoldHolder, class...Args>
+    format_sink& format_to(format_sink& sink, const compiled_format_mold<MoldHolder>&, const Args&...args)
+    {
+        static_assert(compiled_format_mold<MoldHolder>::plan.argument_count <= sizeof...(Args), "Count of arguments is less than the format mold requires!");
+        details::produce_format(sink, compiled_format_mold<MoldHolder>::plan, args...);
+        return sink;
+    }
+
+    /**
+     * \brief Format and append the result after an existing sequence.
+     * Arguments are written into out directly, reusing out with enough capacity does not allocate.
+     * \return out
+     */
+    template<class Format, class...Args>
+    codeunit_sequence& format_to(codeunit_sequence& out, const Format& format_mold, const Args&...args)
+    {
+        format_sink sink{ out };
+        format_to(sink, format_mold, args...);
+        return out;
+    }
+
+    /**
+     * \brief Format and write the result through an output iterator, like a char* or a std::back_insert_iterator.
+     * \return the iterator past the last code unit written
+     */
+    template<class OutputIt, class Format, class...Args>
+    std::enable_if_t<!std::is_same_v<OutputIt, codeunit_sequence> && !std::is_base_of_v<format_sink, OutputIt>, OutputIt>
+    format_to(OutputIt out, const Format& format_mold, const Args&...args)
+    {
+        format_sink sink{ &out, [](void* destination, const char* data, const u64 size)
+        {
+            OutputIt& iterator = *static_cast<OutputIt*>(destination);
+            iterator = std::copy_n(data, size, iterator);
+        } };
+        format_to(sink, format_mold, args...);
+        return out;
+    }
+
+    /**
+     * \brief Count code units of the formatted result exactly, by formatting without writing anywhere.
+     * \return size of the formatted result
+     */
+    template<class Format, class...Args>
+    [[nodiscard]] u64 formatted_size(const Format& format_mold, const Args&...args)
+    {
+        format_sink counter{ nullptr, nullptr };
+        format_to(counter, format_mold, args...);
+        return counter.size();
+    }
+
+    /**
+     * \brief Result of format_to_n.
+     */
+    struct format_to_n_result
+    {
+        // Past the last code unit written.
+        char* out = nullptr;
+        // Size of the whole formatted result, which is larger than the code units written if truncated.
+        u64 size = 0;
+    };
+
+    namespace details
+    {
+        /**
+         * \brief Destination writing code units into a fixed array, code units out of capacity are dropped.
+         */
+        struct bounded_format_destination
+        {
+            char* data = nullptr;
+            u64 capacity = 0;
+            u64 size = 0;
+            bool truncated = false;
+            // The first code unit dropped, which tells whether the last codepoint written is complete.
+            char first_dropped = 0;
+
+            static void write(void* destination, const char* data, const u64 size) noexcept
+            {
+                bounded_format_destination& self = *static_cast<bounded_format_destination*>(destination);
+                const u64 count = minimum(size, self.capacity - self.size);
+                std::copy_n(data, count, self.data + self.size);
+                self.size += count;
+                if(count < size && !self.truncated)
+                {
+                    self.truncated = true;
+                    self.first_dropped = data[count];
+                }
+            }
+
+            /**
+             * \brief Drop code units of the codepoint cut by truncation.
+             * \return count of code units kept
+             */
+            u64 finish() noexcept
+            {
+                if(!this->truncated || unicode::parse_utf8_length(this->first_dropped) != 0)
+                    return this->size;
+                // The first code unit dropped continues the last codepoint, so drop its leading code units too.
+                u64 kept = this->size;
+                for(u64 i = 0; i + 1 < unicode::UTF8_SEQUENCE_MAXIMUM_LENGTH && kept > 0 && unicode::parse_utf8_length(this->data[kept - 1]) == 0; ++i)
+                    --kept;
+                if(kept > 0)
+                    --kept;
+                this->size = kept;
+                return kept;
+            }
+        };
     }
 
+    /**
+     * \brief Format into a caller-provided array without allocation, truncating the result on a codepoint boundary.
+     * No null terminator is written.
+     * \param out array to write into
+     * \param capacity count of code units out is able to receive
+     * \return past the last code unit written, and size of the whole result
+     */
+    template<class Format, class...Args>
+    format_to_n_result format_to_n(char* out, const u64 capacity, const Format& format_mold, const Args&...args)
+    {
+        details::bounded_format_destination destination{ out, capacity };
+        format_sink sink{ &destination, details::bounded_format_destination::write };
+        format_to(sink, format_mold, args...);
+        return { out + destination.finish(), sink.size() };
+    }
+
+    /**
+     * \brief Fixed-capacity inline buffer of a formatted result, which never allocates.
+     * Results longer than Capacity are truncated on a codepoint boundary.
+     * Example: const auto message = format_inline<128>("{} hit {}", attacker, target);
+     * \tparam Capacity count of code units kept, without the null terminator
+     */
+    template<u64 Capacity>
+    class format_buffer
+    {
+    public:
+        /**
+         * \brief Replace the content with a formatted result.
+         */
+        template<class Format, class...Args>
+        format_buffer& format(const Format& format_mold, const Args&...args)
+        {
+            const format_to_n_result result = format_to_n(this->data_.data(), Capacity, format_mold, args...);
+            this->size_ = static_cast<u64>(result.out - this->data_.data());
+            this->formatted_size_ = result.size;
+            this->data_[this->size_] = '\0';
+            return *this;
+        }
+
+        [[nodiscard]] codeunit_sequence_view view() const noexcept
+        {
+            return { this->data_.data(), this->size_ };
+        }
+
+        [[nodiscard]] const char* c_str() const noexcept
+        {
+            return this->data_.data();
+        }
+
+        [[nodiscard]] u64 size() const noexcept
+        {
+            return this->size_;
+        }
+
+        /// @return size of the whole formatted result, which is larger than size() if truncated
+        [[nodiscard]] u64 formatted_size() const noexcept
+        {
+            return this->formatted_size_;
+        }
+
+        [[nodiscard]] bool is_truncated() const noexcept
+        {
+            return this->formatted_size_ > this->size_;
+        }
+
+    private:
+        std::array<char, Capacity + 1> data_{ };
+        u64 size_ = 0;
+        u64 formatted_size_ = 0;
+    };
+
+    /**
+     * \brief Format into a fixed-capacity inline buffer, without allocation.
+     * \tparam Capacity count of code units kept, the result is truncated on a codepoint boundary if it is longer
+     */
+    template<u64 Capacity, class Format, class...Args>
+    [[nodiscard]] format_buffer<Capacity> format_inline(const Format& format_mold, const Args&...args)
+    {
+        format_buffer<Capacity> buffer;
+        buffer.format(format_mold, args...);
+        return buffer;
+    }
+
+    /**
+     * \brief Format into a new sequence.
+     * The result is measured before formatting, so the sequence allocates at most once,
+     * and not at all if the result fits inline.
+     */
     template<class Format, class...Args>
     [[nodiscard]] codeunit_sequence format(const Format& format_mold_literal, const Args&...args)
     {
-        return details::produce_format(details::format_mold_view{ details::view_sequence(format_mold_literal) }, args...);
+        codeunit_sequence result;
+        const codeunit_sequence_view format_mold = details::view_sequence(format_mold_literal);
+        const details::runtime_format_plan plan = details::plan_format_mold(format_mold);
+        if(plan.is_complete())
+            details::produce_format_sized(result, plan, args...);
+        else    // Too many steps to keep on stack, parse the format mold twice.
+            details::produce_format_sized(result, format_mold, args...);
+        return result;
+    }
+
+    /**
+     * \brief Format into a new sequence with a format mold parsed at compile time.
+     * Example: format(OPEN_STRING_FORMAT_MOLD("{} is {:x}"), name, 255);
+     */
+    template<class MoldHolder, class...Args>
+    [[nodiscard]] codeunit_sequence format(const compiled_format_mold<MoldHolder>&, const Args&...args)
+    {
+        static_assert(compiled_format_mold<MoldHolder>::plan.argument_count <= sizeof...(Args), "Count of arguments is less than the format mold requires!");
+        codeunit_sequence result;
+        details::produce_format_sized(result, compiled_format_mold<MoldHolder>::plan, args...);
+        return result;
     }
 
     // code-region-start: formatter specializations for built-in types
@@ -271,83 +902,157 @@ namespace ostr
     template<class T>
     struct argument_formatter<T, std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T>>>
     {
-        static codeunit_sequence produce(const T& value, const codeunit_sequence_view& specification)
+        static void produce(format_sink& sink, const T& value, const codeunit_sequence_view& specification)
         {
-            return details::format_integer(static_cast<i64>(value), specification);
+            details::format_integer(sink, static_cast<i64>(value), specification);
+        }
+
+        static u64 measure(const T& value, const codeunit_sequence_view& specification)
+        {
+            return details::measure_integer(static_cast<i64>(value), specification);
         }
     };
 
     template<class T>
     struct argument_formatter<T, std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T>>>
     {
-        static codeunit_sequence produce(const T& value, const codeunit_sequence_view& specification)
+        static void produce(format_sink& sink, const T& value, const codeunit_sequence_view& specification)
+        {
+            details::format_integer(sink, static_cast<u64>(value), specification);
+        }
+
+        static u64 measure(const T& value, const codeunit_sequence_view& specification)
         {
-            return details::format_integer(static_cast<u64>(value), specification);
+            return details::measure_integer(static_cast<u64>(value), specification);
         }
     };
 
+    /**
+     * Floats are formatted in the shortest representation which reads back to the same value, unless
+     * a type of 'e' (scientific), 'f' (fixed), 'g' (general) or 'a' (hexadecimal), or a precision is specified.
+     */
     template<class T> 
     struct argument_formatter<T, std::enable_if_t<std::is_floating_point_v<T>>>
     {
-        static codeunit_sequence produce(const T& value, const codeunit_sequence_view& specification)
+        // f32 keeps its own shortest representation, which is shorter than the one of the same value in f64.
+        using float_type = std::conditional_t<std::is_same_v<T, f32>, f32, f64>;
+
+        static void produce(format_sink& sink, const T& value, const codeunit_sequence_view& specification)
         {
-            return details::format_float(static_cast<f64>(value), specification);
+            details::format_float(sink, static_cast<float_type>(value), specification);
+        }
+
+        static u64 measure(const T& value, const codeunit_sequence_view& specification)
+        {
+            return details::measure_float(static_cast<float_type>(value), specification);
         }
     };
 
     template<> 
     struct argument_formatter<const char*>
     {
-        static codeunit_sequence produce(const char* value, const codeunit_sequence_view& specification)
+        static void produce(format_sink& sink, const char* value, const codeunit_sequence_view& specification)
+        {
+            sink.append(codeunit_sequence_view{ value });
+        }
+
+        static u64 measure(const char* value, const codeunit_sequence_view& specification)
         {
-            return codeunit_sequence{value};
+            return codeunit_sequence_view{ value }.size();
         }
     };
 
     template<size_t N> 
     struct argument_formatter<char[N]>
     {
-        static codeunit_sequence produce(const char (&value)[N], const codeunit_sequence_view& specification)
+        static void produce(format_sink& sink, const char (&value)[N], const codeunit_sequence_view& specification)
+        {
+            sink.append(codeunit_sequence_view{ value });
+        }
+
+        static u64 measure(const char (&value)[N], const codeunit_sequence_view& specification)
         {
-            return codeunit_sequence{value};
+            return codeunit_sequence_view{ value }.size();
         }
     };
 
     template<> 
     struct argument_formatter<codeunit_sequence_view>
     {
-        static codeunit_sequence produce(const codeunit_sequence_view& value, const codeunit_sequence_view& specification)
+        static void produce(format_sink& sink, const codeunit_sequence_view& value, const codeunit_sequence_view& specification)
         {
-            return codeunit_sequence{value};
+            sink.append(value);
+        }
+
+        static u64 measure(const codeunit_sequence_view& value, const codeunit_sequence_view& specification)
+        {
+            return value.size();
         }
     };
 
     template<> 
     struct argument_formatter<codeunit_sequence>
     {
-        static const codeunit_sequence& produce(const codeunit_sequence& value, const codeunit_sequence_view& specification)
+        static void produce(format_sink& sink, const codeunit_sequence& value, const codeunit_sequence_view& specification)
         {
-            return value;
+            sink.append(value.view());
+        }
+
+        static u64 measure(const codeunit_sequence& value, const codeunit_sequence_view& specification)
+        {
+            return value.size();
         }
     };
 
     template<>
     struct argument_formatter<std::nullptr_t>
     {
-        static codeunit_sequence produce(std::nullptr_t, const codeunit_sequence_view& specification)
+        static void produce(format_sink& sink, std::nullptr_t, const codeunit_sequence_view& specification)
+        {
+            sink.append("nullptr"_cuqv);
+        }
+
+        static u64 measure(std::nullptr_t, const codeunit_sequence_view& specification)
         {
-            return codeunit_sequence{"nullptr"_cuqv};
+            return "nullptr"_cuqv.size();
         }
     };
 
     template<class T> 
     struct argument_formatter<T*>
     {
-        static codeunit_sequence produce(const T* value, const codeunit_sequence_view& specification)
+        // Only the address is formatted, the pointer is never read through.
+        static constexpr bool formats_address = true;
+
+        static void produce(format_sink& sink, const T* value, const codeunit_sequence_view& specification)
         {
-            return details::format_integer(reinterpret_cast<i64>(value), "#016x"_cuqv);
+            details::format_integer(sink, reinterpret_cast<i64>(value), "#016x"_cuqv);
+        }
+
+        static u64 measure(const T* value, const codeunit_sequence_view& specification)
+        {
+            return details::measure_integer(reinterpret_cast<i64>(value), "#016x"_cuqv);
         }
     };
 
     // code-region-end: formatter specializations for built-in types
 }
+
+#ifndef OPEN_STRING_FORMAT_MOLD
+/**
+ * Parse a format mold literal at compile time, an invalid format mold fails to compile.
+ * Example: ostr::format(OPEN_STRING_FORMAT_MOLD("{} is {:x}"), name, 255);
+ */
+#define OPEN_STRING_FORMAT_MOLD(mold_literal) \
+    ([]() noexcept \
+    { \
+        struct format_mold_literal_holder \
+        { \
+            [[nodiscard]] static constexpr ostr::codeunit_sequence_view value() noexcept \
+            { \
+                return { mold_literal, sizeof(mold_literal) - 1 }; \
+            } \
+        }; \
+        return ostr::compiled_format_mold<format_mold_literal_holder>{ }; \
+    }())
+#endif
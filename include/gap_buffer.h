@@ -0,0 +1,141 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include <array>
+
+#include "text.h"
+
+namespace ostr
+{
+	/**
+	 * \brief Editable text for interactive input, which keeps a gap of free code units where edits happen.
+	 * Typing and erasing at the cursor take O(1), and moving the cursor takes O(distance),
+	 * instead of moving the whole text on every keystroke.
+	 * The gap follows the cursor lazily on the next edit, so reading never moves code units,
+	 * except view(), which closes the gap once until the next edit elsewhere.
+	 * Like text, all the indices and sizes are counted in codepoints.
+	 */
+	class OPEN_STRING_API gap_buffer
+	{
+	public:
+		static constexpr u64 CAPACITY_MINIMUM = 64;
+
+		// code-region-start: constructors
+
+		gap_buffer() noexcept;
+		gap_buffer(const gap_buffer&) noexcept;
+		gap_buffer(gap_buffer&&) noexcept;
+		gap_buffer& operator=(const gap_buffer&) noexcept;
+		gap_buffer& operator=(gap_buffer&&) noexcept;
+		~gap_buffer() noexcept;
+
+		gap_buffer(const char* str) noexcept;
+		gap_buffer(const text_view& view) noexcept;
+
+		// code-region-end: constructors
+
+		/// @return count of codepoints
+		[[nodiscard]] u64 size() const noexcept;
+		/// @return count of code units
+		[[nodiscard]] u64 raw_size() const noexcept;
+		[[nodiscard]] bool is_empty() const noexcept;
+		/// @return count of code units that can be held without reallocation
+		[[nodiscard]] u64 get_capacity() const noexcept;
+
+		/// @return index of the codepoint after the cursor
+		[[nodiscard]] u64 cursor() const noexcept;
+
+		/**
+		 * \brief Move the cursor before the codepoint at index, or to the end if index is out of range.
+		 */
+		gap_buffer& set_cursor(u64 index) noexcept;
+
+		/**
+		 * \brief Move the cursor by delta codepoints, which is clamped to the text.
+		 */
+		gap_buffer& move_cursor(i64 delta) noexcept;
+
+		/**
+		 * \brief Insert at the cursor, and the cursor is moved after the inserted codepoints.
+		 */
+		gap_buffer& insert(const text_view& view) noexcept;
+		gap_buffer& insert(const codepoint& cp) noexcept;
+
+		/**
+		 * \brief Erase count codepoints before the cursor, like backspace.
+		 */
+		gap_buffer& erase_before(u64 count = 1) noexcept;
+
+		/**
+		 * \brief Erase count codepoints after the cursor, like delete.
+		 */
+		gap_buffer& erase_after(u64 count = 1) noexcept;
+
+		void empty() noexcept;
+
+		[[nodiscard]] codepoint read_at(u64 index) const noexcept;
+		[[nodiscard]] codepoint operator[](u64 index) const noexcept;
+
+		[[nodiscard]] bool operator==(const text_view& rhs) const noexcept;
+		[[nodiscard]] bool operator!=(const text_view& rhs) const noexcept;
+		[[nodiscard]] bool starts_with(const text_view& prefix) const noexcept;
+		[[nodiscard]] bool ends_with(const text_view& suffix) const noexcept;
+
+		/// @return whether code units are contiguous, so that view() is free
+		[[nodiscard]] bool is_contiguous() const noexcept;
+
+		/**
+		 * @return text before the gap and text after the gap, without moving code units
+		 */
+		[[nodiscard]] std::array<text_view, 2> segments() const noexcept;
+
+		/**
+		 * \brief View the whole text, which provides all the reading methods of text.
+		 * The gap is moved to the end if the text is not contiguous,
+		 * and the view is invalidated by any edit.
+		 */
+		[[nodiscard]] text_view view() noexcept;
+
+		[[nodiscard]] text to_text() const noexcept;
+
+	private:
+		// Move the gap to the code unit at offset in the text.
+		void move_gap(u64 offset) noexcept;
+
+		// Make the gap hold size code units at least.
+		void grow_gap(u64 size) noexcept;
+
+		// Offset of the code unit starting the codepoint at index.
+		[[nodiscard]] u64 get_offset(u64 index) const noexcept;
+
+		[[nodiscard]] u64 get_gap_size() const noexcept;
+
+		// Code unit at offset in the text, skipping the gap.
+		[[nodiscard]] const char* get_codeunit(u64 offset) const noexcept;
+
+		char* data_ = nullptr;
+		u64 capacity_ = 0;
+		u64 gap_begin_ = 0;
+		u64 gap_end_ = 0;
+		u64 size_ = 0;
+		// Positions of the cursor in codepoints and in code units.
+		u64 cursor_ = 0;
+		u64 cursor_offset_ = 0;
+	};
+
+	template<>
+	struct argument_formatter<gap_buffer>
+	{
+		static void produce(format_sink& sink, const gap_buffer& value, const codeunit_sequence_view& specification)
+		{
+			for(const text_view& segment : value.segments())
+				sink.append(segment.raw());
+		}
+
+		static u64 measure(const gap_buffer& value, const codeunit_sequence_view& specification)
+		{
+			return value.raw_size();
+		}
+	};
+}
@@ -0,0 +1,129 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include <cstdio>
+#include <iterator>
+
+#include "codeunit_sequence.h"
+
+namespace ostr
+{
+	enum class line_reader_status : u8
+	{
+		reading,
+		// Every line has been read.
+		end_of_file,
+		// Reading from the source failed, lines before the failure have been read.
+		read_failed,
+	};
+
+	/**
+	 * \brief Reads lines from a file descriptor or a stream through a single reusable buffer.
+	 * Lines are views into the buffer without the line feed, or the carriage return before it,
+	 * so a line is only valid until the next line is read.
+	 * The buffer grows only when a single line does not fit in it.
+	 * The file descriptor or the stream is not owned, it is left open after reading.
+	 */
+	class OPEN_STRING_API line_reader
+	{
+	public:
+
+		static constexpr u64 BUFFER_SIZE_DEFAULT = 64 * 1024;
+
+		// code-region-start: constructors
+
+		/**
+		 * @param descriptor file descriptor opened for reading
+		 * @param buffer_size size of the buffer for the initial allocation
+		 */
+		explicit line_reader(int descriptor, u64 buffer_size = BUFFER_SIZE_DEFAULT) noexcept;
+		/**
+		 * @param stream stream opened for reading in binary mode
+		 * @param buffer_size size of the buffer for the initial allocation
+		 */
+		explicit line_reader(std::FILE* stream, u64 buffer_size = BUFFER_SIZE_DEFAULT) noexcept;
+		line_reader(const line_reader&) = delete;
+		line_reader(line_reader&&) noexcept = default;
+		line_reader& operator=(const line_reader&) = delete;
+		line_reader& operator=(line_reader&&) noexcept = default;
+		~line_reader() noexcept = default;
+
+		// code-region-end: constructors
+
+		// code-region-start: iterators
+
+		struct OPEN_STRING_API line_iterator
+		{
+			using iterator_category = std::input_iterator_tag;
+			using value_type = codeunit_sequence_view;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const codeunit_sequence_view*;
+			using reference = const codeunit_sequence_view&;
+
+			line_iterator() noexcept = default;
+			explicit line_iterator(line_reader* reader) noexcept;
+
+			[[nodiscard]] const codeunit_sequence_view& operator*() const noexcept;
+			line_iterator& operator++() noexcept;
+
+			[[nodiscard]] bool operator==(const line_iterator& rhs) const noexcept;
+			[[nodiscard]] bool operator!=(const line_iterator& rhs) const noexcept;
+
+		private:
+			line_reader* reader_ = nullptr;
+			codeunit_sequence_view line_;
+		};
+
+		struct line_range
+		{
+			[[nodiscard]] line_iterator begin() const noexcept
+			{
+				return line_iterator{ this->reader };
+			}
+
+			[[nodiscard]] line_iterator end() const noexcept
+			{
+				return { };
+			}
+
+			line_reader* reader = nullptr;
+		};
+
+		/**
+		 * Lines are read while iterating, so the range can only be iterated once.
+		 * @return range of the lines left
+		 */
+		[[nodiscard]] line_range lines() noexcept;
+
+		// code-region-end: iterators
+
+		/**
+		 * \brief Read the next line.
+		 * The last line is read even without a line feed at the end.
+		 * @param line view of the line, valid until the next line is read
+		 * @return false if there is no line left
+		 */
+		bool next(codeunit_sequence_view& line) noexcept;
+
+		[[nodiscard]] line_reader_status status() const noexcept;
+		/// @return count of lines read
+		[[nodiscard]] u64 get_line_count() const noexcept;
+
+	private:
+		/// @return false if nothing more can be read
+		bool refill() noexcept;
+		[[nodiscard]] i64 read(char* destination, u64 size) noexcept;
+
+		int descriptor_ = -1;
+		std::FILE* stream_ = nullptr;
+		codeunit_sequence buffer_;
+		// Code units [begin_, end_) of the buffer are read but not consumed,
+		// and code units [begin_, scanned_) are known to contain no line feed.
+		u64 begin_ = 0;
+		u64 scanned_ = 0;
+		u64 end_ = 0;
+		u64 line_count_ = 0;
+		line_reader_status status_ = line_reader_status::reading;
+	};
+}
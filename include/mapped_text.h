@@ -0,0 +1,103 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include "text.h"
+
+namespace ostr
+{
+	enum class mapped_text_status : u8
+	{
+		succeeded,
+		// Nothing is mapped.
+		closed,
+		// The file does not exist, or it is not readable.
+		open_failed,
+		map_failed,
+		// The file is mapped, but it is not well-formed utf-8.
+		invalid_utf8,
+	};
+
+	enum class mapped_access_hint : u8
+	{
+		normal,
+		// Pages are read ahead aggressively and dropped soon after being read.
+		sequential,
+		// Pages are not read ahead.
+		random,
+	};
+
+	struct mapped_text_options
+	{
+		mapped_access_hint access = mapped_access_hint::normal;
+		// Start reading the whole file in the background right after mapping.
+		bool will_need = false;
+		// Ask for huge pages, which is ignored where file mappings do not support them.
+		bool huge_pages = false;
+		// Check the whole file is well-formed utf-8, which reads every page once.
+		bool validate_utf8 = false;
+		// Skip the utf-8 byte order mark at the beginning.
+		bool strip_bom = false;
+	};
+
+	/**
+	 * \brief File mapped read-only into memory, exposed as a view without copying.
+	 * Pages are loaded by the system when they are touched, so opening is O(1) regardless of the size,
+	 * and all the algorithms of codeunit_sequence_view and text_view work on it directly.
+	 * The view is invalidated when the mapped_text is closed or destroyed.
+	 */
+	class OPEN_STRING_API mapped_text
+	{
+	public:
+
+		// code-region-start: constructors
+
+		mapped_text() noexcept;
+		/**
+		 * \brief Map a file, check status() for the result.
+		 * @param path path of the file encoded in utf-8
+		 */
+		explicit mapped_text(const char* path, const mapped_text_options& options = { }) noexcept;
+		mapped_text(const mapped_text&) = delete;
+		mapped_text(mapped_text&&) noexcept;
+		mapped_text& operator=(const mapped_text&) = delete;
+		mapped_text& operator=(mapped_text&&) noexcept;
+		~mapped_text() noexcept;
+
+		// code-region-end: constructors
+
+		/**
+		 * \brief Map a file, the file mapped before is closed.
+		 * @param path path of the file encoded in utf-8
+		 */
+		mapped_text_status open(const char* path, const mapped_text_options& options = { }) noexcept;
+
+		void close() noexcept;
+
+		[[nodiscard]] mapped_text_status status() const noexcept;
+		[[nodiscard]] bool is_open() const noexcept;
+
+		/// @return offset of the first ill-formed code unit if status is invalid_utf8
+		[[nodiscard]] u64 get_invalid_offset() const noexcept;
+
+		/// @return count of code units, excluding the byte order mark if it is stripped
+		[[nodiscard]] u64 size() const noexcept;
+		[[nodiscard]] bool is_empty() const noexcept;
+		[[nodiscard]] const char* data() const noexcept;
+
+		[[nodiscard]] codeunit_sequence_view raw() const noexcept;
+		[[nodiscard]] text_view view() const noexcept;
+
+		[[nodiscard]] operator codeunit_sequence_view() const noexcept;
+		[[nodiscard]] explicit operator text_view() const noexcept;
+
+	private:
+		// Files and mapping objects are closed right after mapping, the mapping keeps them alive.
+		void* mapping_ = nullptr;
+		u64 mapping_size_ = 0;
+		// Offset of the view in the mapping, after the byte order mark stripped.
+		u64 offset_ = 0;
+		u64 invalid_offset_ = 0;
+		mapped_text_status status_ = mapped_text_status::closed;
+	};
+}
@@ -0,0 +1,103 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include "text.h"
+
+namespace ostr
+{
+	/**
+	 * \brief Normalization forms of UAX #15, under which canonically equivalent texts, e.g. "é" precomposed and "e" with a combining acute accent, are equal.
+	 * Compatibility forms also fold compatibility variants, e.g. "ﬁ" to "fi" and full width "Ａ" to "A".
+	 */
+	enum class normalization_form : u8
+	{
+		// Canonical decomposition followed by canonical composition, the form most text already is in.
+		nfc,
+		// Canonical decomposition.
+		nfd,
+		// Compatibility decomposition followed by canonical composition.
+		nfkc,
+		// Compatibility decomposition.
+		nfkd,
+	};
+
+	enum class normalization_check : u8
+	{
+		// The text is in the normalization form.
+		yes,
+		// The text is not in the normalization form.
+		no,
+		// The text has codepoints which may compose with the ones before them, it is only known by normalizing it.
+		maybe,
+	};
+
+	/**
+	 * \brief Quick check of UAX #15, which resolves most texts in one pass without allocating.
+	 * Ill-formed code units are kept as they are by normalization, so they are taken as normalized.
+	 * @param source utf-8 text to check
+	 * @param form normalization form to check against
+	 * @return yes or no when the text is known to be in the normalization form or not, maybe otherwise
+	 */
+	OPEN_STRING_API [[nodiscard]] normalization_check quick_check_normalization(const codeunit_sequence_view& source, normalization_form form) noexcept;
+
+	/**
+	 * \brief Whether text is in a normalization form, which is decided by the quick check without allocating
+	 * unless it returns maybe, when the text is normalized to be compared with itself.
+	 */
+	OPEN_STRING_API [[nodiscard]] bool is_normalized(const text_view& source, normalization_form form) noexcept;
+
+	/**
+	 * \brief Append the normalized source to destination.
+	 * Parts of source passing the quick check are copied as they are, only the segments around codepoints failing it are normalized.
+	 * Ill-formed code units are copied as they are.
+	 * @param destination sequence to append to
+	 * @param source utf-8 text to normalize
+	 * @param form normalization form to apply
+	 */
+	OPEN_STRING_API void normalize_to(codeunit_sequence& destination, const codeunit_sequence_view& source, normalization_form form) noexcept;
+
+	OPEN_STRING_API [[nodiscard]] text normalize(const text_view& source, normalization_form form) noexcept;
+
+	/**
+	 * \brief Normalizes a document coming in chunks, e.g. read from a file or a socket, keeping only the tail of the chunks so far
+	 * which the next chunk may change, from the last codepoint nothing before can compose with or be reordered after.
+	 * Chunks may be split anywhere, even inside a codepoint, the text normalized is the same as normalizing the whole document at once.
+	 */
+	class OPEN_STRING_API normalizer
+	{
+	public:
+
+		// code-region-start: constructors
+
+		explicit normalizer(normalization_form form) noexcept;
+		normalizer(const normalizer&) noexcept = default;
+		normalizer(normalizer&&) noexcept = default;
+		normalizer& operator=(const normalizer&) noexcept = default;
+		normalizer& operator=(normalizer&&) noexcept = default;
+		~normalizer() noexcept = default;
+
+		// code-region-end: constructors
+
+		/**
+		 * \brief Normalize the next chunk of the document.
+		 * @param destination sequence to append the text normalized so far to
+		 * @param chunk next utf-8 code units of the document
+		 */
+		void normalize_to(codeunit_sequence& destination, const codeunit_sequence_view& chunk) noexcept;
+
+		/**
+		 * \brief Normalize the tail left after the last chunk of the document, then another document can be normalized.
+		 * @param destination sequence to append the rest of the normalized text to
+		 */
+		void finish(codeunit_sequence& destination) noexcept;
+
+		[[nodiscard]] normalization_form get_form() const noexcept;
+		/// @return count of code units kept for the next chunk
+		[[nodiscard]] u64 get_pending_size() const noexcept;
+
+	private:
+		normalization_form form_;
+		codeunit_sequence pending_;
+	};
+}
@@ -0,0 +1,154 @@
+
+#pragma once
+
+#include <limits>
+#include <type_traits>
+#include "common/platforms.h"
+#include "common/definitions.h"
+#include "codeunit_sequence_view.h"
+
+namespace ostr
+{
+    enum class parse_status : u8
+    {
+        succeeded,
+        // No number at the beginning of the view.
+        invalid,
+        // The number is out of range of the type.
+        overflow
+    };
+
+    template<class T>
+    struct parse_result
+    {
+        T value{ };
+        // Count of code units of the number, which are consumed even if the number overflows.
+        u64 consumed = 0;
+        parse_status status = parse_status::invalid;
+
+        [[nodiscard]] constexpr bool succeeded() const noexcept
+        {
+            return this->status == parse_status::succeeded;
+        }
+    };
+
+    struct parse_delimited_result
+    {
+        // Count of numbers parsed.
+        u64 count = 0;
+        // Count of code units consumed, including delimiters after the numbers parsed.
+        u64 consumed = 0;
+        // Status of the last number parsed, parsing stops at the first failure.
+        parse_status status = parse_status::succeeded;
+    };
+
+    namespace details
+    {
+        /**
+         * \brief Parse digits of an unsigned integer, 8 decimal digits are parsed at once if possible.
+         * \param view code units starting with digits
+         * \param base base of digits, from 2 to 36
+         * \return the value, which overflows if it is larger than u64
+         */
+        [[nodiscard]] OPEN_STRING_API parse_result<u64> parse_magnitude(const codeunit_sequence_view& view, u32 base) noexcept;
+
+        [[nodiscard]] OPEN_STRING_API parse_result<f32> parse_f32(const codeunit_sequence_view& view) noexcept;
+        [[nodiscard]] OPEN_STRING_API parse_result<f64> parse_f64(const codeunit_sequence_view& view) noexcept;
+    }
+
+    /**
+     * \brief Parse an integer at the beginning of a view, like "-42" or "ff" in base 16.
+     * A sign of '+' is accepted, and a sign of '-' is accepted for signed types only.
+     * No white spaces or prefixes like "0x" are skipped.
+     * \tparam T integer type to parse, of any width
+     * \param view code units to parse
+     * \param base base of digits, from 2 to 36, letters are accepted in both cases
+     * \return the value, with status overflow if it is out of range of T
+     */
+    template<class T>
+    [[nodiscard]] parse_result<T> parse_integer(const codeunit_sequence_view& view, const u32 base = 10) noexcept
+    {
+        static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "Only integers are parsable by parse_integer!");
+        OPEN_STRING_CHECK(base >= 2 && base <= 36, "Invalid base [{}]!", base);
+        u64 sign_size = 0;
+        bool negative = false;
+        if(!view.is_empty())
+        {
+            const char sign = view.read_at(0);
+            if(sign == '+' || (std::is_signed_v<T> && sign == '-'))
+            {
+                sign_size = 1;
+                negative = sign == '-';
+            }
+        }
+        const parse_result<u64> magnitude = details::parse_magnitude(view.subview(sign_size), base);
+        parse_result<T> result;
+        if(magnitude.status == parse_status::invalid)
+            return result;
+        result.consumed = sign_size + magnitude.consumed;
+        const u64 limit = negative ?
+            static_cast<u64>(std::numeric_limits<T>::max()) + 1 :
+            static_cast<u64>(std::numeric_limits<T>::max());
+        if(magnitude.status == parse_status::overflow || magnitude.value > limit)
+        {
+            result.status = parse_status::overflow;
+            return result;
+        }
+        result.value = static_cast<T>(negative ? 0 - magnitude.value : magnitude.value);
+        result.status = parse_status::succeeded;
+        return result;
+    }
+
+    /**
+     * \brief Parse a float at the beginning of a view, like "-1.5e3", "inf" or "nan", correctly rounded.
+     * A sign of '+' is accepted, and no white spaces are skipped.
+     * \tparam T f32 or f64
+     * \param view code units to parse
+     * \return the value, with status overflow if it is too large for T, numbers too small for T are rounded to a denormal or zero
+     */
+    template<class T>
+    [[nodiscard]] parse_result<T> parse_float(const codeunit_sequence_view& view) noexcept
+    {
+        static_assert(std::is_same_v<T, f32> || std::is_same_v<T, f64>, "Only f32 and f64 are parsable by parse_float!");
+        if constexpr (std::is_same_v<T, f32>)
+            return details::parse_f32(view);
+        else
+            return details::parse_f64(view);
+    }
+
+    /**
+     * \brief Parse numbers separated by a delimiter, like a row of a csv file, in a single call.
+     * Every number must be followed by the delimiter or the end of view.
+     * \param view code units to parse, like "1,2,3"
+     * \param delimiter code unit between numbers, like ','
+     * \param out array to receive the numbers
+     * \param capacity count of numbers out is able to receive
+     * \return count of numbers parsed, and status of the first failure if any
+     */
+    template<class T>
+    [[nodiscard]] parse_delimited_result parse_delimited(const codeunit_sequence_view& view, const char delimiter, T* out, const u64 capacity) noexcept
+    {
+        parse_delimited_result result;
+        const u64 size = view.size();
+        while(result.count < capacity && result.consumed < size)
+        {
+            const codeunit_sequence_view remaining = view.subview(result.consumed);
+            parse_result<T> number;
+            if constexpr (std::is_floating_point_v<T>)
+                number = parse_float<T>(remaining);
+            else
+                number = parse_integer<T>(remaining);
+            if(number.succeeded() && number.consumed < remaining.size() && remaining.read_at(number.consumed) != delimiter)
+                number.status = parse_status::invalid;
+            if(!number.succeeded())
+            {
+                result.status = number.status;
+                return result;
+            }
+            out[result.count] = number.value;
+            ++result.count;
+            result.consumed = minimum(result.consumed + number.consumed + 1, size);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,187 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include <array>
+#include <iterator>
+
+#include "text.h"
+
+namespace ostr
+{
+	namespace details
+	{
+		// Code units kept by a leaf, a leaf never ends in the middle of a codepoint.
+		static constexpr u64 ROPE_LEAF_SIZE_MAXIMUM = 1024;
+		// Leaves smaller than it are merged with neighbours when ropes are concatenated.
+		static constexpr u64 ROPE_LEAF_SIZE_MINIMUM = ROPE_LEAF_SIZE_MAXIMUM / 4;
+		static constexpr u64 ROPE_BRANCH_COUNT_MAXIMUM = 8;
+		static constexpr u64 ROPE_BRANCH_COUNT_MINIMUM = ROPE_BRANCH_COUNT_MAXIMUM / 2;
+		// Branches hold 4 children at least, so it covers leaves far more than memory can hold.
+		static constexpr u64 ROPE_HEIGHT_MAXIMUM = 24;
+
+		struct rope_node
+		{
+			// Count of code units in the subtree.
+			u64 raw_size = 0;
+			// Count of codepoints in the subtree.
+			u64 size = 0;
+			// Leaves are of height 0, and all the leaves are of the same depth.
+			u64 height = 0;
+		};
+
+		struct rope_leaf : rope_node
+		{
+			std::array<char, ROPE_LEAF_SIZE_MAXIMUM> data;
+		};
+
+		struct rope_branch : rope_node
+		{
+			u64 count = 0;
+			std::array<rope_node*, ROPE_BRANCH_COUNT_MAXIMUM> children{ };
+		};
+	}
+
+	/**
+	 * \brief Text stored in a balanced B-tree of UTF-8 chunks, for editing in the middle of huge text.
+	 * Counts of code units and codepoints are cached in every node, so insert, erase, split,
+	 * concatenation and codepoint indexing take O(log n), instead of rebuilding the whole buffer.
+	 * Like text, all the indices and sizes are counted in codepoints.
+	 */
+	class OPEN_STRING_API rope
+	{
+	public:
+
+		// code-region-start: constructors
+
+		rope() noexcept;
+		rope(const rope&) noexcept;
+		rope(rope&&) noexcept;
+		rope& operator=(const rope&) noexcept;
+		rope& operator=(rope&&) noexcept;
+		~rope() noexcept;
+
+		rope(const char* str) noexcept;
+		rope(const text_view& view) noexcept;
+		rope(const text& t) noexcept;
+
+		// code-region-end: constructors
+
+		// code-region-start: iterators
+
+		/**
+		 * \brief Iterator of chunks in order, each chunk is a text_view of whole codepoints.
+		 */
+		struct OPEN_STRING_API chunk_iterator
+		{
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = text_view;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const text_view*;
+			using reference = text_view;
+
+			chunk_iterator() noexcept = default;
+			explicit chunk_iterator(const details::rope_node* root) noexcept;
+
+			[[nodiscard]] text_view operator*() const noexcept;
+			chunk_iterator& operator++() noexcept;
+			chunk_iterator operator++(int) noexcept;
+
+			[[nodiscard]] bool operator==(const chunk_iterator& rhs) const noexcept;
+			[[nodiscard]] bool operator!=(const chunk_iterator& rhs) const noexcept;
+
+		private:
+			void descend(const details::rope_node* node) noexcept;
+
+			std::array<const details::rope_branch*, details::ROPE_HEIGHT_MAXIMUM> branches_{ };
+			std::array<u64, details::ROPE_HEIGHT_MAXIMUM> indices_{ };
+			u64 depth_ = 0;
+			const details::rope_leaf* leaf_ = nullptr;
+		};
+
+		struct chunk_range
+		{
+			[[nodiscard]] chunk_iterator begin() const noexcept
+			{
+				return chunk_iterator{ this->root };
+			}
+
+			[[nodiscard]] chunk_iterator end() const noexcept
+			{
+				return { };
+			}
+
+			const details::rope_node* root = nullptr;
+		};
+
+		/**
+		 * Chunks are invalidated by any modification of the rope.
+		 * @return range of chunks, which are text_views together forming the whole text
+		 */
+		[[nodiscard]] chunk_range chunks() const noexcept;
+
+		// code-region-end: iterators
+
+		/// @return count of codepoints
+		[[nodiscard]] u64 size() const noexcept;
+		/// @return count of code units
+		[[nodiscard]] u64 raw_size() const noexcept;
+		[[nodiscard]] bool is_empty() const noexcept;
+
+		[[nodiscard]] bool operator==(const text_view& rhs) const noexcept;
+		[[nodiscard]] bool operator==(const rope& rhs) const noexcept;
+		[[nodiscard]] bool operator!=(const text_view& rhs) const noexcept;
+		[[nodiscard]] bool operator!=(const rope& rhs) const noexcept;
+
+		[[nodiscard]] codepoint read_at(u64 index) const noexcept;
+		[[nodiscard]] codepoint operator[](u64 index) const noexcept;
+
+		/**
+		 * \brief Insert before the codepoint at index, or at the end if index is out of range.
+		 */
+		rope& insert(u64 index, const text_view& view) noexcept;
+
+		/**
+		 * \brief Erase size codepoints from index.
+		 */
+		rope& erase(u64 index, u64 size = SIZE_MAX) noexcept;
+
+		rope& append(const text_view& view) noexcept;
+
+		/**
+		 * \brief Concatenate other to the end, nodes of other are moved without copy.
+		 */
+		rope& append(rope&& other) noexcept;
+
+		rope& operator+=(const text_view& view) noexcept;
+		rope& operator+=(rope&& other) noexcept;
+
+		/**
+		 * \brief Split the rope at index, the rope keeps the codepoints before index.
+		 * @return the codepoints from index
+		 */
+		[[nodiscard]] rope split(u64 index) noexcept;
+
+		void empty() noexcept;
+
+		[[nodiscard]] text to_text() const noexcept;
+
+	private:
+		details::rope_node* root_ = nullptr;
+	};
+
+	template<>
+	struct argument_formatter<rope>
+	{
+		static void produce(format_sink& sink, const rope& value, const codeunit_sequence_view& specification)
+		{
+			for(const text_view chunk : value.chunks())
+				sink.append(chunk.raw());
+		}
+
+		static u64 measure(const rope& value, const codeunit_sequence_view& specification)
+		{
+			return value.raw_size();
+		}
+	};
+}
@@ -0,0 +1,152 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include <vector>
+
+#include "codeunit_sequence.h"
+#include "format.h"
+
+namespace ostr
+{
+	/**
+	 * \brief Builder of huge outputs, which appends into chunks growing geometrically
+	 * and never moves code units appended before.
+	 * Chunks are concatenated once by finish(), handed back by finish_chunks(),
+	 * or written to a file without concatenation by write_to().
+	 */
+	class OPEN_STRING_API string_builder
+	{
+	public:
+		static constexpr u64 CHUNK_CAPACITY_MINIMUM = 4096;
+		static constexpr u64 CHUNK_CAPACITY_MAXIMUM = 1 << 26;
+
+		// code-region-start: constructors
+
+		/**
+		 * @param size count of code units expected, which is reserved in the first chunk
+		 */
+		explicit string_builder(u64 size = 0) noexcept;
+		string_builder(const string_builder&) = delete;
+		string_builder(string_builder&&) noexcept;
+		string_builder& operator=(const string_builder&) = delete;
+		string_builder& operator=(string_builder&&) noexcept;
+		~string_builder() noexcept;
+
+		// code-region-end: constructors
+
+		/// @return count of code units appended
+		[[nodiscard]] u64 size() const noexcept;
+		[[nodiscard]] bool is_empty() const noexcept;
+		[[nodiscard]] u64 chunk_count() const noexcept;
+
+		/**
+		 * Make sure the next size code units are appended without allocation,
+		 * by starting a chunk large enough if the current one is not.
+		 */
+		string_builder& reserve(u64 size) noexcept;
+
+		string_builder& append(const codeunit_sequence_view& view) noexcept
+		{
+			const u64 view_size = view.size();
+			if(view_size <= static_cast<u64>(this->chunk_end_ - this->cursor_))
+			{
+				this->cursor_ = details::copy_codeunits(this->cursor_, view);
+				return *this;
+			}
+			return this->append_chunks(view);
+		}
+
+		string_builder& append(const codepoint& cp) noexcept
+		{
+			return this->append(codeunit_sequence_view{ cp });
+		}
+
+		string_builder& append(const char* str) noexcept
+		{
+			return this->append(codeunit_sequence_view{ str });
+		}
+
+		string_builder& append(char codeunit, u64 count = 1) noexcept;
+
+		string_builder& operator+=(const codeunit_sequence_view& view) noexcept
+		{
+			return this->append(view);
+		}
+
+		string_builder& operator+=(const codepoint& cp) noexcept
+		{
+			return this->append(cp);
+		}
+
+		string_builder& operator+=(const char* str) noexcept
+		{
+			return this->append(str);
+		}
+
+		string_builder& operator+=(const char codeunit) noexcept
+		{
+			return this->append(codeunit);
+		}
+
+		/**
+		 * \brief Format and append the result, without a temporary sequence.
+		 */
+		template<class Format, class...Args>
+		string_builder& append_formatted(const Format& format_mold, const Args&...args)
+		{
+			format_sink sink{ this, [](void* destination, const char* data, const u64 size)
+			{
+				static_cast<string_builder*>(destination)->append(codeunit_sequence_view{ data, size });
+			} };
+			format_to(sink, format_mold, args...);
+			return *this;
+		}
+
+		/**
+		 * Empty the builder, chunks are kept for reuse.
+		 * Together with write_to, it streams outputs larger than memory.
+		 */
+		void empty() noexcept;
+
+		/**
+		 * \brief Write all the code units to a file descriptor, chunk by chunk with writev where available.
+		 * \param file_descriptor file descriptor opened for writing
+		 * \return false if writing fails
+		 */
+		[[nodiscard]] bool write_to(int file_descriptor) const noexcept;
+
+		/**
+		 * Concatenate all the chunks into one sequence, the only chunk is moved without copy.
+		 * The builder is empty afterwards.
+		 * A sequence holds 2^31 - 1 code units at most, if more are built, an empty sequence is returned
+		 * and the builder is kept as is, hand the chunks back by finish_chunks or write them by write_to instead.
+		 */
+		[[nodiscard]] codeunit_sequence finish() noexcept;
+
+		/**
+		 * Hand back chunks in order without concatenation.
+		 * The builder is empty afterwards.
+		 */
+		[[nodiscard]] std::vector<codeunit_sequence> finish_chunks() noexcept;
+
+	private:
+		// Append into the following chunks, when the view does not fit in the current chunk.
+		string_builder& append_chunks(const codeunit_sequence_view& view) noexcept;
+
+		// Commit the size of the current chunk, then move to the next chunk, which holds size code units at least.
+		void next_chunk(u64 size) noexcept;
+
+		void commit_chunk() noexcept;
+
+		[[nodiscard]] u64 get_chunk_size(u64 index) const noexcept;
+
+		std::vector<codeunit_sequence> chunks_;
+		// Index of the chunk written, chunks after it are empty chunks kept for reuse.
+		u64 current_ = 0;
+		// Sum of sizes of chunks before the current one.
+		u64 committed_size_ = 0;
+		char* cursor_ = nullptr;
+		char* chunk_end_ = nullptr;
+	};
+}
@@ -0,0 +1,287 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "text.h"
+#include "format.h"
+
+namespace ostr
+{
+	/**
+	 * \brief Append-only table of strings, storing all the code units in one contiguous buffer
+	 * and where each string starts in an array of offsets.
+	 * A string costs sizeof(Offset) besides its code units, instead of a sequence and a heap block of its own.
+	 * Bulk operations run over the offsets and the buffer linearly, which compilers vectorize.
+	 * @tparam Offset u32 for tables up to 4 GiB of code units, u64 for larger ones
+	 */
+	template<class Offset>
+	class basic_string_table
+	{
+		static_assert(std::is_same_v<Offset, u32> || std::is_same_v<Offset, u64>, "Offsets of a string table are u32 or u64!");
+
+	public:
+		static constexpr u64 CODEUNIT_SIZE_MAXIMUM = std::numeric_limits<Offset>::max();
+
+		// code-region-start: constructors
+
+		basic_string_table() noexcept
+			: offsets_(1, 0)
+		{ }
+
+		/**
+		 * \brief Build a table of elements of a range, each of which is viewed as a codeunit_sequence_view.
+		 * Elements of multi-pass ranges are measured first, so the table is allocated once.
+		 */
+		template<class Container>
+		[[nodiscard]] static basic_string_table build(const Container& container) noexcept
+		{
+			using std::begin;
+			using std::end;
+			return build(begin(container), end(container));
+		}
+
+		template<class Iterator, class Sentinel>
+		[[nodiscard]] static basic_string_table build(Iterator first, Sentinel last) noexcept
+		{
+			basic_string_table table;
+			if constexpr (!details::is_single_pass_iterator<Iterator>::value)
+			{
+				u64 count = 0;
+				u64 codeunit_size = 0;
+				for(Iterator it = first; it != last; ++it, ++count)
+					codeunit_size += details::view_sequence(*it).size();
+				table.reserve(count, codeunit_size);
+			}
+			for(; first != last; ++first)
+				table.append(details::view_sequence(*first));
+			return table;
+		}
+
+		// code-region-end: constructors
+
+		// code-region-start: iterators
+
+		struct const_iterator
+		{
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = codeunit_sequence_view;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const codeunit_sequence_view*;
+			using reference = codeunit_sequence_view;
+
+			const_iterator() noexcept = default;
+			const_iterator(const basic_string_table* table, const u64 index) noexcept
+				: table_(table)
+				, index_(index)
+			{ }
+
+			[[nodiscard]] codeunit_sequence_view operator*() const noexcept
+			{
+				return this->table_->raw_at(this->index_);
+			}
+
+			const_iterator& operator++() noexcept
+			{
+				++this->index_;
+				return *this;
+			}
+
+			const_iterator operator++(int) noexcept
+			{
+				const_iterator old = *this;
+				++*this;
+				return old;
+			}
+
+			[[nodiscard]] bool operator==(const const_iterator& rhs) const noexcept
+			{
+				return this->index_ == rhs.index_;
+			}
+
+			[[nodiscard]] bool operator!=(const const_iterator& rhs) const noexcept
+			{
+				return !(*this == rhs);
+			}
+
+		private:
+			const basic_string_table* table_ = nullptr;
+			u64 index_ = 0;
+		};
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return { this, 0 };
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return { this, this->size() };
+		}
+
+		// code-region-end: iterators
+
+		/// @return count of strings
+		[[nodiscard]] u64 size() const noexcept
+		{
+			return this->offsets_.size() - 1;
+		}
+
+		[[nodiscard]] bool is_empty() const noexcept
+		{
+			return this->size() == 0;
+		}
+
+		/// @return count of code units of all the strings
+		[[nodiscard]] u64 codeunit_size() const noexcept
+		{
+			return this->codeunits_.size();
+		}
+
+		/// @return bytes allocated by the table
+		[[nodiscard]] u64 memory_size() const noexcept
+		{
+			return this->codeunits_.capacity() + this->offsets_.capacity() * sizeof(Offset);
+		}
+
+		/**
+		 * \brief Reserve memory for strings appended later.
+		 * @param count count of strings
+		 * @param codeunit_size count of code units of all the strings
+		 */
+		void reserve(const u64 count, const u64 codeunit_size) noexcept
+		{
+			this->offsets_.reserve(this->offsets_.size() + count);
+			this->codeunits_.reserve(this->codeunits_.size() + codeunit_size);
+		}
+
+		/**
+		 * @return index of the string appended
+		 */
+		u64 append(const codeunit_sequence_view& view) noexcept
+		{
+			OPEN_STRING_CHECK(this->codeunits_.size() + view.size() <= CODEUNIT_SIZE_MAXIMUM, "String table is limited to [{}] code units! Use a table of u64 offsets instead.", CODEUNIT_SIZE_MAXIMUM);
+			const u64 size = this->codeunits_.size();
+			if(!view.is_empty())
+			{
+				// The view may point into the table itself, which is moved by growing, so the source is located by offset.
+				const char* data = this->codeunits_.data();
+				const bool aliased = !std::less<const char*>{ }(view.data(), data) && std::less<const char*>{ }(view.data(), data + size);
+				const u64 source = aliased ? static_cast<u64>(view.data() - data) : 0;
+				this->codeunits_.resize(size + view.size());
+				std::memcpy(this->codeunits_.data() + size, aliased ? this->codeunits_.data() + source : view.data(), view.size());
+			}
+			this->offsets_.push_back(static_cast<Offset>(this->codeunits_.size()));
+			return this->size() - 1;
+		}
+
+		u64 append(const text_view& view) noexcept
+		{
+			return this->append(view.raw());
+		}
+
+		/**
+		 * Remove all the strings, memory is kept for reuse.
+		 */
+		void empty() noexcept
+		{
+			this->codeunits_.clear();
+			this->offsets_.resize(1);
+		}
+
+		/**
+		 * Views are invalidated by appending.
+		 * @return code units of the string at index
+		 */
+		[[nodiscard]] codeunit_sequence_view raw_at(const u64 index) const noexcept
+		{
+			const Offset first = this->offsets_[index];
+			return { this->codeunits_.data() + first, static_cast<u64>(this->offsets_[index + 1] - first) };
+		}
+
+		[[nodiscard]] text_view view_at(const u64 index) const noexcept
+		{
+			return text_view{ this->raw_at(index) };
+		}
+
+		[[nodiscard]] codeunit_sequence_view operator[](const u64 index) const noexcept
+		{
+			return this->raw_at(index);
+		}
+
+		/// @return count of code units of the string at index, without touching the code units
+		[[nodiscard]] u64 size_at(const u64 index) const noexcept
+		{
+			return static_cast<u64>(this->offsets_[index + 1] - this->offsets_[index]);
+		}
+
+		/**
+		 * \brief Hash every string, the same as hash_sequence_crc64 of each of them.
+		 * @param hashes hashes in order of strings
+		 */
+		void hash_all(std::vector<u64>& hashes) const noexcept
+		{
+			const u64 count = this->size();
+			hashes.resize(count);
+			const char* codeunits = this->codeunits_.data();
+			for(u64 i = 0; i < count; ++i)
+				hashes[i] = hash_sequence_crc64(codeunits + this->offsets_[i], static_cast<u64>(this->offsets_[i + 1] - this->offsets_[i]));
+		}
+
+		/**
+		 * \brief Compare every string with a pattern, code unit by code unit, which is also the order of codepoints.
+		 * @param results negative, zero or positive if the string is less than, equal to or greater than the pattern
+		 */
+		void compare_all(const codeunit_sequence_view& pattern, std::vector<i32>& results) const noexcept
+		{
+			const u64 count = this->size();
+			results.resize(count);
+			const char* codeunits = this->codeunits_.data();
+			for(u64 i = 0; i < count; ++i)
+			{
+				const u64 size = static_cast<u64>(this->offsets_[i + 1] - this->offsets_[i]);
+				const u64 common = minimum(size, pattern.size());
+				const int order = common > 0 ? std::memcmp(codeunits + this->offsets_[i], pattern.data(), common) : 0;
+				results[i] = order != 0 ? order : (size < pattern.size() ? -1 : size > pattern.size() ? 1 : 0);
+			}
+		}
+
+		/**
+		 * \brief Find a string equal to the pattern, comparing code units only of strings of the same size.
+		 * @return index of the first string equal to the pattern since from, or global_constant::INDEX_INVALID
+		 */
+		[[nodiscard]] u64 index_of(const codeunit_sequence_view& pattern, const u64 from = 0) const noexcept
+		{
+			const u64 count = this->size();
+			const u64 pattern_size = pattern.size();
+			const char* codeunits = this->codeunits_.data();
+			for(u64 i = from; i < count; ++i)
+			{
+				const Offset first = this->offsets_[i];
+				if(static_cast<u64>(this->offsets_[i + 1] - first) == pattern_size
+					&& (pattern_size == 0 || std::memcmp(codeunits + first, pattern.data(), pattern_size) == 0))
+					return i;
+			}
+			return global_constant::INDEX_INVALID;
+		}
+
+		[[nodiscard]] bool contains(const codeunit_sequence_view& pattern) const noexcept
+		{
+			return this->index_of(pattern) != global_constant::INDEX_INVALID;
+		}
+
+	private:
+		std::vector<char> codeunits_;
+		// Offsets of strings in code units, with the end of the last string at the back.
+		std::vector<Offset> offsets_;
+	};
+
+	using string_table = basic_string_table<u32>;
+	using large_string_table = basic_string_table<u64>;
+}
@@ -0,0 +1,147 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include <array>
+
+#include "mapped_text.h"
+#include "string_table.h"
+
+namespace ostr
+{
+	enum class string_table_file_status : u8
+	{
+		succeeded,
+		// Nothing is opened.
+		closed,
+		open_failed,
+		map_failed,
+		// The file is not a string table file, or its sections do not match its size.
+		invalid_format,
+		unsupported_version,
+		// The checksum is verified and it does not match the content.
+		checksum_mismatch,
+		// A key or a value to write is not well-formed utf-8.
+		invalid_utf8,
+		// Two entries to write have the same key.
+		duplicate_key,
+		// Entries to write exceed limits of the format, or no perfect hash is found for them.
+		too_large,
+		write_failed,
+	};
+
+	/**
+	 * \brief Header at the beginning of a string table file, all the integers are little-endian.
+	 * Sections follow the header in order, each of which is sized by the header:
+	 *     u32 key_offsets[count + 1]
+	 *     u32 value_offsets[count + 1]
+	 *     u32 displacements[bucket_count]      perfect hash, displacement of each bucket
+	 *     u32 slots[slot_count]                perfect hash, id of the entry in each slot
+	 *     char keys[key_codeunit_size]         well-formed utf-8
+	 *     char values[value_codeunit_size]     well-formed utf-8
+	 */
+	struct string_table_file_header
+	{
+		static constexpr std::array<char, 8> MAGIC{ 'O', 'S', 'T', 'R', 'T', 'A', 'B', '\0' };
+		static constexpr u32 VERSION = 1;
+
+		std::array<char, 8> magic = MAGIC;
+		u32 version = VERSION;
+		// Reserved, which is 0.
+		u32 flags = 0;
+		u64 count = 0;
+		u64 bucket_count = 0;
+		u64 slot_count = 0;
+		// CRC64 of everything after the header.
+		u64 checksum = 0;
+		u64 key_codeunit_size = 0;
+		u64 value_codeunit_size = 0;
+	};
+	static_assert(sizeof(string_table_file_header) == 64, "Header of string table files must be 64 bytes!");
+
+	/**
+	 * \brief Writer of string table files, which validates and indexes entries once,
+	 * so that readers look them up without any parsing.
+	 */
+	class OPEN_STRING_API string_table_file_writer
+	{
+	public:
+		/**
+		 * @return id of the entry, which is the count of entries added before
+		 */
+		u64 add(const codeunit_sequence_view& key, const codeunit_sequence_view& value) noexcept;
+
+		[[nodiscard]] u64 size() const noexcept;
+
+		/**
+		 * \brief Validate entries, build the perfect hash index, then write the file.
+		 * @param path path of the file encoded in utf-8
+		 */
+		[[nodiscard]] string_table_file_status write(const char* path) const noexcept;
+
+	private:
+		string_table keys_;
+		string_table values_;
+	};
+
+	struct string_table_file_options
+	{
+		// Verify the checksum of the whole file, which reads every page once.
+		bool verify_checksum = false;
+	};
+
+	/**
+	 * \brief String table file mapped into memory, looked up by key or id without parsing or allocation.
+	 * Views are invalidated when the file is closed.
+	 */
+	class OPEN_STRING_API string_table_file
+	{
+	public:
+
+		// code-region-start: constructors
+
+		string_table_file() noexcept = default;
+		/**
+		 * \brief Open a file, check status() for the result.
+		 * @param path path of the file encoded in utf-8
+		 */
+		explicit string_table_file(const char* path, const string_table_file_options& options = { }) noexcept;
+
+		// code-region-end: constructors
+
+		string_table_file_status open(const char* path, const string_table_file_options& options = { }) noexcept;
+		void close() noexcept;
+
+		[[nodiscard]] string_table_file_status status() const noexcept;
+		[[nodiscard]] bool is_open() const noexcept;
+
+		/// @return count of entries
+		[[nodiscard]] u64 size() const noexcept;
+
+		/**
+		 * @return id of the entry of the key, or global_constant::INDEX_INVALID
+		 */
+		[[nodiscard]] u64 index_of(const codeunit_sequence_view& key) const noexcept;
+
+		[[nodiscard]] text_view key_at(u64 id) const noexcept;
+		[[nodiscard]] text_view value_at(u64 id) const noexcept;
+
+		/**
+		 * @return value of the key, or fallback if there is no such key
+		 */
+		[[nodiscard]] text_view find(const codeunit_sequence_view& key, const text_view& fallback = { }) const noexcept;
+
+	private:
+		[[nodiscard]] codeunit_sequence_view read_entry(const char* offsets, const char* codeunits, u64 codeunit_size, u64 id) const noexcept;
+
+		mapped_text mapped_;
+		string_table_file_header header_;
+		const char* key_offsets_ = nullptr;
+		const char* value_offsets_ = nullptr;
+		const char* displacements_ = nullptr;
+		const char* slots_ = nullptr;
+		const char* keys_ = nullptr;
+		const char* values_ = nullptr;
+		string_table_file_status status_ = string_table_file_status::closed;
+	};
+}
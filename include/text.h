@@ -7,6 +7,8 @@
 
 namespace ostr
 {
+	enum class normalization_form : u8;
+
 	class OPEN_STRING_API text
 	{
 	public:
@@ -103,6 +105,21 @@ namespace ostr
 		[[nodiscard]] bool operator!=(const text_view& rhs) const noexcept;
 		[[nodiscard]] bool operator!=(const text& rhs) const noexcept;
 		[[nodiscard]] bool operator!=(const char* rhs) const noexcept;
+		[[nodiscard]] bool operator<(const text_view& rhs) const noexcept;
+		[[nodiscard]] bool operator<(const text& rhs) const noexcept;
+		[[nodiscard]] bool operator>(const text_view& rhs) const noexcept;
+		[[nodiscard]] bool operator>(const text& rhs) const noexcept;
+		[[nodiscard]] bool operator<=(const text_view& rhs) const noexcept;
+		[[nodiscard]] bool operator<=(const text& rhs) const noexcept;
+		[[nodiscard]] bool operator>=(const text_view& rhs) const noexcept;
+		[[nodiscard]] bool operator>=(const text& rhs) const noexcept;
+
+		/**
+		 * \brief Three-way comparison in the order of codepoints.
+		 * @return negative if this is ordered before rhs, 0 if they are equal, positive if this is ordered after rhs
+		 */
+		[[nodiscard]] i32 compare(const text_view& rhs) const noexcept;
+		[[nodiscard]] i32 compare(const text& rhs) const noexcept;
 
 		text& append(const text_view& rhs) noexcept;
 		text& append(const text& rhs) noexcept;
@@ -163,6 +180,25 @@ namespace ostr
 		[[nodiscard]] text_view view_trim_end(const text_view& characters = text_view(" \t")) const noexcept;
 		[[nodiscard]] text_view view_trim(const text_view& characters = text_view(" \t")) const noexcept;
 
+		/**
+		 * Full case mappings of the Unicode Character Database, see case_mapping.h.
+		 */
+		[[nodiscard]] text to_lower() const noexcept;
+		[[nodiscard]] text to_upper() const noexcept;
+		[[nodiscard]] text case_fold() const noexcept;
+
+		text& self_to_lower() noexcept;
+		text& self_to_upper() noexcept;
+		text& self_case_fold() noexcept;
+
+		/**
+		 * Unicode normalization forms, see normalization.h.
+		 */
+		[[nodiscard]] text normalize(normalization_form form) const noexcept;
+		[[nodiscard]] bool is_normalized(normalization_form form) const noexcept;
+
+		text& self_normalize(normalization_form form) noexcept;
+
 		[[nodiscard]] const char* c_str() const noexcept;
 
 	private:
@@ -202,18 +238,28 @@ namespace ostr
 	template<> 
 	struct argument_formatter<text_view>
 	{
-		static codeunit_sequence produce(const text_view& value, const codeunit_sequence_view& specification)
+		static void produce(format_sink& sink, const text_view& value, const codeunit_sequence_view& specification)
 		{
-			return codeunit_sequence{ value.raw() };
+			sink.append(value.raw());
+		}
+
+		static u64 measure(const text_view& value, const codeunit_sequence_view& specification)
+		{
+			return value.raw().size();
 		}
 	};
 
 	template<> 
 	struct argument_formatter<text>
 	{
-		static codeunit_sequence produce(const text& value, const codeunit_sequence_view& specification)
+		static void produce(format_sink& sink, const text& value, const codeunit_sequence_view& specification)
+		{
+			sink.append(value.raw().view());
+		}
+
+		static u64 measure(const text& value, const codeunit_sequence_view& specification)
 		{
-			return value.raw();
+			return value.raw().size();
 		}
 	};
 }
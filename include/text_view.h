@@ -3,6 +3,7 @@
 #include "common/definitions.h"
 
 #include "codeunit_sequence_view.h"
+#include "parse.h"
 #include "text.h"
 #include <optional>
 
@@ -218,6 +219,35 @@ namespace ostr
 			return this->view_ != rhs;
 		}
 
+		[[nodiscard]] constexpr bool operator<(const text_view& rhs) const noexcept
+		{
+			return this->view_ < rhs.view_;
+		}
+
+		[[nodiscard]] constexpr bool operator>(const text_view& rhs) const noexcept
+		{
+			return this->view_ > rhs.view_;
+		}
+
+		[[nodiscard]] constexpr bool operator<=(const text_view& rhs) const noexcept
+		{
+			return this->view_ <= rhs.view_;
+		}
+
+		[[nodiscard]] constexpr bool operator>=(const text_view& rhs) const noexcept
+		{
+			return this->view_ >= rhs.view_;
+		}
+
+		/**
+		 * \brief Three-way comparison in the order of codepoints, which is the order of utf-8 code units.
+		 * @return negative if this is ordered before rhs, 0 if they are equal, positive if this is ordered after rhs
+		 */
+		[[nodiscard]] constexpr i32 compare(const text_view& rhs) const noexcept
+		{
+			return this->view_.compare(rhs.view_);
+		}
+
 		[[nodiscard]] constexpr u64 size() const noexcept
 		{
 			return this->get_codepoint_index( this->view_.size() );
@@ -315,6 +345,46 @@ namespace ostr
 			return this->view_.ends_with(suffix.view_);
 		}
 
+		/**
+		 * \brief Case-insensitive variants, which fold ASCII letters only, see codeunit_sequence_view::iequals.
+		 */
+		[[nodiscard]] constexpr bool iequals(const text_view& rhs) const noexcept
+		{
+			return this->view_.iequals(rhs.view_);
+		}
+
+		[[nodiscard]] constexpr i32 icompare(const text_view& rhs) const noexcept
+		{
+			return this->view_.icompare(rhs.view_);
+		}
+
+		[[nodiscard]] constexpr bool istarts_with(const text_view& prefix) const noexcept
+		{
+			return this->view_.istarts_with(prefix.view_);
+		}
+
+		[[nodiscard]] constexpr bool iends_with(const text_view& suffix) const noexcept
+		{
+			return this->view_.iends_with(suffix.view_);
+		}
+
+		[[nodiscard]] constexpr u64 iindex_of(const text_view& pattern, const u64 from = 0, const u64 size = SIZE_MAX) const noexcept
+		{
+			if(pattern.is_empty())
+				return global_constant::INDEX_INVALID;
+			u64 raw_from = from; u64 raw_size = size;
+			this->get_codeunit_range(raw_from, raw_size);
+			const u64 found_raw_index = this->view_.iindex_of(pattern.view_, raw_from, raw_size);
+			if(found_raw_index == global_constant::INDEX_INVALID)
+				return global_constant::INDEX_INVALID;
+			return this->get_codepoint_index(found_raw_index);
+		}
+
+		[[nodiscard]] constexpr u64 ihash() const noexcept
+		{
+			return this->view_.ihash();
+		}
+
 		[[nodiscard]] constexpr text_view remove_prefix(const text_view& prefix) const noexcept
 		{
 			return text_view{ this->view_.remove_prefix(prefix.view_) };
@@ -402,31 +472,29 @@ namespace ostr
 			size = last - from;
 		}
 
-		// todo: a better conversion approach
-		[[nodiscard]] constexpr std::optional<i32> try_as_integer() const
+		/**
+		 * @param base base of digits, from 2 to 36
+		 * @return the integer if the whole text is one in range of T
+		 */
+		template<class T = i32>
+		[[nodiscard]] std::optional<T> try_as_integer(const u32 base = 10) const noexcept
 		{
-			if(this->is_empty())
+			const parse_result<T> result = parse_integer<T>(this->raw(), base);
+			if(!result.succeeded() || result.consumed != this->view_.size())
 				return { };
-			i32 result = 0;
-			i32 signal = 1;
-			codeunit_sequence_view raw_view = this->raw();
-			if(raw_view.starts_with("+"_cuqv))
-			{
-				raw_view = raw_view.subview(1);
-			}
-			if(raw_view.starts_with("-"_cuqv))
-			{
-				raw_view = raw_view.subview(1);
-				signal = -1;
-			}
-			for(const char c : raw_view)
-			{
-				if(c < '0' || c > '9')
-					return { };
-				result *= 10;
-				result += (c - '0');
-			}
-			return result * signal;
+			return result.value;
+		}
+
+		/**
+		 * @return the float if the whole text is one in range of T
+		 */
+		template<class T = f64>
+		[[nodiscard]] std::optional<T> try_as_float() const noexcept
+		{
+			const parse_result<T> result = parse_float<T>(this->raw());
+			if(!result.succeeded() || result.consumed != this->view_.size())
+				return { };
+			return result.value;
 		}
 	
 	private:
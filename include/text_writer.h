@@ -0,0 +1,197 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "text.h"
+#include "format.h"
+
+namespace ostr
+{
+	enum class text_flush_policy : u8
+	{
+		// The buffer is written out when it is full, or flushed explicitly.
+		when_full,
+		// The buffer is written out after each write containing a line feed.
+		on_line_feed,
+		// Every write is written out right away, the buffer only gathers pieces of a single formatting.
+		immediate,
+	};
+
+	/**
+	 * \brief Writer of code units into a file descriptor through a fixed-size buffer.
+	 * Payloads not smaller than the buffer bypass it, and are written together with the buffered code units
+	 * by a single writev where available.
+	 * A writer is used by a single thread, except the optional background thread flushing it periodically.
+	 */
+	class OPEN_STRING_API text_writer
+	{
+	public:
+		static constexpr u64 BUFFER_SIZE_DEFAULT = 64 * 1024;
+
+		// code-region-start: constructors
+
+		/**
+		 * @param descriptor file descriptor opened for writing, which is not closed by the writer
+		 * @param policy when the buffer is written out
+		 * @param buffer_size size of the buffer, which is allocated once
+		 */
+		explicit text_writer(int descriptor, text_flush_policy policy = text_flush_policy::when_full, u64 buffer_size = BUFFER_SIZE_DEFAULT) noexcept;
+		text_writer(const text_writer&) = delete;
+		text_writer(text_writer&&) = delete;
+		text_writer& operator=(const text_writer&) = delete;
+		text_writer& operator=(text_writer&&) = delete;
+		/**
+		 * Stop the background thread and flush.
+		 */
+		~text_writer() noexcept;
+
+		// code-region-end: constructors
+
+		text_writer& write(const codeunit_sequence_view& view) noexcept
+		{
+			const std::unique_lock<std::mutex> lock = this->lock();
+			this->write_codeunits(view);
+			this->apply_policy(view);
+			return *this;
+		}
+
+		text_writer& write(const text_view& view) noexcept
+		{
+			return this->write(view.raw());
+		}
+
+		text_writer& write(const codepoint& cp) noexcept
+		{
+			return this->write(codeunit_sequence_view{ cp });
+		}
+
+		text_writer& write(const char* str) noexcept
+		{
+			return this->write(codeunit_sequence_view{ str });
+		}
+
+		text_writer& write(char codeunit, u64 count = 1) noexcept;
+
+		text_writer& operator<<(const codeunit_sequence_view& view) noexcept
+		{
+			return this->write(view);
+		}
+
+		text_writer& operator<<(const text_view& view) noexcept
+		{
+			return this->write(view);
+		}
+
+		text_writer& operator<<(const codepoint& cp) noexcept
+		{
+			return this->write(cp);
+		}
+
+		text_writer& operator<<(const char* str) noexcept
+		{
+			return this->write(str);
+		}
+
+		text_writer& operator<<(const char codeunit) noexcept
+		{
+			return this->write(codeunit);
+		}
+
+		/**
+		 * \brief Format into the buffer directly, without a temporary sequence.
+		 * The flush policy applies once to the whole result.
+		 */
+		template<class Format, class...Args>
+		text_writer& write_formatted(const Format& format_mold, const Args&...args)
+		{
+			const std::unique_lock<std::mutex> lock = this->lock();
+			struct formatting
+			{
+				text_writer* writer;
+				bool line_fed;
+			} state{ this, false };
+			format_sink sink{ &state, [](void* destination, const char* data, const u64 size)
+			{
+				formatting& current = *static_cast<formatting*>(destination);
+				const codeunit_sequence_view view{ data, size };
+				current.writer->write_codeunits(view);
+				current.line_fed = current.line_fed || view.contains('\n');
+			} };
+			format_to(sink, format_mold, args...);
+			if(this->policy_ == text_flush_policy::immediate || (this->policy_ == text_flush_policy::on_line_feed && state.line_fed))
+				this->flush_buffer();
+			return *this;
+		}
+
+		/**
+		 * \brief Write out the code units in the buffer.
+		 * @return false if writing has failed, now or before
+		 */
+		bool flush() noexcept;
+
+		/**
+		 * \brief Start a thread flushing the writer periodically, so that code units never stay in the buffer too long.
+		 * Writing takes a lock while the thread is running.
+		 * @param interval time between two flushes
+		 */
+		void start_background_flush(std::chrono::milliseconds interval) noexcept;
+		/**
+		 * \brief Stop the thread flushing periodically, without flushing.
+		 */
+		void stop_background_flush() noexcept;
+
+		/// @return whether writing into the file descriptor has failed, code units written after that are dropped
+		[[nodiscard]] bool has_failed() const noexcept;
+		/// @return count of code units in the buffer
+		[[nodiscard]] u64 get_buffered_size() const noexcept;
+
+	private:
+		[[nodiscard]] std::unique_lock<std::mutex> lock() const noexcept
+		{
+			if(this->flush_thread_.joinable())
+				return std::unique_lock<std::mutex>{ this->mutex_ };
+			return { };
+		}
+
+		void write_codeunits(const codeunit_sequence_view& view) noexcept
+		{
+			const u64 size = view.size();
+			if(size <= this->buffer_.size() - this->used_)
+			{
+				details::copy_codeunits(this->buffer_.data() + this->used_, view);
+				this->used_ += size;
+				return;
+			}
+			this->write_through(view);
+		}
+
+		void apply_policy(const codeunit_sequence_view& written) noexcept
+		{
+			if(this->policy_ == text_flush_policy::immediate
+				|| (this->policy_ == text_flush_policy::on_line_feed && written.contains('\n')))
+				this->flush_buffer();
+		}
+
+		// Write the buffer out together with a view not fitting in it.
+		void write_through(const codeunit_sequence_view& view) noexcept;
+		void flush_buffer() noexcept;
+		void run_background_flush() noexcept;
+
+		int descriptor_ = -1;
+		text_flush_policy policy_ = text_flush_policy::when_full;
+		bool failed_ = false;
+		codeunit_sequence buffer_;
+		u64 used_ = 0;
+
+		mutable std::mutex mutex_;
+		std::condition_variable stopping_condition_;
+		bool stopping_ = false;
+		std::chrono::milliseconds flush_interval_{ 0 };
+		std::thread flush_thread_;
+	};
+}
@@ -2,7 +2,9 @@
 #pragma once
 
 #include "common/basic_types.h"
+#include "common/definitions.h"
 #include <array>
+#include <cstring>
 
 namespace ostr
 {
@@ -34,6 +36,7 @@ namespace ostr
 			static constexpr char32_t TRAILING_SURROGATE_MAXIMUM = 0xDFFF;
 			static constexpr char32_t SURROGATE_MASK = 0x03FF;
 			static constexpr char32_t SINGLE_UNIT_MAXIMUM_VALUE = 0xFFFF;
+			static constexpr char32_t SUPPLEMENTARY_PLANE_OFFSET = 0x10000;
 			
 			[[nodiscard]] constexpr bool is_leading_surrogate(const char16_t c) noexcept
 			{
@@ -102,8 +105,11 @@ namespace ostr
 				return 1;
 			if (utf16 <= get_utf8_maximum_codepoint(2))
 				return 2;
-			if (utf16::is_surrogate(utf16))
+			// A surrogate pair encodes one supplementary codepoint, which takes 4 bytes in utf-8.
+			if (utf16::is_leading_surrogate(utf16))
 				return 4;
+			if (utf16::is_trailing_surrogate(utf16))
+				return 0;
 			return 3;
 		}
 
@@ -173,7 +179,7 @@ namespace ostr
 			//         |||||||||| ||||||||||
 			// [110110]9876543210 |||||||||| high surrogate
 			//            [110111]9876543210 low  surrogate
-			return length == 1 ? utf16[0] : ((utf16[0] & utf16::SURROGATE_MASK) << 10) + (utf16[1] & utf16::SURROGATE_MASK);
+			return length == 1 ? utf16[0] : ((utf16[0] & utf16::SURROGATE_MASK) << 10) + (utf16[1] & utf16::SURROGATE_MASK) + utf16::SUPPLEMENTARY_PLANE_OFFSET;
 		}
 		
 		[[nodiscard]] constexpr std::array<char16_t, utf16::SEQUENCE_MAXIMUM_LENGTH> utf32_to_utf16(char32_t const utf32) noexcept
@@ -181,8 +187,8 @@ namespace ostr
 			return utf32 <= utf16::SINGLE_UNIT_MAXIMUM_VALUE ? 
 				std::array<char16_t, utf16::SEQUENCE_MAXIMUM_LENGTH>{ static_cast<char16_t>(utf32) } :
 				std::array<char16_t, utf16::SEQUENCE_MAXIMUM_LENGTH>{
-					static_cast<char16_t>((utf32 >> 10) + utf16::LEADING_SURROGATE_HEADER),
-					static_cast<char16_t>((utf32 & utf16::SURROGATE_MASK) + utf16::TRAILING_SURROGATE_HEADER) };
+					static_cast<char16_t>(((utf32 - utf16::SUPPLEMENTARY_PLANE_OFFSET) >> 10) + utf16::LEADING_SURROGATE_HEADER),
+					static_cast<char16_t>(((utf32 - utf16::SUPPLEMENTARY_PLANE_OFFSET) & utf16::SURROGATE_MASK) + utf16::TRAILING_SURROGATE_HEADER) };
 		}
 
 		[[nodiscard]] constexpr std::array<char16_t, utf16::SEQUENCE_MAXIMUM_LENGTH> utf8_to_utf16(char const* const utf8, const u64 length) noexcept
@@ -194,6 +200,177 @@ namespace ostr
 		{
 			return utf32_to_utf8(utf16_to_utf32(utf16, length));
 		}
+
+		/**
+		 * Overlong sequences, surrogates and codepoints beyond U+10FFFF are ill-formed.
+		 * @param utf8 start of a utf-8 sequence
+		 * @param size count of code units available
+		 * @return length of the well-formed utf-8 sequence at the start, return 0 if it is ill-formed or truncated
+		 */
+		[[nodiscard]] constexpr u64 parse_valid_utf8_length(char const* const utf8, const u64 size) noexcept
+		{
+			if (size == 0)
+				return 0;
+			const u8 c0 = static_cast<u8>(utf8[0]);
+			if (c0 < 0x80)
+				return 1;
+			// Ranges of the second code unit follow table 3-7 of the Unicode standard.
+			u64 length = 0;
+			u8 lower = 0x80;
+			u8 upper = 0xbf;
+			if (c0 < 0xc2)
+				return 0;
+			if (c0 < 0xe0)
+				length = 2;
+			else if (c0 < 0xf0)
+			{
+				length = 3;
+				if (c0 == 0xe0)
+					lower = 0xa0;
+				else if (c0 == 0xed)
+					upper = 0x9f;
+			}
+			else if (c0 < 0xf5)
+			{
+				length = 4;
+				if (c0 == 0xf0)
+					lower = 0x90;
+				else if (c0 == 0xf4)
+					upper = 0x8f;
+			}
+			else
+				return 0;
+			if (size < length)
+				return 0;
+			const u8 c1 = static_cast<u8>(utf8[1]);
+			if (c1 < lower || c1 > upper)
+				return 0;
+			for (u64 i = 2; i < length; ++i)
+				if ((static_cast<u8>(utf8[i]) & 0xc0) != 0x80)
+					return 0;
+			return length;
+		}
+
+		[[nodiscard]] constexpr bool is_utf8_continuation(const char c) noexcept
+		{
+			return (static_cast<u8>(c) & 0xc0) == 0x80;
+		}
+
+		/// @return whether c starts a codepoint, which every code unit but a continuation does
+		[[nodiscard]] constexpr bool is_utf8_codepoint_start(const char c) noexcept
+		{
+			return !is_utf8_continuation(c);
+		}
+
+		/**
+		 * Every code unit which is not a continuation starts a codepoint, even in ill-formed sequences.
+		 * @param utf8 utf-8 code unit sequence
+		 * @param size count of code units
+		 * @return count of codepoints
+		 */
+		[[nodiscard]] constexpr u64 count_utf8_codepoints(char const* const utf8, const u64 size) noexcept
+		{
+			u64 count = 0;
+			for (u64 i = 0; i < size; ++i)
+				count += is_utf8_codepoint_start(utf8[i]);
+			return count;
+		}
+
+		/**
+		 * @param utf8 utf-8 code unit sequence
+		 * @param size count of code units
+		 * @param index index of a codepoint
+		 * @return offset of the code unit starting the codepoint at index, return size if index is out of range
+		 */
+		[[nodiscard]] constexpr u64 find_utf8_codepoint_offset(char const* const utf8, const u64 size, const u64 index) noexcept
+		{
+			u64 found = 0;
+			for (u64 i = 0; i < size; ++i)
+			{
+				if (!is_utf8_codepoint_start(utf8[i]))
+					continue;
+				if (found == index)
+					return i;
+				++found;
+			}
+			return size;
+		}
+
+		/**
+		 * Only the code units of one sequence are looked back, so ill-formed code units are cut anywhere.
+		 * @param utf8 utf-8 code unit sequence
+		 * @param size count of code units
+		 * @param offset offset to cut the code units at
+		 * @return nearest boundary of codepoints not after offset, return size if offset is not less than size
+		 */
+		[[nodiscard]] constexpr u64 find_utf8_codepoint_boundary(char const* const utf8, const u64 size, const u64 offset) noexcept
+		{
+			if (offset >= size)
+				return size;
+			u64 boundary = offset;
+			while (offset - boundary < UTF8_SEQUENCE_MAXIMUM_LENGTH - 1 && boundary > 0 && !is_utf8_codepoint_start(utf8[boundary]))
+				--boundary;
+			return is_utf8_codepoint_start(utf8[boundary]) ? boundary : offset;
+		}
+
+		/**
+		 * \brief Decode the utf-8 sequence at the start, with the sequences of 2 and 3 code units checked inline.
+		 * @param utf8 start of a utf-8 sequence
+		 * @param size count of code units available
+		 * @param utf32 receives the codepoint if the sequence is well-formed
+		 * @return length of the well-formed utf-8 sequence at the start, return 0 if it is ill-formed or truncated
+		 */
+		[[nodiscard]] constexpr u64 decode_utf8(char const* const utf8, const u64 size, char32_t& utf32) noexcept
+		{
+			const u8 c0 = static_cast<u8>(utf8[0]);
+			if (c0 >= 0xc2 && c0 < 0xe0 && size >= 2 && is_utf8_continuation(utf8[1]))
+			{
+				utf32 = (static_cast<char32_t>(c0 & 0x1f) << 6) | (static_cast<u8>(utf8[1]) & 0x3f);
+				return 2;
+			}
+			// Lead code units 0xe0 and 0xed limit the second one, which is left to parse_valid_utf8_length.
+			if (c0 > 0xe0 && c0 < 0xf0 && c0 != 0xed && size >= 3 && is_utf8_continuation(utf8[1]) && is_utf8_continuation(utf8[2]))
+			{
+				utf32 = (static_cast<char32_t>(c0 & 0x0f) << 12) | (static_cast<char32_t>(static_cast<u8>(utf8[1]) & 0x3f) << 6) | (static_cast<u8>(utf8[2]) & 0x3f);
+				return 3;
+			}
+			const u64 length = parse_valid_utf8_length(utf8, size);
+			if (length != 0)
+				utf32 = utf8_to_utf32(utf8, length);
+			return length;
+		}
+
+		/**
+		 * At runtime, 8 code units are skipped at once while they are all ascii.
+		 * @param utf8 utf-8 code unit sequence
+		 * @param size count of code units
+		 * @return offset of the first ill-formed sequence, return size if the whole sequence is well-formed
+		 */
+		[[nodiscard]] constexpr u64 find_invalid_utf8(char const* const utf8, const u64 size) noexcept
+		{
+			constexpr u64 word_size = sizeof(u64);
+			constexpr u64 non_ascii_mask = 0x8080808080808080ull;
+			const bool skips_words = !OPEN_STRING_IS_CONSTANT_EVALUATED();
+			u64 offset = 0;
+			while (offset < size)
+			{
+				while (skips_words && offset + word_size <= size)
+				{
+					u64 word = 0;
+					std::memcpy(&word, utf8 + offset, word_size);
+					if ((word & non_ascii_mask) != 0)
+						break;
+					offset += word_size;
+				}
+				if (offset == size)
+					break;
+				const u64 length = parse_valid_utf8_length(utf8 + offset, size - offset);
+				if (length == 0)
+					return offset;
+				offset += length;
+			}
+			return size;
+		}
 	}
 
 	struct codepoint
@@ -0,0 +1,43 @@
+
+#pragma once
+#include "common/definitions.h"
+
+#include <vector>
+
+#include "text.h"
+
+namespace ostr
+{
+	/**
+	 * \brief Sort views in the order of operator<, which is the order of codepoints for utf-8.
+	 * This is a MSD radix sort, which distributes large ranges by one code unit at a time and skips prefixes shared by
+	 * a whole range, then sorts small ranges by multikey quicksort on caches of several code units moved along with the views.
+	 * Each code unit of the common prefixes is read only a few times, unlike comparison sorts which read whole prefixes
+	 * in every comparison. The sort is not stable.
+	 * @param views first view to sort
+	 * @param count count of views to sort
+	 */
+	OPEN_STRING_API void sort_views(codeunit_sequence_view* views, u64 count) noexcept;
+	OPEN_STRING_API void sort_views(text_view* views, u64 count) noexcept;
+
+	/**
+	 * \brief Same as sort_views, with ranges of the radix sort shared by a pool of work-stealing threads.
+	 * @param views first view to sort
+	 * @param count count of views to sort
+	 * @param thread_count count of threads including the calling thread, 0 for the count of hardware threads
+	 */
+	OPEN_STRING_API void sort_views_parallel(codeunit_sequence_view* views, u64 count, u32 thread_count = 0) noexcept;
+	OPEN_STRING_API void sort_views_parallel(text_view* views, u64 count, u32 thread_count = 0) noexcept;
+
+	template<class View>
+	void sort_views(std::vector<View>& views) noexcept
+	{
+		sort_views(views.data(), views.size());
+	}
+
+	template<class View>
+	void sort_views_parallel(std::vector<View>& views, const u32 thread_count = 0) noexcept
+	{
+		sort_views_parallel(views.data(), views.size(), thread_count);
+	}
+}
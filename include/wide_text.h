@@ -4,9 +4,57 @@
 #include "codeunit_sequence.h"
 #include "codeunit_sequence_view.h"
 #include "common/sequence.h"
+#include "format.h"
 
 namespace ostr
 {
+	namespace details
+	{
+		[[nodiscard]] constexpr u64 get_sequence_length(const wchar_t* str) noexcept
+		{
+			if(!str)
+				return 0;
+			u64 count = 0;
+			while(str[count] != 0)
+				++count;
+			return count;
+		}
+
+		/**
+		 * @param wide_str wide code units, utf-16 on Windows and utf-32 elsewhere
+		 * @param count count of wide code units
+		 * @return size of the same text encoded in utf-8
+		 */
+		[[nodiscard]] OPEN_STRING_API u64 get_utf8_size(const wchar_t* wide_str, u64 count) noexcept;
+
+		/**
+		 * \brief Encode wide code units into utf-8 at target, which has space for get_utf8_size code units.
+		 * \param target space to write code units into
+		 * \param wide_str wide code units, utf-16 on Windows and utf-32 elsewhere
+		 * \param count count of wide code units
+		 * \return the code unit past the last one written
+		 */
+		OPEN_STRING_API char* encode_wide(char* target, const wchar_t* wide_str, u64 count) noexcept;
+
+		/**
+		 * \brief Encode wide code units into utf-8 and append them after out directly,
+		 * there is no intermediate wide_text or text, and out grows at most once.
+		 * \param out sequence to append to
+		 * \param wide_str wide code units, utf-16 on Windows and utf-32 elsewhere
+		 * \param count count of wide code units
+		 */
+		OPEN_STRING_API void append_wide(codeunit_sequence& out, const wchar_t* wide_str, u64 count) noexcept;
+
+		/**
+		 * \brief Encode wide code units into utf-8 and write them into a sink,
+		 * code units are encoded in small blocks on stack without any allocation.
+		 * \param sink sink to write into
+		 * \param wide_str wide code units, utf-16 on Windows and utf-32 elsewhere
+		 * \param count count of wide code units
+		 */
+		OPEN_STRING_API void append_wide(format_sink& sink, const wchar_t* wide_str, u64 count) noexcept;
+	}
+
 	class OPEN_STRING_API wide_text
 	{
 	public:
@@ -16,37 +64,56 @@ namespace ostr
 		wide_text& operator=(const codeunit_sequence_view& view) noexcept;
 
 		[[nodiscard]] const wchar_t* data() const noexcept;
+		/// @return count of wide code units, without the null-terminator
+		[[nodiscard]] u64 size() const noexcept;
 		void decode(codeunit_sequence& out) const noexcept;
+
 	private:
-		sequence<wchar_t, 128> sequence_{ };
+		// 16 bytes inline, which is 4 code units on utf-32 platforms and 8 on utf-16 ones.
+		static constexpr u64 INLINE_CAPACITY = 16 / sizeof(wchar_t);
+
+		sequence<wchar_t, INLINE_CAPACITY> sequence_{ };
 	};
 
-	template<> 
+	template<>
 	struct argument_formatter<wide_text>
 	{
-		static codeunit_sequence produce(const wide_text& value, const codeunit_sequence_view& specification)
+		static void produce(format_sink& sink, const wide_text& value, const codeunit_sequence_view& specification)
 		{
-			codeunit_sequence result;
-			value.decode(result);
-			return result;
+			details::append_wide(sink, value.data(), value.size());
+		}
+
+		static u64 measure(const wide_text& value, const codeunit_sequence_view& specification)
+		{
+			return details::get_utf8_size(value.data(), value.size());
 		}
 	};
 
-	template<> 
+	template<>
 	struct argument_formatter<const wchar_t*>
 	{
-		static codeunit_sequence produce(const wchar_t* value, const codeunit_sequence_view& specification)
+		static void produce(format_sink& sink, const wchar_t* value, const codeunit_sequence_view& specification)
 		{
-			return argument_formatter<wide_text>::produce(wide_text{ value }, specification);
+			details::append_wide(sink, value, details::get_sequence_length(value));
+		}
+
+		static u64 measure(const wchar_t* value, const codeunit_sequence_view& specification)
+		{
+			return details::get_utf8_size(value, details::get_sequence_length(value));
 		}
 	};
 
-	template<size_t N> 
+	template<size_t N>
 	struct argument_formatter<wchar_t[N]>
 	{
-		static codeunit_sequence produce(const wchar_t (&value)[N], const codeunit_sequence_view& specification)
+		static void produce(format_sink& sink, const wchar_t (&value)[N], const codeunit_sequence_view& specification)
+		{
+			argument_formatter<const wchar_t*>::produce(sink, value, specification);
+		}
+
+		static u64 measure(const wchar_t (&value)[N], const codeunit_sequence_view& specification)
 		{
-			return argument_formatter<wide_text>::produce(wide_text{ value }, specification);
+			return argument_formatter<const wchar_t*>::measure(value, specification);
 		}
 	};
 }
@@ -0,0 +1,341 @@
+
+#include "case_mapping.h"
+
+#include "case_mapping_tables.h"
+
+namespace ostr
+{
+	namespace details
+	{
+		[[nodiscard]] static const std::array<i32, 3>& get_case_mapping_record(const char32_t cp) noexcept
+		{
+			if(cp >= CASE_MAPPING_LIMIT)
+				return CASE_MAPPING_RECORDS[0];
+			const u64 block = CASE_MAPPING_BLOCK_INDICES[cp >> CASE_MAPPING_BLOCK_SHIFT];
+			const u64 offset = cp & ((1 << CASE_MAPPING_BLOCK_SHIFT) - 1);
+			return CASE_MAPPING_RECORDS[CASE_MAPPING_RECORD_INDICES[(block << CASE_MAPPING_BLOCK_SHIFT) | offset]];
+		}
+
+		/**
+		 * @return the mapped codepoint as a delta from the codepoint, or CASE_MAPPING_SPECIAL_BASE plus the index of a special mapping
+		 */
+		[[nodiscard]] static i32 get_case_mapping_value(const char32_t cp, const case_mapping mapping) noexcept
+		{
+			return get_case_mapping_record(cp)[static_cast<u8>(mapping)];
+		}
+
+		[[nodiscard]] static constexpr char upper_ascii_case(const char codeunit) noexcept
+		{
+			return codeunit >= 'a' && codeunit <= 'z' ? static_cast<char>(codeunit - 'a' + 'A') : codeunit;
+		}
+
+		// Upper case of the letters in a word of code units, the counterpart of fold_ascii_case_word.
+		[[nodiscard]] static constexpr u64 upper_ascii_case_word(const u64 word) noexcept
+		{
+			const u64 ascii = word & (CODEUNIT_WORD_ONES * 0x7f);
+			const u64 from_a = ascii + CODEUNIT_WORD_ONES * (0x80 - 'a');
+			const u64 after_z = ascii + CODEUNIT_WORD_ONES * (0x80 - 'z' - 1);
+			const u64 lower = from_a & ~after_z & ~word & (CODEUNIT_WORD_ONES * 0x80);
+			return word & ~(lower >> 2);
+		}
+
+		static_assert(upper_ascii_case_word(load_little_endian_codeunit_word("`az{@AZ[", 8)) == load_little_endian_codeunit_word("`AZ{@AZ[", 8));
+
+		[[nodiscard]] static constexpr char map_ascii_case(const char codeunit, const case_mapping mapping) noexcept
+		{
+			return mapping == case_mapping::upper ? upper_ascii_case(codeunit) : fold_ascii_case(codeunit);
+		}
+
+		[[nodiscard]] static constexpr u64 map_ascii_case_word(const u64 word, const case_mapping mapping) noexcept
+		{
+			return mapping == case_mapping::upper ? upper_ascii_case_word(word) : fold_ascii_case_word(word);
+		}
+
+		struct case_mapping_writer
+		{
+			// Code units a codepoint is mapped to at most.
+			static constexpr u64 MAPPED_SIZE_MAXIMUM = unicode::CASE_MAPPING_MAXIMUM_LENGTH * unicode::UTF8_SEQUENCE_MAXIMUM_LENGTH;
+
+			using mapped_codeunits = std::array<char, MAPPED_SIZE_MAXIMUM>;
+
+			static u64 write_codepoint(const char32_t cp, char* destination) noexcept
+			{
+				if(cp <= unicode::get_utf8_maximum_codepoint(1))
+				{
+					destination[0] = static_cast<char>(cp);
+					return 1;
+				}
+				if(cp <= unicode::get_utf8_maximum_codepoint(2))
+				{
+					destination[0] = static_cast<char>((cp >> 6) | 0xc0);
+					destination[1] = static_cast<char>((cp & 0x3f) | 0x80);
+					return 2;
+				}
+				const std::array<char, unicode::UTF8_SEQUENCE_MAXIMUM_LENGTH> utf8 = unicode::utf32_to_utf8(cp);
+				const u64 length = unicode::parse_utf8_length(cp);
+				std::memcpy(destination, utf8.data(), length);
+				return length;
+			}
+
+			/**
+			 * \brief Check a sequence of 2 or 3 code units by its lead code unit, without decoding it, e.g. the whole of CJK and Hangul.
+			 * Ill-formed sequences, which are copied as they are, may be taken as unmapped.
+			 * @return count of code units of the sequence at the start of source if none of the codepoints of its lead code unit is mapped, return 0 otherwise
+			 */
+			[[nodiscard]] static u64 parse_unmapped_length(const char* source, const u64 size) noexcept
+			{
+				const u8 lead = static_cast<u8>(source[0]);
+				if(lead < 0xc0 || lead >= 0xf0 || ((CASE_MAPPING_UNMAPPED_LEADS >> (lead - 0xc0)) & 1) == 0)
+					return 0;
+				if(lead < 0xe0)
+					return size >= 2 && unicode::is_utf8_continuation(source[1]) ? 2 : 0;
+				return size >= 3 && unicode::is_utf8_continuation(source[1]) && unicode::is_utf8_continuation(source[2]) ? 3 : 0;
+			}
+
+			/**
+			 * \brief Write the mapping of a codepoint whose mapped value is not 0.
+			 * @param destination room of MAPPED_SIZE_MAXIMUM code units
+			 * @return count of code units written
+			 */
+			static u64 write_mapped(const char32_t cp, const i32 value, char* destination) noexcept
+			{
+				if(value < CASE_MAPPING_SPECIAL_BASE)
+					return write_codepoint(static_cast<char32_t>(static_cast<i32>(cp) + value), destination);
+				u64 written = 0;
+				for(const char32_t special : CASE_MAPPING_SPECIALS[value - CASE_MAPPING_SPECIAL_BASE])
+				{
+					if(special == 0)
+						break;
+					written += write_codepoint(special, destination + written);
+				}
+				return written;
+			}
+
+			[[nodiscard]] static bool is_ascii_word(const u64 word) noexcept
+			{
+				return (word & (CODEUNIT_WORD_ONES * 0x80)) == 0;
+			}
+
+			/**
+			 * \brief Grow destination, keeping the estimate that the rest of source is as long as it is, with some room for mappings lengthening it further.
+			 * @param written count of code units written to destination
+			 * @param required count of code units required for the rest of source
+			 * @return the buffer of destination
+			 */
+			static char* grow(codeunit_sequence& destination, const u64 written, const u64 required) noexcept
+			{
+				destination.set_size(written);
+				destination.reserve(written + required + required / 8);
+				return destination.data();
+			}
+
+			static void copy_run(char* output, u64& written, const char* run, const u64 count) noexcept
+			{
+				if(count == 0)
+					return;
+				std::memcpy(output + written, run, count);
+				written += count;
+			}
+
+			static void map(codeunit_sequence& destination, const codeunit_sequence_view& source, const case_mapping mapping) noexcept
+			{
+				const char* input = source.data();
+				const u64 size = source.size();
+				u64 written = destination.size();
+				// Most mappings keep the length of text, so the mapped text is estimated to be as long as source.
+				destination.reserve(written + size);
+				char* output = destination.data();
+				u64 capacity = destination.get_capacity();
+				// Codepoints not mapped are copied later as a run, which is the whole text for scripts without case.
+				u64 run = 0;
+				u64 i = 0;
+				while(i < size)
+				{
+					if(i + sizeof(u64) <= size)
+					{
+						if(const u64 word = load_codeunit_word<u64>(input + i); is_ascii_word(word))
+						{
+							if(capacity - written < i - run + sizeof(u64))
+							{
+								output = grow(destination, written, i - run + size - i);
+								capacity = destination.get_capacity();
+							}
+							copy_run(output, written, input + run, i - run);
+							const u64 mapped = map_ascii_case_word(word, mapping);
+							std::memcpy(output + written, &mapped, sizeof(u64));
+							written += sizeof(u64);
+							i += sizeof(u64);
+							run = i;
+							continue;
+						}
+					}
+					if(const u64 unmapped = parse_unmapped_length(input + i, size - i); unmapped != 0)
+					{
+						i += unmapped;
+						continue;
+					}
+					char32_t cp = 0;
+					const u64 length = static_cast<u8>(input[i]) < 0x80 ? 1 : unicode::decode_utf8(input + i, size - i, cp);
+					const i32 value = length > 1 ? get_case_mapping_value(cp, mapping) : 0;
+					if(length > 1 && value == 0)
+					{
+						i += length;
+						continue;
+					}
+					if(capacity - written < i - run)
+					{
+						output = grow(destination, written, i - run + size - i);
+						capacity = destination.get_capacity();
+					}
+					copy_run(output, written, input + run, i - run);
+					// Mapped code units are written through a buffer only when they may not fit.
+					mapped_codeunits mapped;
+					char* cursor = capacity - written >= MAPPED_SIZE_MAXIMUM ? output + written : mapped.data();
+					u64 mapped_size = 1;
+					if(length <= 1)
+					{
+						// Ascii code units between the others, and ill-formed code units, which are copied as they are.
+						cursor[0] = map_ascii_case(input[i], mapping);
+						i += 1;
+					}
+					else
+					{
+						mapped_size = write_mapped(cp, value, cursor);
+						i += length;
+					}
+					if(cursor == mapped.data())
+					{
+						if(capacity - written < mapped_size)
+						{
+							output = grow(destination, written, mapped_size + size - i);
+							capacity = destination.get_capacity();
+						}
+						std::memcpy(output + written, mapped.data(), mapped_size);
+					}
+					written += mapped_size;
+					run = i;
+				}
+				if(capacity - written < size - run)
+					output = grow(destination, written, size - run);
+				copy_run(output, written, input + run, size - run);
+				destination.set_size(written);
+				output[written] = '\0';
+			}
+
+			static void map_in_place(codeunit_sequence& sequence, const case_mapping mapping) noexcept
+			{
+				char* data = sequence.data();
+				const u64 size = sequence.size();
+				u64 written = 0;
+				u64 i = 0;
+				while(i < size)
+				{
+					if(i + sizeof(u64) <= size)
+					{
+						if(const u64 word = load_codeunit_word<u64>(data + i); is_ascii_word(word))
+						{
+							const u64 mapped = map_ascii_case_word(word, mapping);
+							std::memcpy(data + written, &mapped, sizeof(u64));
+							written += sizeof(u64);
+							i += sizeof(u64);
+							continue;
+						}
+					}
+					if(const u64 unmapped = parse_unmapped_length(data + i, size - i); unmapped != 0)
+					{
+						if(written != i)
+							std::memmove(data + written, data + i, unmapped);
+						written += unmapped;
+						i += unmapped;
+						continue;
+					}
+					char32_t cp = 0;
+					const u64 length = static_cast<u8>(data[i]) < 0x80 ? 1 : unicode::decode_utf8(data + i, size - i, cp);
+					if(length <= 1)
+					{
+						data[written] = map_ascii_case(data[i], mapping);
+						++written;
+						++i;
+						continue;
+					}
+					if(const i32 value = get_case_mapping_value(cp, mapping); value == 0)
+					{
+						if(written != i)
+							std::memmove(data + written, data + i, length);
+						written += length;
+					}
+					else
+					{
+						mapped_codeunits mapped;
+						const u64 mapped_size = write_mapped(cp, value, mapped.data());
+						// The mapped code units would overwrite the ones not read yet.
+						if(written + mapped_size > i + length)
+							break;
+						std::memcpy(data + written, mapped.data(), mapped_size);
+						written += mapped_size;
+					}
+					i += length;
+				}
+				if(i < size)
+				{
+					codeunit_sequence result{ written + (size - i) };
+					result.append(codeunit_sequence_view{ data, written });
+					map(result, codeunit_sequence_view{ data + i, size - i }, mapping);
+					sequence.transfer_data(result);
+					return;
+				}
+				sequence.set_size(written);
+				data[written] = '\0';
+			}
+		};
+	}
+
+	namespace unicode
+	{
+		u64 map_case(const char32_t cp, const case_mapping mapping, std::array<char32_t, CASE_MAPPING_MAXIMUM_LENGTH>& mapped) noexcept
+		{
+			const i32 value = details::get_case_mapping_value(cp, mapping);
+			if(value < details::CASE_MAPPING_SPECIAL_BASE)
+			{
+				mapped[0] = static_cast<char32_t>(static_cast<i32>(cp) + value);
+				return 1;
+			}
+			const std::array<char32_t, CASE_MAPPING_MAXIMUM_LENGTH>& special = details::CASE_MAPPING_SPECIALS[value - details::CASE_MAPPING_SPECIAL_BASE];
+			u64 count = 0;
+			for(; count < CASE_MAPPING_MAXIMUM_LENGTH && special[count] != 0; ++count)
+				mapped[count] = special[count];
+			return count;
+		}
+	}
+
+	void map_case_to(codeunit_sequence& destination, const codeunit_sequence_view& source, const case_mapping mapping) noexcept
+	{
+		details::case_mapping_writer::map(destination, source, mapping);
+	}
+
+	void map_case_in_place(codeunit_sequence& sequence, const case_mapping mapping) noexcept
+	{
+		details::case_mapping_writer::map_in_place(sequence, mapping);
+	}
+
+	text to_lower(const text_view& source) noexcept
+	{
+		codeunit_sequence result;
+		map_case_to(result, source.raw(), case_mapping::lower);
+		return text{ std::move(result) };
+	}
+
+	text to_upper(const text_view& source) noexcept
+	{
+		codeunit_sequence result;
+		map_case_to(result, source.raw(), case_mapping::upper);
+		return text{ std::move(result) };
+	}
+
+	text case_fold(const text_view& source) noexcept
+	{
+		codeunit_sequence result;
+		map_case_to(result, source.raw(), case_mapping::fold);
+		return text{ std::move(result) };
+	}
+}
@@ -0,0 +1,670 @@
+
+// Generated by tools/generate_case_mapping_tables.py from the Unicode Character Database 14.0.0, do not edit.
+// 44 blocks, 279 records and 145 special mappings, 17331 bytes in total.
+#pragma once
+#include "common/basic_types.h"
+
+#include <array>
+
+namespace ostr
+{
+	namespace details
+	{
+		inline constexpr u64 CASE_MAPPING_BLOCK_SHIFT = 7;
+		inline constexpr char32_t CASE_MAPPING_LIMIT = 0x1E980;
+		inline constexpr i32 CASE_MAPPING_SPECIAL_BASE = 0x200000;
+		// Bit c - 0xc0 is set when no codepoint starting with the lead code unit c is mapped, for leads of 2 and 3 code units.
+		inline constexpr u64 CASE_MAPPING_UNMAPPED_LEADS = 0x00007BF8FF801803;
+
+		// Index of the block in CASE_MAPPING_RECORD_INDICES of each block of codepoints.
+		inline constexpr std::array<u8, 979> CASE_MAPPING_BLOCK_INDICES
+		{
+			  0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  13,  12,  12,  12,  12,  12,  14,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  15,  16,  17,  18,  19,  20,  21,
+			 12,  12,  22,  23,  12,  12,  12,  12,  12,  24,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  25,  26,  27,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  28,  29,  30,  31,  12,  12,  12,  12,  12,  12,  32,  33,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  34,  12,  12,  12,  12,  12,  12,  12,  35,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  36,  37,  38,  39,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  40,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  41,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  42,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,
+			 12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  12,  43,
+		};
+
+		// Index in CASE_MAPPING_RECORDS of each codepoint of a block.
+		inline constexpr std::array<u16, 5632> CASE_MAPPING_RECORD_INDICES
+		{
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   0,   0,   0,   0,   0,
+			  0,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   3,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   0,   1,   1,   1,   1,   1,   1,   1,   4,
+			  2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   0,   2,   2,   2,   2,   2,   2,   2,   5,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   8,   9,   6,   7,   6,   7,   6,   7,   0,   6,   7,   6,   7,   6,   7,   6,
+			  7,   6,   7,   6,   7,   6,   7,   6,   7,  10,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,  11,   6,   7,   6,   7,   6,   7,  12,
+			 13,  14,   6,   7,   6,   7,  15,   6,   7,  16,  16,   6,   7,   0,  17,  18,  19,   6,   7,  16,  20,  21,  22,  23,   6,   7,  24,   0,  22,  25,  26,  27,
+			  6,   7,   6,   7,   6,   7,  28,   6,   7,  28,   0,   0,   6,   7,  28,   6,   7,  29,  29,   6,   7,   6,   7,  30,   6,   7,   0,   0,   6,   7,   0,  31,
+			  0,   0,   0,   0,  32,  33,  34,  32,  33,  34,  32,  33,  34,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,  35,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,  36,  32,  33,  34,   6,   7,  37,  38,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			 39,   0,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   0,   0,   0,   0,   0,   0,  40,   6,   7,  41,  42,  43,
+			 43,   6,   7,  44,  45,  46,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,  47,  48,  49,  50,  51,   0,  52,  52,   0,  53,   0,  54,  55,   0,   0,   0,
+			 52,  56,   0,  57,   0,  58,  59,   0,  60,  61,  59,  62,  63,   0,   0,  61,   0,  64,  65,   0,   0,  66,   0,   0,   0,   0,   0,   0,   0,  67,   0,   0,
+			 68,   0,  69,  68,   0,   0,   0,  70,  68,  71,  72,  72,  73,   0,   0,   0,   0,   0,  74,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  75,  76,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,  77,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   6,   7,   6,   7,   0,   0,   6,   7,   0,   0,   0,  26,  26,  26,   0,  78,
+			  0,   0,   0,   0,   0,   0,  79,   0,  80,  80,  80,   0,  81,   0,  82,  82,  83,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+			  1,   1,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,  84,  85,  85,  85,  86,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+			  2,   2,  87,   2,   2,   2,   2,   2,   2,   2,   2,   2,  88,  89,  89,  90,  91,  92,   0,   0,   0,  93,  94,  95,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,  96,  97,  98,  99, 100, 101,   0,   6,   7, 102,   6,   7,   0,  39,  39,  39,
+			103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103, 103,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+			  1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+			  2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104, 104,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   0,   0,   0,   0,   0,   0,   0,   0,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			105,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7, 106,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   0, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107,
+			107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108,
+			108, 108, 108, 108, 108, 108, 108, 109,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110, 110,
+			110, 110, 110, 110, 110, 110,   0, 110,   0,   0,   0,   0,   0, 110,   0,   0, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111,
+			111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111, 111,   0,   0, 111, 111, 111,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112,
+			112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112,
+			112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 112, 113, 113, 113, 113, 113, 113,   0,   0, 114, 114, 114, 114, 114, 114,   0,   0,
+			115, 116, 117, 118, 118, 119, 120, 121, 122,   0,   0,   0,   0,   0,   0,   0, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123,
+			123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123, 123,   0,   0, 123, 123, 123,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 124,   0,   0,   0, 125,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 126,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7, 127, 128, 129, 130, 131, 132,   0,   0, 133,   0,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			134, 134, 134, 134, 134, 134, 134, 134, 135, 135, 135, 135, 135, 135, 135, 135, 134, 134, 134, 134, 134, 134,   0,   0, 135, 135, 135, 135, 135, 135,   0,   0,
+			134, 134, 134, 134, 134, 134, 134, 134, 135, 135, 135, 135, 135, 135, 135, 135, 134, 134, 134, 134, 134, 134, 134, 134, 135, 135, 135, 135, 135, 135, 135, 135,
+			134, 134, 134, 134, 134, 134,   0,   0, 135, 135, 135, 135, 135, 135,   0,   0, 136, 134, 137, 134, 138, 134, 139, 134,   0, 135,   0, 135,   0, 135,   0, 135,
+			134, 134, 134, 134, 134, 134, 134, 134, 135, 135, 135, 135, 135, 135, 135, 135, 140, 140, 141, 141, 141, 141, 142, 142, 143, 143, 144, 144, 145, 145,   0,   0,
+			146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177,
+			178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 134, 134, 194, 195, 196,   0, 197, 198, 135, 135, 199, 199, 200,   0, 201,   0,
+			  0,   0, 202, 203, 204,   0, 205, 206, 207, 207, 207, 207, 208,   0,   0,   0, 134, 134, 209,  83,   0,   0, 210, 211, 135, 135, 212, 212,   0,   0,   0,   0,
+			134, 134, 213,  86, 214,  98, 215, 216, 135, 135, 217, 217, 102,   0,   0,   0,   0,   0, 218, 219, 220,   0, 221, 222, 223, 223, 224, 224, 225,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0, 226,   0,   0,   0, 227, 228,   0,   0,   0,   0,   0,   0, 229,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 230,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 231, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232, 232,
+			  0,   0,   0,   6,   7,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
+			233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234, 234,
+			234, 234, 234, 234, 234, 234, 234, 234, 234, 234,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107,
+			107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 107, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108,
+			108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108, 108,
+			  6,   7, 235, 236, 237, 238, 239,   6,   7,   6,   7,   6,   7, 240, 241, 242, 243,   0,   6,   7,   0,   6,   7,   0,   0,   0,   0,   0,   0,   0, 244, 244,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   0,   0,   0,   0,   0,   0,   0,   6,   7,   6,   7,   0,   0,   0,   6,   7,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245, 245,
+			245, 245, 245, 245, 245, 245,   0, 245,   0,   0,   0,   0,   0, 245,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   0,   0,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   0,   0,   0,   0,   0,   0,   0,   0,   0,   6,   7,   6,   7, 246,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   0,   0,   0,   6,   7, 247,   0,   0,   6,   7,   6,   7, 248,   0,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7,   6,   7,   6,   7,   6,   7, 249, 250, 251, 252, 249,   0, 253, 254, 255, 256,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,   6,   7,
+			  6,   7,   6,   7, 257, 258, 259,   6,   7,   6,   7,   0,   0,   0,   0,   0,   6,   7,   0,   0,   0,   0,   6,   7,   6,   7,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   6,   7,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 260,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261,
+			261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261,
+			261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261, 261,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			262, 263, 264, 265, 266, 267, 267,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 268, 269, 270, 271, 272,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   0,   0,   0,   0,   0,
+			  0,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273,
+			273, 273, 273, 273, 273, 273, 273, 273, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274,
+			274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273,
+			273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273, 273,   0,   0,   0,   0, 274, 274, 274, 274, 274, 274, 274, 274,
+			274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274, 274,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 275, 275, 275, 275, 275, 275, 275, 275, 275, 275, 275,   0, 275, 275, 275, 275,
+			275, 275, 275, 275, 275, 275, 275, 275, 275, 275, 275,   0, 275, 275, 275, 275, 275, 275, 275,   0, 275, 275,   0, 276, 276, 276, 276, 276, 276, 276, 276, 276,
+			276, 276,   0, 276, 276, 276, 276, 276, 276, 276, 276, 276, 276, 276, 276, 276, 276, 276,   0, 276, 276, 276, 276, 276, 276, 276,   0, 276, 276,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			 81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,
+			 81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,  81,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			 88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,
+			 88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,  88,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+			  2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+			  2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+			277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277, 277,
+			277, 277, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278, 278,
+			278, 278, 278, 278,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+			  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+		};
+
+		// Lower case, upper case and case folding of codepoints, as deltas or special mappings.
+		inline constexpr std::array<std::array<i32, 3>, 279> CASE_MAPPING_RECORDS
+		{{
+			{ 0, 0, 0 },
+			{ 32, 0, 32 },
+			{ 0, -32, 0 },
+			{ 0, 743, 775 },
+			{ 0, 0x200000, 0x200001 },
+			{ 0, 121, 0 },
+			{ 1, 0, 1 },
+			{ 0, -1, 0 },
+			{ 0x200002, 0, 0x200002 },
+			{ 0, -232, 0 },
+			{ 0, 0x200003, 0x200004 },
+			{ -121, 0, -121 },
+			{ 0, -300, -268 },
+			{ 0, 195, 0 },
+			{ 210, 0, 210 },
+			{ 206, 0, 206 },
+			{ 205, 0, 205 },
+			{ 79, 0, 79 },
+			{ 202, 0, 202 },
+			{ 203, 0, 203 },
+			{ 207, 0, 207 },
+			{ 0, 97, 0 },
+			{ 211, 0, 211 },
+			{ 209, 0, 209 },
+			{ 0, 163, 0 },
+			{ 213, 0, 213 },
+			{ 0, 130, 0 },
+			{ 214, 0, 214 },
+			{ 218, 0, 218 },
+			{ 217, 0, 217 },
+			{ 219, 0, 219 },
+			{ 0, 56, 0 },
+			{ 2, 0, 2 },
+			{ 1, -1, 1 },
+			{ 0, -2, 0 },
+			{ 0, -79, 0 },
+			{ 0, 0x200005, 0x200006 },
+			{ -97, 0, -97 },
+			{ -56, 0, -56 },
+			{ -130, 0, -130 },
+			{ 10795, 0, 10795 },
+			{ -163, 0, -163 },
+			{ 10792, 0, 10792 },
+			{ 0, 10815, 0 },
+			{ -195, 0, -195 },
+			{ 69, 0, 69 },
+			{ 71, 0, 71 },
+			{ 0, 10783, 0 },
+			{ 0, 10780, 0 },
+			{ 0, 10782, 0 },
+			{ 0, -210, 0 },
+			{ 0, -206, 0 },
+			{ 0, -205, 0 },
+			{ 0, -202, 0 },
+			{ 0, -203, 0 },
+			{ 0, 42319, 0 },
+			{ 0, 42315, 0 },
+			{ 0, -207, 0 },
+			{ 0, 42280, 0 },
+			{ 0, 42308, 0 },
+			{ 0, -209, 0 },
+			{ 0, -211, 0 },
+			{ 0, 10743, 0 },
+			{ 0, 42305, 0 },
+			{ 0, 10749, 0 },
+			{ 0, -213, 0 },
+			{ 0, -214, 0 },
+			{ 0, 10727, 0 },
+			{ 0, -218, 0 },
+			{ 0, 42307, 0 },
+			{ 0, 42282, 0 },
+			{ 0, -69, 0 },
+			{ 0, -217, 0 },
+			{ 0, -71, 0 },
+			{ 0, -219, 0 },
+			{ 0, 42261, 0 },
+			{ 0, 42258, 0 },
+			{ 0, 84, 116 },
+			{ 116, 0, 116 },
+			{ 38, 0, 38 },
+			{ 37, 0, 37 },
+			{ 64, 0, 64 },
+			{ 63, 0, 63 },
+			{ 0, 0x200007, 0x200008 },
+			{ 0, -38, 0 },
+			{ 0, -37, 0 },
+			{ 0, 0x200009, 0x20000A },
+			{ 0, -31, 1 },
+			{ 0, -64, 0 },
+			{ 0, -63, 0 },
+			{ 8, 0, 8 },
+			{ 0, -62, -30 },
+			{ 0, -57, -25 },
+			{ 0, -47, -15 },
+			{ 0, -54, -22 },
+			{ 0, -8, 0 },
+			{ 0, -86, -54 },
+			{ 0, -80, -48 },
+			{ 0, 7, 0 },
+			{ 0, -116, 0 },
+			{ -60, 0, -60 },
+			{ 0, -96, -64 },
+			{ -7, 0, -7 },
+			{ 80, 0, 80 },
+			{ 0, -80, 0 },
+			{ 15, 0, 15 },
+			{ 0, -15, 0 },
+			{ 48, 0, 48 },
+			{ 0, -48, 0 },
+			{ 0, 0x20000B, 0x20000C },
+			{ 7264, 0, 7264 },
+			{ 0, 3008, 0 },
+			{ 38864, 0, 0 },
+			{ 8, 0, 0 },
+			{ 0, -8, -8 },
+			{ 0, -6254, -6222 },
+			{ 0, -6253, -6221 },
+			{ 0, -6244, -6212 },
+			{ 0, -6242, -6210 },
+			{ 0, -6243, -6211 },
+			{ 0, -6236, -6204 },
+			{ 0, -6181, -6180 },
+			{ 0, 35266, 35267 },
+			{ -3008, 0, -3008 },
+			{ 0, 35332, 0 },
+			{ 0, 3814, 0 },
+			{ 0, 35384, 0 },
+			{ 0, 0x20000D, 0x20000E },
+			{ 0, 0x20000F, 0x200010 },
+			{ 0, 0x200011, 0x200012 },
+			{ 0, 0x200013, 0x200014 },
+			{ 0, 0x200015, 0x200016 },
+			{ 0, -59, -58 },
+			{ -7615, 0, 0x200001 },
+			{ 0, 8, 0 },
+			{ -8, 0, -8 },
+			{ 0, 0x200017, 0x200018 },
+			{ 0, 0x200019, 0x20001A },
+			{ 0, 0x20001B, 0x20001C },
+			{ 0, 0x20001D, 0x20001E },
+			{ 0, 74, 0 },
+			{ 0, 86, 0 },
+			{ 0, 100, 0 },
+			{ 0, 128, 0 },
+			{ 0, 112, 0 },
+			{ 0, 126, 0 },
+			{ 0, 0x20001F, 0x200020 },
+			{ 0, 0x200021, 0x200022 },
+			{ 0, 0x200023, 0x200024 },
+			{ 0, 0x200025, 0x200026 },
+			{ 0, 0x200027, 0x200028 },
+			{ 0, 0x200029, 0x20002A },
+			{ 0, 0x20002B, 0x20002C },
+			{ 0, 0x20002D, 0x20002E },
+			{ -8, 0x20001F, 0x200020 },
+			{ -8, 0x200021, 0x200022 },
+			{ -8, 0x200023, 0x200024 },
+			{ -8, 0x200025, 0x200026 },
+			{ -8, 0x200027, 0x200028 },
+			{ -8, 0x200029, 0x20002A },
+			{ -8, 0x20002B, 0x20002C },
+			{ -8, 0x20002D, 0x20002E },
+			{ 0, 0x20002F, 0x200030 },
+			{ 0, 0x200031, 0x200032 },
+			{ 0, 0x200033, 0x200034 },
+			{ 0, 0x200035, 0x200036 },
+			{ 0, 0x200037, 0x200038 },
+			{ 0, 0x200039, 0x20003A },
+			{ 0, 0x20003B, 0x20003C },
+			{ 0, 0x20003D, 0x20003E },
+			{ -8, 0x20002F, 0x200030 },
+			{ -8, 0x200031, 0x200032 },
+			{ -8, 0x200033, 0x200034 },
+			{ -8, 0x200035, 0x200036 },
+			{ -8, 0x200037, 0x200038 },
+			{ -8, 0x200039, 0x20003A },
+			{ -8, 0x20003B, 0x20003C },
+			{ -8, 0x20003D, 0x20003E },
+			{ 0, 0x20003F, 0x200040 },
+			{ 0, 0x200041, 0x200042 },
+			{ 0, 0x200043, 0x200044 },
+			{ 0, 0x200045, 0x200046 },
+			{ 0, 0x200047, 0x200048 },
+			{ 0, 0x200049, 0x20004A },
+			{ 0, 0x20004B, 0x20004C },
+			{ 0, 0x20004D, 0x20004E },
+			{ -8, 0x20003F, 0x200040 },
+			{ -8, 0x200041, 0x200042 },
+			{ -8, 0x200043, 0x200044 },
+			{ -8, 0x200045, 0x200046 },
+			{ -8, 0x200047, 0x200048 },
+			{ -8, 0x200049, 0x20004A },
+			{ -8, 0x20004B, 0x20004C },
+			{ -8, 0x20004D, 0x20004E },
+			{ 0, 0x20004F, 0x200050 },
+			{ 0, 0x200051, 0x200052 },
+			{ 0, 0x200053, 0x200054 },
+			{ 0, 0x200055, 0x200056 },
+			{ 0, 0x200057, 0x200058 },
+			{ -74, 0, -74 },
+			{ -9, 0x200051, 0x200052 },
+			{ 0, -7205, -7173 },
+			{ 0, 0x200059, 0x20005A },
+			{ 0, 0x20005B, 0x20005C },
+			{ 0, 0x20005D, 0x20005E },
+			{ 0, 0x20005F, 0x200060 },
+			{ 0, 0x200061, 0x200062 },
+			{ -86, 0, -86 },
+			{ -9, 0x20005B, 0x20005C },
+			{ 0, 0x200063, 0x200064 },
+			{ 0, 0x200065, 0x200066 },
+			{ 0, 0x200067, 0x200068 },
+			{ -100, 0, -100 },
+			{ 0, 0x200069, 0x20006A },
+			{ 0, 0x20006B, 0x20006C },
+			{ 0, 0x20006D, 0x20006E },
+			{ 0, 0x20006F, 0x200070 },
+			{ -112, 0, -112 },
+			{ 0, 0x200071, 0x200072 },
+			{ 0, 0x200073, 0x200074 },
+			{ 0, 0x200075, 0x200076 },
+			{ 0, 0x200077, 0x200078 },
+			{ 0, 0x200079, 0x20007A },
+			{ -128, 0, -128 },
+			{ -126, 0, -126 },
+			{ -9, 0x200073, 0x200074 },
+			{ -7517, 0, -7517 },
+			{ -8383, 0, -8383 },
+			{ -8262, 0, -8262 },
+			{ 28, 0, 28 },
+			{ 0, -28, 0 },
+			{ 16, 0, 16 },
+			{ 0, -16, 0 },
+			{ 26, 0, 26 },
+			{ 0, -26, 0 },
+			{ -10743, 0, -10743 },
+			{ -3814, 0, -3814 },
+			{ -10727, 0, -10727 },
+			{ 0, -10795, 0 },
+			{ 0, -10792, 0 },
+			{ -10780, 0, -10780 },
+			{ -10749, 0, -10749 },
+			{ -10783, 0, -10783 },
+			{ -10782, 0, -10782 },
+			{ -10815, 0, -10815 },
+			{ 0, -7264, 0 },
+			{ -35332, 0, -35332 },
+			{ -42280, 0, -42280 },
+			{ 0, 48, 0 },
+			{ -42308, 0, -42308 },
+			{ -42319, 0, -42319 },
+			{ -42315, 0, -42315 },
+			{ -42305, 0, -42305 },
+			{ -42258, 0, -42258 },
+			{ -42282, 0, -42282 },
+			{ -42261, 0, -42261 },
+			{ 928, 0, 928 },
+			{ -48, 0, -48 },
+			{ -42307, 0, -42307 },
+			{ -35384, 0, -35384 },
+			{ 0, -928, 0 },
+			{ 0, -38864, -38864 },
+			{ 0, 0x20007B, 0x20007C },
+			{ 0, 0x20007D, 0x20007E },
+			{ 0, 0x20007F, 0x200080 },
+			{ 0, 0x200081, 0x200082 },
+			{ 0, 0x200083, 0x200084 },
+			{ 0, 0x200085, 0x200086 },
+			{ 0, 0x200087, 0x200088 },
+			{ 0, 0x200089, 0x20008A },
+			{ 0, 0x20008B, 0x20008C },
+			{ 0, 0x20008D, 0x20008E },
+			{ 0, 0x20008F, 0x200090 },
+			{ 40, 0, 40 },
+			{ 0, -40, 0 },
+			{ 39, 0, 39 },
+			{ 0, -39, 0 },
+			{ 34, 0, 34 },
+			{ 0, -34, 0 },
+		}};
+
+		// Mappings to more than one codepoint, ending with 0 when shorter than 3 codepoints.
+		inline constexpr std::array<std::array<char32_t, 3>, 145> CASE_MAPPING_SPECIALS
+		{{
+			{ 0x0053, 0x0053, 0 },
+			{ 0x0073, 0x0073, 0 },
+			{ 0x0069, 0x0307, 0 },
+			{ 0x02BC, 0x004E, 0 },
+			{ 0x02BC, 0x006E, 0 },
+			{ 0x004A, 0x030C, 0 },
+			{ 0x006A, 0x030C, 0 },
+			{ 0x0399, 0x0308, 0x0301 },
+			{ 0x03B9, 0x0308, 0x0301 },
+			{ 0x03A5, 0x0308, 0x0301 },
+			{ 0x03C5, 0x0308, 0x0301 },
+			{ 0x0535, 0x0552, 0 },
+			{ 0x0565, 0x0582, 0 },
+			{ 0x0048, 0x0331, 0 },
+			{ 0x0068, 0x0331, 0 },
+			{ 0x0054, 0x0308, 0 },
+			{ 0x0074, 0x0308, 0 },
+			{ 0x0057, 0x030A, 0 },
+			{ 0x0077, 0x030A, 0 },
+			{ 0x0059, 0x030A, 0 },
+			{ 0x0079, 0x030A, 0 },
+			{ 0x0041, 0x02BE, 0 },
+			{ 0x0061, 0x02BE, 0 },
+			{ 0x03A5, 0x0313, 0 },
+			{ 0x03C5, 0x0313, 0 },
+			{ 0x03A5, 0x0313, 0x0300 },
+			{ 0x03C5, 0x0313, 0x0300 },
+			{ 0x03A5, 0x0313, 0x0301 },
+			{ 0x03C5, 0x0313, 0x0301 },
+			{ 0x03A5, 0x0313, 0x0342 },
+			{ 0x03C5, 0x0313, 0x0342 },
+			{ 0x1F08, 0x0399, 0 },
+			{ 0x1F00, 0x03B9, 0 },
+			{ 0x1F09, 0x0399, 0 },
+			{ 0x1F01, 0x03B9, 0 },
+			{ 0x1F0A, 0x0399, 0 },
+			{ 0x1F02, 0x03B9, 0 },
+			{ 0x1F0B, 0x0399, 0 },
+			{ 0x1F03, 0x03B9, 0 },
+			{ 0x1F0C, 0x0399, 0 },
+			{ 0x1F04, 0x03B9, 0 },
+			{ 0x1F0D, 0x0399, 0 },
+			{ 0x1F05, 0x03B9, 0 },
+			{ 0x1F0E, 0x0399, 0 },
+			{ 0x1F06, 0x03B9, 0 },
+			{ 0x1F0F, 0x0399, 0 },
+			{ 0x1F07, 0x03B9, 0 },
+			{ 0x1F28, 0x0399, 0 },
+			{ 0x1F20, 0x03B9, 0 },
+			{ 0x1F29, 0x0399, 0 },
+			{ 0x1F21, 0x03B9, 0 },
+			{ 0x1F2A, 0x0399, 0 },
+			{ 0x1F22, 0x03B9, 0 },
+			{ 0x1F2B, 0x0399, 0 },
+			{ 0x1F23, 0x03B9, 0 },
+			{ 0x1F2C, 0x0399, 0 },
+			{ 0x1F24, 0x03B9, 0 },
+			{ 0x1F2D, 0x0399, 0 },
+			{ 0x1F25, 0x03B9, 0 },
+			{ 0x1F2E, 0x0399, 0 },
+			{ 0x1F26, 0x03B9, 0 },
+			{ 0x1F2F, 0x0399, 0 },
+			{ 0x1F27, 0x03B9, 0 },
+			{ 0x1F68, 0x0399, 0 },
+			{ 0x1F60, 0x03B9, 0 },
+			{ 0x1F69, 0x0399, 0 },
+			{ 0x1F61, 0x03B9, 0 },
+			{ 0x1F6A, 0x0399, 0 },
+			{ 0x1F62, 0x03B9, 0 },
+			{ 0x1F6B, 0x0399, 0 },
+			{ 0x1F63, 0x03B9, 0 },
+			{ 0x1F6C, 0x0399, 0 },
+			{ 0x1F64, 0x03B9, 0 },
+			{ 0x1F6D, 0x0399, 0 },
+			{ 0x1F65, 0x03B9, 0 },
+			{ 0x1F6E, 0x0399, 0 },
+			{ 0x1F66, 0x03B9, 0 },
+			{ 0x1F6F, 0x0399, 0 },
+			{ 0x1F67, 0x03B9, 0 },
+			{ 0x1FBA, 0x0399, 0 },
+			{ 0x1F70, 0x03B9, 0 },
+			{ 0x0391, 0x0399, 0 },
+			{ 0x03B1, 0x03B9, 0 },
+			{ 0x0386, 0x0399, 0 },
+			{ 0x03AC, 0x03B9, 0 },
+			{ 0x0391, 0x0342, 0 },
+			{ 0x03B1, 0x0342, 0 },
+			{ 0x0391, 0x0342, 0x0399 },
+			{ 0x03B1, 0x0342, 0x03B9 },
+			{ 0x1FCA, 0x0399, 0 },
+			{ 0x1F74, 0x03B9, 0 },
+			{ 0x0397, 0x0399, 0 },
+			{ 0x03B7, 0x03B9, 0 },
+			{ 0x0389, 0x0399, 0 },
+			{ 0x03AE, 0x03B9, 0 },
+			{ 0x0397, 0x0342, 0 },
+			{ 0x03B7, 0x0342, 0 },
+			{ 0x0397, 0x0342, 0x0399 },
+			{ 0x03B7, 0x0342, 0x03B9 },
+			{ 0x0399, 0x0308, 0x0300 },
+			{ 0x03B9, 0x0308, 0x0300 },
+			{ 0x0399, 0x0342, 0 },
+			{ 0x03B9, 0x0342, 0 },
+			{ 0x0399, 0x0308, 0x0342 },
+			{ 0x03B9, 0x0308, 0x0342 },
+			{ 0x03A5, 0x0308, 0x0300 },
+			{ 0x03C5, 0x0308, 0x0300 },
+			{ 0x03A1, 0x0313, 0 },
+			{ 0x03C1, 0x0313, 0 },
+			{ 0x03A5, 0x0342, 0 },
+			{ 0x03C5, 0x0342, 0 },
+			{ 0x03A5, 0x0308, 0x0342 },
+			{ 0x03C5, 0x0308, 0x0342 },
+			{ 0x1FFA, 0x0399, 0 },
+			{ 0x1F7C, 0x03B9, 0 },
+			{ 0x03A9, 0x0399, 0 },
+			{ 0x03C9, 0x03B9, 0 },
+			{ 0x038F, 0x0399, 0 },
+			{ 0x03CE, 0x03B9, 0 },
+			{ 0x03A9, 0x0342, 0 },
+			{ 0x03C9, 0x0342, 0 },
+			{ 0x03A9, 0x0342, 0x0399 },
+			{ 0x03C9, 0x0342, 0x03B9 },
+			{ 0x0046, 0x0046, 0 },
+			{ 0x0066, 0x0066, 0 },
+			{ 0x0046, 0x0049, 0 },
+			{ 0x0066, 0x0069, 0 },
+			{ 0x0046, 0x004C, 0 },
+			{ 0x0066, 0x006C, 0 },
+			{ 0x0046, 0x0046, 0x0049 },
+			{ 0x0066, 0x0066, 0x0069 },
+			{ 0x0046, 0x0046, 0x004C },
+			{ 0x0066, 0x0066, 0x006C },
+			{ 0x0053, 0x0054, 0 },
+			{ 0x0073, 0x0074, 0 },
+			{ 0x0544, 0x0546, 0 },
+			{ 0x0574, 0x0576, 0 },
+			{ 0x0544, 0x0535, 0 },
+			{ 0x0574, 0x0565, 0 },
+			{ 0x0544, 0x053B, 0 },
+			{ 0x0574, 0x056B, 0 },
+			{ 0x054E, 0x0546, 0 },
+			{ 0x057E, 0x0576, 0 },
+			{ 0x0544, 0x053D, 0 },
+			{ 0x0574, 0x056D, 0 },
+		}};
+	}
+}
@@ -1,6 +1,7 @@
 
 #include "codeunit_sequence.h"
 #include <algorithm>
+#include <cstring>
 #include "common/basic_types.h"
 #include "common/adapters.h"
 #include "common/functions.h"
@@ -306,6 +307,56 @@ namespace ostr
 		return this->view() != codeunit_sequence_view(rhs);
 	}
 
+	bool codeunit_sequence::operator<(const codeunit_sequence_view& rhs) const noexcept
+	{
+		return this->compare(rhs) < 0;
+	}
+
+	bool codeunit_sequence::operator<(const codeunit_sequence& rhs) const noexcept
+	{
+		return this->compare(rhs) < 0;
+	}
+
+	bool codeunit_sequence::operator>(const codeunit_sequence_view& rhs) const noexcept
+	{
+		return this->compare(rhs) > 0;
+	}
+
+	bool codeunit_sequence::operator>(const codeunit_sequence& rhs) const noexcept
+	{
+		return this->compare(rhs) > 0;
+	}
+
+	bool codeunit_sequence::operator<=(const codeunit_sequence_view& rhs) const noexcept
+	{
+		return this->compare(rhs) <= 0;
+	}
+
+	bool codeunit_sequence::operator<=(const codeunit_sequence& rhs) const noexcept
+	{
+		return this->compare(rhs) <= 0;
+	}
+
+	bool codeunit_sequence::operator>=(const codeunit_sequence_view& rhs) const noexcept
+	{
+		return this->compare(rhs) >= 0;
+	}
+
+	bool codeunit_sequence::operator>=(const codeunit_sequence& rhs) const noexcept
+	{
+		return this->compare(rhs) >= 0;
+	}
+
+	i32 codeunit_sequence::compare(const codeunit_sequence_view& rhs) const noexcept
+	{
+		return this->view().compare(rhs);
+	}
+
+	i32 codeunit_sequence::compare(const codeunit_sequence& rhs) const noexcept
+	{
+		return this->view().compare(rhs.view());
+	}
+
 	codeunit_sequence& codeunit_sequence::append(const codeunit_sequence_view& rhs) noexcept
 	{
 		if(rhs.is_empty())
@@ -793,6 +844,64 @@ namespace ostr
 		other.empty();
 	}
 
+	namespace details
+	{
+		static constexpr u64 CODEUNIT_CHUNK_CAPACITY_MINIMUM = 4096;
+		static constexpr u64 CODEUNIT_CHUNK_CAPACITY_MAXIMUM = 1 << 24;
+
+		codeunit_chunk_list::~codeunit_chunk_list() noexcept
+		{
+			chunk* c = this->first_;
+			while(c)
+			{
+				chunk* next = c->next;
+				allocator<byte>::deallocate_array(reinterpret_cast<byte*>(c));
+				c = next;
+			}
+		}
+
+		void codeunit_chunk_list::append_chunks(const codeunit_sequence_view& view) noexcept
+		{
+			const char* source = view.data();
+			u64 rest = view.size();
+			while(rest > 0)
+			{
+				if(!this->last_ || this->last_->size == this->last_->capacity)
+				{
+					// Each chunk doubles the one before, so the count of chunks is logarithmic.
+					const u64 capacity = this->last_ ? minimum(this->last_->capacity * 2, CODEUNIT_CHUNK_CAPACITY_MAXIMUM) : CODEUNIT_CHUNK_CAPACITY_MINIMUM;
+					chunk* created = reinterpret_cast<chunk*>(allocator<byte>::allocate_array(sizeof(chunk) + capacity));
+					*created = chunk{ nullptr, 0, capacity };
+					if(this->last_)
+						this->last_->next = created;
+					else
+						this->first_ = created;
+					this->last_ = created;
+				}
+				const u64 count = minimum(rest, this->last_->capacity - this->last_->size);
+				std::memcpy(chunk_data(this->last_) + this->last_->size, source, count);
+				this->last_->size += count;
+				source += count;
+				rest -= count;
+			}
+			this->size_ += view.size();
+		}
+
+		u64 codeunit_chunk_list::size() const noexcept
+		{
+			return this->size_;
+		}
+
+		void codeunit_chunk_list::copy_to(char* destination) const noexcept
+		{
+			for(chunk* c = this->first_; c; c = c->next)
+			{
+				std::memcpy(destination, chunk_data(c), c->size);
+				destination += c->size;
+			}
+		}
+	}
+
 	bool operator==(const codeunit_sequence_view& lhs, const codeunit_sequence& rhs) noexcept
 	{
 		return rhs == lhs;
@@ -0,0 +1,143 @@
+
+#include "deferred_format.h"
+
+namespace ostr
+{
+    namespace details
+    {
+        // The first word of a record is its size, the second word is its render function.
+        static constexpr u64 DEFERRED_RECORD_HEADER_SIZE = 2 * sizeof(u64);
+
+        static_assert(std::atomic<u64>::is_always_lock_free, "Deferred records require lock-free 64-bit atomics!");
+        static_assert(sizeof(std::atomic<u64>) == sizeof(u64), "Deferred records require atomics of the same size as words!");
+
+        [[nodiscard]] constexpr u64 align_deferred_record(const u64 size) noexcept
+        {
+            return (size + deferred_format_queue::RECORD_ALIGNMENT - 1) & ~(deferred_format_queue::RECORD_ALIGNMENT - 1);
+        }
+
+        [[nodiscard]] constexpr u64 round_up_power_of_2(const u64 value) noexcept
+        {
+            u64 result = 1;
+            while(result < value)
+                result <<= 1;
+            return result;
+        }
+    }
+
+    // code-region-start: constructors
+
+    deferred_format_queue::deferred_format_queue(const u64 capacity, const deferred_producer_mode producer_mode, const deferred_overflow_policy overflow_policy) noexcept
+        : capacity_(details::round_up_power_of_2(maximum(capacity, details::DEFERRED_RECORD_HEADER_SIZE * 4)))
+        , producer_mode_(producer_mode)
+        , overflow_policy_(overflow_policy)
+    {
+        // Value initialization zeroes every word, so no record is committed at first.
+        this->words_ = new std::atomic<u64>[this->capacity_ / sizeof(u64)]();
+    }
+
+    deferred_format_queue::~deferred_format_queue() noexcept
+    {
+        delete[] this->words_;
+    }
+
+    // code-region-end: constructors
+
+    u64 deferred_format_queue::render(format_sink& sink) noexcept
+    {
+        const u64 mask = this->capacity_ - 1;
+        u64 position = this->read_position_.load(std::memory_order_relaxed);
+        u64 count = 0;
+        for(;;)
+        {
+            const u64 offset = position & mask;
+            std::atomic<u64>& size_word = this->word_at(offset);
+            const u64 size = size_word.load(std::memory_order_acquire);
+            // Not pushed yet, or still being written by a producer.
+            if(size == 0)
+                break;
+            const u64 render_word = this->word_at(offset + sizeof(u64)).load(std::memory_order_relaxed);
+            if(render_word != 0)
+            {
+                details::deferred_render_function_type render_function = nullptr;
+                std::memcpy(&render_function, &render_word, sizeof(render_function));
+                render_function(sink, reinterpret_cast<const byte*>(this->words_) + offset + details::DEFERRED_RECORD_HEADER_SIZE);
+                ++count;
+            }
+            // Any word is possibly the size of a later record, so the whole record is cleared before it is released.
+            for(u64 word_offset = offset; word_offset < offset + size; word_offset += sizeof(u64))
+                this->word_at(word_offset).store(0, std::memory_order_relaxed);
+            position += size;
+            this->read_position_.store(position, std::memory_order_release);
+        }
+        return count;
+    }
+
+    u64 deferred_format_queue::dropped() const noexcept
+    {
+        return this->dropped_.load(std::memory_order_relaxed);
+    }
+
+    u64 deferred_format_queue::capacity() const noexcept
+    {
+        return this->capacity_;
+    }
+
+    bool deferred_format_queue::reserve(const u64 argument_size, record_reservation& reservation) noexcept
+    {
+        const u64 size = details::align_deferred_record(details::DEFERRED_RECORD_HEADER_SIZE + argument_size);
+        if(size > this->capacity_ / 2)
+        {
+            // Never fits, even if the queue is empty, so it is dropped whatever the policy is.
+            this->dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        const u64 mask = this->capacity_ - 1;
+        u64 position = this->write_position_.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            // A record is never split at the end of the buffer, the tail is skipped by a padding record instead.
+            const u64 tail = this->capacity_ - (position & mask);
+            const bool fits_tail = size <= tail;
+            const u64 step = fits_tail ? size : tail;
+            if(position + step - this->read_position_.load(std::memory_order_acquire) > this->capacity_)
+            {
+                if(this->overflow_policy_ == deferred_overflow_policy::drop)
+                {
+                    this->dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                std::this_thread::yield();
+                position = this->write_position_.load(std::memory_order_relaxed);
+                continue;
+            }
+            if(this->producer_mode_ == deferred_producer_mode::single)
+                this->write_position_.store(position + step, std::memory_order_relaxed);
+            else if(!this->write_position_.compare_exchange_weak(position, position + step, std::memory_order_relaxed))
+                continue;
+            if(fits_tail)
+                break;
+            // A padding record has no render function, the consumer skips it.
+            this->word_at(position & mask).store(step, std::memory_order_release);
+            position += step;
+        }
+        reservation.offset = position & mask;
+        reservation.size = size;
+        reservation.arguments = reinterpret_cast<byte*>(this->words_) + reservation.offset + details::DEFERRED_RECORD_HEADER_SIZE;
+        return true;
+    }
+
+    void deferred_format_queue::commit(const record_reservation& reservation, const details::deferred_render_function_type render_function) noexcept
+    {
+        u64 render_word = 0;
+        std::memcpy(&render_word, &render_function, sizeof(render_function));
+        this->word_at(reservation.offset + sizeof(u64)).store(render_word, std::memory_order_relaxed);
+        // Release the arguments written with the size, which the consumer acquires.
+        this->word_at(reservation.offset).store(reservation.size, std::memory_order_release);
+    }
+
+    std::atomic<u64>& deferred_format_queue::word_at(const u64 offset) const noexcept
+    {
+        return this->words_[offset / sizeof(u64)];
+    }
+}
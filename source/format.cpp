@@ -3,337 +3,722 @@
 #include "format.h"
 #include "text.h"
 
+#include <algorithm>
+#include <limits>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
 namespace ostr
 {
     namespace details
     {
-        [[nodiscard]] constexpr u64 get_integer_digit_count(const i64 value, const i64 base)
+        /// @return count of significant bits of value, 0 for 0
+        [[nodiscard]] inline u64 get_bit_width(const u64 value) noexcept
         {
             if(value == 0)
-                return 1;
-            i64 remaining = value;
-            u64 count = 0;
-            while(remaining != 0)
+                return 0;
+#if _WIN64
+            unsigned long index = 0;
+            _BitScanReverse64(&index, value);
+            return static_cast<u64>(index) + 1;
+#else
+            return 64 - static_cast<u64>(__builtin_clzll(value));
+#endif
+        }
+
+        static constexpr std::array<u64, 20> POWERS_OF_10
+        {
+            1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+            10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+            1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+        };
+
+        [[nodiscard]] inline u64 get_decimal_digit_count(const u64 value) noexcept
+        {
+            // log10(2) is about 1233 / 4096, which approximates the digit count from the bit width,
+            // and one comparison corrects the approximation.
+            const u64 approximation = (get_bit_width(value | 1) * 1233) >> 12;
+            return approximation + 1 - static_cast<u64>(value < POWERS_OF_10[approximation]);
+        }
+
+        /// @return count of bits of each digit of base 2, 8 or 16, 0 for other bases
+        [[nodiscard]] constexpr u64 get_digit_bit_count(const u64 base) noexcept
+        {
+            switch (base)
             {
-                remaining /= base;
-                ++count;
+            case 2:
+                return 1;
+            case 8:
+                return 3;
+            case 16:
+                return 4;
+            default:
+                return 0;
             }
-            return count;
         }
-        
-        [[nodiscard]] constexpr u64 get_integer_digit_count(const u64 value, const u64 base)
+
+        [[nodiscard]] inline u64 get_integer_digit_count(const u64 value, const u64 base) noexcept
         {
-            if(value == 0)
-                return 1;
+            if(const u64 bit_count = get_digit_bit_count(base); bit_count != 0)
+                return maximum(get_bit_width(value) + bit_count - 1, bit_count) / bit_count;
+            return get_decimal_digit_count(value);
+        }
+
+        static constexpr char DIGITS[] = "0123456789abcdef";
+
+        static constexpr char DECIMAL_DIGIT_PAIRS[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        // Digits are written backward from the end of a buffer on stack, large enough for 64 binary digits.
+        static constexpr u64 INTEGER_DIGITS_CAPACITY = 64;
+
+        /**
+         * @param last end of the buffer to write digits into
+         * @param value value to write
+         * @param base base of digits
+         * @return first digit written
+         */
+        [[nodiscard]] char* write_integer_digits(char* last, const u64 value, const u64 base) noexcept
+        {
+            char* first = last;
             u64 remaining = value;
-            u64 count = 0;
-            while(remaining != 0)
+            if(const u64 bit_count = get_digit_bit_count(base); bit_count != 0)
+            {
+                const u64 mask = base - 1;
+                do
+                {
+                    *--first = DIGITS[remaining & mask];
+                    remaining >>= bit_count;
+                }
+                while(remaining != 0);
+                return first;
+            }
+            while(remaining >= 100)
             {
-                remaining /= base;
-                ++count;
+                const u64 pair = (remaining % 100) * 2;
+                remaining /= 100;
+                first -= 2;
+                first[0] = DECIMAL_DIGIT_PAIRS[pair];
+                first[1] = DECIMAL_DIGIT_PAIRS[pair + 1];
             }
-            return count;
+            if(remaining >= 10)
+            {
+                const u64 pair = remaining * 2;
+                first -= 2;
+                first[0] = DECIMAL_DIGIT_PAIRS[pair];
+                first[1] = DECIMAL_DIGIT_PAIRS[pair + 1];
+            }
+            else
+            {
+                *--first = DIGITS[remaining];
+            }
+            return first;
         }
 
-        [[nodiscard]] constexpr char from_digit(const u64 digit)
-        {
-            constexpr char digits[] = "0123456789abcdef";
-            return digits[digit];
-        }
-    
-        codeunit_sequence format_integer(const u64& value, const codeunit_sequence_view& specification)
+        struct integer_specification
         {
             char type = 'd';
             char holder = '0';
             u64 holding = global_constant::SIZE_INVALID;
             bool with_prefix = false;
-            if (!specification.is_empty())
+
+            [[nodiscard]] u64 base() const noexcept
             {
-                codeunit_sequence_view parsing = specification;
-                if ("bcdox"_cuqv.contains(parsing.read_from_last(0)))
+                switch (this->type)
                 {
-                    type = parsing.read_from_last(0);
-                    parsing = parsing.subview(0, parsing.size() - 1);
+                case 'b':
+                    return 2;
+                case 'o':
+                    return 8;
+                case 'x':
+                    return 16;
+                default:
+                    return 10;
                 }
-                if(!parsing.is_empty())
-                {
-                    if(const u64 holder_index = parsing.index_of_any("0 "_cuqv); holder_index != global_constant::INDEX_INVALID)
-                    {
-                        holder = parsing.read_at(holder_index);
-                        const codeunit_sequence_view holding_view = parsing.subview(holder_index + 1);
-                        const auto [ last, error ] = std::from_chars(holding_view.data(), holding_view.cend().data(), holding);
-                        OPEN_STRING_CHECK(last == holding_view.cend().data(), "Invalid format specification [{}]!", specification);
-                        parsing = parsing.subview(0, holder_index);
-                    }
-                }
-                if(!parsing.is_empty())
-                {
-                    if(parsing.read_from_last(0) == '#')
-                    {
-                        with_prefix = true;
-                        parsing = parsing.subview(0, parsing.size() - 1);
-                    }
-                }
-                OPEN_STRING_CHECK(parsing.is_empty(), "Invalid format specification [{}]!", specification);
             }
-            u64 base = 10;
-            codeunit_sequence_view prefix;
-            switch (type)
+
+            [[nodiscard]] codeunit_sequence_view prefix() const noexcept
             {
-            case 'b':
+                if(!this->with_prefix)
+                    return ""_cuqv;
+                switch (this->type)
                 {
-                    base = 2;
-                    prefix = "0b"_cuqv;
+                case 'b':
+                    return "0b"_cuqv;
+                case 'o':
+                    return "0o"_cuqv;
+                case 'x':
+                    return "0x"_cuqv;
+                default:
+                    return ""_cuqv;
                 }
-                break;
-            case 'c':
+            }
+
+            /**
+             * @param digit_count count of digits of the value
+             * @return count of holders to fill before digits
+             */
+            [[nodiscard]] u64 get_holder_count(const u64 digit_count) const noexcept
+            {
+                if(this->holding == global_constant::SIZE_INVALID)
+                    return 0;
+                return maximum(this->holding, digit_count) - digit_count;
+            }
+        };
+
+        /**
+         * @param specification specification like "#016x"
+         * @param holders code units allowed to fill before digits
+         */
+        [[nodiscard]] integer_specification parse_integer_specification(const codeunit_sequence_view& specification, const codeunit_sequence_view& holders)
+        {
+            integer_specification result;
+            if (specification.is_empty())
+                return result;
+            codeunit_sequence_view parsing = specification;
+            if ("bcdox"_cuqv.contains(parsing.read_from_last(0)))
+            {
+                result.type = parsing.read_from_last(0);
+                parsing = parsing.subview(0, parsing.size() - 1);
+            }
+            if(!parsing.is_empty())
+            {
+                if(const u64 holder_index = parsing.index_of_any(holders); holder_index != global_constant::INDEX_INVALID)
                 {
-                    codeunit_sequence result;
-                    result.append(static_cast<char>(value));
-                    return result;
+                    result.holder = parsing.read_at(holder_index);
+                    const codeunit_sequence_view holding_view = parsing.subview(holder_index + 1);
+                    const auto [ last, error ] = std::from_chars(holding_view.data(), holding_view.cend().data(), result.holding);
+                    OPEN_STRING_CHECK(last == holding_view.cend().data(), "Invalid format specification [{}]!", specification);
+                    parsing = parsing.subview(0, holder_index);
                 }
-            case 'd':
-                break;
-            case 'o':
+            }
+            if(!parsing.is_empty())
+            {
+                if(parsing.read_from_last(0) == '#')
                 {
-                    base = 8;
-                    prefix = "0o"_cuqv;
+                    result.with_prefix = true;
+                    parsing = parsing.subview(0, parsing.size() - 1);
                 }
-                break;
-            case 'x':
+            }
+            OPEN_STRING_CHECK(parsing.is_empty(), "Invalid format specification [{}]!", specification);
+            return result;
+        }
+
+        [[nodiscard]] u64 get_integer_magnitude(const i64 value) noexcept
+        {
+            // Negate in unsigned to keep the minimum value correct.
+            return value >= 0 ? static_cast<u64>(value) : 0 - static_cast<u64>(value);
+        }
+
+        void format_integer(format_sink& sink, const u64& value, const codeunit_sequence_view& specification)
+        {
+            const integer_specification parsed = parse_integer_specification(specification, "0 "_cuqv);
+            if(parsed.type == 'c')
+            {
+                sink.append(static_cast<char>(value));
+                return;
+            }
+            std::array<char, INTEGER_DIGITS_CAPACITY> digits;
+            const char* last = digits.data() + digits.size();
+            const char* first = write_integer_digits(digits.data() + digits.size(), value, parsed.base());
+            const u64 digit_count = static_cast<u64>(last - first);
+            sink
+            .append(parsed.prefix())
+            .append(parsed.holder, parsed.get_holder_count(digit_count))
+            .append({ first, digit_count });
+        }
+
+        void format_integer(format_sink& sink, const i64& value, const codeunit_sequence_view& specification)
+        {
+            const integer_specification parsed = parse_integer_specification(specification, "0"_cuqv);
+            if(parsed.type == 'c')
+            {
+                sink.append(static_cast<char>(value));
+                return;
+            }
+            std::array<char, INTEGER_DIGITS_CAPACITY> digits;
+            const char* last = digits.data() + digits.size();
+            const char* first = write_integer_digits(digits.data() + digits.size(), get_integer_magnitude(value), parsed.base());
+            const u64 digit_count = static_cast<u64>(last - first);
+            sink
+            .append(value < 0 ? "-"_cuqv : ""_cuqv)
+            .append(parsed.prefix())
+            .append('0', parsed.get_holder_count(digit_count))
+            .append({ first, digit_count });
+        }
+
+        u64 measure_integer(const u64& value, const codeunit_sequence_view& specification)
+        {
+            const integer_specification parsed = parse_integer_specification(specification, "0 "_cuqv);
+            if(parsed.type == 'c')
+                return 1;
+            const u64 digit_count = get_integer_digit_count(value, parsed.base());
+            return parsed.prefix().size() + parsed.get_holder_count(digit_count) + digit_count;
+        }
+
+        u64 measure_integer(const i64& value, const codeunit_sequence_view& specification)
+        {
+            const integer_specification parsed = parse_integer_specification(specification, "0"_cuqv);
+            if(parsed.type == 'c')
+                return 1;
+            const u64 digit_count = get_integer_digit_count(get_integer_magnitude(value), parsed.base());
+            const u64 sign_size = value < 0 ? 1 : 0;
+            return sign_size + parsed.prefix().size() + parsed.get_holder_count(digit_count) + digit_count;
+        }
+
+        struct float_specification
+        {
+            // 'e', 'f', 'g' or 'a', or 0 for the shortest representation.
+            char type = 0;
+            u64 precision = global_constant::SIZE_INVALID;
+
+            [[nodiscard]] bool has_precision() const noexcept
+            {
+                return this->precision != global_constant::SIZE_INVALID;
+            }
+        };
+
+        /**
+         * @param specification specification like ".3f"
+         */
+        [[nodiscard]] float_specification parse_float_specification(const codeunit_sequence_view& specification)
+        {
+            float_specification result;
+            if (specification.is_empty())
+                return result;
+            codeunit_sequence_view parsing = specification;
+            if("aefg"_cuqv.contains( parsing.read_from_last(0) ))
+            {    
+                result.type = parsing.read_from_last(0);
+                parsing = parsing.subview(0, parsing.size() - 1);
+            }
+            if(!parsing.is_empty())
+            {
+                if(const u64 dot_index = parsing.index_of('.'); dot_index != global_constant::INDEX_INVALID)
                 {
-                    base = 16;
-                    prefix = "0x"_cuqv;
+                    const codeunit_sequence_view precision_view = parsing.subview(dot_index + 1);
+                    const auto [ last, error ] = std::from_chars(precision_view.data(), precision_view.cend().data(), result.precision);
+                    OPEN_STRING_CHECK(last == precision_view.cend().data(), "Invalid format specification [{}]!", specification);
+                    parsing = parsing.subview(0, dot_index);
                 }
-                break;
+            }
+            OPEN_STRING_CHECK(parsing.is_empty(), "Invalid format specification [{}]!", specification);
+            // Precision without a type keeps digits after the dot.
+            if(result.type == 0 && result.has_precision())
+                result.type = 'f';
+            return result;
+        }
+
+        [[nodiscard]] constexpr std::chars_format get_chars_format(const char type) noexcept
+        {
+            switch (type)
+            {
+            case 'a':
+                return std::chars_format::hex;
+            case 'e':
+                return std::chars_format::scientific;
+            case 'f':
+                return std::chars_format::fixed;
             default:
-                break;
+                return std::chars_format::general;
             }
-            if(!with_prefix)
-                prefix = ""_cuqv;
-        
-            const u64 digit_count = get_integer_digit_count(value, base);
-            const u64 preserve = holding == global_constant::SIZE_INVALID ? digit_count : maximum(holding, digit_count);
-            const u64 holder_count = preserve - digit_count;
-            codeunit_sequence result( prefix.size() + preserve );
-            result
-            .append(prefix)
-            .append(holder, holder_count);
-            u64 remaining = value;
-            for(u64 i = 0; i < digit_count; ++i)
+        }
+
+        // Floating to_chars is missing from some standard libraries, like libc++ on macOS before 13.3,
+        // so floats are written by snprintf, and the shortest digits are found by reading them back.
+        // It is compiled everywhere, so tests compare it with to_chars.
+
+        // Precision of "%g" if none is given.
+        static constexpr i64 GENERAL_DEFAULT_PRECISION = 6;
+
+        /**
+         * \brief Shortest significant digits which read back to a magnitude, like "15" with exponent 2 for 150.
+         */
+        struct shortest_float_digits
+        {
+            std::array<char, 24> digits{ };
+            u64 count = 0;
+            // Decimal exponent of the first digit.
+            i64 exponent = 0;
+        };
+
+        template<class T>
+        [[nodiscard]] shortest_float_digits find_shortest_float_digits(const T magnitude) noexcept
+        {
+            std::array<char, 40> buffer;
+            // snprintf and strtod agree on the decimal point of the current locale.
+            const auto reads_back = [&buffer, magnitude](const int precision)
             {
-                const char digit = from_digit(remaining % base); 
-                remaining /= base;
-                result.append(digit);
+                std::snprintf(buffer.data(), buffer.size(), "%.*e", precision, static_cast<f64>(magnitude));
+                if constexpr (std::is_same_v<T, f32>)
+                    return std::strtof(buffer.data(), nullptr) == magnitude;
+                else
+                    return std::strtod(buffer.data(), nullptr) == magnitude;
+            };
+            // Digits which read back keep reading back with one more digit, which is as close at least,
+            // so the shortest is bisected in 5 rounds at most, and max_digits10 digits always read back.
+            int lower = 0;
+            int upper = std::numeric_limits<T>::max_digits10 - 1;
+            while(lower < upper)
+            {
+                const int middle = (lower + upper) / 2;
+                if(reads_back(middle))
+                    upper = middle;
+                else
+                    lower = middle + 1;
+            }
+            std::snprintf(buffer.data(), buffer.size(), "%.*e", upper, static_cast<f64>(magnitude));
+            // Digits like "1.50e+02", whose decimal point is of the current locale.
+            shortest_float_digits result;
+            const char* cursor = buffer.data();
+            for(; *cursor != 'e'; ++cursor)
+            {
+                if(*cursor >= '0' && *cursor <= '9')
+                    result.digits[result.count++] = *cursor;
             }
-            result.reverse();
+            result.exponent = std::strtol(cursor + 1, nullptr, 10);
+            while(result.count > 1 && result.digits[result.count - 1] == '0')
+                --result.count;
             return result;
         }
 
-        codeunit_sequence format_integer(const i64& value, const codeunit_sequence_view& specification)
+        [[nodiscard]] u64 get_scientific_size(const shortest_float_digits& shortest) noexcept
         {
-            char type = 'd';
-            u64 holding = global_constant::SIZE_INVALID;
-            bool with_prefix = false;
-            if (!specification.is_empty())
+            const u64 exponent_magnitude = static_cast<u64>(shortest.exponent < 0 ? -shortest.exponent : shortest.exponent);
+            const u64 exponent_digit_count = exponent_magnitude >= 100 ? 3 : 2;
+            return shortest.count + (shortest.count > 1 ? 1 : 0) + 2 + exponent_digit_count;
+        }
+
+        [[nodiscard]] u64 get_fixed_size(const shortest_float_digits& shortest) noexcept
+        {
+            if(shortest.exponent < 0)
+                return 2 + static_cast<u64>(-shortest.exponent - 1) + shortest.count;
+            const u64 integer_digit_count = static_cast<u64>(shortest.exponent) + 1;
+            return shortest.count > integer_digit_count ? shortest.count + 1 : integer_digit_count;
+        }
+
+        // Like "1.5e+02", with at least 2 digits of exponent.
+        [[nodiscard]] char* write_scientific_digits(char* cursor, const shortest_float_digits& shortest) noexcept
+        {
+            *cursor++ = shortest.digits[0];
+            if(shortest.count > 1)
             {
-                codeunit_sequence_view parsing = specification;
-                if ("bcdox"_cuqv.contains(parsing.read_from_last(0)))
-                {
-                    type = parsing.read_from_last(0);
-                    parsing = parsing.subview(0, parsing.size() - 1);
-                }
-                if(!parsing.is_empty())
+                *cursor++ = '.';
+                cursor = std::copy_n(shortest.digits.data() + 1, shortest.count - 1, cursor);
+            }
+            *cursor++ = 'e';
+            *cursor++ = shortest.exponent < 0 ? '-' : '+';
+            const u64 exponent_magnitude = static_cast<u64>(shortest.exponent < 0 ? -shortest.exponent : shortest.exponent);
+            if(exponent_magnitude >= 100)
+                *cursor++ = static_cast<char>('0' + exponent_magnitude / 100);
+            *cursor++ = static_cast<char>('0' + exponent_magnitude / 10 % 10);
+            *cursor++ = static_cast<char>('0' + exponent_magnitude % 10);
+            return cursor;
+        }
+
+        // Like "1.5" or "0.015", of digits which are not all in the integer part.
+        [[nodiscard]] char* write_fixed_digits(char* cursor, const shortest_float_digits& shortest) noexcept
+        {
+            if(shortest.exponent < 0)
+            {
+                *cursor++ = '0';
+                *cursor++ = '.';
+                cursor = std::fill_n(cursor, static_cast<u64>(-shortest.exponent - 1), '0');
+                return std::copy_n(shortest.digits.data(), shortest.count, cursor);
+            }
+            const u64 integer_digit_count = static_cast<u64>(shortest.exponent) + 1;
+            cursor = std::copy_n(shortest.digits.data(), integer_digit_count, cursor);
+            *cursor++ = '.';
+            return std::copy_n(shortest.digits.data() + integer_digit_count, shortest.count - integer_digit_count, cursor);
+        }
+
+        template<class T>
+        [[nodiscard]] char* write_printed_float(char* first, char* last, const T value, const char type, const u64 precision) noexcept
+        {
+            std::array<char, 6> conversion{ '%', '.', '*', type, 0, 0 };
+            if(precision == global_constant::SIZE_INVALID)
+                conversion = { '%', type, 0, 0, 0, 0 };
+            const u64 capacity = static_cast<u64>(last - first);
+            const int written = precision == global_constant::SIZE_INVALID ?
+                std::snprintf(first, capacity, conversion.data(), static_cast<f64>(value)) :
+                std::snprintf(first, capacity, conversion.data(), static_cast<int>(precision), static_cast<f64>(value));
+            // snprintf needs a code unit for the terminator.
+            if(written < 0 || static_cast<u64>(written) >= capacity)
+                return nullptr;
+            char* cursor = first + written;
+            // Like parse_floating, the decimal point of the current locale is replaced, which may be several code units.
+            const char* decimal_point = std::localeconv()->decimal_point;
+            if(const u64 point_size = std::strlen(decimal_point); point_size != 1 || *decimal_point != '.')
+            {
+                if(char* const point = std::search(first, cursor, decimal_point, decimal_point + point_size); point != cursor)
                 {
-                    if(const u64 zero_index = parsing.index_of('0'); zero_index != global_constant::INDEX_INVALID)
-                    {
-                        const codeunit_sequence_view holding_view = parsing.subview(zero_index + 1);
-                        const auto [ last, error ] = std::from_chars(holding_view.data(), holding_view.cend().data(), holding);
-                        OPEN_STRING_CHECK(last == holding_view.cend().data(), "Invalid format specification [{}]!", specification);
-                        parsing = parsing.subview(0, zero_index);
-                    }
+                    *point = '.';
+                    cursor = std::copy(point + point_size, cursor, point + 1);
                 }
-                if(!parsing.is_empty())
+            }
+            if(type == 'a')
+            {
+                // Hexadecimal floats are written without "0x", like to_chars.
+                char* const prefix = std::find(first, cursor, '0');
+                cursor = std::copy(prefix + 2, cursor, prefix);
+            }
+            return cursor;
+        }
+
+        template<class T>
+        [[nodiscard]] char* write_shortest_float(char* first, char* last, const T value, const char type) noexcept
+        {
+            const shortest_float_digits shortest = find_shortest_float_digits(std::abs(value));
+            bool scientific = type == 'e';
+            if(type == 0)
+                scientific = get_scientific_size(shortest) < get_fixed_size(shortest);
+            else if(type == 'g')
+                // to_chars chooses the style of general like "%g" with its default precision P of 6,
+                // which is scientific if the exponent X is less than -4 or not less than P.
+                scientific = shortest.exponent < -4 || shortest.exponent >= GENERAL_DEFAULT_PRECISION;
+            // Whole numbers are written with their exact digits, which are as short and closest to the value.
+            if(!scientific && shortest.exponent >= 0 && shortest.count <= static_cast<u64>(shortest.exponent) + 1)
+                return write_printed_float(first, last, value, 'f', 0);
+            const u64 sign_size = std::signbit(value) ? 1 : 0;
+            const u64 size = sign_size + (scientific ? get_scientific_size(shortest) : get_fixed_size(shortest));
+            if(size > static_cast<u64>(last - first))
+                return nullptr;
+            char* cursor = first;
+            if(sign_size)
+                *cursor++ = '-';
+            return scientific ? write_scientific_digits(cursor, shortest) : write_fixed_digits(cursor, shortest);
+        }
+
+        template<class T>
+        [[nodiscard]] char* write_portable_float(char* first, char* last, const T value, const char type, const u64 precision) noexcept
+        {
+            if(precision == global_constant::SIZE_INVALID && type != 'a')
+                return write_shortest_float(first, last, value, type);
+            return write_printed_float(first, last, value, type, precision);
+        }
+
+        /**
+         * \brief Write a float like std::to_chars, in the shortest representation if there is no precision.
+         * \param type 'e', 'f', 'g' or 'a', or 0 for the shortest representation
+         * \return end of the code units written, or nullptr if they do not fit
+         */
+        template<class T>
+        [[nodiscard]] char* write_float(char* first, char* last, const T value, const char type, const u64 precision) noexcept
+        {
+#if defined(__cpp_lib_to_chars)
+            std::to_chars_result written;
+            if(type == 0)
+                written = std::to_chars(first, last, value);
+            else if(precision == global_constant::SIZE_INVALID)
+                written = std::to_chars(first, last, value, get_chars_format(type));
+            else
+                written = std::to_chars(first, last, value, get_chars_format(type), static_cast<int>(precision));
+            return written.ec == std::errc{ } ? written.ptr : nullptr;
+#else
+            return write_portable_float(first, last, value, type, precision);
+#endif
+        }
+
+        /**
+         * @return decimal exponent of the leading digit of value, or an upper bound of it
+         */
+        template<class T>
+        [[nodiscard]] i64 get_decimal_exponent_bound(const T value, const bool upper) noexcept
+        {
+            if(value == 0)
+                return 0;
+            int binary_exponent = 0;
+            std::frexp(value, &binary_exponent);
+            // value is in [2^(e-1), 2^e), and log10(2) is less than 0.30103.
+            const f64 exponent = static_cast<f64>(upper ? binary_exponent : binary_exponent - 1) * 0.30103;
+            return static_cast<i64>(std::floor(exponent)) + (upper ? 1 : -1);
+        }
+
+        template<class T>
+        [[nodiscard]] u64 measure_floating(const T& value, const float_specification& parsed)
+        {
+            // Sign, leading digit, dot, 'e', sign of exponent and at most 3 digits of exponent.
+            static constexpr u64 max_scientific_extra_size = 8;
+            // Shortest significant digits to round trip, 17 for f64 and 9 for f32.
+            static constexpr u64 max_shortest_digit_count = std::numeric_limits<T>::max_digits10;
+            // Hexadecimal digits of the mantissa after the dot, 13 for f64 and 6 for f32.
+            static constexpr u64 max_hex_digit_count = (std::numeric_limits<T>::digits + 2) / 4;
+            switch (parsed.type)
+            {
+            case 'a':
+                return (parsed.has_precision() ? parsed.precision : max_hex_digit_count) + max_scientific_extra_size + 1;
+            case 'f':
                 {
-                    if(parsing.read_from_last(0) == '#')
+                    const T magnitude = std::abs(value);
+                    const i64 upper_exponent = get_decimal_exponent_bound(magnitude, true);
+                    const u64 integer_digit_count = upper_exponent > 0 ? static_cast<u64>(upper_exponent) + 1 : 1;
+                    u64 fraction_digit_count = parsed.precision;
+                    if(!parsed.has_precision())
                     {
-                        with_prefix = true;
-                        parsing = parsing.subview(0, parsing.size() - 1);
+                        const i64 lower_exponent = get_decimal_exponent_bound(magnitude, false);
+                        const i64 fraction_digit_bound = static_cast<i64>(max_shortest_digit_count) - lower_exponent;
+                        fraction_digit_count = fraction_digit_bound > 0 ? static_cast<u64>(fraction_digit_bound) : 0;
                     }
+                    return 1 + integer_digit_count + 1 + fraction_digit_count;
                 }
-                OPEN_STRING_CHECK(parsing.is_empty(), "Invalid format specification [{}]!", specification);
+            default:
+                return (parsed.has_precision() ? parsed.precision : max_shortest_digit_count) + max_scientific_extra_size;
             }
-            i64 base = 10;
-            codeunit_sequence_view prefix;
-            switch (type)
+        }
+
+        template<class T>
+        [[nodiscard]] u64 measure_floating(const T& value, const codeunit_sequence_view& specification)
+        {
+            static constexpr u64 max_special_size = 4;    // -inf
+            if(std::isinf(value) || std::isnan(value))
+                return max_special_size;
+            return measure_floating(value, parse_float_specification(specification));
+        }
+
+        /**
+         * \brief Counts of digits after the dot, beyond which every digit of an exact representation is 0.
+         */
+        template<class T>
+        struct float_exact_digit_counts
+        {
+            // 1074 for f64 and 149 for f32, of the smallest subnormal.
+            static constexpr u64 fixed = static_cast<u64>(std::numeric_limits<T>::digits - std::numeric_limits<T>::min_exponent);
+            // 767 significant digits at most for f64 and 112 for f32.
+            static constexpr u64 scientific = std::is_same_v<T, f32> ? 111 : 766;
+            static constexpr u64 hexadecimal = (std::numeric_limits<T>::digits + 2) / 4;
+            // Sign, integer digits of the largest value, dot, fraction digits and a terminator written by snprintf.
+            static constexpr u64 buffer_size = 2 + static_cast<u64>(std::numeric_limits<T>::max_exponent10) + 1 + fixed + 1;
+        };
+
+        /**
+         * \brief Format huge fixed values or high precisions without allocation.
+         * Precision is limited to digits which are possibly not 0, and the rest are filled with '0'.
+         */
+        template<class T>
+        OPEN_STRING_NOINLINE void format_floating_exact(format_sink& sink, const T& value, const float_specification& parsed)
+        {
+            using digit_counts = float_exact_digit_counts<T>;
+            u64 precision = parsed.precision;
+            u64 zero_count = 0;
+            char exponent_mark = 0;
+            if(parsed.has_precision())
             {
-            case 'b':
-                {
-                    base = 2;
-                    prefix = "0b"_cuqv;
-                }
-                break;
-            case 'c':
-                {
-                    codeunit_sequence result;
-                    result.append(static_cast<char>(value));
-                    return result;
-                }
-            case 'd':
-                break;
-            case 'o':
-                {
-                    base = 8;
-                    prefix = "0o"_cuqv;
-                }
-                break;
-            case 'x':
+                switch (parsed.type)
                 {
-                    base = 16;
-                    prefix = "0x"_cuqv;
+                case 'a':
+                    zero_count = precision > digit_counts::hexadecimal ? precision - digit_counts::hexadecimal : 0;
+                    exponent_mark = 'p';
+                    break;
+                case 'e':
+                    zero_count = precision > digit_counts::scientific ? precision - digit_counts::scientific : 0;
+                    exponent_mark = 'e';
+                    break;
+                case 'f':
+                    zero_count = precision > digit_counts::fixed ? precision - digit_counts::fixed : 0;
+                    break;
+                default:
+                    // Trailing zeros are removed in general format, so they are never filled.
+                    precision = minimum(precision, digit_counts::scientific + 1);
+                    break;
                 }
-                break;
-            default:
-                break;
             }
-            if(!with_prefix)
-                prefix = ""_cuqv;
-        
-            const codeunit_sequence_view sign = (value < 0) ? "-"_cuqv : ""_cuqv;
-            const u64 digit_count = get_integer_digit_count(value, base);
-            const u64 preserve = holding == global_constant::SIZE_INVALID ? digit_count : maximum(holding, digit_count);
-            const u64 zero_count = preserve - digit_count;
-            codeunit_sequence result( sign.size() + prefix.size() + preserve );
-            result
-            .append(sign)
-            .append(prefix)
-            .append('0', zero_count);
-            const u64 digits_start = result.size();
-            i64 remaining = value >= 0 ? value : -value;
-            for(u64 i = 0; i < digit_count; ++i)
+            precision -= zero_count;
+            std::array<char, digit_counts::buffer_size> buffer;
+            const u64 written_precision = parsed.has_precision() ? precision : global_constant::SIZE_INVALID;
+            const char* written = write_float(buffer.data(), buffer.data() + buffer.size(), value, parsed.type, written_precision);
+            OPEN_STRING_CHECK(written != nullptr, "Failed to format float with specification [{}]!", parsed.type);
+            const codeunit_sequence_view result{ buffer.data(), written };
+            if(zero_count == 0)
             {
-                const char digit = from_digit(remaining % base); 
-                remaining /= base;
-                result.append(digit);
+                sink.append(result);
+                return;
             }
-            result.reverse(digits_start);
-            return result;
+            const u64 exponent_index = exponent_mark ? result.index_of(exponent_mark) : global_constant::INDEX_INVALID;
+            if(exponent_index == global_constant::INDEX_INVALID)
+            {
+                sink.append(result).append('0', zero_count);
+                return;
+            }
+            sink.append(result.subview(0, exponent_index)).append('0', zero_count).append(result.subview(exponent_index));
         }
 
-        codeunit_sequence format_float(const f64& value, const codeunit_sequence_view& specification)
+        template<class T>
+        void format_floating(format_sink& sink, const T& value, const codeunit_sequence_view& specification)
         {
             if (std::isinf(value))
-                return codeunit_sequence{ value < 0 ? "-inf"_cuqv : "inf"_cuqv };
+            {
+                sink.append(value < 0 ? "-inf"_cuqv : "inf"_cuqv);
+                return;
+            }
             if (std::isnan(value))
-                return codeunit_sequence{ "nan"_cuqv };
-            u64 precision = global_constant::SIZE_INVALID;
-            // char type = 'g';
-            if (!specification.is_empty())
             {
-                codeunit_sequence_view parsing = specification;
-                if("aefg"_cuqv.contains( parsing.read_from_last(0) ))
-                {    
-                    // type = parsing.read_from_last(0);
-                    parsing = parsing.subview(0, parsing.size() - 1);
-                }
-                if(!parsing.is_empty())
-                {
-                    if(const u64 dot_index = parsing.index_of('.'); dot_index != global_constant::INDEX_INVALID)
-                    {
-                        const codeunit_sequence_view precision_view = parsing.subview(dot_index + 1);
-                        const auto [ last, error ] = std::from_chars(precision_view.data(), precision_view.cend().data(), precision);
-                        OPEN_STRING_CHECK(last == precision_view.cend().data(), "Invalid format specification [{}]!", specification);
-                        parsing = parsing.subview(0, dot_index);
-                    }
-                }
-                OPEN_STRING_CHECK(parsing.is_empty(), "Invalid format specification [{}]!", specification);
+                sink.append("nan"_cuqv);
+                return;
             }
-            // switch (type) 
-            // {
-            // case 'a':
-            //     break;
-            // case 'e':
-            //     break;
-            // case 'f':
-            //     break;
-            // case 'g':
-            //     break;
-            // default:
-            //     break;
-            // }
-            static constexpr u64 max_precision = 9;
-            OPEN_STRING_CHECK(precision == global_constant::SIZE_INVALID || precision <= max_precision, "Too high precision for float type [{}]!", precision);
-            codeunit_sequence result;
-            const bool negative = value < 0;
-            if(negative)
-                result.append("-");
-            f64 remaining = negative ? -value : value;
-            const u64 decimal = static_cast<u64>(remaining);
-            remaining -= static_cast<f64>(decimal);
-            if(precision == global_constant::SIZE_INVALID)
+            const float_specification parsed = parse_float_specification(specification);
+            // Digits are written into the destination directly if it has space for them.
+            const u64 size_bound = measure_floating(value, parsed);
+            if(char* const first = sink.acquire(size_bound))
             {
-                static constexpr u64 max_floating = power(10, max_precision + 1);
-                u64 floating = 1;
-                u64 count_nine = 0;
-                while(floating <= max_floating)
-                {
-                    remaining *= 10;
-                    floating *= 10;
-                    const u64 ones = static_cast<u64>(remaining);
-                    floating += ones;
-                    remaining -= static_cast<f64>(ones);
-                    if(ones == 9)
-                    {
-                        ++count_nine;
-                        if(count_nine == global_constant::TOLERANCE_EXPONENT)
-                        {
-                            floating += 1;
-                            floating = floating / power(10, global_constant::TOLERANCE_EXPONENT);
-                            break;
-                        }
-                    }
-                    else
-                    {
-                        count_nine = 0;
-                    }
-                    if(remaining < global_constant::TOLERANCE)
-                        break;
-                }
-                if(floating > 10)
-                {
-                    const codeunit_sequence decimal_part = format_integer(decimal, { });
-                    const u64 dot_position = result.size() + decimal_part.size();
-                    const codeunit_sequence floating_part = format_integer(floating, { });
-                    result.reserve(dot_position + floating_part.size());
-                    result  .append(decimal_part)
-                            .append(floating_part)
-                            .write_at(dot_position, '.');
-                }
-                if(floating == 2)
-                {
-                    result.append(format_integer(decimal + 1, { }));
-                }
+                const char* const last = write_float(first, first + size_bound, value, parsed.type, parsed.precision);
+                sink.commit(last ? static_cast<u64>(last - first) : 0);
+                if(last)
+                    return;
             }
-            else 
+            else
             {
-                u64 floating = 1;
-                for(u64 i = 0; i < precision; ++i)
+                // Enough for every shortest representation and short precisions.
+                static constexpr u64 FLOAT_BUFFER_SIZE = 128;
+                std::array<char, FLOAT_BUFFER_SIZE> buffer;
+                if(const char* const last = write_float(buffer.data(), buffer.data() + buffer.size(), value, parsed.type, parsed.precision))
                 {
-                    remaining *= 10;
-                    floating *= 10;
-                    const u64 ones = static_cast<u64>(remaining);
-                    floating += ones;
-                    remaining -= static_cast<f64>(ones);
+                    sink.append({ buffer.data(), last });
+                    return;
                 }
-                const codeunit_sequence decimal_part = format_integer(decimal, { });
-                const u64 dot_position = result.size() + decimal_part.size();
-                const codeunit_sequence floating_part = format_integer(floating, { });
-                result.reserve(dot_position + floating_part.size());
-                result  .append(decimal_part)
-                        .append(floating_part)
-                        .write_at(dot_position, '.');
             }
-            return result;
+            // Huge fixed values or high precisions, which are rare.
+            format_floating_exact(sink, value, parsed);
+        }
+
+        void format_float(format_sink& sink, const f32& value, const codeunit_sequence_view& specification)
+        {
+            format_floating(sink, value, specification);
+        }
+
+        void format_float(format_sink& sink, const f64& value, const codeunit_sequence_view& specification)
+        {
+            format_floating(sink, value, specification);
+        }
+
+        char* write_float_portable(char* first, char* last, const f32& value, const char type, const u64 precision) noexcept
+        {
+            return write_portable_float(first, last, value, type, precision);
+        }
+
+        char* write_float_portable(char* first, char* last, const f64& value, const char type, const u64 precision) noexcept
+        {
+            return write_portable_float(first, last, value, type, precision);
+        }
+
+        u64 measure_float(const f32& value, const codeunit_sequence_view& specification)
+        {
+            return measure_floating(value, specification);
+        }
+
+        u64 measure_float(const f64& value, const codeunit_sequence_view& specification)
+        {
+            return measure_floating(value, specification);
         }
     }
 }
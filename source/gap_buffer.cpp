@@ -0,0 +1,392 @@
+
+#include "gap_buffer.h"
+
+#include <cstring>
+#include "common/functions.h"
+
+namespace ostr
+{
+	namespace details
+	{
+		using gap_buffer_allocator = allocator<char>;
+	}
+
+	// code-region-start: constructors
+
+	gap_buffer::gap_buffer() noexcept = default;
+
+	gap_buffer::gap_buffer(const gap_buffer& other) noexcept
+		: capacity_(other.capacity_)
+		, gap_begin_(other.gap_begin_)
+		, gap_end_(other.gap_end_)
+		, size_(other.size_)
+		, cursor_(other.cursor_)
+		, cursor_offset_(other.cursor_offset_)
+	{
+		if(this->capacity_ > 0)
+		{
+			this->data_ = details::gap_buffer_allocator::allocate_array(this->capacity_);
+			std::memcpy(this->data_, other.data_, this->gap_begin_);
+			std::memcpy(this->data_ + this->gap_end_, other.data_ + this->gap_end_, this->capacity_ - this->gap_end_);
+		}
+	}
+
+	gap_buffer::gap_buffer(gap_buffer&& other) noexcept
+		: data_(other.data_)
+		, capacity_(other.capacity_)
+		, gap_begin_(other.gap_begin_)
+		, gap_end_(other.gap_end_)
+		, size_(other.size_)
+		, cursor_(other.cursor_)
+		, cursor_offset_(other.cursor_offset_)
+	{
+		other.data_ = nullptr;
+		other.capacity_ = 0;
+		other.gap_begin_ = 0;
+		other.gap_end_ = 0;
+		other.empty();
+	}
+
+	gap_buffer& gap_buffer::operator=(const gap_buffer& other) noexcept
+	{
+		if(this != &other)
+		{
+			gap_buffer copied{ other };
+			*this = std::move(copied);
+		}
+		return *this;
+	}
+
+	gap_buffer& gap_buffer::operator=(gap_buffer&& other) noexcept
+	{
+		if(this != &other)
+		{
+			details::gap_buffer_allocator::deallocate_array(this->data_);
+			this->data_ = other.data_;
+			this->capacity_ = other.capacity_;
+			this->gap_begin_ = other.gap_begin_;
+			this->gap_end_ = other.gap_end_;
+			this->size_ = other.size_;
+			this->cursor_ = other.cursor_;
+			this->cursor_offset_ = other.cursor_offset_;
+			other.data_ = nullptr;
+			other.capacity_ = 0;
+			other.gap_begin_ = 0;
+			other.gap_end_ = 0;
+			other.empty();
+		}
+		return *this;
+	}
+
+	gap_buffer::~gap_buffer() noexcept
+	{
+		details::gap_buffer_allocator::deallocate_array(this->data_);
+	}
+
+	gap_buffer::gap_buffer(const char* str) noexcept
+		: gap_buffer(text_view{ str })
+	{ }
+
+	gap_buffer::gap_buffer(const text_view& view) noexcept
+	{
+		// The gap is at the end, it follows the cursor on the first edit.
+		const codeunit_sequence_view raw = view.raw();
+		const u64 raw_size = raw.size();
+		this->capacity_ = raw_size + CAPACITY_MINIMUM;
+		this->data_ = details::gap_buffer_allocator::allocate_array(this->capacity_);
+		std::memcpy(this->data_, raw.data(), raw_size);
+		this->gap_begin_ = raw_size;
+		this->gap_end_ = this->capacity_;
+		this->size_ = unicode::count_utf8_codepoints(raw.data(), raw.size());
+	}
+
+	// code-region-end: constructors
+
+	u64 gap_buffer::size() const noexcept
+	{
+		return this->size_;
+	}
+
+	u64 gap_buffer::raw_size() const noexcept
+	{
+		return this->capacity_ - this->get_gap_size();
+	}
+
+	bool gap_buffer::is_empty() const noexcept
+	{
+		return this->size_ == 0;
+	}
+
+	u64 gap_buffer::get_capacity() const noexcept
+	{
+		return this->capacity_;
+	}
+
+	u64 gap_buffer::cursor() const noexcept
+	{
+		return this->cursor_;
+	}
+
+	gap_buffer& gap_buffer::set_cursor(const u64 index) noexcept
+	{
+		const u64 actual_index = minimum(index, this->size_);
+		this->cursor_offset_ = this->get_offset(actual_index);
+		this->cursor_ = actual_index;
+		return *this;
+	}
+
+	gap_buffer& gap_buffer::move_cursor(const i64 delta) noexcept
+	{
+		if(delta < 0)
+			return this->set_cursor(this->cursor_ - minimum(static_cast<u64>(-delta), this->cursor_));
+		return this->set_cursor(this->cursor_ + static_cast<u64>(delta));
+	}
+
+	gap_buffer& gap_buffer::insert(const text_view& view) noexcept
+	{
+		const codeunit_sequence_view raw = view.raw();
+		const u64 raw_size = raw.size();
+		if(raw_size == 0)
+			return *this;
+		this->move_gap(this->cursor_offset_);
+		this->grow_gap(raw_size);
+		std::memcpy(this->data_ + this->gap_begin_, raw.data(), raw_size);
+		this->gap_begin_ += raw_size;
+		const u64 count = unicode::count_utf8_codepoints(raw.data(), raw.size());
+		this->size_ += count;
+		this->cursor_ += count;
+		this->cursor_offset_ += raw_size;
+		return *this;
+	}
+
+	gap_buffer& gap_buffer::insert(const codepoint& cp) noexcept
+	{
+		return this->insert(text_view{ cp });
+	}
+
+	gap_buffer& gap_buffer::erase_before(const u64 count) noexcept
+	{
+		if(count == 0 || this->cursor_ == 0)
+			return *this;
+		this->move_gap(this->cursor_offset_);
+		u64 erased = 0;
+		while(erased < count && this->gap_begin_ > 0)
+		{
+			do
+				--this->gap_begin_;
+			while(this->gap_begin_ > 0 && !unicode::is_utf8_codepoint_start(this->data_[this->gap_begin_]));
+			++erased;
+		}
+		this->size_ -= erased;
+		this->cursor_ -= erased;
+		this->cursor_offset_ = this->gap_begin_;
+		return *this;
+	}
+
+	gap_buffer& gap_buffer::erase_after(const u64 count) noexcept
+	{
+		if(count == 0 || this->cursor_ == this->size_)
+			return *this;
+		this->move_gap(this->cursor_offset_);
+		u64 erased = 0;
+		while(erased < count && this->gap_end_ < this->capacity_)
+		{
+			do
+				++this->gap_end_;
+			while(this->gap_end_ < this->capacity_ && !unicode::is_utf8_codepoint_start(this->data_[this->gap_end_]));
+			++erased;
+		}
+		this->size_ -= erased;
+		return *this;
+	}
+
+	void gap_buffer::empty() noexcept
+	{
+		this->gap_begin_ = 0;
+		this->gap_end_ = this->capacity_;
+		this->size_ = 0;
+		this->cursor_ = 0;
+		this->cursor_offset_ = 0;
+	}
+
+	codepoint gap_buffer::read_at(const u64 index) const noexcept
+	{
+		OPEN_STRING_CHECK(index < this->size_, "Index [{}] out of range [0, {})!", index, this->size_);
+		const u64 offset = this->get_offset(index);
+		const u64 raw_size = this->raw_size();
+		// A codepoint may be split by the gap when invalid sequences are inserted.
+		std::array<char, unicode::UTF8_SEQUENCE_MAXIMUM_LENGTH> codeunits{ };
+		u8 length = 0;
+		do
+		{
+			codeunits[length] = *this->get_codeunit(offset + length);
+			++length;
+		}
+		while(length < codeunits.size() && offset + length < raw_size && !unicode::is_utf8_codepoint_start(*this->get_codeunit(offset + length)));
+		return codepoint{ codeunits.data(), length };
+	}
+
+	codepoint gap_buffer::operator[](const u64 index) const noexcept
+	{
+		return this->read_at(index);
+	}
+
+	bool gap_buffer::operator==(const text_view& rhs) const noexcept
+	{
+		return this->raw_size() == rhs.raw().size() && this->starts_with(rhs);
+	}
+
+	bool gap_buffer::operator!=(const text_view& rhs) const noexcept
+	{
+		return !(*this == rhs);
+	}
+
+	bool gap_buffer::starts_with(const text_view& prefix) const noexcept
+	{
+		const codeunit_sequence_view raw = prefix.raw();
+		if(raw.size() > this->raw_size())
+			return false;
+		const std::array<text_view, 2> segments = this->segments();
+		const u64 before_size = minimum(raw.size(), this->gap_begin_);
+		return segments[0].raw().subview(0, before_size) == raw.subview(0, before_size)
+			&& segments[1].raw().subview(0, raw.size() - before_size) == raw.subview(before_size);
+	}
+
+	bool gap_buffer::ends_with(const text_view& suffix) const noexcept
+	{
+		const codeunit_sequence_view raw = suffix.raw();
+		if(raw.size() > this->raw_size())
+			return false;
+		const std::array<text_view, 2> segments = this->segments();
+		const codeunit_sequence_view after = segments[1].raw();
+		const u64 after_size = minimum(raw.size(), after.size());
+		const u64 before_size = raw.size() - after_size;
+		return after.subview(after.size() - after_size) == raw.subview(before_size)
+			&& segments[0].raw().subview(this->gap_begin_ - before_size) == raw.subview(0, before_size);
+	}
+
+	bool gap_buffer::is_contiguous() const noexcept
+	{
+		return this->gap_begin_ == 0 || this->gap_end_ == this->capacity_;
+	}
+
+	std::array<text_view, 2> gap_buffer::segments() const noexcept
+	{
+		if(this->data_ == nullptr)
+			return { };
+		return
+		{
+			text_view{ this->data_, this->gap_begin_ },
+			text_view{ this->data_ + this->gap_end_, this->capacity_ - this->gap_end_ },
+		};
+	}
+
+	text_view gap_buffer::view() noexcept
+	{
+		if(this->data_ == nullptr)
+			return { };
+		if(this->gap_begin_ == 0)
+			return { this->data_ + this->gap_end_, this->capacity_ - this->gap_end_ };
+		this->move_gap(this->raw_size());
+		return { this->data_, this->gap_begin_ };
+	}
+
+	text gap_buffer::to_text() const noexcept
+	{
+		codeunit_sequence sequence{ this->raw_size() };
+		for(const text_view& segment : this->segments())
+			sequence.append(segment.raw());
+		return text{ std::move(sequence) };
+	}
+
+	void gap_buffer::move_gap(const u64 offset) noexcept
+	{
+		if(offset < this->gap_begin_)
+		{
+			const u64 count = this->gap_begin_ - offset;
+			std::memmove(this->data_ + this->gap_end_ - count, this->data_ + offset, count);
+			this->gap_begin_ -= count;
+			this->gap_end_ -= count;
+		}
+		else if(offset > this->gap_begin_)
+		{
+			const u64 count = offset - this->gap_begin_;
+			std::memmove(this->data_ + this->gap_begin_, this->data_ + this->gap_end_, count);
+			this->gap_begin_ += count;
+			this->gap_end_ += count;
+		}
+	}
+
+	void gap_buffer::grow_gap(const u64 size) noexcept
+	{
+		if(this->get_gap_size() >= size)
+			return;
+		const u64 raw_size = this->raw_size();
+		const u64 capacity = maximum(maximum(this->capacity_ * 2, raw_size + size), CAPACITY_MINIMUM);
+		char* data = details::gap_buffer_allocator::allocate_array(capacity);
+		const u64 after_size = this->capacity_ - this->gap_end_;
+		if(this->data_ != nullptr)
+		{
+			std::memcpy(data, this->data_, this->gap_begin_);
+			std::memcpy(data + capacity - after_size, this->data_ + this->gap_end_, after_size);
+			details::gap_buffer_allocator::deallocate_array(this->data_);
+		}
+		this->data_ = data;
+		this->capacity_ = capacity;
+		this->gap_end_ = capacity - after_size;
+	}
+
+	u64 gap_buffer::get_offset(const u64 index) const noexcept
+	{
+		// Walk from the nearest one of the start, the cursor and the end.
+		u64 current = this->cursor_;
+		u64 offset = this->cursor_offset_;
+		const u64 distance = index > current ? index - current : current - index;
+		if(index < distance)
+		{
+			current = 0;
+			offset = 0;
+		}
+		else if(this->size_ - index < distance)
+		{
+			current = this->size_;
+			offset = this->raw_size();
+		}
+		// Scan the code units before the gap and after the gap, each of which is contiguous.
+		const u64 raw_size = this->raw_size();
+		const std::array<u64, 3> bounds{ 0, this->gap_begin_, raw_size };
+		const std::array<const char*, 2> bases{ this->data_, this->data_ + this->get_gap_size() };
+		if(current < index)
+		{
+			// Stop at the start of the codepoint after count codepoints.
+			const u64 count = index - current;
+			u64 found = 0;
+			for(u64 segment = 0; segment < bases.size(); ++segment)
+				for(u64 i = maximum(bounds[segment], offset); i < bounds[segment + 1]; ++i)
+					if(unicode::is_utf8_codepoint_start(bases[segment][i]) && found++ == count)
+						return i;
+			return raw_size;
+		}
+		if(current > index)
+		{
+			const u64 count = current - index;
+			u64 found = 0;
+			for(u64 segment = bases.size(); segment > 0; --segment)
+				for(u64 i = minimum(bounds[segment], offset); i > bounds[segment - 1]; --i)
+					if(unicode::is_utf8_codepoint_start(bases[segment - 1][i - 1]) && ++found == count)
+						return i - 1;
+			return 0;
+		}
+		return offset;
+	}
+
+	u64 gap_buffer::get_gap_size() const noexcept
+	{
+		return this->gap_end_ - this->gap_begin_;
+	}
+
+	const char* gap_buffer::get_codeunit(const u64 offset) const noexcept
+	{
+		return offset < this->gap_begin_ ? this->data_ + offset : this->data_ + offset + this->get_gap_size();
+	}
+}
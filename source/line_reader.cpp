@@ -0,0 +1,168 @@
+
+#include "line_reader.h"
+
+#include <cerrno>
+#include <cstring>
+
+#if _WIN64
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace ostr
+{
+	namespace details
+	{
+		static constexpr u64 LINE_READER_BUFFER_SIZE_MINIMUM = 16;
+		// Reads of a single call are limited, as sizes of reading are 32-bit on some platforms.
+		static constexpr u64 LINE_READER_READ_SIZE_MAXIMUM = 1ull << 30;
+	}
+
+	// code-region-start: constructors
+
+	line_reader::line_reader(const int descriptor, const u64 buffer_size) noexcept
+		: descriptor_(descriptor)
+	{
+		// One less than the size, so that the null terminator fits in an allocation of the size.
+		this->buffer_.append('\0', maximum(buffer_size, details::LINE_READER_BUFFER_SIZE_MINIMUM) - 1);
+	}
+
+	line_reader::line_reader(std::FILE* stream, const u64 buffer_size) noexcept
+		: stream_(stream)
+	{
+		this->buffer_.append('\0', maximum(buffer_size, details::LINE_READER_BUFFER_SIZE_MINIMUM) - 1);
+	}
+
+	// code-region-end: constructors
+
+	// code-region-start: iterators
+
+	line_reader::line_iterator::line_iterator(line_reader* reader) noexcept
+		: reader_(reader)
+	{
+		++*this;
+	}
+
+	const codeunit_sequence_view& line_reader::line_iterator::operator*() const noexcept
+	{
+		return this->line_;
+	}
+
+	line_reader::line_iterator& line_reader::line_iterator::operator++() noexcept
+	{
+		if(this->reader_ && !this->reader_->next(this->line_))
+		{
+			this->reader_ = nullptr;
+			this->line_ = { };
+		}
+		return *this;
+	}
+
+	bool line_reader::line_iterator::operator==(const line_iterator& rhs) const noexcept
+	{
+		return this->reader_ == rhs.reader_;
+	}
+
+	bool line_reader::line_iterator::operator!=(const line_iterator& rhs) const noexcept
+	{
+		return !(*this == rhs);
+	}
+
+	line_reader::line_range line_reader::lines() noexcept
+	{
+		return { this };
+	}
+
+	// code-region-end: iterators
+
+	bool line_reader::next(codeunit_sequence_view& line) noexcept
+	{
+		while(true)
+		{
+			const char* data = this->buffer_.data();
+			// memchr is vectorized by the C library, which beats a loop over code units by far.
+			if(const void* found = std::memchr(data + this->scanned_, '\n', this->end_ - this->scanned_))
+			{
+				const u64 feed = static_cast<u64>(static_cast<const char*>(found) - data);
+				u64 last = feed;
+				if(last > this->begin_ && data[last - 1] == '\r')
+					--last;
+				line = { data + this->begin_, last - this->begin_ };
+				this->begin_ = feed + 1;
+				this->scanned_ = this->begin_;
+				++this->line_count_;
+				return true;
+			}
+			this->scanned_ = this->end_;
+			if(!this->refill())
+				break;
+		}
+		// The last line without a line feed.
+		if(this->begin_ == this->end_)
+			return false;
+		line = { this->buffer_.data() + this->begin_, this->end_ - this->begin_ };
+		this->begin_ = this->end_;
+		this->scanned_ = this->end_;
+		++this->line_count_;
+		return true;
+	}
+
+	line_reader_status line_reader::status() const noexcept
+	{
+		return this->status_;
+	}
+
+	u64 line_reader::get_line_count() const noexcept
+	{
+		return this->line_count_;
+	}
+
+	bool line_reader::refill() noexcept
+	{
+		if(this->status_ != line_reader_status::reading)
+			return false;
+		char* data = this->buffer_.data();
+		// The line not consumed is moved to the front, then the buffer grows only if the line fills it.
+		if(this->begin_ > 0)
+		{
+			std::memmove(data, data + this->begin_, this->end_ - this->begin_);
+			this->scanned_ -= this->begin_;
+			this->end_ -= this->begin_;
+			this->begin_ = 0;
+		}
+		else if(this->end_ == this->buffer_.size())
+		{
+			this->buffer_.append('\0', this->buffer_.size() + 1);
+			data = this->buffer_.data();
+		}
+		const i64 read = this->read(data + this->end_, this->buffer_.size() - this->end_);
+		if(read <= 0)
+		{
+			this->status_ = read == 0 ? line_reader_status::end_of_file : line_reader_status::read_failed;
+			return false;
+		}
+		this->end_ += static_cast<u64>(read);
+		return true;
+	}
+
+	i64 line_reader::read(char* destination, const u64 size) noexcept
+	{
+		const u64 request = minimum(size, details::LINE_READER_READ_SIZE_MAXIMUM);
+		if(this->stream_)
+		{
+			const u64 read = std::fread(destination, 1, request, this->stream_);
+			return read == 0 && std::ferror(this->stream_) ? -1 : static_cast<i64>(read);
+		}
+		while(true)
+		{
+#if _WIN64
+			const i64 read = _read(this->descriptor_, destination, static_cast<unsigned>(request));
+#else
+			const i64 read = ::read(this->descriptor_, destination, request);
+#endif
+			if(read >= 0 || errno != EINTR)
+				return read;
+		}
+	}
+}
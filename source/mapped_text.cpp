@@ -0,0 +1,240 @@
+
+#include "mapped_text.h"
+
+#include <cstring>
+#include "common/platforms.h"
+
+#if _WIN64
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ostr
+{
+	namespace details
+	{
+		static constexpr std::array<char, 3> UTF8_BYTE_ORDER_MARK{ '\xef', '\xbb', '\xbf' };
+
+#if _WIN64
+		[[nodiscard]] static std::vector<wchar_t> to_wide_path(const char* path) noexcept
+		{
+			const int length = MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0);
+			std::vector<wchar_t> wide_path(length > 0 ? length : 1, L'\0');
+			if(length > 0)
+				MultiByteToWideChar(CP_UTF8, 0, path, -1, wide_path.data(), length);
+			return wide_path;
+		}
+#endif
+	}
+
+	// code-region-start: constructors
+
+	mapped_text::mapped_text() noexcept = default;
+
+	mapped_text::mapped_text(const char* path, const mapped_text_options& options) noexcept
+	{
+		this->open(path, options);
+	}
+
+	mapped_text::mapped_text(mapped_text&& other) noexcept
+		: mapping_(other.mapping_)
+		, mapping_size_(other.mapping_size_)
+		, offset_(other.offset_)
+		, invalid_offset_(other.invalid_offset_)
+		, status_(other.status_)
+	{
+		other.mapping_ = nullptr;
+		other.mapping_size_ = 0;
+		other.offset_ = 0;
+		other.invalid_offset_ = 0;
+		other.status_ = mapped_text_status::closed;
+	}
+
+	mapped_text& mapped_text::operator=(mapped_text&& other) noexcept
+	{
+		if(this != &other)
+		{
+			this->close();
+			this->mapping_ = other.mapping_;
+			this->mapping_size_ = other.mapping_size_;
+			this->offset_ = other.offset_;
+			this->invalid_offset_ = other.invalid_offset_;
+			this->status_ = other.status_;
+			other.mapping_ = nullptr;
+			other.mapping_size_ = 0;
+			other.offset_ = 0;
+			other.invalid_offset_ = 0;
+			other.status_ = mapped_text_status::closed;
+		}
+		return *this;
+	}
+
+	mapped_text::~mapped_text() noexcept
+	{
+		this->close();
+	}
+
+	// code-region-end: constructors
+
+	mapped_text_status mapped_text::open(const char* path, const mapped_text_options& options) noexcept
+	{
+		this->close();
+#if _WIN64
+		const std::vector<wchar_t> wide_path = details::to_wide_path(path);
+		const DWORD flags = options.access == mapped_access_hint::sequential ? FILE_FLAG_SEQUENTIAL_SCAN :
+			options.access == mapped_access_hint::random ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL;
+		const HANDLE file = CreateFileW(wide_path.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+		if(file == INVALID_HANDLE_VALUE)
+			return this->status_ = mapped_text_status::open_failed;
+		LARGE_INTEGER file_size{ };
+		if(!GetFileSizeEx(file, &file_size))
+		{
+			CloseHandle(file);
+			return this->status_ = mapped_text_status::open_failed;
+		}
+		this->mapping_size_ = static_cast<u64>(file_size.QuadPart);
+		// Empty files can not be mapped, they are viewed as empty.
+		if(this->mapping_size_ > 0)
+		{
+			// Large pages are only available for mappings backed by the paging file, so huge_pages is ignored.
+			const HANDLE mapping_object = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if(mapping_object != nullptr)
+			{
+				this->mapping_ = MapViewOfFile(mapping_object, FILE_MAP_READ, 0, 0, 0);
+				CloseHandle(mapping_object);
+			}
+			if(this->mapping_ == nullptr)
+			{
+				CloseHandle(file);
+				this->mapping_size_ = 0;
+				return this->status_ = mapped_text_status::map_failed;
+			}
+			if(options.will_need)
+			{
+				WIN32_MEMORY_RANGE_ENTRY range{ this->mapping_, static_cast<SIZE_T>(this->mapping_size_) };
+				PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+			}
+		}
+		CloseHandle(file);
+#else
+		const int file = ::open(path, O_RDONLY | O_CLOEXEC);
+		if(file < 0)
+			return this->status_ = mapped_text_status::open_failed;
+		struct stat file_status{ };
+		if(::fstat(file, &file_status) != 0)
+		{
+			::close(file);
+			return this->status_ = mapped_text_status::open_failed;
+		}
+		this->mapping_size_ = static_cast<u64>(file_status.st_size);
+		// Empty files can not be mapped, they are viewed as empty.
+		if(this->mapping_size_ > 0)
+		{
+			void* mapping = ::mmap(nullptr, this->mapping_size_, PROT_READ, MAP_SHARED, file, 0);
+			if(mapping == MAP_FAILED)
+			{
+				::close(file);
+				this->mapping_size_ = 0;
+				return this->status_ = mapped_text_status::map_failed;
+			}
+			this->mapping_ = mapping;
+			// Hints are only advices, failures are ignored.
+			if(options.access == mapped_access_hint::sequential)
+				::madvise(this->mapping_, this->mapping_size_, MADV_SEQUENTIAL);
+			else if(options.access == mapped_access_hint::random)
+				::madvise(this->mapping_, this->mapping_size_, MADV_RANDOM);
+			if(options.will_need)
+				::madvise(this->mapping_, this->mapping_size_, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+			// Transparent huge pages of the page cache, where the file system supports them.
+			if(options.huge_pages)
+				::madvise(this->mapping_, this->mapping_size_, MADV_HUGEPAGE);
+#endif
+		}
+		::close(file);
+#endif
+		const char* data = static_cast<const char*>(this->mapping_);
+		if(options.strip_bom && this->mapping_size_ >= details::UTF8_BYTE_ORDER_MARK.size()
+			&& std::memcmp(data, details::UTF8_BYTE_ORDER_MARK.data(), details::UTF8_BYTE_ORDER_MARK.size()) == 0)
+			this->offset_ = details::UTF8_BYTE_ORDER_MARK.size();
+		if(options.validate_utf8)
+		{
+			const u64 size = this->size();
+			this->invalid_offset_ = unicode::find_invalid_utf8(this->data(), size);
+			if(this->invalid_offset_ != size)
+				return this->status_ = mapped_text_status::invalid_utf8;
+		}
+		return this->status_ = mapped_text_status::succeeded;
+	}
+
+	void mapped_text::close() noexcept
+	{
+		if(this->mapping_ != nullptr)
+		{
+#if _WIN64
+			UnmapViewOfFile(this->mapping_);
+#else
+			::munmap(this->mapping_, this->mapping_size_);
+#endif
+		}
+		this->mapping_ = nullptr;
+		this->mapping_size_ = 0;
+		this->offset_ = 0;
+		this->invalid_offset_ = 0;
+		this->status_ = mapped_text_status::closed;
+	}
+
+	mapped_text_status mapped_text::status() const noexcept
+	{
+		return this->status_;
+	}
+
+	bool mapped_text::is_open() const noexcept
+	{
+		return this->status_ == mapped_text_status::succeeded || this->status_ == mapped_text_status::invalid_utf8;
+	}
+
+	u64 mapped_text::get_invalid_offset() const noexcept
+	{
+		return this->invalid_offset_;
+	}
+
+	u64 mapped_text::size() const noexcept
+	{
+		return this->mapping_size_ - this->offset_;
+	}
+
+	bool mapped_text::is_empty() const noexcept
+	{
+		return this->size() == 0;
+	}
+
+	const char* mapped_text::data() const noexcept
+	{
+		return this->mapping_ ? static_cast<const char*>(this->mapping_) + this->offset_ : nullptr;
+	}
+
+	codeunit_sequence_view mapped_text::raw() const noexcept
+	{
+		return { this->data(), this->size() };
+	}
+
+	text_view mapped_text::view() const noexcept
+	{
+		return text_view{ this->raw() };
+	}
+
+	mapped_text::operator codeunit_sequence_view() const noexcept
+	{
+		return this->raw();
+	}
+
+	mapped_text::operator text_view() const noexcept
+	{
+		return this->view();
+	}
+}
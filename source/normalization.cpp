@@ -0,0 +1,543 @@
+
+#include "normalization.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "normalization_tables.h"
+
+namespace ostr
+{
+	namespace details
+	{
+		// Flags of normalization_record, the same as the ones of tools/generate_normalization_tables.py.
+		static constexpr u8 NORMALIZATION_NFD_NO = 1 << 0;
+		static constexpr u8 NORMALIZATION_NFKD_NO = 1 << 1;
+		static constexpr u8 NORMALIZATION_NFC_NO = 1 << 2;
+		static constexpr u8 NORMALIZATION_NFC_MAYBE = 1 << 3;
+		static constexpr u8 NORMALIZATION_NFKC_NO = 1 << 4;
+		static constexpr u8 NORMALIZATION_NFKC_MAYBE = 1 << 5;
+		static constexpr u8 NORMALIZATION_CANONICAL_NON_STARTER = 1 << 6;
+		static constexpr u8 NORMALIZATION_COMPATIBILITY_NON_STARTER = 1 << 7;
+
+		// Hangul syllables are composed of a leading consonant, a vowel and an optional trailing consonant, see chapter 3.12 of the Unicode Standard.
+		static constexpr char32_t HANGUL_SYLLABLE_FIRST = 0xAC00;
+		static constexpr char32_t HANGUL_LEADING_FIRST = 0x1100;
+		static constexpr char32_t HANGUL_VOWEL_FIRST = 0x1161;
+		// The one before the first trailing consonant, which stands for no trailing consonant.
+		static constexpr char32_t HANGUL_TRAILING_BASE = 0x11A7;
+		static constexpr char32_t HANGUL_LEADING_COUNT = 19;
+		static constexpr char32_t HANGUL_VOWEL_COUNT = 21;
+		static constexpr char32_t HANGUL_TRAILING_COUNT = 28;
+		static constexpr char32_t HANGUL_SYLLABLE_COUNT = HANGUL_LEADING_COUNT * HANGUL_VOWEL_COUNT * HANGUL_TRAILING_COUNT;
+
+		[[nodiscard]] static const normalization_record& get_normalization_record(const char32_t cp) noexcept
+		{
+			if(cp >= NORMALIZATION_LIMIT)
+				return NORMALIZATION_RECORDS[0];
+			const u64 block = NORMALIZATION_BLOCK_INDICES[cp >> NORMALIZATION_BLOCK_SHIFT];
+			const u64 offset = cp & ((1 << NORMALIZATION_BLOCK_SHIFT) - 1);
+			return NORMALIZATION_RECORDS[NORMALIZATION_RECORD_INDICES[(block << NORMALIZATION_BLOCK_SHIFT) | offset]];
+		}
+
+		[[nodiscard]] static constexpr bool is_composing(const normalization_form form) noexcept
+		{
+			return form == normalization_form::nfc || form == normalization_form::nfkc;
+		}
+
+		[[nodiscard]] static constexpr bool is_compatibility(const normalization_form form) noexcept
+		{
+			return form == normalization_form::nfkc || form == normalization_form::nfkd;
+		}
+
+		[[nodiscard]] static constexpr u8 get_normalization_no_flag(const normalization_form form) noexcept
+		{
+			constexpr std::array<u8, 4> flags { NORMALIZATION_NFC_NO, NORMALIZATION_NFD_NO, NORMALIZATION_NFKC_NO, NORMALIZATION_NFKD_NO };
+			return flags[static_cast<u8>(form)];
+		}
+
+		[[nodiscard]] static constexpr u8 get_normalization_maybe_flag(const normalization_form form) noexcept
+		{
+			constexpr std::array<u8, 4> flags { NORMALIZATION_NFC_MAYBE, 0, NORMALIZATION_NFKC_MAYBE, 0 };
+			return flags[static_cast<u8>(form)];
+		}
+
+		struct normalization_writer
+		{
+			// Ill-formed code units are kept in segments as codepoints from this one on, which never compose.
+			static constexpr char32_t ILL_FORMED_BASE = 0x110000;
+
+			struct segment_codepoint
+			{
+				char32_t cp;
+				u8 ccc;
+			};
+
+			using segment = std::vector<segment_codepoint>;
+
+			// Count of codepoints after which a segment ends at any position text can be split before.
+			static constexpr u64 SEGMENT_SIZE_SOFT_LIMIT = 64;
+			// Room for segments up to the soft limit, with the decompositions of the last codepoint.
+			static constexpr u64 SEGMENT_CAPACITY = SEGMENT_SIZE_SOFT_LIMIT * 2;
+
+			[[nodiscard]] static bool is_ascii_word(const u64 word) noexcept
+			{
+				return (word & (CODEUNIT_WORD_ONES * 0x80)) == 0;
+			}
+
+			/**
+			 * \brief Check a sequence of 2 or 3 code units by the block of 64 codepoints it is in, without decoding it, e.g. the whole of CJK.
+			 * Ill-formed sequences, which are copied as they are, may be taken as inert.
+			 * @return count of code units of the sequence at the start of source if all codepoints of its block are starters passing the quick check, return 0 otherwise
+			 */
+			[[nodiscard]] static u64 parse_inert_length(const char* source, const u64 size, const u64 inert_leads, const std::array<u64, 16>& inert_blocks) noexcept
+			{
+				const u8 lead = static_cast<u8>(source[0]);
+				if(lead < 0xe0)
+					return lead >= 0xc0 && ((inert_leads >> (lead - 0xc0)) & 1) != 0 && size >= 2 && unicode::is_utf8_continuation(source[1]) ? 2 : 0;
+				if(lead >= 0xf0 || size < 3 || !unicode::is_utf8_continuation(source[1]) || !unicode::is_utf8_continuation(source[2]))
+					return 0;
+				return ((inert_blocks[lead - 0xe0] >> (static_cast<u8>(source[1]) & 0x3f)) & 1) != 0 ? 3 : 0;
+			}
+
+			/// @return whether source starts with a codepoint cut by the end of source, which the next chunk of a document completes
+			[[nodiscard]] static bool is_truncated(const char* source, const u64 size) noexcept
+			{
+				const u64 length = unicode::parse_utf8_length(source[0]);
+				if(length < 2 || length > unicode::UTF8_SEQUENCE_MAXIMUM_LENGTH || length <= size)
+					return false;
+				for(u64 i = 1; i < size; ++i)
+					if(!unicode::is_utf8_continuation(source[i]))
+						return false;
+				return true;
+			}
+
+			/**
+			 * \brief Whether text can be split before a codepoint, normalizing the parts separately, as nothing before it composes with it or is reordered after it.
+			 */
+			[[nodiscard]] static bool is_boundary_before(const normalization_record& record, const normalization_form form) noexcept
+			{
+				if(record.ccc != 0)
+					return false;
+				if(!is_composing(form))
+					return (record.flags & (is_compatibility(form) ? NORMALIZATION_COMPATIBILITY_NON_STARTER : NORMALIZATION_CANONICAL_NON_STARTER)) == 0;
+				const u8 maybe = get_normalization_maybe_flag(form);
+				if((record.flags & maybe) != 0)
+					return false;
+				if((record.flags & get_normalization_no_flag(form)) == 0)
+					return true;
+				// Decomposed to a starter composing with nothing before it, e.g. the singletons of CJK compatibility ideographs.
+				const u16 index = is_compatibility(form) ? record.compatibility : record.canonical;
+				if(index == 0)
+					return false;
+				const normalization_record& first = get_normalization_record(NORMALIZATION_DECOMPOSITIONS[index + 1]);
+				return first.ccc == 0 && (first.flags & maybe) == 0;
+			}
+
+			/**
+			 * \brief Scan source while codepoints pass the quick check.
+			 * @param position position to start from, set to the position of the first codepoint failing the quick check, or the size of source
+			 * @param boundary set to the position of the last codepoint scanned which text can be split before
+			 * @param last_ccc canonical combining class of the codepoint before position
+			 * @tparam StopAtMaybe whether to stop at codepoints checked as maybe too, otherwise they are skipped and maybe is returned at the end
+			 * @return check of the codepoint at position, or of the whole source when it reaches the end
+			 */
+			template<bool StopAtMaybe>
+			static normalization_check scan(const char* input, const u64 size, const normalization_form form, u64& position, u64& boundary, u8& last_ccc) noexcept
+			{
+				const u64 inert_leads = NORMALIZATION_INERT_LEADS[static_cast<u8>(form)];
+				const std::array<u64, 16>& inert_blocks = NORMALIZATION_INERT_BLOCKS[static_cast<u8>(form)];
+				const u8 no = get_normalization_no_flag(form);
+				const u8 maybe = get_normalization_maybe_flag(form);
+				normalization_check result = normalization_check::yes;
+				// Kept in locals, as stores through the references may alias source.
+				u64 last_boundary = boundary;
+				u8 ccc = last_ccc;
+				u64 i = position;
+				while(i < size)
+				{
+					if(static_cast<u8>(input[i]) < 0x80)
+					{
+						if(i + sizeof(u64) <= size && is_ascii_word(load_codeunit_word<u64>(input + i)))
+							i += sizeof(u64);
+						else
+							++i;
+						last_boundary = i - 1;
+						ccc = 0;
+						continue;
+					}
+					if(const u64 length = parse_inert_length(input + i, size - i, inert_leads, inert_blocks); length != 0)
+					{
+						last_boundary = i;
+						ccc = 0;
+						i += length;
+						continue;
+					}
+					char32_t cp = 0;
+					const u64 length = unicode::decode_utf8(input + i, size - i, cp);
+					if(length == 0)
+					{
+						// Ill-formed code units are kept as starters.
+						last_boundary = i;
+						ccc = 0;
+						++i;
+						continue;
+					}
+					const normalization_record& record = get_normalization_record(cp);
+					if((record.flags & no) != 0 || (record.ccc != 0 && record.ccc < ccc))
+					{
+						result = normalization_check::no;
+						break;
+					}
+					if((record.flags & maybe) != 0)
+					{
+						result = normalization_check::maybe;
+						if constexpr (StopAtMaybe)
+							break;
+					}
+					else if(record.ccc == 0)
+						last_boundary = i;
+					ccc = record.ccc;
+					i += length;
+				}
+				position = i;
+				boundary = last_boundary;
+				last_ccc = ccc;
+				return result;
+			}
+
+			/**
+			 * \brief Find where the next chunk of a document starts to be independent of the chunks before, which end in the middle of a segment.
+			 * Leading continuation code units may complete a codepoint cut by the end of the chunk before.
+			 * @return position of the first codepoint text can be split before, or the size of chunk if there is none
+			 */
+			[[nodiscard]] static u64 find_first_boundary(const char* input, const u64 size, const normalization_form form) noexcept
+			{
+				u64 position = 0;
+				while(position < size && position < unicode::UTF8_SEQUENCE_MAXIMUM_LENGTH - 1 && unicode::is_utf8_continuation(input[position]))
+					++position;
+				while(position < size)
+				{
+					char32_t cp = 0;
+					const u64 length = unicode::decode_utf8(input + position, size - position, cp);
+					if(length == 0)
+						return is_truncated(input + position, size - position) ? size : position;
+					if(is_boundary_before(get_normalization_record(cp), form))
+						return position;
+					position += length;
+				}
+				return size;
+			}
+
+			/**
+			 * \brief Find where the last chunk of a document may start to depend on the next chunk, skipping a codepoint cut by its end.
+			 * @return position of the last codepoint text can be split before, or 0 if there is none
+			 */
+			[[nodiscard]] static u64 find_last_boundary(const char* input, const u64 size, const normalization_form form) noexcept
+			{
+				u64 end = size;
+				while(end > 0)
+				{
+					u64 start = end - 1;
+					while(start > 0 && end - start < unicode::UTF8_SEQUENCE_MAXIMUM_LENGTH && unicode::is_utf8_continuation(input[start]))
+						--start;
+					char32_t cp = 0;
+					if(unicode::decode_utf8(input + start, end - start, cp) == end - start)
+					{
+						if(is_boundary_before(get_normalization_record(cp), form))
+							return start;
+					}
+					else if(end != size || !is_truncated(input + start, end - start))
+					{
+						// No codepoint ends at the end, so the last code unit is an ill-formed one, kept as a starter.
+						return end - 1;
+					}
+					end = start;
+				}
+				return 0;
+			}
+
+			static void decompose(segment& result, const char32_t cp, const normalization_record& record, const normalization_form form) noexcept
+			{
+				if(cp >= HANGUL_SYLLABLE_FIRST && cp < HANGUL_SYLLABLE_FIRST + HANGUL_SYLLABLE_COUNT)
+				{
+					const char32_t index = cp - HANGUL_SYLLABLE_FIRST;
+					result.push_back({ HANGUL_LEADING_FIRST + index / (HANGUL_VOWEL_COUNT * HANGUL_TRAILING_COUNT), 0 });
+					result.push_back({ HANGUL_VOWEL_FIRST + index % (HANGUL_VOWEL_COUNT * HANGUL_TRAILING_COUNT) / HANGUL_TRAILING_COUNT, 0 });
+					if(const char32_t trailing = index % HANGUL_TRAILING_COUNT; trailing != 0)
+						result.push_back({ HANGUL_TRAILING_BASE + trailing, 0 });
+					return;
+				}
+				const u16 index = is_compatibility(form) ? record.compatibility : record.canonical;
+				if(index == 0)
+				{
+					result.push_back({ cp, record.ccc });
+					return;
+				}
+				const u64 count = NORMALIZATION_DECOMPOSITIONS[index];
+				for(u64 i = 0; i < count; ++i)
+				{
+					const char32_t decomposed = NORMALIZATION_DECOMPOSITIONS[index + 1 + i];
+					result.push_back({ decomposed, get_normalization_record(decomposed).ccc });
+				}
+			}
+
+			// Stable sort of each run of non-starters by their canonical combining classes.
+			static void reorder(segment& codepoints) noexcept
+			{
+				for(u64 i = 1; i < codepoints.size(); ++i)
+				{
+					const segment_codepoint current = codepoints[i];
+					if(current.ccc == 0)
+						continue;
+					u64 j = i;
+					for(; j > 0 && codepoints[j - 1].ccc > current.ccc; --j)
+						codepoints[j] = codepoints[j - 1];
+					codepoints[j] = current;
+				}
+			}
+
+			/// @return primary composite of a pair of codepoints, return 0 if there is none
+			[[nodiscard]] static char32_t compose_pair(const char32_t first, const char32_t second) noexcept
+			{
+				if(first >= HANGUL_LEADING_FIRST && first < HANGUL_LEADING_FIRST + HANGUL_LEADING_COUNT)
+				{
+					if(second >= HANGUL_VOWEL_FIRST && second < HANGUL_VOWEL_FIRST + HANGUL_VOWEL_COUNT)
+						return HANGUL_SYLLABLE_FIRST + ((first - HANGUL_LEADING_FIRST) * HANGUL_VOWEL_COUNT + second - HANGUL_VOWEL_FIRST) * HANGUL_TRAILING_COUNT;
+					return 0;
+				}
+				if(first >= HANGUL_SYLLABLE_FIRST && first < HANGUL_SYLLABLE_FIRST + HANGUL_SYLLABLE_COUNT)
+				{
+					if((first - HANGUL_SYLLABLE_FIRST) % HANGUL_TRAILING_COUNT == 0 && second > HANGUL_TRAILING_BASE && second < HANGUL_TRAILING_BASE + HANGUL_TRAILING_COUNT)
+						return first + second - HANGUL_TRAILING_BASE;
+					return 0;
+				}
+				const auto found = std::lower_bound(NORMALIZATION_COMPOSITIONS.begin(), NORMALIZATION_COMPOSITIONS.end(), std::make_pair(first, second),
+					[](const normalization_composition& composition, const std::pair<char32_t, char32_t>& pair)
+					{
+						return composition.first < pair.first || (composition.first == pair.first && composition.second < pair.second);
+					});
+				if(found == NORMALIZATION_COMPOSITIONS.end() || found->first != first || found->second != second)
+					return 0;
+				return found->composite;
+			}
+
+			// Canonical composition of a segment in canonical order.
+			static void compose(segment& codepoints) noexcept
+			{
+				if(codepoints.empty())
+					return;
+				u64 starter = 0;
+				// Above all canonical combining classes when the segment does not start with a starter, so nothing composes with it.
+				u16 last_ccc = codepoints[0].ccc == 0 ? 0 : 0x100;
+				u64 written = 1;
+				for(u64 i = 1; i < codepoints.size(); ++i)
+				{
+					const segment_codepoint current = codepoints[i];
+					if(last_ccc < current.ccc || last_ccc == 0)
+					{
+						if(const char32_t composite = compose_pair(codepoints[starter].cp, current.cp); composite != 0)
+						{
+							codepoints[starter].cp = composite;
+							continue;
+						}
+					}
+					if(current.ccc == 0)
+						starter = written;
+					last_ccc = current.ccc;
+					codepoints[written++] = current;
+				}
+				codepoints.resize(written);
+			}
+
+			static u64 write_codepoint(const char32_t cp, char* destination) noexcept
+			{
+				if(cp <= unicode::get_utf8_maximum_codepoint(1))
+				{
+					destination[0] = static_cast<char>(cp);
+					return 1;
+				}
+				if(cp <= unicode::get_utf8_maximum_codepoint(2))
+				{
+					destination[0] = static_cast<char>((cp >> 6) | 0xc0);
+					destination[1] = static_cast<char>((cp & 0x3f) | 0x80);
+					return 2;
+				}
+				if(cp <= unicode::get_utf8_maximum_codepoint(3))
+				{
+					destination[0] = static_cast<char>((cp >> 12) | 0xe0);
+					destination[1] = static_cast<char>(((cp >> 6) & 0x3f) | 0x80);
+					destination[2] = static_cast<char>((cp & 0x3f) | 0x80);
+					return 3;
+				}
+				if(cp >= ILL_FORMED_BASE)
+				{
+					destination[0] = static_cast<char>(cp - ILL_FORMED_BASE);
+					return 1;
+				}
+				destination[0] = static_cast<char>((cp >> 18) | 0xf0);
+				destination[1] = static_cast<char>(((cp >> 12) & 0x3f) | 0x80);
+				destination[2] = static_cast<char>(((cp >> 6) & 0x3f) | 0x80);
+				destination[3] = static_cast<char>((cp & 0x3f) | 0x80);
+				return 4;
+			}
+
+			static void write_segment(codeunit_sequence& destination, const segment& codepoints) noexcept
+			{
+				// Left uninitialized, as only the code units written are appended.
+				std::array<char, 256> buffer;
+				u64 written = 0;
+				for(const segment_codepoint& current : codepoints)
+				{
+					if(buffer.size() - written < unicode::UTF8_SEQUENCE_MAXIMUM_LENGTH)
+					{
+						destination.append(codeunit_sequence_view{ buffer.data(), written });
+						written = 0;
+					}
+					written += write_codepoint(current.cp, buffer.data() + written);
+				}
+				destination.append(codeunit_sequence_view{ buffer.data(), written });
+			}
+
+			/**
+			 * \brief Normalize the segment of source from a position text can be split before, past the codepoint failing the quick check,
+			 * up to the next codepoint text can be split before and which passes the quick check, where scanning goes on.
+			 * Codepoints failing the quick check in a row, e.g. Hangul syllables decomposed, are normalized as one segment up to a soft limit.
+			 * @param start position of the segment
+			 * @param position position of the codepoint failing the quick check
+			 * @return position of the end of the segment
+			 */
+			static u64 normalize_segment(codeunit_sequence& destination, const char* input, const u64 size, const u64 start, const u64 position, const normalization_form form, segment& codepoints) noexcept
+			{
+				const u8 unchecked = get_normalization_no_flag(form) | get_normalization_maybe_flag(form);
+				codepoints.clear();
+				codepoints.reserve(SEGMENT_CAPACITY);
+				u64 i = start;
+				while(i < size)
+				{
+					char32_t cp = 0;
+					const u64 length = unicode::decode_utf8(input + i, size - i, cp);
+					if(length == 0)
+					{
+						if(i > position)
+							break;
+						codepoints.push_back({ ILL_FORMED_BASE + static_cast<u8>(input[i]), 0 });
+						++i;
+						continue;
+					}
+					const normalization_record& record = get_normalization_record(cp);
+					if(i > position && is_boundary_before(record, form) && ((record.flags & unchecked) == 0 || codepoints.size() >= SEGMENT_SIZE_SOFT_LIMIT))
+						break;
+					decompose(codepoints, cp, record, form);
+					i += length;
+				}
+				reorder(codepoints);
+				if(is_composing(form))
+					compose(codepoints);
+				write_segment(destination, codepoints);
+				return i;
+			}
+
+			static void normalize(codeunit_sequence& destination, const codeunit_sequence_view& source, const normalization_form form) noexcept
+			{
+				const char* input = source.data();
+				const u64 size = source.size();
+				// Most text is already normalized, so the normalized text is estimated to be as long as source.
+				destination.reserve(destination.size() + size);
+				// Allocated at the first segment to normalize.
+				segment codepoints;
+				// Codepoints passing the quick check are copied later as a run, which is the whole text when it is normalized.
+				u64 run = 0;
+				u64 position = 0;
+				u64 boundary = 0;
+				u8 last_ccc = 0;
+				while(scan<true>(input, size, form, position, boundary, last_ccc) != normalization_check::yes)
+				{
+					const u64 start = std::max(run, boundary);
+					destination.append(codeunit_sequence_view{ input + run, start - run });
+					const u64 end = normalize_segment(destination, input, size, start, position, form, codepoints);
+					run = end;
+					position = end;
+					boundary = end;
+					last_ccc = 0;
+				}
+				destination.append(codeunit_sequence_view{ input + run, size - run });
+			}
+		};
+	}
+
+	normalization_check quick_check_normalization(const codeunit_sequence_view& source, const normalization_form form) noexcept
+	{
+		u64 position = 0;
+		u64 boundary = 0;
+		u8 last_ccc = 0;
+		return details::normalization_writer::scan<false>(source.data(), source.size(), form, position, boundary, last_ccc);
+	}
+
+	bool is_normalized(const text_view& source, const normalization_form form) noexcept
+	{
+		const normalization_check check = quick_check_normalization(source.raw(), form);
+		if(check != normalization_check::maybe)
+			return check == normalization_check::yes;
+		codeunit_sequence normalized;
+		details::normalization_writer::normalize(normalized, source.raw(), form);
+		return normalized == source.raw();
+	}
+
+	void normalize_to(codeunit_sequence& destination, const codeunit_sequence_view& source, const normalization_form form) noexcept
+	{
+		details::normalization_writer::normalize(destination, source, form);
+	}
+
+	text normalize(const text_view& source, const normalization_form form) noexcept
+	{
+		codeunit_sequence result;
+		normalize_to(result, source.raw(), form);
+		return text{ std::move(result) };
+	}
+
+	// code-region-start: constructors
+
+	normalizer::normalizer(const normalization_form form) noexcept
+		: form_(form)
+	{ }
+
+	// code-region-end: constructors
+
+	void normalizer::normalize_to(codeunit_sequence& destination, const codeunit_sequence_view& chunk) noexcept
+	{
+		using details::normalization_writer;
+		const char* input = chunk.data();
+		const u64 size = chunk.size();
+		u64 start = 0;
+		if(!this->pending_.is_empty())
+		{
+			// The tail kept is normalized with the start of chunk, up to where they stop depending on each other.
+			start = normalization_writer::find_first_boundary(input, size, this->form_);
+			this->pending_.append(chunk.subview(0, start));
+			if(start == size)
+				return;
+			normalization_writer::normalize(destination, this->pending_.view(), this->form_);
+			this->pending_.empty();
+		}
+		const u64 end = start + normalization_writer::find_last_boundary(input + start, size - start, this->form_);
+		normalization_writer::normalize(destination, chunk.subview(start, end - start), this->form_);
+		this->pending_.append(chunk.subview(end));
+	}
+
+	void normalizer::finish(codeunit_sequence& destination) noexcept
+	{
+		details::normalization_writer::normalize(destination, this->pending_.view(), this->form_);
+		this->pending_.empty();
+	}
+
+	normalization_form normalizer::get_form() const noexcept
+	{
+		return this->form_;
+	}
+
+	u64 normalizer::get_pending_size() const noexcept
+	{
+		return this->pending_.size();
+	}
+}
@@ -0,0 +1,348 @@
+
+#include "parse.h"
+
+#include <array>
+#include <charconv>
+#include <cstring>
+#if !defined(__cpp_lib_to_chars)
+#include <cerrno>
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#endif
+
+namespace ostr
+{
+    namespace details
+    {
+        // Count of decimal digits which never overflow u64.
+        static constexpr u64 SAFE_DECIMAL_DIGIT_COUNT = 19;
+
+        /// @return value of the digit in base 36, or 36 if c is not a digit
+        [[nodiscard]] constexpr u32 to_digit(const char c) noexcept
+        {
+            if(c >= '0' && c <= '9')
+                return static_cast<u32>(c - '0');
+            if(c >= 'a' && c <= 'z')
+                return static_cast<u32>(c - 'a') + 10;
+            if(c >= 'A' && c <= 'Z')
+                return static_cast<u32>(c - 'A') + 10;
+            return 36;
+        }
+
+        [[nodiscard]] inline u64 read_eight_codeunits(const char* data) noexcept
+        {
+            // All supported platforms are little-endian, so the first code unit is the lowest byte.
+            u64 word = 0;
+            std::memcpy(&word, data, sizeof(u64));
+            return word;
+        }
+
+        [[nodiscard]] constexpr bool is_eight_digits(const u64 word) noexcept
+        {
+            // Every byte is in ['0', '9'] if its high nibble is 3 and adding 6 does not carry into the high nibble.
+            return (((word & 0xF0F0F0F0F0F0F0F0ull) | (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull);
+        }
+
+        [[nodiscard]] constexpr u64 parse_eight_digits(u64 word) noexcept
+        {
+            // Combine pairs of digits, then pairs of pairs, then the two halves, each by a single multiplication.
+            word = (word & 0x0F0F0F0F0F0F0F0Full) * 2561 >> 8;
+            word = (word & 0x00FF00FF00FF00FFull) * 6553601 >> 16;
+            return (word & 0x0000FFFF0000FFFFull) * 42949672960001ull >> 32;
+        }
+
+        /// @return value of the decimal digit, or a value larger than 9 if c is not a decimal digit
+        [[nodiscard]] constexpr u32 to_decimal_digit(const char c) noexcept
+        {
+            return static_cast<u32>(static_cast<u8>(c)) - '0';
+        }
+
+        parse_result<u64> parse_decimal_magnitude(const codeunit_sequence_view& view) noexcept
+        {
+            const char* data = view.data();
+            const u64 size = view.size();
+            u64 index = 0;
+            // Leading zeros never overflow.
+            while(index < size && data[index] == '0')
+                ++index;
+            // Digits before safe_last never overflow, so they are parsed without checks.
+            const u64 safe_last = minimum(size, index + SAFE_DECIMAL_DIGIT_COUNT);
+            u64 value = 0;
+            while(index + 8 <= safe_last)
+            {
+                const u64 word = read_eight_codeunits(data + index);
+                if(!is_eight_digits(word))
+                    break;
+                value = value * 100000000 + parse_eight_digits(word);
+                index += 8;
+            }
+            for(; index < safe_last; ++index)
+            {
+                const u32 digit = to_decimal_digit(data[index]);
+                if(digit > 9)
+                    break;
+                value = value * 10 + digit;
+            }
+            bool overflow = false;
+            if(index == safe_last)
+            {
+                for(; index < size; ++index)
+                {
+                    const u32 digit = to_decimal_digit(data[index]);
+                    if(digit > 9)
+                        break;
+                    overflow |= value > (std::numeric_limits<u64>::max() - digit) / 10;
+                    value = value * 10 + digit;
+                }
+            }
+            parse_result<u64> result;
+            if(index == 0)
+                return result;
+            result.consumed = index;
+            result.value = overflow ? 0 : value;
+            result.status = overflow ? parse_status::overflow : parse_status::succeeded;
+            return result;
+        }
+
+        parse_result<u64> parse_magnitude(const codeunit_sequence_view& view, const u32 base) noexcept
+        {
+            if(base == 10)
+                return parse_decimal_magnitude(view);
+            const char* data = view.data();
+            const u64 size = view.size();
+            u64 value = 0;
+            bool overflow = false;
+            u64 index = 0;
+            for(; index < size; ++index)
+            {
+                const u32 digit = to_digit(data[index]);
+                if(digit >= base)
+                    break;
+                if(!overflow)
+                {
+                    overflow = value > (std::numeric_limits<u64>::max() - digit) / base;
+                    value = value * base + digit;
+                }
+            }
+            parse_result<u64> result;
+            if(index == 0)
+                return result;
+            result.consumed = index;
+            result.value = overflow ? 0 : value;
+            result.status = overflow ? parse_status::overflow : parse_status::succeeded;
+            return result;
+        }
+
+        /**
+         * \brief A decimal float split by its syntax, mantissa * 10^exponent.
+         */
+        struct decimal_float
+        {
+            u64 mantissa = 0;
+            i64 exponent = 0;
+            // Count of code units of the float, 0 if there is not a float.
+            u64 size = 0;
+            bool negative = false;
+            // Too many significant digits to keep in mantissa.
+            bool truncated = false;
+        };
+
+        [[nodiscard]] decimal_float scan_decimal_float(const codeunit_sequence_view& view) noexcept
+        {
+            decimal_float result;
+            const char* data = view.data();
+            const u64 size = view.size();
+            u64 index = 0;
+            if(index < size && (data[index] == '+' || data[index] == '-'))
+            {
+                result.negative = data[index] == '-';
+                ++index;
+            }
+            u64 digit_count = 0;
+            u64 significant_count = 0;
+            const auto take_digit = [&result, &significant_count](const u32 digit)
+            {
+                if(significant_count == 0 && digit == 0)
+                    return false;
+                if(significant_count < SAFE_DECIMAL_DIGIT_COUNT)
+                {
+                    result.mantissa = result.mantissa * 10 + digit;
+                    ++significant_count;
+                    return false;
+                }
+                result.truncated |= digit != 0;
+                return true;
+            };
+            for(; index < size && to_decimal_digit(data[index]) <= 9; ++index, ++digit_count)
+            {
+                if(take_digit(to_decimal_digit(data[index])))
+                    ++result.exponent;
+            }
+            if(index < size && data[index] == '.')
+            {
+                ++index;
+                for(; index < size && to_decimal_digit(data[index]) <= 9; ++index, ++digit_count)
+                {
+                    if(!take_digit(to_decimal_digit(data[index])))
+                        --result.exponent;
+                }
+            }
+            if(digit_count == 0)
+                return { };
+            result.size = index;
+            if(index < size && (data[index] == 'e' || data[index] == 'E'))
+            {
+                const parse_result<i64> exponent = parse_integer<i64>(view.subview(index + 1));
+                // A malformed exponent is not a part of the float.
+                if(exponent.status != parse_status::invalid)
+                {
+                    static constexpr i64 exponent_limit = 100000;
+                    // Exponents beyond the limit are all infinity or zero.
+                    i64 clamped = view.read_at(index + 1) == '-' ? -exponent_limit : exponent_limit;
+                    if(exponent.succeeded() && exponent.value > -exponent_limit && exponent.value < exponent_limit)
+                        clamped = exponent.value;
+                    result.exponent += clamped;
+                    result.size = index + 1 + exponent.consumed;
+                }
+            }
+            return result;
+        }
+
+        [[nodiscard]] u64 scan_special_float(const codeunit_sequence_view& view) noexcept
+        {
+            u64 index = 0;
+            if(!view.is_empty() && (view.read_at(0) == '+' || view.read_at(0) == '-'))
+                ++index;
+            const auto matches = [&view, index](const codeunit_sequence_view& word)
+            {
+                if(view.size() - index < word.size())
+                    return false;
+                for(u64 i = 0; i < word.size(); ++i)
+                {
+                    const char c = view.read_at(index + i);
+                    if(c != word.read_at(i) && c != word.read_at(i) - ('a' - 'A'))
+                        return false;
+                }
+                return true;
+            };
+            if(matches("infinity"_cuqv))
+                return index + 8;
+            if(matches("inf"_cuqv) || matches("nan"_cuqv))
+                return index + 3;
+            return 0;
+        }
+
+        /**
+         * \brief Round a float by the standard library, which rounds correctly with Eisel-Lemire and big numbers.
+         * \param first first code unit of a float scanned before, without a sign of '+'
+         * \param last end of the float
+         * \return the value, with status overflow if it is out of range of T in either direction
+         */
+        template<class T>
+        [[nodiscard]] parse_result<T> round_by_library(const char* first, const char* last) noexcept
+        {
+            parse_result<T> result;
+#if defined(__cpp_lib_to_chars)
+            const auto [ parsed_last, error ] = std::from_chars(first, last, result.value);
+            result.consumed = static_cast<u64>(parsed_last - first);
+            if(error == std::errc::result_out_of_range)
+                result.status = parse_status::overflow;
+            else if(error == std::errc{ })
+                result.status = parse_status::succeeded;
+            else
+                result.consumed = 0;
+#else
+            // Floating from_chars is missing from some standard libraries, like libc++ on macOS before 13.3.
+            // strtod reads a terminated copy, with the decimal point of the current locale.
+            const u64 size = static_cast<u64>(last - first);
+            std::array<char, 64> inline_buffer;
+            std::unique_ptr<char[]> heap_buffer;
+            char* buffer = inline_buffer.data();
+            if(size >= inline_buffer.size())
+            {
+                heap_buffer.reset(new char[size + 1]);
+                buffer = heap_buffer.get();
+            }
+            const char decimal_point = *std::localeconv()->decimal_point;
+            for(u64 i = 0; i < size; ++i)
+                buffer[i] = first[i] == '.' ? decimal_point : first[i];
+            buffer[size] = 0;
+            char* parsed_last = buffer;
+            errno = 0;
+            if constexpr (std::is_same_v<T, f32>)
+                result.value = std::strtof(buffer, &parsed_last);
+            else
+                result.value = std::strtod(buffer, &parsed_last);
+            result.consumed = static_cast<u64>(parsed_last - buffer);
+            // Underflow is reported by ERANGE as well, but the value is already rounded to zero or a denormal.
+            if(errno == ERANGE && std::isinf(result.value))
+                result.status = parse_status::overflow;
+            else if(result.consumed != 0)
+                result.status = parse_status::succeeded;
+#endif
+            return result;
+        }
+
+        template<class T>
+        [[nodiscard]] parse_result<T> parse_floating(const codeunit_sequence_view& view) noexcept
+        {
+            // Powers of ten exactly representable, 10^22 for f64 and 10^10 for f32.
+            static constexpr i64 exact_power_limit = std::is_same_v<T, f64> ? 22 : 10;
+            static constexpr std::array<T, 23> exact_powers
+            {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+            static constexpr u64 exact_mantissa_limit = 1ull << std::numeric_limits<T>::digits;
+
+            parse_result<T> result;
+            const decimal_float decimal = scan_decimal_float(view);
+            u64 size = decimal.size;
+            if(size == 0)
+            {
+                size = scan_special_float(view);
+                if(size == 0)
+                    return result;
+            }
+            else if(!decimal.truncated && decimal.mantissa <= exact_mantissa_limit &&
+                decimal.exponent >= -exact_power_limit && decimal.exponent <= exact_power_limit)
+            {
+                // Both mantissa and the power of ten are exact, so a single operation rounds correctly.
+                T value = static_cast<T>(decimal.mantissa);
+                if(decimal.exponent >= 0)
+                    value *= exact_powers[static_cast<u64>(decimal.exponent)];
+                else
+                    value /= exact_powers[static_cast<u64>(-decimal.exponent)];
+                result.value = decimal.negative ? -value : value;
+                result.consumed = size;
+                result.status = parse_status::succeeded;
+                return result;
+            }
+            const char* first = view.data();
+            const u64 plus_size = (*first == '+') ? 1 : 0;
+            result = round_by_library<T>(first + plus_size, first + size);
+            if(result.consumed == 0)
+                return result;
+            result.consumed += plus_size;
+            if(result.status == parse_status::overflow && decimal.size != 0 && decimal.exponent < 0)
+            {
+                // Too small even for a denormal, which rounds to zero.
+                result.value = decimal.negative ? -static_cast<T>(0) : static_cast<T>(0);
+                result.status = parse_status::succeeded;
+            }
+            return result;
+        }
+
+        parse_result<f32> parse_f32(const codeunit_sequence_view& view) noexcept
+        {
+            return parse_floating<f32>(view);
+        }
+
+        parse_result<f64> parse_f64(const codeunit_sequence_view& view) noexcept
+        {
+            return parse_floating<f64>(view);
+        }
+    }
+}
@@ -0,0 +1,728 @@
+
+#include "rope.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "common/functions.h"
+
+namespace ostr
+{
+	namespace details
+	{
+		using rope_leaf_allocator = allocator<rope_leaf>;
+		using rope_branch_allocator = allocator<rope_branch>;
+
+		[[nodiscard]] static rope_leaf* as_leaf(rope_node* node) noexcept
+		{
+			return static_cast<rope_leaf*>(node);
+		}
+
+		[[nodiscard]] static rope_branch* as_branch(rope_node* node) noexcept
+		{
+			return static_cast<rope_branch*>(node);
+		}
+
+		[[nodiscard]] static rope_leaf* make_leaf(const char* data, const u64 size) noexcept
+		{
+			rope_leaf* leaf = rope_leaf_allocator::allocate_single();
+			std::memcpy(leaf->data.data(), data, size);
+			leaf->raw_size = size;
+			leaf->size = unicode::count_utf8_codepoints(data, size);
+			leaf->height = 0;
+			return leaf;
+		}
+
+		static void refresh_branch(rope_branch* branch) noexcept
+		{
+			branch->raw_size = 0;
+			branch->size = 0;
+			for(u64 i = 0; i < branch->count; ++i)
+			{
+				branch->raw_size += branch->children[i]->raw_size;
+				branch->size += branch->children[i]->size;
+			}
+		}
+
+		// Children are of the same height, count is 2 at least.
+		[[nodiscard]] static rope_branch* make_branch(rope_node* const* children, const u64 count) noexcept
+		{
+			rope_branch* branch = rope_branch_allocator::allocate_single();
+			std::copy_n(children, count, branch->children.data());
+			branch->count = count;
+			branch->height = children[0]->height + 1;
+			OPEN_STRING_CHECK(branch->height < ROPE_HEIGHT_MAXIMUM, "Rope is too high [{}]!", branch->height);
+			refresh_branch(branch);
+			return branch;
+		}
+
+		// Node of the children, without a branch of a single child.
+		[[nodiscard]] static rope_node* gather(rope_node* const* children, const u64 count) noexcept
+		{
+			if(count == 0)
+				return nullptr;
+			if(count == 1)
+				return children[0];
+			return make_branch(children, count);
+		}
+
+		static void destroy(rope_node* node) noexcept
+		{
+			if(node == nullptr)
+				return;
+			if(node->height == 0)
+			{
+				rope_leaf_allocator::deallocate_single(as_leaf(node));
+				return;
+			}
+			rope_branch* branch = as_branch(node);
+			for(u64 i = 0; i < branch->count; ++i)
+				destroy(branch->children[i]);
+			rope_branch_allocator::deallocate_single(branch);
+		}
+
+		[[nodiscard]] static rope_node* clone(const rope_node* node) noexcept
+		{
+			if(node == nullptr)
+				return nullptr;
+			if(node->height == 0)
+			{
+				rope_leaf* leaf = rope_leaf_allocator::allocate_single();
+				*leaf = *static_cast<const rope_leaf*>(node);
+				return leaf;
+			}
+			const rope_branch* source = static_cast<const rope_branch*>(node);
+			rope_branch* branch = rope_branch_allocator::allocate_single();
+			*branch = *source;
+			for(u64 i = 0; i < branch->count; ++i)
+				branch->children[i] = clone(source->children[i]);
+			return branch;
+		}
+
+		// Build a balanced tree bottom-up, leaves are filled evenly so that none of them is too small.
+		[[nodiscard]] static rope_node* build(const codeunit_sequence_view& view) noexcept
+		{
+			const u64 view_size = view.size();
+			if(view_size == 0)
+				return nullptr;
+			const char* data = view.data();
+			std::vector<rope_node*> level;
+			level.reserve((view_size + ROPE_LEAF_SIZE_MAXIMUM - 1) / ROPE_LEAF_SIZE_MAXIMUM * 2);
+			u64 offset = 0;
+			while(offset < view_size)
+			{
+				const u64 rest = view_size - offset;
+				const u64 leaf_count = (rest + ROPE_LEAF_SIZE_MAXIMUM - 1) / ROPE_LEAF_SIZE_MAXIMUM;
+				const u64 target = (rest + leaf_count - 1) / leaf_count;
+				u64 leaf_size = rest;
+				if(target < rest)
+				{
+					leaf_size = unicode::find_utf8_codepoint_boundary(data + offset, rest, target);
+					// Invalid sequences may have no boundary at all, so they are cut anywhere.
+					if(leaf_size == 0)
+						leaf_size = target;
+				}
+				level.push_back(make_leaf(data + offset, leaf_size));
+				offset += leaf_size;
+			}
+			while(level.size() > 1)
+			{
+				const u64 level_size = level.size();
+				const u64 branch_count = (level_size + ROPE_BRANCH_COUNT_MAXIMUM - 1) / ROPE_BRANCH_COUNT_MAXIMUM;
+				u64 index = 0;
+				for(u64 i = 0; i < branch_count; ++i)
+				{
+					const u64 count = (level_size - index) / (branch_count - i);
+					level[i] = gather(level.data() + index, count);
+					index += count;
+				}
+				level.resize(branch_count);
+			}
+			return level[0];
+		}
+
+		[[nodiscard]] static bool is_ok_child(const rope_node* node) noexcept
+		{
+			if(node->height == 0)
+				return node->raw_size >= ROPE_LEAF_SIZE_MINIMUM;
+			return static_cast<const rope_branch*>(node)->count >= ROPE_BRANCH_COUNT_MINIMUM;
+		}
+
+		// Merge children of the same height into one branch, or two branches under a new one if too many.
+		[[nodiscard]] static rope_node* merge_children(rope_node* const* lhs, const u64 lhs_count, rope_node* const* rhs, const u64 rhs_count) noexcept
+		{
+			std::array<rope_node*, ROPE_BRANCH_COUNT_MAXIMUM * 2> children{ };
+			std::copy_n(lhs, lhs_count, children.data());
+			std::copy_n(rhs, rhs_count, children.data() + lhs_count);
+			const u64 count = lhs_count + rhs_count;
+			if(count <= ROPE_BRANCH_COUNT_MAXIMUM)
+				return gather(children.data(), count);
+			const u64 split_count = minimum(ROPE_BRANCH_COUNT_MAXIMUM, count - ROPE_BRANCH_COUNT_MINIMUM);
+			const std::array<rope_node*, 2> halves
+			{
+				make_branch(children.data(), split_count),
+				make_branch(children.data() + split_count, count - split_count),
+			};
+			return make_branch(halves.data(), halves.size());
+		}
+
+		[[nodiscard]] static rope_node* merge_leaves(rope_leaf* lhs, rope_leaf* rhs) noexcept
+		{
+			const u64 total = lhs->raw_size + rhs->raw_size;
+			if(total <= ROPE_LEAF_SIZE_MAXIMUM)
+			{
+				std::memcpy(lhs->data.data() + lhs->raw_size, rhs->data.data(), rhs->raw_size);
+				lhs->raw_size = total;
+				lhs->size += rhs->size;
+				rope_leaf_allocator::deallocate_single(rhs);
+				return lhs;
+			}
+			std::array<char, ROPE_LEAF_SIZE_MAXIMUM * 2> data;
+			std::memcpy(data.data(), lhs->data.data(), lhs->raw_size);
+			std::memcpy(data.data() + lhs->raw_size, rhs->data.data(), rhs->raw_size);
+			u64 split_size = unicode::find_utf8_codepoint_boundary(data.data(), total, total / 2);
+			if(split_size == 0)
+				split_size = total / 2;
+			std::memcpy(lhs->data.data(), data.data(), split_size);
+			lhs->raw_size = split_size;
+			lhs->size = unicode::count_utf8_codepoints(lhs->data.data(), split_size);
+			std::memcpy(rhs->data.data(), data.data() + split_size, total - split_size);
+			rhs->raw_size = total - split_size;
+			rhs->size = unicode::count_utf8_codepoints(rhs->data.data(), rhs->raw_size);
+			const std::array<rope_node*, 2> leaves{ lhs, rhs };
+			return make_branch(leaves.data(), leaves.size());
+		}
+
+		/**
+		 * Concatenate two trees, descending the higher one along its edge to the height of the lower one.
+		 * The result is as high as the higher one, or one level higher.
+		 * Nodes which are not ok, like roots after split, are always merged into their neighbours.
+		 */
+		[[nodiscard]] static rope_node* concat(rope_node* lhs, rope_node* rhs) noexcept
+		{
+			if(lhs == nullptr)
+				return rhs;
+			if(rhs == nullptr)
+				return lhs;
+			const u64 lhs_height = lhs->height;
+			const u64 rhs_height = rhs->height;
+			if(lhs_height < rhs_height)
+			{
+				rope_branch* branch = as_branch(rhs);
+				rope_node* result;
+				if(lhs_height == rhs_height - 1 && is_ok_child(lhs))
+					result = merge_children(&lhs, 1, branch->children.data(), branch->count);
+				else
+				{
+					rope_node* merged = concat(lhs, branch->children[0]);
+					if(merged->height == rhs_height - 1)
+						result = merge_children(&merged, 1, branch->children.data() + 1, branch->count - 1);
+					else
+					{
+						rope_branch* merged_branch = as_branch(merged);
+						result = merge_children(merged_branch->children.data(), merged_branch->count, branch->children.data() + 1, branch->count - 1);
+						rope_branch_allocator::deallocate_single(merged_branch);
+					}
+				}
+				rope_branch_allocator::deallocate_single(branch);
+				return result;
+			}
+			if(lhs_height > rhs_height)
+			{
+				rope_branch* branch = as_branch(lhs);
+				rope_node* result;
+				if(rhs_height == lhs_height - 1 && is_ok_child(rhs))
+					result = merge_children(branch->children.data(), branch->count, &rhs, 1);
+				else
+				{
+					rope_node* merged = concat(branch->children[branch->count - 1], rhs);
+					if(merged->height == lhs_height - 1)
+						result = merge_children(branch->children.data(), branch->count - 1, &merged, 1);
+					else
+					{
+						rope_branch* merged_branch = as_branch(merged);
+						result = merge_children(branch->children.data(), branch->count - 1, merged_branch->children.data(), merged_branch->count);
+						rope_branch_allocator::deallocate_single(merged_branch);
+					}
+				}
+				rope_branch_allocator::deallocate_single(branch);
+				return result;
+			}
+			if(is_ok_child(lhs) && is_ok_child(rhs))
+			{
+				const std::array<rope_node*, 2> children{ lhs, rhs };
+				return make_branch(children.data(), children.size());
+			}
+			if(lhs_height == 0)
+				return merge_leaves(as_leaf(lhs), as_leaf(rhs));
+			rope_branch* lhs_branch = as_branch(lhs);
+			rope_branch* rhs_branch = as_branch(rhs);
+			rope_node* result = merge_children(lhs_branch->children.data(), lhs_branch->count, rhs_branch->children.data(), rhs_branch->count);
+			rope_branch_allocator::deallocate_single(lhs_branch);
+			rope_branch_allocator::deallocate_single(rhs_branch);
+			return result;
+		}
+
+		/**
+		 * Split a tree before the codepoint at index, the node is consumed.
+		 * Siblings on each side are gathered and concatenated with the split child, so heights telescope.
+		 */
+		static void split(rope_node* node, const u64 index, rope_node*& lhs, rope_node*& rhs) noexcept
+		{
+			if(index == 0)
+			{
+				lhs = nullptr;
+				rhs = node;
+				return;
+			}
+			if(index >= node->size)
+			{
+				lhs = node;
+				rhs = nullptr;
+				return;
+			}
+			if(node->height == 0)
+			{
+				rope_leaf* leaf = as_leaf(node);
+				const u64 offset = unicode::find_utf8_codepoint_offset(leaf->data.data(), leaf->raw_size, index);
+				rhs = make_leaf(leaf->data.data() + offset, leaf->raw_size - offset);
+				leaf->raw_size = offset;
+				leaf->size = index;
+				lhs = leaf;
+				return;
+			}
+			rope_branch* branch = as_branch(node);
+			u64 child_index = 0;
+			u64 rest = index;
+			while(rest >= branch->children[child_index]->size)
+			{
+				rest -= branch->children[child_index]->size;
+				++child_index;
+			}
+			rope_node* child_lhs = nullptr;
+			rope_node* child_rhs = nullptr;
+			split(branch->children[child_index], rest, child_lhs, child_rhs);
+			lhs = concat(gather(branch->children.data(), child_index), child_lhs);
+			rhs = concat(child_rhs, gather(branch->children.data() + child_index + 1, branch->count - child_index - 1));
+			rope_branch_allocator::deallocate_single(branch);
+		}
+
+		// Branches from the root to a leaf, and indices of children taken in them.
+		struct rope_path
+		{
+			std::array<rope_branch*, ROPE_HEIGHT_MAXIMUM> branches;
+			std::array<u64, ROPE_HEIGHT_MAXIMUM> indices;
+			u64 depth = 0;
+		};
+
+		/**
+		 * Find the leaf of the codepoint at index, recording branches and children on the path.
+		 * If at_end is true, index at the end of a leaf is found in this leaf instead of the next one.
+		 * @return index of the codepoint in the leaf
+		 */
+		[[nodiscard]] static u64 find_leaf(rope_node* root, const u64 index, const bool at_end, rope_path& path, rope_leaf*& leaf) noexcept
+		{
+			rope_node* node = root;
+			u64 rest = index;
+			path.depth = 0;
+			while(node->height > 0)
+			{
+				rope_branch* branch = as_branch(node);
+				u64 child_index = 0;
+				while(child_index + 1 < branch->count && (at_end ? rest > branch->children[child_index]->size : rest >= branch->children[child_index]->size))
+				{
+					rest -= branch->children[child_index]->size;
+					++child_index;
+				}
+				path.branches[path.depth] = branch;
+				path.indices[path.depth] = child_index;
+				++path.depth;
+				node = branch->children[child_index];
+			}
+			leaf = as_leaf(node);
+			return rest;
+		}
+
+		static void update_path(const rope_path& path, const i64 raw_delta, const i64 delta) noexcept
+		{
+			for(u64 i = 0; i < path.depth; ++i)
+			{
+				path.branches[i]->raw_size += raw_delta;
+				path.branches[i]->size += delta;
+			}
+		}
+
+		/**
+		 * Insert a node after the end of the path, splitting full branches upwards like a B-tree.
+		 * Sizes of branches on the path must already include the node.
+		 * @return the new root if the root is split, or nullptr
+		 */
+		[[nodiscard]] static rope_node* insert_after(const rope_path& path, rope_node* root, rope_node* node) noexcept
+		{
+			rope_node* sibling = node;
+			for(u64 level = path.depth; level > 0; --level)
+			{
+				rope_branch* branch = path.branches[level - 1];
+				const u64 position = path.indices[level - 1] + 1;
+				std::array<rope_node*, ROPE_BRANCH_COUNT_MAXIMUM + 1> children{ };
+				std::copy_n(branch->children.data(), position, children.data());
+				children[position] = sibling;
+				std::copy_n(branch->children.data() + position, branch->count - position, children.data() + position + 1);
+				const u64 count = branch->count + 1;
+				if(count <= ROPE_BRANCH_COUNT_MAXIMUM)
+				{
+					std::copy_n(children.data(), count, branch->children.data());
+					branch->count = count;
+					return nullptr;
+				}
+				const u64 split_count = count / 2;
+				std::copy_n(children.data(), split_count, branch->children.data());
+				branch->count = split_count;
+				refresh_branch(branch);
+				sibling = make_branch(children.data() + split_count, count - split_count);
+			}
+			const std::array<rope_node*, 2> children{ root, sibling };
+			return make_branch(children.data(), children.size());
+		}
+	}
+
+	// code-region-start: constructors
+
+	rope::rope() noexcept = default;
+
+	rope::rope(const rope& other) noexcept
+		: root_(details::clone(other.root_))
+	{ }
+
+	rope::rope(rope&& other) noexcept
+		: root_(other.root_)
+	{
+		other.root_ = nullptr;
+	}
+
+	rope& rope::operator=(const rope& other) noexcept
+	{
+		if(this != &other)
+		{
+			details::destroy(this->root_);
+			this->root_ = details::clone(other.root_);
+		}
+		return *this;
+	}
+
+	rope& rope::operator=(rope&& other) noexcept
+	{
+		if(this != &other)
+		{
+			details::destroy(this->root_);
+			this->root_ = other.root_;
+			other.root_ = nullptr;
+		}
+		return *this;
+	}
+
+	rope::~rope() noexcept
+	{
+		details::destroy(this->root_);
+	}
+
+	rope::rope(const char* str) noexcept
+		: rope(text_view{ str })
+	{ }
+
+	rope::rope(const text_view& view) noexcept
+		: root_(details::build(view.raw()))
+	{ }
+
+	rope::rope(const text& t) noexcept
+		: root_(details::build(t.raw().view()))
+	{ }
+
+	// code-region-end: constructors
+
+	// code-region-start: iterators
+
+	rope::chunk_iterator::chunk_iterator(const details::rope_node* root) noexcept
+	{
+		if(root != nullptr)
+			this->descend(root);
+	}
+
+	text_view rope::chunk_iterator::operator*() const noexcept
+	{
+		return { this->leaf_->data.data(), this->leaf_->raw_size };
+	}
+
+	rope::chunk_iterator& rope::chunk_iterator::operator++() noexcept
+	{
+		while(this->depth_ > 0)
+		{
+			const u64 level = this->depth_ - 1;
+			if(++this->indices_[level] < this->branches_[level]->count)
+			{
+				this->descend(this->branches_[level]->children[this->indices_[level]]);
+				return *this;
+			}
+			--this->depth_;
+		}
+		this->leaf_ = nullptr;
+		return *this;
+	}
+
+	rope::chunk_iterator rope::chunk_iterator::operator++(int) noexcept
+	{
+		chunk_iterator tmp = *this;
+		++*this;
+		return tmp;
+	}
+
+	bool rope::chunk_iterator::operator==(const chunk_iterator& rhs) const noexcept
+	{
+		return this->leaf_ == rhs.leaf_;
+	}
+
+	bool rope::chunk_iterator::operator!=(const chunk_iterator& rhs) const noexcept
+	{
+		return !(*this == rhs);
+	}
+
+	void rope::chunk_iterator::descend(const details::rope_node* node) noexcept
+	{
+		while(node->height > 0)
+		{
+			const details::rope_branch* branch = static_cast<const details::rope_branch*>(node);
+			this->branches_[this->depth_] = branch;
+			this->indices_[this->depth_] = 0;
+			++this->depth_;
+			node = branch->children[0];
+		}
+		this->leaf_ = static_cast<const details::rope_leaf*>(node);
+	}
+
+	rope::chunk_range rope::chunks() const noexcept
+	{
+		return { this->root_ };
+	}
+
+	// code-region-end: iterators
+
+	u64 rope::size() const noexcept
+	{
+		return this->root_ ? this->root_->size : 0;
+	}
+
+	u64 rope::raw_size() const noexcept
+	{
+		return this->root_ ? this->root_->raw_size : 0;
+	}
+
+	bool rope::is_empty() const noexcept
+	{
+		return this->root_ == nullptr;
+	}
+
+	bool rope::operator==(const text_view& rhs) const noexcept
+	{
+		const codeunit_sequence_view rhs_raw = rhs.raw();
+		if(this->raw_size() != rhs_raw.size())
+			return false;
+		u64 offset = 0;
+		for(const text_view chunk : this->chunks())
+		{
+			const codeunit_sequence_view chunk_raw = chunk.raw();
+			if(chunk_raw != rhs_raw.subview(offset, chunk_raw.size()))
+				return false;
+			offset += chunk_raw.size();
+		}
+		return true;
+	}
+
+	bool rope::operator==(const rope& rhs) const noexcept
+	{
+		if(this->raw_size() != rhs.raw_size())
+			return false;
+		// Chunks of the two ropes may be cut at different places.
+		chunk_iterator lhs_it = this->chunks().begin();
+		chunk_iterator rhs_it = rhs.chunks().begin();
+		codeunit_sequence_view lhs_rest;
+		codeunit_sequence_view rhs_rest;
+		while(true)
+		{
+			if(lhs_rest.is_empty())
+			{
+				if(lhs_it == chunk_iterator{ })
+					return true;
+				lhs_rest = (*lhs_it++).raw();
+			}
+			if(rhs_rest.is_empty())
+				rhs_rest = (*rhs_it++).raw();
+			const u64 count = minimum(lhs_rest.size(), rhs_rest.size());
+			if(lhs_rest.subview(0, count) != rhs_rest.subview(0, count))
+				return false;
+			lhs_rest = lhs_rest.subview(count);
+			rhs_rest = rhs_rest.subview(count);
+		}
+	}
+
+	bool rope::operator!=(const text_view& rhs) const noexcept
+	{
+		return !(*this == rhs);
+	}
+
+	bool rope::operator!=(const rope& rhs) const noexcept
+	{
+		return !(*this == rhs);
+	}
+
+	codepoint rope::read_at(const u64 index) const noexcept
+	{
+		OPEN_STRING_CHECK(index < this->size(), "Index [{}] out of range [0, {})!", index, this->size());
+		details::rope_path path;
+		details::rope_leaf* leaf = nullptr;
+		const u64 leaf_index = details::find_leaf(this->root_, index, false, path, leaf);
+		const u64 offset = unicode::find_utf8_codepoint_offset(leaf->data.data(), leaf->raw_size, leaf_index);
+		return codepoint{ leaf->data.data() + offset };
+	}
+
+	codepoint rope::operator[](const u64 index) const noexcept
+	{
+		return this->read_at(index);
+	}
+
+	rope& rope::insert(const u64 index, const text_view& view) noexcept
+	{
+		const codeunit_sequence_view raw = view.raw();
+		const u64 raw_size = raw.size();
+		if(raw_size == 0)
+			return *this;
+		const u64 actual_index = minimum(index, this->size());
+		if(this->root_ != nullptr && raw_size <= details::ROPE_LEAF_SIZE_MAXIMUM)
+		{
+			// Insert into the leaf in place, which is the common case of typing.
+			details::rope_path path;
+			details::rope_leaf* leaf = nullptr;
+			const u64 leaf_index = details::find_leaf(this->root_, actual_index, true, path, leaf);
+			const u64 offset = unicode::find_utf8_codepoint_offset(leaf->data.data(), leaf->raw_size, leaf_index);
+			const u64 count = unicode::count_utf8_codepoints(raw.data(), raw_size);
+			details::update_path(path, static_cast<i64>(raw_size), static_cast<i64>(count));
+			const u64 total = leaf->raw_size + raw_size;
+			if(total <= details::ROPE_LEAF_SIZE_MAXIMUM)
+			{
+				char* target = leaf->data.data() + offset;
+				std::memmove(target + raw_size, target, leaf->raw_size - offset);
+				std::memcpy(target, raw.data(), raw_size);
+				leaf->raw_size = total;
+				leaf->size += count;
+				return *this;
+			}
+			// Split the leaf in halves if it is full, so that only one leaf is allocated.
+			std::array<char, details::ROPE_LEAF_SIZE_MAXIMUM * 2> data;
+			const char* source = leaf->data.data();
+			std::memcpy(data.data(), source, offset);
+			std::memcpy(data.data() + offset, raw.data(), raw_size);
+			std::memcpy(data.data() + offset + raw_size, source + offset, leaf->raw_size - offset);
+			u64 split_size = unicode::find_utf8_codepoint_boundary(data.data(), total, total / 2);
+			if(split_size == 0)
+				split_size = total / 2;
+			std::memcpy(leaf->data.data(), data.data(), split_size);
+			leaf->raw_size = split_size;
+			leaf->size = unicode::count_utf8_codepoints(data.data(), split_size);
+			details::rope_leaf* sibling = details::make_leaf(data.data() + split_size, total - split_size);
+			if(details::rope_node* root = details::insert_after(path, this->root_, sibling))
+				this->root_ = root;
+			return *this;
+		}
+		details::rope_node* lhs = nullptr;
+		details::rope_node* rhs = nullptr;
+		if(this->root_ != nullptr)
+			details::split(this->root_, actual_index, lhs, rhs);
+		this->root_ = details::concat(details::concat(lhs, details::build(raw)), rhs);
+		return *this;
+	}
+
+	rope& rope::erase(const u64 index, const u64 size) noexcept
+	{
+		const u64 self_size = this->size();
+		if(index >= self_size || size == 0)
+			return *this;
+		const u64 actual_size = minimum(size, self_size - index);
+		{
+			// Erase from the leaf in place if the leaf is still large enough afterwards.
+			details::rope_path path;
+			details::rope_leaf* leaf = nullptr;
+			const u64 leaf_index = details::find_leaf(this->root_, index, false, path, leaf);
+			if(leaf_index + actual_size <= leaf->size)
+			{
+				char* data = leaf->data.data();
+				const u64 from = unicode::find_utf8_codepoint_offset(data, leaf->raw_size, leaf_index);
+				const u64 to = from + unicode::find_utf8_codepoint_offset(data + from, leaf->raw_size - from, actual_size);
+				const u64 raw_size = to - from;
+				const bool is_root = leaf == this->root_;
+				if(leaf->raw_size - raw_size >= details::ROPE_LEAF_SIZE_MINIMUM || (is_root && leaf->size > actual_size))
+				{
+					std::memmove(data + from, data + to, leaf->raw_size - to);
+					leaf->raw_size -= raw_size;
+					leaf->size -= actual_size;
+					details::update_path(path, -static_cast<i64>(raw_size), -static_cast<i64>(actual_size));
+					return *this;
+				}
+			}
+		}
+		details::rope_node* lhs = nullptr;
+		details::rope_node* rest = nullptr;
+		details::split(this->root_, index, lhs, rest);
+		details::rope_node* erased = nullptr;
+		details::rope_node* rhs = nullptr;
+		details::split(rest, actual_size, erased, rhs);
+		details::destroy(erased);
+		this->root_ = details::concat(lhs, rhs);
+		return *this;
+	}
+
+	rope& rope::append(const text_view& view) noexcept
+	{
+		return this->insert(this->size(), view);
+	}
+
+	rope& rope::append(rope&& other) noexcept
+	{
+		if(this != &other)
+		{
+			this->root_ = details::concat(this->root_, other.root_);
+			other.root_ = nullptr;
+		}
+		return *this;
+	}
+
+	rope& rope::operator+=(const text_view& view) noexcept
+	{
+		return this->append(view);
+	}
+
+	rope& rope::operator+=(rope&& other) noexcept
+	{
+		return this->append(std::move(other));
+	}
+
+	rope rope::split(const u64 index) noexcept
+	{
+		rope result;
+		if(this->root_ != nullptr)
+			details::split(this->root_, index, this->root_, result.root_);
+		return result;
+	}
+
+	void rope::empty() noexcept
+	{
+		details::destroy(this->root_);
+		this->root_ = nullptr;
+	}
+
+	text rope::to_text() const noexcept
+	{
+		codeunit_sequence sequence{ this->raw_size() };
+		for(const text_view chunk : this->chunks())
+			sequence.append(chunk.raw());
+		return text{ std::move(sequence) };
+	}
+}
@@ -0,0 +1,212 @@
+
+#include "string_builder.h"
+
+#include <algorithm>
+#include "common/functions.h"
+
+#include "write_vectors.h"
+
+namespace ostr
+{
+	namespace details
+	{
+		// Size of a chunk is kept in 31 bits of a sequence.
+		static constexpr u64 STRING_BUILDER_CHUNK_SIZE_MAXIMUM = (1ull << 31) - 1;
+	}
+
+	// code-region-start: constructors
+
+	string_builder::string_builder(const u64 size) noexcept
+	{
+		if(size > 0)
+			this->next_chunk(size);
+	}
+
+	string_builder::string_builder(string_builder&& other) noexcept
+		: chunks_(std::move(other.chunks_))
+		, current_(other.current_)
+		, committed_size_(other.committed_size_)
+		, cursor_(other.cursor_)
+		, chunk_end_(other.chunk_end_)
+	{
+		other.chunks_.clear();
+		other.current_ = 0;
+		other.committed_size_ = 0;
+		other.cursor_ = nullptr;
+		other.chunk_end_ = nullptr;
+	}
+
+	string_builder& string_builder::operator=(string_builder&& other) noexcept
+	{
+		if(this != &other)
+		{
+			// Chunks live in the heap, so cursors stay valid after the vector is moved.
+			this->chunks_ = std::move(other.chunks_);
+			this->current_ = other.current_;
+			this->committed_size_ = other.committed_size_;
+			this->cursor_ = other.cursor_;
+			this->chunk_end_ = other.chunk_end_;
+			other.chunks_.clear();
+			other.current_ = 0;
+			other.committed_size_ = 0;
+			other.cursor_ = nullptr;
+			other.chunk_end_ = nullptr;
+		}
+		return *this;
+	}
+
+	string_builder::~string_builder() noexcept = default;
+
+	// code-region-end: constructors
+
+	u64 string_builder::size() const noexcept
+	{
+		return this->committed_size_ + this->get_chunk_size(this->current_);
+	}
+
+	bool string_builder::is_empty() const noexcept
+	{
+		return this->size() == 0;
+	}
+
+	u64 string_builder::chunk_count() const noexcept
+	{
+		return this->chunks_.empty() ? 0 : this->current_ + 1;
+	}
+
+	string_builder& string_builder::reserve(const u64 size) noexcept
+	{
+		if(static_cast<u64>(this->chunk_end_ - this->cursor_) < size)
+			this->next_chunk(size);
+		return *this;
+	}
+
+	string_builder& string_builder::append(const char codeunit, const u64 count) noexcept
+	{
+		u64 rest = count;
+		while(rest > 0)
+		{
+			if(this->cursor_ == this->chunk_end_)
+				this->next_chunk(0);
+			const u64 filled = minimum(rest, static_cast<u64>(this->chunk_end_ - this->cursor_));
+			this->cursor_ = std::fill_n(this->cursor_, filled, codeunit);
+			rest -= filled;
+		}
+		return *this;
+	}
+
+	void string_builder::empty() noexcept
+	{
+		if(this->chunks_.empty())
+			return;
+		for(u64 i = 0; i <= this->current_; ++i)
+			this->chunks_[i].empty();
+		this->current_ = 0;
+		this->committed_size_ = 0;
+		this->cursor_ = this->chunks_[0].data();
+		this->chunk_end_ = this->cursor_ + this->chunks_[0].get_capacity();
+	}
+
+	bool string_builder::write_to(const int file_descriptor) const noexcept
+	{
+		const u64 chunk_count = this->chunk_count();
+		std::vector<details::iovec> vectors;
+		vectors.reserve(chunk_count);
+		for(u64 i = 0; i < chunk_count; ++i)
+			if(const u64 chunk_size = this->get_chunk_size(i); chunk_size > 0)
+				vectors.push_back({ const_cast<char*>(this->chunks_[i].data()), chunk_size });
+		return details::write_vectors(file_descriptor, vectors.data(), vectors.size());
+	}
+
+	codeunit_sequence string_builder::finish() noexcept
+	{
+		codeunit_sequence result;
+		if(this->chunks_.empty())
+			return result;
+		this->commit_chunk();
+		if(this->current_ == 0)
+			result = std::move(this->chunks_[0]);
+		else
+		{
+			const u64 size = this->committed_size_ + this->chunks_[this->current_].size();
+			OPEN_STRING_CHECK(size <= details::STRING_BUILDER_CHUNK_SIZE_MAXIMUM, "Sequence is limited to [{}] code units, but [{}] are built! Use write_to or finish_chunks instead.", details::STRING_BUILDER_CHUNK_SIZE_MAXIMUM, size);
+			// The size would wrap in a sequence, so the chunks are kept for write_to or finish_chunks.
+			if(size > details::STRING_BUILDER_CHUNK_SIZE_MAXIMUM)
+				return result;
+			result.reserve(size);
+			for(u64 i = 0; i <= this->current_; ++i)
+				result.append(this->chunks_[i].view());
+		}
+		*this = string_builder{ };
+		return result;
+	}
+
+	std::vector<codeunit_sequence> string_builder::finish_chunks() noexcept
+	{
+		if(this->chunks_.empty())
+			return { };
+		this->commit_chunk();
+		// Chunks kept for reuse are not a part of the result.
+		this->chunks_.resize(this->current_ + 1);
+		std::vector<codeunit_sequence> chunks = std::move(this->chunks_);
+		*this = string_builder{ };
+		return chunks;
+	}
+
+	string_builder& string_builder::append_chunks(const codeunit_sequence_view& view) noexcept
+	{
+		codeunit_sequence_view rest = view;
+		while(!rest.is_empty())
+		{
+			if(this->cursor_ == this->chunk_end_)
+				this->next_chunk(0);
+			// A chunk may end in the middle of a codepoint.
+			const u64 count = minimum(rest.size(), static_cast<u64>(this->chunk_end_ - this->cursor_));
+			this->cursor_ = details::copy_codeunits(this->cursor_, rest.subview(0, count));
+			rest = rest.subview(count);
+		}
+		return *this;
+	}
+
+	void string_builder::next_chunk(const u64 size) noexcept
+	{
+		// An empty chunk is replaced if it is too small, instead of being left behind.
+		if(!this->chunks_.empty() && this->cursor_ != this->chunks_[this->current_].data())
+		{
+			this->commit_chunk();
+			this->committed_size_ += this->chunks_[this->current_].size();
+			++this->current_;
+		}
+		const u64 required = minimum(size, details::STRING_BUILDER_CHUNK_SIZE_MAXIMUM);
+		if(this->current_ == this->chunks_.size() || this->chunks_[this->current_].get_capacity() < required)
+		{
+			// Memory of chunks doubles from the minimum to the maximum, and a code unit is left for the null terminator.
+			const u64 previous = this->current_ > 0 ? this->chunks_[this->current_ - 1].get_capacity() + 1 : 0;
+			const u64 capacity = maximum(required + 1, minimum(maximum(previous * 2, CHUNK_CAPACITY_MINIMUM), CHUNK_CAPACITY_MAXIMUM));
+			codeunit_sequence chunk{ capacity - 1 };
+			if(this->current_ == this->chunks_.size())
+				this->chunks_.push_back(std::move(chunk));
+			else
+				this->chunks_[this->current_] = std::move(chunk);
+		}
+		codeunit_sequence& chunk = this->chunks_[this->current_];
+		this->cursor_ = chunk.data();
+		this->chunk_end_ = this->cursor_ + chunk.get_capacity();
+	}
+
+	void string_builder::commit_chunk() noexcept
+	{
+		codeunit_sequence& chunk = this->chunks_[this->current_];
+		chunk.set_size(static_cast<u64>(this->cursor_ - chunk.data()));
+		*this->cursor_ = '\0';
+	}
+
+	u64 string_builder::get_chunk_size(const u64 index) const noexcept
+	{
+		if(this->chunks_.empty() || index > this->current_)
+			return 0;
+		if(index < this->current_)
+			return this->chunks_[index].size();
+		return static_cast<u64>(this->cursor_ - this->chunks_[index].data());
+	}
+}
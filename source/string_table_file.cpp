@@ -0,0 +1,335 @@
+
+#include "string_table_file.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "common/functions.h"
+
+namespace ostr
+{
+	namespace details
+	{
+		// Average count of keys in a bucket of the perfect hash.
+		static constexpr u64 STRING_TABLE_FILE_BUCKET_LOAD = 4;
+		// Slots are a little more than keys, which keeps finding displacements fast.
+		static constexpr u64 STRING_TABLE_FILE_SLOT_LOAD_PERCENT = 95;
+		static constexpr u64 STRING_TABLE_FILE_DISPLACEMENT_MAXIMUM = 1ull << 24;
+		static constexpr u32 STRING_TABLE_FILE_SLOT_EMPTY = 0xFFFFFFFF;
+		static constexpr u64 STRING_TABLE_FILE_COUNT_MAXIMUM = 0xFFFFFFFE;
+
+		// Mixer of splitmix64, every bit of the result depends on every bit of h.
+		[[nodiscard]] static u64 mix_hash(u64 h) noexcept
+		{
+			h ^= h >> 30;
+			h *= 0xBF58476D1CE4E5B9ull;
+			h ^= h >> 27;
+			h *= 0x94D049BB133111EBull;
+			h ^= h >> 31;
+			return h;
+		}
+
+		// FNV-1a, finished by the mixer so that the low bits taken by modulo are usable.
+		[[nodiscard]] static u64 hash_key(const codeunit_sequence_view& key) noexcept
+		{
+			u64 h = 0xCBF29CE484222325ull;
+			for(const char codeunit : key)
+			{
+				h ^= static_cast<u8>(codeunit);
+				h *= 0x100000001B3ull;
+			}
+			return mix_hash(h);
+		}
+
+		[[nodiscard]] static u64 get_slot(const u64 hash, const u32 displacement, const u64 slot_count) noexcept
+		{
+			return mix_hash(hash + displacement * 0x9E3779B97F4A7C15ull) % slot_count;
+		}
+
+		[[nodiscard]] static u32 load_u32(const char* at) noexcept
+		{
+			u32 value = 0;
+			std::memcpy(&value, at, sizeof(u32));
+			return value;
+		}
+
+		[[nodiscard]] static u64 get_file_size(const string_table_file_header& header) noexcept
+		{
+			return sizeof(string_table_file_header)
+				+ ((header.count + 1) * 2 + header.bucket_count + header.slot_count) * sizeof(u32)
+				+ header.key_codeunit_size + header.value_codeunit_size;
+		}
+
+		struct string_table_file_output
+		{
+			explicit string_table_file_output(const char* path) noexcept
+				: file(std::fopen(path, "wb"))
+			{ }
+
+			~string_table_file_output() noexcept
+			{
+				if(this->file)
+					std::fclose(this->file);
+			}
+
+			void write(const void* data, const u64 size) noexcept
+			{
+				if(size > 0 && std::fwrite(data, 1, size, this->file) != size)
+					this->failed = true;
+				if(size > 0)
+					this->checksum = hash_sequence_crc64(static_cast<const char*>(data), size, this->checksum);
+			}
+
+			std::FILE* file;
+			u64 checksum = 0;
+			bool failed = false;
+		};
+
+		// Offsets of a string table, written as u32.
+		static void write_offsets(string_table_file_output& output, const string_table& table) noexcept
+		{
+			std::vector<u32> offsets(table.size() + 1, 0);
+			for(u64 i = 0; i < table.size(); ++i)
+				offsets[i + 1] = static_cast<u32>(offsets[i] + table.size_at(i));
+			output.write(offsets.data(), offsets.size() * sizeof(u32));
+		}
+
+		static void write_codeunits(string_table_file_output& output, const string_table& table) noexcept
+		{
+			if(table.size() > 0)
+				output.write(table.raw_at(0).data(), table.codeunit_size());
+		}
+	}
+
+	// code-region-start: string_table_file_writer
+
+	u64 string_table_file_writer::add(const codeunit_sequence_view& key, const codeunit_sequence_view& value) noexcept
+	{
+		this->keys_.append(key);
+		return this->values_.append(value);
+	}
+
+	u64 string_table_file_writer::size() const noexcept
+	{
+		return this->keys_.size();
+	}
+
+	string_table_file_status string_table_file_writer::write(const char* path) const noexcept
+	{
+		const u64 count = this->size();
+		if(count > details::STRING_TABLE_FILE_COUNT_MAXIMUM
+			|| this->keys_.codeunit_size() > string_table::CODEUNIT_SIZE_MAXIMUM || this->values_.codeunit_size() > string_table::CODEUNIT_SIZE_MAXIMUM)
+			return string_table_file_status::too_large;
+		for(u64 i = 0; i < count; ++i)
+		{
+			const codeunit_sequence_view key = this->keys_[i];
+			const codeunit_sequence_view value = this->values_[i];
+			if(unicode::find_invalid_utf8(key.data(), key.size()) != key.size()
+				|| unicode::find_invalid_utf8(value.data(), value.size()) != value.size())
+				return string_table_file_status::invalid_utf8;
+		}
+
+		string_table_file_header header;
+		header.count = count;
+		header.bucket_count = maximum(1, (count + details::STRING_TABLE_FILE_BUCKET_LOAD - 1) / details::STRING_TABLE_FILE_BUCKET_LOAD);
+		header.slot_count = maximum(1, count * 100 / details::STRING_TABLE_FILE_SLOT_LOAD_PERCENT + 1);
+		header.key_codeunit_size = this->keys_.codeunit_size();
+		header.value_codeunit_size = this->values_.codeunit_size();
+
+		// Entries sorted by hash find duplicates, then they are grouped into buckets.
+		std::vector<u64> hashes(count);
+		std::vector<u32> order(count);
+		for(u64 i = 0; i < count; ++i)
+		{
+			hashes[i] = details::hash_key(this->keys_[i]);
+			order[i] = static_cast<u32>(i);
+		}
+		std::sort(order.begin(), order.end(), [&hashes](const u32 a, const u32 b) { return hashes[a] < hashes[b]; });
+		for(u64 i = 1; i < count; ++i)
+		{
+			if(hashes[order[i]] != hashes[order[i - 1]])
+				continue;
+			// Different keys of the same 64-bit hash can not be told apart by any displacement.
+			return this->keys_[order[i]] == this->keys_[order[i - 1]] ? string_table_file_status::duplicate_key : string_table_file_status::too_large;
+		}
+
+		// Hash and displace: the largest buckets are placed first, each with the first displacement moving all its keys into empty slots.
+		std::vector<std::vector<u32>> buckets(header.bucket_count);
+		for(u64 i = 0; i < count; ++i)
+			buckets[hashes[i] % header.bucket_count].push_back(static_cast<u32>(i));
+		std::vector<u32> bucket_order(header.bucket_count);
+		for(u64 i = 0; i < header.bucket_count; ++i)
+			bucket_order[i] = static_cast<u32>(i);
+		std::stable_sort(bucket_order.begin(), bucket_order.end(), [&buckets](const u32 a, const u32 b) { return buckets[a].size() > buckets[b].size(); });
+		std::vector<u32> displacements(header.bucket_count, 0);
+		std::vector<u32> slots(header.slot_count, details::STRING_TABLE_FILE_SLOT_EMPTY);
+		std::vector<u64> placed;
+		for(const u32 bucket : bucket_order)
+		{
+			const std::vector<u32>& entries = buckets[bucket];
+			if(entries.empty())
+				break;
+			u32 displacement = 0;
+			for(; displacement < details::STRING_TABLE_FILE_DISPLACEMENT_MAXIMUM; ++displacement)
+			{
+				placed.clear();
+				for(const u32 entry : entries)
+				{
+					const u64 slot = details::get_slot(hashes[entry], displacement, header.slot_count);
+					if(slots[slot] != details::STRING_TABLE_FILE_SLOT_EMPTY || std::find(placed.begin(), placed.end(), slot) != placed.end())
+						break;
+					placed.push_back(slot);
+				}
+				if(placed.size() == entries.size())
+					break;
+			}
+			if(displacement == details::STRING_TABLE_FILE_DISPLACEMENT_MAXIMUM)
+				return string_table_file_status::too_large;
+			displacements[bucket] = displacement;
+			for(u64 i = 0; i < entries.size(); ++i)
+				slots[placed[i]] = entries[i];
+		}
+
+		details::string_table_file_output output{ path };
+		if(!output.file)
+			return string_table_file_status::write_failed;
+		// The header is written again with the checksum after the content.
+		output.write(&header, sizeof(header));
+		output.checksum = 0;
+		details::write_offsets(output, this->keys_);
+		details::write_offsets(output, this->values_);
+		output.write(displacements.data(), displacements.size() * sizeof(u32));
+		output.write(slots.data(), slots.size() * sizeof(u32));
+		details::write_codeunits(output, this->keys_);
+		details::write_codeunits(output, this->values_);
+		header.checksum = output.checksum;
+		if(output.failed || std::fseek(output.file, 0, SEEK_SET) != 0)
+			return string_table_file_status::write_failed;
+		output.write(&header, sizeof(header));
+		if(output.failed || std::fflush(output.file) != 0)
+			return string_table_file_status::write_failed;
+		return string_table_file_status::succeeded;
+	}
+
+	// code-region-end: string_table_file_writer
+
+	// code-region-start: constructors
+
+	string_table_file::string_table_file(const char* path, const string_table_file_options& options) noexcept
+	{
+		this->open(path, options);
+	}
+
+	// code-region-end: constructors
+
+	string_table_file_status string_table_file::open(const char* path, const string_table_file_options& options) noexcept
+	{
+		this->close();
+		const mapped_text_status mapped_status = this->mapped_.open(path);
+		if(mapped_status != mapped_text_status::succeeded)
+			return this->status_ = mapped_status == mapped_text_status::open_failed ? string_table_file_status::open_failed : string_table_file_status::map_failed;
+		const auto fail = [this](const string_table_file_status status)
+		{
+			this->close();
+			return this->status_ = status;
+		};
+
+		const codeunit_sequence_view raw = this->mapped_.raw();
+		string_table_file_header header;
+		if(raw.size() < sizeof(header))
+			return fail(string_table_file_status::invalid_format);
+		std::memcpy(&header, raw.data(), sizeof(header));
+		if(header.magic != string_table_file_header::MAGIC)
+			return fail(string_table_file_status::invalid_format);
+		if(header.version != string_table_file_header::VERSION)
+			return fail(string_table_file_status::unsupported_version);
+		// Sizes are bounded before they are added up, so that the sum never overflows.
+		if(header.count > details::STRING_TABLE_FILE_COUNT_MAXIMUM || header.bucket_count == 0 || header.bucket_count > raw.size()
+			|| header.slot_count <= header.count || header.slot_count > raw.size()
+			|| header.key_codeunit_size > raw.size() || header.value_codeunit_size > raw.size()
+			|| details::get_file_size(header) != raw.size())
+			return fail(string_table_file_status::invalid_format);
+		if(options.verify_checksum && hash_sequence_crc64(raw.data() + sizeof(header), raw.size() - sizeof(header)) != header.checksum)
+			return fail(string_table_file_status::checksum_mismatch);
+
+		this->header_ = header;
+		this->key_offsets_ = raw.data() + sizeof(header);
+		this->value_offsets_ = this->key_offsets_ + (header.count + 1) * sizeof(u32);
+		this->displacements_ = this->value_offsets_ + (header.count + 1) * sizeof(u32);
+		this->slots_ = this->displacements_ + header.bucket_count * sizeof(u32);
+		this->keys_ = this->slots_ + header.slot_count * sizeof(u32);
+		this->values_ = this->keys_ + header.key_codeunit_size;
+		return this->status_ = string_table_file_status::succeeded;
+	}
+
+	void string_table_file::close() noexcept
+	{
+		this->mapped_.close();
+		this->header_ = { };
+		this->key_offsets_ = nullptr;
+		this->value_offsets_ = nullptr;
+		this->displacements_ = nullptr;
+		this->slots_ = nullptr;
+		this->keys_ = nullptr;
+		this->values_ = nullptr;
+		this->status_ = string_table_file_status::closed;
+	}
+
+	string_table_file_status string_table_file::status() const noexcept
+	{
+		return this->status_;
+	}
+
+	bool string_table_file::is_open() const noexcept
+	{
+		return this->status_ == string_table_file_status::succeeded;
+	}
+
+	u64 string_table_file::size() const noexcept
+	{
+		return this->header_.count;
+	}
+
+	u64 string_table_file::index_of(const codeunit_sequence_view& key) const noexcept
+	{
+		if(!this->is_open())
+			return global_constant::INDEX_INVALID;
+		const u64 hash = details::hash_key(key);
+		const u32 displacement = details::load_u32(this->displacements_ + hash % this->header_.bucket_count * sizeof(u32));
+		const u64 slot = details::get_slot(hash, displacement, this->header_.slot_count);
+		const u32 id = details::load_u32(this->slots_ + slot * sizeof(u32));
+		// Keys not in the table land in any slot, so the key of the slot is compared.
+		if(id >= this->header_.count || this->read_entry(this->key_offsets_, this->keys_, this->header_.key_codeunit_size, id) != key)
+			return global_constant::INDEX_INVALID;
+		return id;
+	}
+
+	text_view string_table_file::key_at(const u64 id) const noexcept
+	{
+		return text_view{ this->read_entry(this->key_offsets_, this->keys_, this->header_.key_codeunit_size, id) };
+	}
+
+	text_view string_table_file::value_at(const u64 id) const noexcept
+	{
+		return text_view{ this->read_entry(this->value_offsets_, this->values_, this->header_.value_codeunit_size, id) };
+	}
+
+	text_view string_table_file::find(const codeunit_sequence_view& key, const text_view& fallback) const noexcept
+	{
+		const u64 id = this->index_of(key);
+		return id == global_constant::INDEX_INVALID ? fallback : this->value_at(id);
+	}
+
+	codeunit_sequence_view string_table_file::read_entry(const char* offsets, const char* codeunits, const u64 codeunit_size, const u64 id) const noexcept
+	{
+		if(id >= this->header_.count)
+			return { };
+		const u32 first = details::load_u32(offsets + id * sizeof(u32));
+		const u32 last = details::load_u32(offsets + (id + 1) * sizeof(u32));
+		// Offsets are not parsed on opening, broken ones are caught here.
+		if(first > last || last > codeunit_size)
+			return { };
+		return { codeunits + first, static_cast<u64>(last - first) };
+	}
+}
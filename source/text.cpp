@@ -2,6 +2,8 @@
 #include "text.h"
 
 #include <algorithm>
+#include "case_mapping.h"
+#include "normalization.h"
 #include "common/functions.h"
 #include "wide_text.h"
 
@@ -76,9 +78,8 @@ namespace ostr
 
 	text text::from_wide(const wchar_t* wide_string) noexcept
 	{
-		const wide_text wt{ wide_string };
 		codeunit_sequence decoded;
-		wt.decode(decoded);
+		details::append_wide(decoded, wide_string, details::get_sequence_length(wide_string));
 		return text{ std::move(decoded) };
 	}
 
@@ -309,6 +310,56 @@ namespace ostr
 		return this->view() != rhs;
 	}
 
+	bool text::operator<(const text_view& rhs) const noexcept
+	{
+		return this->compare(rhs) < 0;
+	}
+
+	bool text::operator<(const text& rhs) const noexcept
+	{
+		return this->compare(rhs) < 0;
+	}
+
+	bool text::operator>(const text_view& rhs) const noexcept
+	{
+		return this->compare(rhs) > 0;
+	}
+
+	bool text::operator>(const text& rhs) const noexcept
+	{
+		return this->compare(rhs) > 0;
+	}
+
+	bool text::operator<=(const text_view& rhs) const noexcept
+	{
+		return this->compare(rhs) <= 0;
+	}
+
+	bool text::operator<=(const text& rhs) const noexcept
+	{
+		return this->compare(rhs) <= 0;
+	}
+
+	bool text::operator>=(const text_view& rhs) const noexcept
+	{
+		return this->compare(rhs) >= 0;
+	}
+
+	bool text::operator>=(const text& rhs) const noexcept
+	{
+		return this->compare(rhs) >= 0;
+	}
+
+	i32 text::compare(const text_view& rhs) const noexcept
+	{
+		return this->view().compare(rhs);
+	}
+
+	i32 text::compare(const text& rhs) const noexcept
+	{
+		return this->view().compare(rhs.view());
+	}
+
 	text& text::append(const text_view& rhs) noexcept
 	{
 		this->sequence_.append(rhs.raw());
@@ -555,6 +606,60 @@ namespace ostr
 		return this->view().trim(characters);
 	}
 
+	text text::to_lower() const noexcept
+	{
+		return ostr::to_lower(this->view());
+	}
+
+	text text::to_upper() const noexcept
+	{
+		return ostr::to_upper(this->view());
+	}
+
+	text text::case_fold() const noexcept
+	{
+		return ostr::case_fold(this->view());
+	}
+
+	text& text::self_to_lower() noexcept
+	{
+		map_case_in_place(this->sequence_, case_mapping::lower);
+		return *this;
+	}
+
+	text& text::self_to_upper() noexcept
+	{
+		map_case_in_place(this->sequence_, case_mapping::upper);
+		return *this;
+	}
+
+	text& text::self_case_fold() noexcept
+	{
+		map_case_in_place(this->sequence_, case_mapping::fold);
+		return *this;
+	}
+
+	text text::normalize(const normalization_form form) const noexcept
+	{
+		return ostr::normalize(this->view(), form);
+	}
+
+	bool text::is_normalized(const normalization_form form) const noexcept
+	{
+		return ostr::is_normalized(this->view(), form);
+	}
+
+	text& text::self_normalize(const normalization_form form) noexcept
+	{
+		// Normalized text, which is most text, is kept as it is without allocating.
+		if(quick_check_normalization(this->sequence_.view(), form) == normalization_check::yes)
+			return *this;
+		codeunit_sequence normalized;
+		normalize_to(normalized, this->sequence_.view(), form);
+		this->sequence_ = std::move(normalized);
+		return *this;
+	}
+
 	const char* text::c_str() const noexcept
 	{
 		return this->sequence_.c_str();
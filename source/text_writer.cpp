@@ -0,0 +1,126 @@
+
+#include "text_writer.h"
+
+#include "write_vectors.h"
+
+namespace ostr
+{
+	namespace details
+	{
+		static constexpr u64 TEXT_WRITER_BUFFER_SIZE_MINIMUM = 16;
+
+		// Write views in order, with a single writev where available.
+		[[nodiscard]] static bool write_views(const int descriptor, std::array<codeunit_sequence_view, 2> views) noexcept
+		{
+			std::array<iovec, 2> vectors{ };
+			u64 count = 0;
+			for(const codeunit_sequence_view& view : views)
+				if(!view.is_empty())
+					vectors[count++] = { const_cast<char*>(view.data()), view.size() };
+			return write_vectors(descriptor, vectors.data(), count);
+		}
+	}
+
+	// code-region-start: constructors
+
+	text_writer::text_writer(const int descriptor, const text_flush_policy policy, const u64 buffer_size) noexcept
+		: descriptor_(descriptor)
+		, policy_(policy)
+	{
+		// One less than the size, so that the null terminator fits in an allocation of the size.
+		this->buffer_.append('\0', maximum(buffer_size, details::TEXT_WRITER_BUFFER_SIZE_MINIMUM) - 1);
+	}
+
+	text_writer::~text_writer() noexcept
+	{
+		this->stop_background_flush();
+		this->flush_buffer();
+	}
+
+	// code-region-end: constructors
+
+	text_writer& text_writer::write(const char codeunit, const u64 count) noexcept
+	{
+		const std::unique_lock<std::mutex> lock = this->lock();
+		u64 rest = count;
+		while(rest > 0)
+		{
+			if(this->used_ == this->buffer_.size())
+				this->flush_buffer();
+			const u64 size = minimum(rest, this->buffer_.size() - this->used_);
+			std::fill_n(this->buffer_.data() + this->used_, size, codeunit);
+			this->used_ += size;
+			rest -= size;
+		}
+		this->apply_policy({ &codeunit, count > 0 ? 1ull : 0ull });
+		return *this;
+	}
+
+	bool text_writer::flush() noexcept
+	{
+		const std::unique_lock<std::mutex> lock = this->lock();
+		this->flush_buffer();
+		return !this->failed_;
+	}
+
+	void text_writer::start_background_flush(const std::chrono::milliseconds interval) noexcept
+	{
+		this->stop_background_flush();
+		this->flush_interval_ = interval;
+		this->flush_thread_ = std::thread{ [this] { this->run_background_flush(); } };
+	}
+
+	void text_writer::stop_background_flush() noexcept
+	{
+		if(!this->flush_thread_.joinable())
+			return;
+		{
+			const std::lock_guard<std::mutex> lock{ this->mutex_ };
+			this->stopping_ = true;
+		}
+		this->stopping_condition_.notify_one();
+		this->flush_thread_.join();
+		this->stopping_ = false;
+	}
+
+	bool text_writer::has_failed() const noexcept
+	{
+		const std::unique_lock<std::mutex> lock = this->lock();
+		return this->failed_;
+	}
+
+	u64 text_writer::get_buffered_size() const noexcept
+	{
+		const std::unique_lock<std::mutex> lock = this->lock();
+		return this->used_;
+	}
+
+	void text_writer::write_through(const codeunit_sequence_view& view) noexcept
+	{
+		// Small views are buffered after the buffer is written out, large ones are written along with the buffer.
+		if(view.size() < this->buffer_.size())
+		{
+			this->flush_buffer();
+			details::copy_codeunits(this->buffer_.data(), view);
+			this->used_ = view.size();
+			return;
+		}
+		if(!this->failed_)
+			this->failed_ = !details::write_views(this->descriptor_, { codeunit_sequence_view{ this->buffer_.data(), this->used_ }, view });
+		this->used_ = 0;
+	}
+
+	void text_writer::flush_buffer() noexcept
+	{
+		if(this->used_ > 0 && !this->failed_)
+			this->failed_ = !details::write_views(this->descriptor_, { codeunit_sequence_view{ this->buffer_.data(), this->used_ }, codeunit_sequence_view{ } });
+		this->used_ = 0;
+	}
+
+	void text_writer::run_background_flush() noexcept
+	{
+		std::unique_lock<std::mutex> lock{ this->mutex_ };
+		while(!this->stopping_condition_.wait_for(lock, this->flush_interval_, [this] { return this->stopping_; }))
+			this->flush_buffer();
+	}
+}
@@ -0,0 +1,422 @@
+
+#include "view_sort.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace ostr
+{
+	namespace details
+	{
+		// Ranges smaller than this are sorted by insertion sort.
+		static constexpr u64 VIEW_SORT_INSERTION_THRESHOLD = 16;
+		// Ranges smaller than this are sorted by multikey quicksort, whose working set fits in the cache.
+		static constexpr u64 VIEW_SORT_RADIX_THRESHOLD = 1 << 12;
+		// Ranges smaller than this are sorted by a single thread.
+		static constexpr u64 VIEW_SORT_PARALLEL_THRESHOLD = 1 << 15;
+		// Bucket 0 is for views ending before the depth, and code unit c is for bucket c + 1.
+		static constexpr u64 VIEW_SORT_BUCKET_COUNT = 257;
+
+		using view_sort_buckets = std::array<u64, VIEW_SORT_BUCKET_COUNT>;
+
+		[[nodiscard]] static codeunit_sequence_view sort_key(const codeunit_sequence_view& view) noexcept
+		{
+			return view;
+		}
+
+		[[nodiscard]] static codeunit_sequence_view sort_key(const text_view& view) noexcept
+		{
+			return view.raw();
+		}
+
+		// Count of code units in a cache, the lowest byte of which is the count of them available.
+		static constexpr u64 VIEW_SORT_CACHE_SIZE = 7;
+
+		/**
+		 * \brief Cache of code units from the depth as a big-endian integer followed by the count of them available,
+		 * so caches are in the same order as the views up to the cached code units, including views ending among them.
+		 */
+		template<class View>
+		[[nodiscard]] static u64 load_cache(const View& view, const u64 depth) noexcept
+		{
+			const codeunit_sequence_view key = sort_key(view);
+			if(depth >= key.size())
+				return 0;
+			const u64 available = minimum(key.size() - depth, VIEW_SORT_CACHE_SIZE);
+			const char* codeunits = key.data() + depth;
+			u64 cache = available;
+			for(u64 i = 0; i < available; ++i)
+				cache |= static_cast<u64>(static_cast<u8>(codeunits[i])) << (56 - 8 * i);
+			return cache;
+		}
+
+		// Views with the cache have ended within it, so there is nothing after the cached code units to compare.
+		[[nodiscard]] static bool is_cache_final(const u64 cache) noexcept
+		{
+			return (cache & 0xff) < VIEW_SORT_CACHE_SIZE;
+		}
+
+		template<class View>
+		static void load_caches(const View* views, u64* caches, const u64 count, const u64 depth) noexcept
+		{
+			for(u64 i = 0; i < count; ++i)
+				caches[i] = load_cache(views[i], depth);
+		}
+
+		// All the views share the first depth code units, which are skipped, and caches are loaded from the depth.
+		template<class View>
+		static void insertion_sort(View* views, u64* caches, const u64 count, const u64 depth) noexcept
+		{
+			for(u64 i = 1; i < count; ++i)
+			{
+				const View view = views[i];
+				const u64 cache = caches[i];
+				const auto is_less = [&](const u64 index)
+				{
+					if(cache != caches[index])
+						return cache < caches[index];
+					return !is_cache_final(cache) && sort_key(view).subview(depth + VIEW_SORT_CACHE_SIZE) < sort_key(views[index]).subview(depth + VIEW_SORT_CACHE_SIZE);
+				};
+				u64 j = i;
+				for(; j > 0 && is_less(j - 1); --j)
+				{
+					views[j] = views[j - 1];
+					caches[j] = caches[j - 1];
+				}
+				views[j] = view;
+				caches[j] = cache;
+			}
+		}
+
+		/**
+		 * \brief Multikey quicksort by Bentley and Sedgewick, which partitions views into less, equal and greater,
+		 * so the equal part goes on from the next code units. Partitions are done on caches of several code units
+		 * moved along with the views, so the code units of a view are read once for every VIEW_SORT_CACHE_SIZE of depth.
+		 */
+		template<class View>
+		static void multikey_quicksort(View* views, u64* caches, u64 count, u64 depth) noexcept
+		{
+			while(count > VIEW_SORT_INSERTION_THRESHOLD)
+			{
+				const u64 first = caches[0];
+				const u64 middle = caches[count / 2];
+				const u64 last = caches[count - 1];
+				const u64 pivot = std::max(std::min(first, middle), std::min(std::max(first, middle), last));
+				// [0, less) is less than the pivot, [less, greater) is equal, and [greater, count) is greater.
+				u64 less = 0;
+				u64 greater = count;
+				for(u64 i = 0; i < greater; )
+				{
+					const u64 cache = caches[i];
+					if(cache < pivot)
+					{
+						std::swap(views[less], views[i]);
+						std::swap(caches[less++], caches[i++]);
+					}
+					else if(cache > pivot)
+					{
+						--greater;
+						std::swap(views[i], views[greater]);
+						std::swap(caches[i], caches[greater]);
+					}
+					else
+						++i;
+				}
+				multikey_quicksort(views, caches, less, depth);
+				multikey_quicksort(views + greater, caches + greater, count - greater, depth);
+				if(is_cache_final(pivot))
+					return;
+				views += less;
+				caches += less;
+				count = greater - less;
+				depth += VIEW_SORT_CACHE_SIZE;
+				load_caches(views, caches, count, depth);
+			}
+			insertion_sort(views, caches, count, depth);
+		}
+
+		// Count of code units shared by all the views after the depth.
+		template<class View>
+		[[nodiscard]] static u64 common_prefix_size(const View* views, const u64 count, const u64 depth) noexcept
+		{
+			const codeunit_sequence_view first = sort_key(views[0]).subview(depth);
+			u64 size = first.size();
+			for(u64 i = 1; i < count && size > 0; ++i)
+			{
+				const codeunit_sequence_view key = sort_key(views[i]).subview(depth);
+				const u64 limit = minimum(size, key.size());
+				u64 shared = 0;
+				while(shared < limit && key.data()[shared] == first.data()[shared])
+					++shared;
+				size = shared;
+			}
+			return size;
+		}
+
+		/**
+		 * \brief Distribute views into buckets by the code unit at the depth.
+		 * Buckets are kept in caches, so the code units are read once and the views are only moved sequentially afterwards.
+		 * @return false if all the views fall into the same bucket, in which case they are not moved
+		 */
+		template<class View>
+		[[nodiscard]] static bool radix_distribute(View* views, View* temporary, u64* caches, const u64 count, const u64 depth, view_sort_buckets& sizes) noexcept
+		{
+			sizes.fill(0);
+			for(u64 i = 0; i < count; ++i)
+			{
+				const codeunit_sequence_view key = sort_key(views[i]);
+				const u16 bucket = depth < key.size() ? static_cast<u16>(static_cast<u8>(key.data()[depth]) + 1) : 0;
+				caches[i] = bucket;
+				++sizes[bucket];
+			}
+			if(sizes[caches[0]] == count)
+				return false;
+			view_sort_buckets offsets;
+			u64 offset = 0;
+			for(u64 bucket = 0; bucket < VIEW_SORT_BUCKET_COUNT; ++bucket)
+			{
+				offsets[bucket] = offset;
+				offset += sizes[bucket];
+			}
+			for(u64 i = 0; i < count; ++i)
+				temporary[offsets[caches[i]]++] = views[i];
+			std::copy(temporary, temporary + count, views);
+			return true;
+		}
+
+		// The largest bucket which is not bucket 0, that is kept by the caller instead of recursion.
+		[[nodiscard]] static u64 largest_bucket(const view_sort_buckets& sizes) noexcept
+		{
+			u64 largest = 1;
+			for(u64 bucket = 2; bucket < VIEW_SORT_BUCKET_COUNT; ++bucket)
+				if(sizes[bucket] > sizes[largest])
+					largest = bucket;
+			return largest;
+		}
+
+		/**
+		 * \brief MSD radix sort, temporary and caches are buffers of the same count as views.
+		 * Every bucket but the largest is sorted recursively, so the recursion depth is logarithmic.
+		 */
+		template<class View>
+		static void radix_sort(View* views, View* temporary, u64* caches, u64 count, u64 depth) noexcept
+		{
+			view_sort_buckets sizes;
+			while(count >= VIEW_SORT_RADIX_THRESHOLD)
+			{
+				if(!radix_distribute(views, temporary, caches, count, depth, sizes))
+				{
+					// Bucket 0 holds views ending before the depth, which are equal to each other.
+					if(sizes[0] == count)
+						return;
+					depth += common_prefix_size(views, count, depth);
+					continue;
+				}
+				const u64 largest = largest_bucket(sizes);
+				u64 largest_offset = 0;
+				u64 offset = sizes[0];
+				for(u64 bucket = 1; bucket < VIEW_SORT_BUCKET_COUNT; ++bucket)
+				{
+					if(bucket == largest)
+						largest_offset = offset;
+					else if(sizes[bucket] > 1)
+						radix_sort(views + offset, temporary + offset, caches + offset, sizes[bucket], depth + 1);
+					offset += sizes[bucket];
+				}
+				views += largest_offset;
+				temporary += largest_offset;
+				caches += largest_offset;
+				count = sizes[largest];
+				++depth;
+			}
+			load_caches(views, caches, count, depth);
+			multikey_quicksort(views, caches, count, depth);
+		}
+
+		template<class View>
+		static void sort_views(View* views, const u64 count) noexcept
+		{
+			std::vector<u64> caches(count);
+			if(count < VIEW_SORT_RADIX_THRESHOLD)
+			{
+				load_caches(views, caches.data(), count, 0);
+				return multikey_quicksort(views, caches.data(), count, 0);
+			}
+			std::vector<View> temporary(count);
+			radix_sort(views, temporary.data(), caches.data(), count, 0);
+		}
+
+		// Range of views sorted from a depth, which is a task of the pool.
+		struct view_sort_task
+		{
+			u64 offset = 0;
+			u64 count = 0;
+			u64 depth = 0;
+		};
+
+		/**
+		 * \brief Pool of threads sorting ranges of views, each of which has its own queue of tasks.
+		 * A thread pushes buckets split from its range into its own queue and pops the latest one, which is likely in its cache.
+		 * When its queue is empty, it steals the earliest task of other threads, which is likely a large range.
+		 */
+		template<class View>
+		class view_sort_pool
+		{
+		public:
+
+			// code-region-start: constructors
+
+			view_sort_pool(View* views, const u64 count, const u32 thread_count) noexcept
+				: views_{ views }
+				, count_{ count }
+				, temporary_(count)
+				, caches_(count)
+				, queues_(thread_count)
+			{ }
+
+			// code-region-end: constructors
+
+			void run() noexcept
+			{
+				this->push(0, { 0, this->count_, 0 });
+				std::vector<std::thread> threads;
+				for(u32 worker = 1; worker < this->queues_.size(); ++worker)
+					threads.emplace_back(&view_sort_pool::work, this, worker);
+				this->work(0);
+				for(std::thread& thread : threads)
+					thread.join();
+			}
+
+		private:
+
+			struct worker_queue
+			{
+				std::mutex mutex;
+				std::deque<view_sort_task> tasks;
+			};
+
+			void push(const u32 worker, const view_sort_task& task) noexcept
+			{
+				this->pending_.fetch_add(1, std::memory_order_relaxed);
+				worker_queue& queue = this->queues_[worker];
+				const std::lock_guard<std::mutex> guard{ queue.mutex };
+				queue.tasks.push_back(task);
+			}
+
+			[[nodiscard]] bool pop(const u32 worker, view_sort_task& task) noexcept
+			{
+				{
+					worker_queue& queue = this->queues_[worker];
+					const std::lock_guard<std::mutex> guard{ queue.mutex };
+					if(!queue.tasks.empty())
+					{
+						task = queue.tasks.back();
+						queue.tasks.pop_back();
+						return true;
+					}
+				}
+				const u64 count = this->queues_.size();
+				for(u64 i = 1; i < count; ++i)
+				{
+					worker_queue& queue = this->queues_[(worker + i) % count];
+					const std::lock_guard<std::mutex> guard{ queue.mutex };
+					if(!queue.tasks.empty())
+					{
+						task = queue.tasks.front();
+						queue.tasks.pop_front();
+						return true;
+					}
+				}
+				return false;
+			}
+
+			void work(const u32 worker) noexcept
+			{
+				// A task is finished after the tasks it pushes are counted, so no thread leaves while there is work to do.
+				while(this->pending_.load(std::memory_order_acquire) > 0)
+				{
+					view_sort_task task;
+					if(this->pop(worker, task))
+					{
+						this->execute(worker, task);
+						this->pending_.fetch_sub(1, std::memory_order_acq_rel);
+					}
+					else
+						std::this_thread::yield();
+				}
+			}
+
+			void execute(const u32 worker, view_sort_task task) noexcept
+			{
+				view_sort_buckets sizes;
+				while(task.count >= VIEW_SORT_PARALLEL_THRESHOLD)
+				{
+					View* views = this->views_ + task.offset;
+					if(!radix_distribute(views, this->temporary_.data() + task.offset, this->caches_.data() + task.offset, task.count, task.depth, sizes))
+					{
+						if(sizes[0] == task.count)
+							return;
+						task.depth += common_prefix_size(views, task.count, task.depth);
+						continue;
+					}
+					const u64 largest = largest_bucket(sizes);
+					view_sort_task kept;
+					u64 offset = task.offset + sizes[0];
+					for(u64 bucket = 1; bucket < VIEW_SORT_BUCKET_COUNT; ++bucket)
+					{
+						const view_sort_task split{ offset, sizes[bucket], task.depth + 1 };
+						if(bucket == largest)
+							kept = split;
+						else if(split.count > 1)
+							this->push(worker, split);
+						offset += sizes[bucket];
+					}
+					task = kept;
+				}
+				radix_sort(this->views_ + task.offset, this->temporary_.data() + task.offset, this->caches_.data() + task.offset, task.count, task.depth);
+			}
+
+			View* views_;
+			u64 count_;
+			std::vector<View> temporary_;
+			std::vector<u64> caches_;
+			std::vector<worker_queue> queues_;
+			std::atomic<u64> pending_{ 0 };
+		};
+
+		template<class View>
+		static void sort_views_parallel(View* views, const u64 count, u32 thread_count) noexcept
+		{
+			if(thread_count == 0)
+				thread_count = std::thread::hardware_concurrency();
+			if(thread_count <= 1 || count < VIEW_SORT_PARALLEL_THRESHOLD)
+				return details::sort_views(views, count);
+			view_sort_pool<View> pool{ views, count, thread_count };
+			pool.run();
+		}
+	}
+
+	void sort_views(codeunit_sequence_view* views, const u64 count) noexcept
+	{
+		details::sort_views(views, count);
+	}
+
+	void sort_views(text_view* views, const u64 count) noexcept
+	{
+		details::sort_views(views, count);
+	}
+
+	void sort_views_parallel(codeunit_sequence_view* views, const u64 count, const u32 thread_count) noexcept
+	{
+		details::sort_views_parallel(views, count, thread_count);
+	}
+
+	void sort_views_parallel(text_view* views, const u64 count, const u32 thread_count) noexcept
+	{
+		details::sort_views_parallel(views, count, thread_count);
+	}
+}
@@ -1,6 +1,7 @@
 
 #include "wide_text.h"
 
+#include <cstring>
 #include "text.h"
 #include "text_view.h"
 
@@ -8,17 +9,152 @@ namespace ostr
 {
 	namespace details
 	{
-		[[nodiscard]] constexpr u64 get_sequence_length(const wchar_t* str) noexcept
+		// Code units are checked and converted in blocks of this size,
+		// plain loops over fixed-size blocks are vectorised by compilers.
+		static constexpr u64 TRANSCODE_BLOCK_SIZE = 8;
+
+		[[nodiscard]] inline bool is_ascii_block(const wchar_t* wide_str) noexcept
+		{
+			u32 bits = 0;
+			for(u64 i = 0; i < TRANSCODE_BLOCK_SIZE; ++i)
+				bits |= static_cast<u32>(wide_str[i]);
+			return bits <= unicode::get_utf8_maximum_codepoint(1);
+		}
+
+		[[nodiscard]] inline bool is_ascii_block(const char* utf8) noexcept
+		{
+			static_assert(TRANSCODE_BLOCK_SIZE == sizeof(u64), "A block of utf-8 code units is read as one word.");
+			u64 word = 0;
+			std::memcpy(&word, utf8, sizeof(u64));
+			return (word & 0x8080808080808080ull) == 0;
+		}
+
+		/**
+		 * @param wide_str wide code units
+		 * @param remaining count of code units readable from wide_str
+		 * @param consumed receives count of code units read
+		 * @return the codepoint read, a lone surrogate is returned as is
+		 */
+		[[nodiscard]] inline char32_t read_wide(const wchar_t* wide_str, const u64 remaining, u64& consumed) noexcept
 		{
-			if(!str)
-				return 0;
-			u64 count = 0;
-			while(str[count] != 0)
-				++count;
-			return count;
+			if constexpr (sizeof(wchar_t) == sizeof(char16_t))
+			{
+				const auto* utf16 = reinterpret_cast<const char16_t*>(wide_str);
+				if(remaining > 1 && unicode::utf16::is_leading_surrogate(utf16[0]) && unicode::utf16::is_trailing_surrogate(utf16[1]))
+				{
+					consumed = unicode::utf16::SEQUENCE_MAXIMUM_LENGTH;
+					return unicode::utf16_to_utf32(utf16, unicode::utf16::SEQUENCE_MAXIMUM_LENGTH);
+				}
+			}
+			consumed = 1;
+			return static_cast<char32_t>(wide_str[0]);
+		}
+
+		template<class Sequence>
+		void write_wide(Sequence& out, const char32_t cp) noexcept
+		{
+			if constexpr (sizeof(wchar_t) == sizeof(char16_t))
+			{
+				const auto utf16_pair = unicode::utf32_to_utf16(cp);
+				out.push_back(static_cast<wchar_t>(utf16_pair.at(0)));
+				if(utf16_pair.at(1) != 0)
+					out.push_back(static_cast<wchar_t>(utf16_pair.at(1)));
+			}
+			else
+			{
+				out.push_back(static_cast<wchar_t>(cp));
+			}
+		}
+
+		u64 get_utf8_size(const wchar_t* wide_str, const u64 count) noexcept
+		{
+			u64 size = 0;
+			u64 i = 0;
+			while(i < count)
+			{
+				if(i + TRANSCODE_BLOCK_SIZE <= count && is_ascii_block(wide_str + i))
+				{
+					size += TRANSCODE_BLOCK_SIZE;
+					i += TRANSCODE_BLOCK_SIZE;
+					continue;
+				}
+				const u64 block_last = minimum(i + TRANSCODE_BLOCK_SIZE, count);
+				while(i < block_last)
+				{
+					u64 consumed = 0;
+					const char32_t cp = read_wide(wide_str + i, count - i, consumed);
+					size += unicode::parse_utf8_length(cp);
+					i += consumed;
+				}
+			}
+			return size;
+		}
+
+		char* encode_wide(char* target, const wchar_t* wide_str, const u64 count) noexcept
+		{
+			u64 i = 0;
+			while(i < count)
+			{
+				if(i + TRANSCODE_BLOCK_SIZE <= count && is_ascii_block(wide_str + i))
+				{
+					for(u64 j = 0; j < TRANSCODE_BLOCK_SIZE; ++j)
+						target[j] = static_cast<char>(wide_str[i + j]);
+					target += TRANSCODE_BLOCK_SIZE;
+					i += TRANSCODE_BLOCK_SIZE;
+					continue;
+				}
+				const u64 block_last = minimum(i + TRANSCODE_BLOCK_SIZE, count);
+				while(i < block_last)
+				{
+					u64 consumed = 0;
+					const char32_t cp = read_wide(wide_str + i, count - i, consumed);
+					const u64 length = unicode::parse_utf8_length(cp);
+					const auto utf8 = unicode::utf32_to_utf8(cp);
+					std::copy_n(utf8.data(), length, target);
+					target += length;
+					i += consumed;
+				}
+			}
+			return target;
+		}
+
+		void append_wide(codeunit_sequence& out, const wchar_t* wide_str, const u64 count) noexcept
+		{
+			const u64 utf8_size = get_utf8_size(wide_str, count);
+			if(utf8_size == 0)
+				return;
+			const u64 old_size = out.size();
+			// Grow once, append('\0', n) sets the size without filling, and the range is filled right below.
+			out.append('\0', utf8_size);
+			encode_wide(out.data() + old_size, wide_str, count);
+		}
+
+		void append_wide(format_sink& sink, const wchar_t* wide_str, const u64 count) noexcept
+		{
+			static constexpr u64 ENCODE_BUFFER_SIZE = 64;
+			std::array<char, ENCODE_BUFFER_SIZE> buffer;
+			u64 buffered = 0;
+			u64 i = 0;
+			while(i < count)
+			{
+				// Flush when the next codepoint may not fit in.
+				if(buffered + unicode::UTF8_SEQUENCE_MAXIMUM_LENGTH > ENCODE_BUFFER_SIZE)
+				{
+					sink.append({ buffer.data(), buffered });
+					buffered = 0;
+				}
+				u64 consumed = 0;
+				const char32_t cp = read_wide(wide_str + i, count - i, consumed);
+				const u64 length = unicode::parse_utf8_length(cp);
+				const auto utf8 = unicode::utf32_to_utf8(cp);
+				std::copy_n(utf8.data(), length, buffer.data() + buffered);
+				buffered += length;
+				i += consumed;
+			}
+			sink.append({ buffer.data(), buffered });
 		}
 	}
-	
+
 	wide_text::wide_text(const wchar_t* wide_str) noexcept
 	{
 		this->operator=(wide_str);
@@ -32,25 +168,35 @@ namespace ostr
 	wide_text& wide_text::operator=(const wchar_t* wide_str) noexcept
 	{
 		this->sequence_.empty();
-		this->sequence_.append(wide_str, details::get_sequence_length(wide_str) + 1);
+		const u64 size = details::get_sequence_length(wide_str);
+		this->sequence_.reserve(size + 1);
+		this->sequence_.append(wide_str, size);
+		this->sequence_.push_back(L'\0');
 		return *this;
 	}
 
 	wide_text& wide_text::operator=(const codeunit_sequence_view& view) noexcept
 	{
-		const text_view tv{ view };
+		const char* utf8 = view.data();
+		const u64 size = view.size();
 		this->sequence_.empty();
-		this->sequence_.reserve(tv.size() + 1);
-		for(const codepoint cp : tv)
+		// A utf-8 sequence never has less code units than the same text in utf-16 or utf-32.
+		this->sequence_.reserve(size + 1);
+		u64 i = 0;
+		while(i < size)
 		{
-#if _WIN64
-			const auto utf16_pair = unicode::utf32_to_utf16(cp.get_codepoint());
-			this->sequence_.push_back(utf16_pair.at(0));
-			if(utf16_pair.at(1) != 0)
-				this->sequence_.push_back(utf16_pair.at(1));
-#elif __linux__ || __MACH__
-			this->sequence_.push_back(cp.get_codepoint());
-#endif
+			if(i + details::TRANSCODE_BLOCK_SIZE <= size && details::is_ascii_block(utf8 + i))
+			{
+				this->sequence_.push_back_uninitialized(details::TRANSCODE_BLOCK_SIZE);
+				wchar_t* target = this->sequence_.data() + this->sequence_.size() - details::TRANSCODE_BLOCK_SIZE;
+				for(u64 j = 0; j < details::TRANSCODE_BLOCK_SIZE; ++j)
+					target[j] = static_cast<wchar_t>(utf8[i + j]);
+				i += details::TRANSCODE_BLOCK_SIZE;
+				continue;
+			}
+			const u64 length = minimum(maximum(unicode::parse_utf8_length(utf8[i]), 1), size - i);
+			details::write_wide(this->sequence_, unicode::utf8_to_utf32(utf8 + i, length));
+			i += length;
 		}
 		this->sequence_.push_back(L'\0');
 		return *this;
@@ -61,12 +207,14 @@ namespace ostr
 		return this->sequence_.data();
 	}
 
+	u64 wide_text::size() const noexcept
+	{
+		return this->sequence_.size() - 1;
+	}
+
 	void wide_text::decode(codeunit_sequence& out) const noexcept
 	{
-#if _WIN64
-		out = text::from_utf16(reinterpret_cast<const char16_t*>(this->sequence_.data())).raw();
-#elif __linux__ || __MACH__
-		out = text::from_utf32(reinterpret_cast<const char32_t*>(this->sequence_.data())).raw();
-#endif
+		out.empty();
+		details::append_wide(out, this->data(), this->size());
 	}
 }
@@ -0,0 +1,67 @@
+
+#include "write_vectors.h"
+
+#include "common/functions.h"
+
+#if _WIN64
+#include <climits>
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace ostr
+{
+	namespace details
+	{
+		// Limit of vectors of a writev call, which is IOV_MAX of Linux and macOS.
+		static constexpr u64 WRITE_VECTOR_COUNT_MAXIMUM = 1024;
+
+		bool write_vectors(const int descriptor, iovec* vectors, const u64 count) noexcept
+		{
+#if _WIN64
+			for(u64 i = 0; i < count; ++i)
+			{
+				const char* data = static_cast<const char*>(vectors[i].iov_base);
+				u64 rest = vectors[i].iov_len;
+				while(rest > 0)
+				{
+					const int written = _write(descriptor, data, static_cast<unsigned>(minimum(rest, INT_MAX)));
+					if(written < 0)
+						return false;
+					data += written;
+					rest -= static_cast<u64>(written);
+				}
+			}
+			return true;
+#else
+			u64 index = 0;
+			while(index < count)
+			{
+				const u64 batch = minimum(count - index, WRITE_VECTOR_COUNT_MAXIMUM);
+				const ssize_t written = ::writev(descriptor, vectors + index, static_cast<int>(batch));
+				if(written < 0)
+				{
+					if(errno == EINTR)
+						continue;
+					return false;
+				}
+				// Skip vectors written completely, and continue from the middle of the one written partially.
+				u64 rest = static_cast<u64>(written);
+				while(index < count && rest >= vectors[index].iov_len)
+				{
+					rest -= vectors[index].iov_len;
+					++index;
+				}
+				if(rest > 0)
+				{
+					vectors[index].iov_base = static_cast<char*>(vectors[index].iov_base) + rest;
+					vectors[index].iov_len -= rest;
+				}
+			}
+			return true;
+#endif
+		}
+	}
+}
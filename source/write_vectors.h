@@ -0,0 +1,33 @@
+#pragma once
+#include "common/basic_types.h"
+
+#if !_WIN64
+#include <sys/uio.h>
+#endif
+
+namespace ostr
+{
+	namespace details
+	{
+#if _WIN64
+		// Layout of iovec of POSIX, written vector by vector.
+		struct iovec
+		{
+			void* iov_base;
+			u64 iov_len;
+		};
+#else
+		using ::iovec;
+#endif
+
+		/**
+		 * \brief Write all the vectors to a file descriptor in order, with writev where available.
+		 * Writes interrupted by signals are retried, and writes of partial vectors are continued.
+		 * @param descriptor the file descriptor to write to
+		 * @param vectors the vectors to write, which are modified on partial writes
+		 * @param count the count of vectors
+		 * @return true if all the code units are written
+		 */
+		[[nodiscard]] bool write_vectors(int descriptor, iovec* vectors, u64 count) noexcept;
+	}
+}
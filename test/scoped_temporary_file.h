@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstdio>
+#include "format.h"
+
+// Temporary file removed at the end of the scope.
+struct scoped_temporary_file
+{
+	/**
+	 * @param prefix prefix of the file name, which is followed by the address of this
+	 */
+	explicit scoped_temporary_file(const ostr::codeunit_sequence_view& prefix)
+		: path(ostr::format("{}_{}.tmp"_cuqv, prefix, static_cast<const void*>(this)))
+	{ }
+
+	/**
+	 * @param prefix prefix of the file name, which is followed by the address of this
+	 * @param content code units written into the file
+	 */
+	scoped_temporary_file(const ostr::codeunit_sequence_view& prefix, const ostr::codeunit_sequence_view& content)
+		: scoped_temporary_file(prefix)
+	{
+		std::FILE* file = std::fopen(this->path.c_str(), "wb");
+		std::fwrite(content.data(), 1, content.size(), file);
+		std::fclose(file);
+	}
+
+	~scoped_temporary_file()
+	{
+		std::remove(this->path.c_str());
+	}
+
+	scoped_temporary_file(const scoped_temporary_file&) = delete;
+	scoped_temporary_file(scoped_temporary_file&&) = delete;
+	scoped_temporary_file& operator=(const scoped_temporary_file&) = delete;
+	scoped_temporary_file& operator=(scoped_temporary_file&&) = delete;
+
+	[[nodiscard]] ostr::codeunit_sequence read() const
+	{
+		ostr::codeunit_sequence content;
+		std::FILE* file = std::fopen(this->path.c_str(), "rb");
+		std::array<char, 256> block{ };
+		while(const ostr::u64 size = std::fread(block.data(), 1, block.size(), file))
+			content.append(ostr::codeunit_sequence_view{ block.data(), size });
+		std::fclose(file);
+		return content;
+	}
+
+	ostr::codeunit_sequence path;
+};
@@ -0,0 +1,131 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+
+#include "case_insensitive.h"
+
+#include <map>
+#include <random>
+#include <unordered_map>
+
+using namespace ostr;
+
+// The same as the case-insensitive functions, on copies folded one code unit at a time.
+static codeunit_sequence fold_by_codeunit(const codeunit_sequence_view& view)
+{
+	codeunit_sequence folded;
+	for(const char codeunit : view)
+		folded.append(codeunit >= 'A' && codeunit <= 'Z' ? static_cast<char>(codeunit - 'A' + 'a') : codeunit);
+	return folded;
+}
+
+TEST(case_insensitive, view)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	static_assert("Content-Type"_cuqv.iequals("content-type"_cuqv));
+	static_assert("Content-Type: text/HTML; charset=UTF-8"_cuqv.iindex_of("CHARSET"_cuqv) == 25);
+	static_assert("Content-Type: text/HTML; charset=UTF-8"_cuqv.ihash() == "content-type: TEXT/html; CHARSET=utf-8"_cuqv.ihash());
+
+	EXPECT_TRUE("Content-Type: text/HTML"_cuqv.iequals("content-type: TEXT/html"_cuqv));
+	EXPECT_FALSE("Content-Type: text/HTML"_cuqv.iequals("content-type: TEXT/htm"_cuqv));
+	EXPECT_FALSE("[@`{"_cuqv.iequals("{`@["_cuqv));
+	EXPECT_TRUE("ÄÖÜ Straße"_cuqv.iequals("ÄÖÜ STRAßE"_cuqv));
+	EXPECT_FALSE("ä"_cuqv.iequals("Ä"_cuqv));
+	EXPECT_EQ("apple"_cuqv.icompare("BANANA"_cuqv), -1);
+	EXPECT_EQ("Zebra"_cuqv.icompare("apple"_cuqv), 1);
+	EXPECT_EQ("ABC"_cuqv.icompare("abc"_cuqv), 0);
+	EXPECT_EQ("ABC"_cuqv.icompare("abcd"_cuqv), -1);
+	// Letters are folded to lower case, so '_' is ordered before letters.
+	EXPECT_EQ("A_LONG_NAME"_cuqv.icompare("a_long_nameless"_cuqv), -1);
+	EXPECT_EQ("_"_cuqv.icompare("A"_cuqv), -1);
+	EXPECT_TRUE("GET /index.html HTTP/1.1"_cuqv.istarts_with("get "_cuqv));
+	EXPECT_TRUE("textures/Rock.PNG"_cuqv.iends_with(".png"_cuqv));
+	EXPECT_FALSE("png"_cuqv.iends_with(".png"_cuqv));
+	EXPECT_EQ("X-Forwarded-For: 1.2.3.4"_cuqv.iindex_of("forwarded"_cuqv), 2);
+	EXPECT_EQ("aaaaaaaaaaaaaaaaAAAAb"_cuqv.iindex_of("AAAB"_cuqv), 17);
+	EXPECT_EQ("abcabcabc"_cuqv.iindex_of("ABC"_cuqv, 1), 3);
+	EXPECT_EQ("abcabcabc"_cuqv.iindex_of("ABC"_cuqv, 1, 4), global_constant::INDEX_INVALID);
+	EXPECT_EQ("abc"_cuqv.iindex_of(""_cuqv), global_constant::INDEX_INVALID);
+	EXPECT_EQ("abc"_cuqv.iindex_of("abcd"_cuqv), global_constant::INDEX_INVALID);
+	EXPECT_NE("abc"_cuqv.ihash(), "abd"_cuqv.ihash());
+	EXPECT_NE("a"_cuqv.ihash(), "a\0"_cuqv.ihash());
+}
+
+TEST(case_insensitive, random)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	// Every size on each path, with letters, their neighbours and code units of the upper half.
+	std::mt19937 engine{ 42 };
+	const codeunit_sequence_view alphabet{ "aAzZ@[`{0\x80\xc1\xe1" };
+	for(u64 i = 0; i < 20000; ++i)
+	{
+		codeunit_sequence lhs;
+		codeunit_sequence rhs;
+		const u64 size = engine() % 40;
+		for(u64 j = 0; j < size; ++j)
+			lhs.append(alphabet.read_at(engine() % alphabet.size()));
+		// Mostly the same letters in a different case, sometimes different code units.
+		for(const char codeunit : lhs)
+		{
+			if(engine() % 64 == 0)
+				rhs.append(alphabet.read_at(engine() % alphabet.size()));
+			else if(engine() % 2 == 0 && codeunit >= 'a' && codeunit <= 'z')
+				rhs.append(static_cast<char>(codeunit - 'a' + 'A'));
+			else
+				rhs.append(codeunit);
+		}
+		const codeunit_sequence lhs_folded = fold_by_codeunit(lhs.view());
+		const codeunit_sequence rhs_folded = fold_by_codeunit(rhs.view());
+		ASSERT_EQ(lhs.view().iequals(rhs.view()), lhs_folded == rhs_folded) << lhs << " " << rhs;
+		ASSERT_EQ(lhs.view().icompare(rhs.view()), lhs_folded.view().compare(rhs_folded.view())) << lhs << " " << rhs;
+		if(lhs_folded == rhs_folded)
+		{
+			ASSERT_EQ(lhs.view().ihash(), rhs.view().ihash()) << lhs << " " << rhs;
+		}
+		const codeunit_sequence_view pattern = rhs.view().subview(size / 3, engine() % 6 + 1);
+		const codeunit_sequence pattern_folded = fold_by_codeunit(pattern);
+		ASSERT_EQ(lhs.view().iindex_of(pattern), lhs_folded.view().index_of(pattern_folded.view())) << lhs << " " << pattern;
+	}
+}
+
+TEST(case_insensitive, text_view)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	constexpr text_view header = "Überschrift: Größe"_txtv;
+	EXPECT_TRUE(header.iequals("Überschrift: GröSSE"_txtv) == false);
+	EXPECT_TRUE(header.iequals("ÜBERSCHRIFT: GRößE"_txtv));
+	EXPECT_EQ(header.iindex_of("GRÖ"_txtv), global_constant::INDEX_INVALID);
+	EXPECT_EQ(header.iindex_of("GRö"_txtv), 13);
+	EXPECT_EQ(header.iindex_of("e"_txtv, 5), 17);
+	EXPECT_TRUE(header.istarts_with("überSCHRIFT"_txtv) == false);
+	EXPECT_TRUE(header.istarts_with("ÜberSCHRIFT"_txtv));
+	EXPECT_TRUE(header.iends_with("ßE"_txtv));
+	EXPECT_EQ(header.icompare("ÜBERSCHRIFT: GRößE"_txtv), 0);
+	EXPECT_EQ(header.ihash(), "ÜBERSCHRIFT: GRößE"_txtv.ihash());
+}
+
+TEST(case_insensitive, policy)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		std::unordered_map<codeunit_sequence, i32, ascii_case_insensitive_hash, ascii_case_insensitive_equal> headers;
+		headers[codeunit_sequence{ "Content-Length" }] = 1;
+		headers[codeunit_sequence{ "content-length" }] = 2;
+		headers[codeunit_sequence{ "Host" }] = 3;
+		EXPECT_EQ(headers.size(), 2);
+		EXPECT_EQ(headers.at(codeunit_sequence{ "CONTENT-LENGTH" }), 2);
+		EXPECT_EQ(headers.count(codeunit_sequence{ "host" }), 1);
+	}
+	{
+		std::map<text, i32, ascii_case_insensitive_less> commands;
+		commands[text{ "Quit" }] = 1;
+		commands[text{ "help" }] = 2;
+		commands[text{ "HELP" }] = 3;
+		EXPECT_EQ(commands.size(), 2);
+		EXPECT_EQ(commands.begin()->first, "help"_txtv);
+		EXPECT_EQ(commands.begin()->second, 3);
+		EXPECT_EQ(commands.find("QUIT"_txtv)->second, 1);
+	}
+	EXPECT_TRUE(ascii_case_insensitive_equal{ }("Accept"_cuqv, codeunit_sequence{ "ACCEPT" }));
+	EXPECT_EQ(ascii_case_insensitive_hash{ }("Accept"_txtv), ascii_case_insensitive_hash{ }(text{ "aCCEPT" }));
+}
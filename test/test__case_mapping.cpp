@@ -0,0 +1,154 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+
+#include "case_mapping.h"
+
+#include <random>
+
+using namespace ostr;
+
+// The same as mapping text, one codepoint at a time.
+static codeunit_sequence map_by_codepoint(const text_view& source, const case_mapping mapping)
+{
+	codeunit_sequence result;
+	for(const codepoint cp : source)
+	{
+		std::array<char32_t, unicode::CASE_MAPPING_MAXIMUM_LENGTH> mapped{ };
+		const u64 count = unicode::map_case(static_cast<char32_t>(cp), mapping, mapped);
+		for(u64 i = 0; i < count; ++i)
+			result.append(codepoint{ mapped[i] });
+	}
+	return result;
+}
+
+TEST(case_mapping, codepoint)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const auto map = [](const char32_t cp, const case_mapping mapping)
+	{
+		std::array<char32_t, unicode::CASE_MAPPING_MAXIMUM_LENGTH> mapped{ };
+		const u64 count = unicode::map_case(cp, mapping, mapped);
+		return std::u32string{ mapped.data(), count };
+	};
+	EXPECT_EQ(map(U'A', case_mapping::lower), U"a");
+	EXPECT_EQ(map(U'a', case_mapping::lower), U"a");
+	EXPECT_EQ(map(U'a', case_mapping::upper), U"A");
+	EXPECT_EQ(map(U'1', case_mapping::upper), U"1");
+	EXPECT_EQ(map(U'Ä', case_mapping::fold), U"ä");
+	EXPECT_EQ(map(U'ß', case_mapping::lower), U"ß");
+	EXPECT_EQ(map(U'ß', case_mapping::upper), U"SS");
+	EXPECT_EQ(map(U'ß', case_mapping::fold), U"ss");
+	EXPECT_EQ(map(U'ẞ', case_mapping::fold), U"ss");
+	EXPECT_EQ(map(U'İ', case_mapping::lower), U"i\u0307");
+	EXPECT_EQ(map(U'ΐ', case_mapping::upper), U"\u0399\u0308\u0301");
+	EXPECT_EQ(map(U'ﬃ', case_mapping::upper), U"FFI");
+	EXPECT_EQ(map(U'Σ', case_mapping::lower), U"σ");
+	EXPECT_EQ(map(U'ς', case_mapping::upper), U"Σ");
+	EXPECT_EQ(map(U'ς', case_mapping::fold), U"σ");
+	EXPECT_EQ(map(U'ǅ', case_mapping::lower), U"ǆ");
+	EXPECT_EQ(map(U'ǅ', case_mapping::upper), U"Ǆ");
+	EXPECT_EQ(map(U'Ꭰ', case_mapping::fold), U"Ꭰ");
+	EXPECT_EQ(map(U'ꭰ', case_mapping::fold), U"Ꭰ");
+	EXPECT_EQ(map(U'𐐀', case_mapping::lower), U"𐐨");
+	EXPECT_EQ(map(U'𞤢', case_mapping::upper), U"𞤀");
+	EXPECT_EQ(map(U'中', case_mapping::upper), U"中");
+	EXPECT_EQ(map(U'\U0010FFFF', case_mapping::lower), U"\U0010FFFF");
+}
+
+TEST(case_mapping, text_view)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	EXPECT_EQ(to_lower("Hello, World! ÄÖÜ"_txtv), "hello, world! äöü"_txtv);
+	EXPECT_EQ(to_upper("Straße"_txtv), "STRASSE"_txtv);
+	EXPECT_EQ(case_fold("Straße"_txtv), case_fold("STRASSE"_txtv));
+	EXPECT_EQ(to_upper("Привет, мир"_txtv), "ПРИВЕТ, МИР"_txtv);
+	// The final sigma depends on the context, which is not applied.
+	EXPECT_EQ(to_lower("ΟΔΥΣΣΕΥΣ"_txtv), "οδυσσευσ"_txtv);
+	EXPECT_EQ(to_upper("ὀδυσσεύς"_txtv), "ὈΔΥΣΣΕΎΣ"_txtv);
+	EXPECT_EQ(to_upper("ﬁﬂΐ"_txtv), "FIFL\u0399\u0308\u0301"_txtv);
+	EXPECT_EQ(to_lower("漢字とカタカナ"_txtv), "漢字とカタカナ"_txtv);
+	EXPECT_EQ(to_upper("𐐨𐐩 𞤢"_txtv), "𐐀𐐁 𞤀"_txtv);
+	EXPECT_EQ(to_lower(""_txtv), ""_txtv);
+	// Ill-formed code units are kept.
+	EXPECT_EQ(to_upper(text_view{ "a\xff" "b\xc3" }).raw(), "A\xff" "B\xc3"_cuqv);
+	EXPECT_EQ(to_upper(text_view{ "\xed\xa0\x80z" }).raw(), "\xed\xa0\x80Z"_cuqv);
+	EXPECT_EQ(to_upper(text_view{ "\xe4" "a\xe4\xb8" "b\xd7" "c" }).raw(), "\xe4" "A\xe4\xb8" "B\xd7" "C"_cuqv);
+	{
+		codeunit_sequence destination{ "Name: " };
+		map_case_to(destination, "Jürgen Groß"_cuqv, case_mapping::upper);
+		EXPECT_EQ(destination, "Name: JÜRGEN GROSS"_cuqv);
+	}
+}
+
+TEST(case_mapping, text)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		const text t{ "The Quick Brown Fox Jumps Over The Lazy Dog" };
+		EXPECT_EQ(t.to_lower(), "the quick brown fox jumps over the lazy dog"_txtv);
+		EXPECT_EQ(t.to_upper(), "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG"_txtv);
+		EXPECT_EQ(t.case_fold(), t.to_lower());
+	}
+	{
+		text t{ "Größenmaßstäbe" };
+		t.self_to_upper();
+		EXPECT_EQ(t, "GRÖSSENMASSSTÄBE"_txtv);
+		t.self_to_lower();
+		EXPECT_EQ(t, "grössenmassstäbe"_txtv);
+	}
+	{
+		// Shorter in upper case, which is mapped in place.
+		text t{ "ﬀ ﬀ ﬀ ﬀ ﬀ ﬀ ﬀ ﬀ ﬀ ﬀ" };
+		const char* data = t.c_str();
+		t.self_to_upper();
+		EXPECT_EQ(t, "FF FF FF FF FF FF FF FF FF FF"_txtv);
+		EXPECT_EQ(t.c_str(), data);
+	}
+	{
+		// Longer in upper case from the start, which moves to a new buffer.
+		text t{ "ΐΰ and some more text after them" };
+		t.self_to_upper();
+		EXPECT_EQ(t, "\u0399\u0308\u0301\u03A5\u0308\u0301 AND SOME MORE TEXT AFTER THEM"_txtv);
+	}
+	{
+		text t{ "İSTANBUL" };
+		t.self_case_fold();
+		EXPECT_EQ(t, "i\u0307stanbul"_txtv);
+	}
+}
+
+TEST(case_mapping, random)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	// Runs of ascii of every length between codepoints of every size, including the ones changing length.
+	const std::array<text_view, 16> pieces
+	{
+		"a"_txtv, "Z"_txtv, "0"_txtv, "ß"_txtv, "Ä"_txtv, "ΐ"_txtv, "İ"_txtv, "ﬃ"_txtv,
+		"ⅷ"_txtv, "Ⱥ"_txtv, "ȿ"_txtv, "中"_txtv, "𐐀"_txtv, "😀"_txtv, "ŉ"_txtv, "ǰ"_txtv,
+	};
+	std::mt19937 engine{ 42 };
+	for(u64 i = 0; i < 5000; ++i)
+	{
+		text source;
+		const u64 count = engine() % 24;
+		for(u64 j = 0; j < count; ++j)
+		{
+			if(engine() % 2 == 0)
+				for(u64 k = engine() % 20; k > 0; --k)
+					source.append(static_cast<char>(" AaZz@[`{~"[engine() % 10]));
+			else
+				source.append(pieces[engine() % pieces.size()]);
+		}
+		for(const case_mapping mapping : { case_mapping::lower, case_mapping::upper, case_mapping::fold })
+		{
+			const codeunit_sequence expected = map_by_codepoint(source.view(), mapping);
+			codeunit_sequence mapped;
+			map_case_to(mapped, source.view().raw(), mapping);
+			ASSERT_EQ(mapped, expected) << source;
+			codeunit_sequence in_place{ source.view().raw() };
+			map_case_in_place(in_place, mapping);
+			ASSERT_EQ(in_place, expected) << source;
+		}
+	}
+}
@@ -2,6 +2,9 @@
 // ReSharper disable StringLiteralTypo
 #include "pch.h"
 
+#include <iterator>
+#include <sstream>
+
 using namespace ostr;
 
 // this is a struct that has same memory layout as struct codeunit_sequence
@@ -20,7 +23,7 @@ struct codeunit_sequence_accessor
 	struct norm
 	{
 		u32 alloc : 1;
-		u32 size : 15;
+		u32 size : 31;
 		u32 capacity;
 		char* data;
 	};
@@ -326,4 +329,43 @@ TEST(codeunit_sequence, join)
 		const codeunit_sequence joined_2 = codeunit_sequence::join(views, ""_cuqv);
 		EXPECT_EQ(joined_2, "Thisisaveryverylongtext"_cuqv);
 	}
+	{
+		const std::vector<const char*> empty;
+		EXPECT_TRUE(codeunit_sequence::join(empty, ", "_cuqv).is_empty());
+		const std::vector<const char*> pieces{ "", "a", "", "b" };
+		EXPECT_EQ(codeunit_sequence::join(pieces, ","_cuqv), ",a,,b"_cuqv);
+	}
+	{
+		// Longer than the 15 bits of size the sequence used to have.
+		const std::vector<codeunit_sequence_view> words(20000, "word"_cuqv);
+		const codeunit_sequence joined = codeunit_sequence::join(words, ", "_cuqv);
+		EXPECT_EQ(joined.size(), 20000 * 6 - 2);
+		EXPECT_TRUE(joined.starts_with("word, word"_cuqv));
+		EXPECT_TRUE(joined.ends_with("word, word"_cuqv));
+		EXPECT_EQ(joined.count("word"_cuqv), 20000);
+	}
+	{
+		// Single-pass ranges are gathered in chunks.
+		std::istringstream stream{ std::string(3000, 'x') };
+		const codeunit_sequence joined = codeunit_sequence::join(std::istream_iterator<char>{ stream }, std::istream_iterator<char>{ }, "-"_cuqv);
+		EXPECT_EQ(joined.size(), 5999);
+		EXPECT_EQ(joined.count("x-"_cuqv), 2999);
+		EXPECT_TRUE(joined.ends_with("-x"_cuqv));
+	}
+}
+
+TEST(codeunit_sequence, compare)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const codeunit_sequence short_sequence{ "textures/rock" };
+	const codeunit_sequence long_sequence{ "textures/rock.png with a heap allocated buffer" };
+	EXPECT_LT(short_sequence, long_sequence);
+	EXPECT_LT(short_sequence, "textures/sky"_cuqv);
+	EXPECT_GT(long_sequence, short_sequence);
+	EXPECT_LE(short_sequence, codeunit_sequence{ "textures/rock" });
+	EXPECT_GE(short_sequence, "textures/rock"_cuqv);
+	EXPECT_EQ(short_sequence.compare(long_sequence), -1);
+	EXPECT_EQ(long_sequence.compare(short_sequence.view()), 1);
+	EXPECT_EQ(short_sequence.compare("textures/rock"_cuqv), 0);
+	EXPECT_LT(codeunit_sequence{ "z" }, codeunit_sequence{ "é" });
 }
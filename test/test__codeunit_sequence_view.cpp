@@ -30,6 +30,7 @@ TEST(codeunit_sequence_view, index_of)
 		constexpr auto view = "Hello world!"_cuqv;
 		constexpr u64 index = view.index_of("?"_cuqv);
 		EXPECT_EQ(index, global_constant::INDEX_INVALID);
+		EXPECT_EQ(view.index_of(""_cuqv), global_constant::INDEX_INVALID);
 	}
 	{
 		constexpr auto view = "{:r}"_cuqv;
@@ -148,6 +149,44 @@ TEST(codeunit_sequence_view, equal)
 	}
 }
 
+TEST(codeunit_sequence_view, compare)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	static_assert("abcdefghijklmnopq"_cuqv == "abcdefghijklmnopq"_cuqv);
+	static_assert("abcdefghijklmnopq"_cuqv.compare("abcdefghijklmnopz"_cuqv) < 0);
+	static_assert("\xff"_cuqv > "\x01"_cuqv);
+
+	// Every size on each path, with a single mismatch at every position in both directions.
+	std::array<char, 40> lhs{ };
+	for(u64 i = 0; i < lhs.size(); ++i)
+		lhs[i] = static_cast<char>('a' + i);
+	for(u64 size = 0; size <= lhs.size(); ++size)
+	{
+		const codeunit_sequence_view view{ lhs.data(), size };
+		std::array<char, 40> rhs = lhs;
+		EXPECT_EQ(view, codeunit_sequence_view(rhs.data(), size));
+		EXPECT_EQ(view.compare({ rhs.data(), size }), 0);
+		for(u64 position = 0; position < size; ++position)
+		{
+			for(const char codeunit : { '\x01', '\xff' })
+			{
+				rhs[position] = codeunit;
+				const codeunit_sequence_view other{ rhs.data(), size };
+				const i32 expected = codeunit == '\x01' ? 1 : -1;
+				EXPECT_FALSE(view == other) << size << " " << position;
+				EXPECT_EQ(view.compare(other), expected) << size << " " << position;
+				EXPECT_EQ(other.compare(view), -expected) << size << " " << position;
+			}
+			rhs[position] = lhs[position];
+		}
+		if(size > 0)
+		{
+			EXPECT_LT(view.subview(0, size - 1), view);
+			EXPECT_GT(view, view.subview(0, size - 1));
+		}
+	}
+}
+
 TEST(codeunit_sequence_view, trim)
 {
 	SCOPED_DETECT_MEMORY_LEAK()
@@ -0,0 +1,82 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+
+#include "concatenation.h"
+
+using namespace ostr;
+
+// Argument counting how many times it is formatted.
+struct counted_argument
+{
+	mutable u64 count = 0;
+};
+
+namespace ostr
+{
+	template<>
+	struct argument_formatter<counted_argument>
+	{
+		static void produce(format_sink& sink, const counted_argument& value, const codeunit_sequence_view&)
+		{
+			++value.count;
+			sink.append("counted"_cuqv);
+		}
+	};
+}
+
+// Sizes of literals, code units and codepoints fold at compile time.
+static_assert(("Hello"_cuqv + ' ' + "World" + codepoint{ U'🌍' }).size() == 15);
+
+TEST(concatenation, materialize)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		const codeunit_sequence hello{ "Hello" };
+		const codeunit_sequence result = hello + ", " + "World"_cuqv + codepoint{ U'🌍' } + '!';
+		EXPECT_EQ(result, "Hello, World🌍!"_cuqv);
+	}
+	{
+		const text name{ "繁星明" };
+		const text result = "Hi "_txtv + name + "! "_cuqv + formatted("You have {} new messages."_cuqv, 42);
+		EXPECT_EQ(result, "Hi 繁星明! You have 42 new messages."_txtv);
+		EXPECT_EQ(result.size(), 33);
+	}
+	{
+		// Nothing is materialized without a destination.
+		const codeunit_sequence_view left = "left"_cuqv;
+		const auto expression = left + '-' + "right";
+		EXPECT_EQ(expression.size(), 10);
+		EXPECT_EQ(expression.to_sequence(), "left-right"_cuqv);
+	}
+}
+
+TEST(concatenation, append)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		codeunit_sequence sequence{ "This is" };
+		const codeunit_sequence_view adjective = "very"_cuqv;
+		sequence += ' ' + adjective + ' ' + adjective + formatted(OPEN_STRING_FORMAT_MOLD(" {} sequence."), "long"_cuqv);
+		EXPECT_EQ(sequence, "This is very very long sequence."_cuqv);
+	}
+	{
+		text t{ "我" };
+		t += " love "_txtv + codepoint{ U'😘' };
+		EXPECT_EQ(t, "我 love 😘"_txtv);
+	}
+	{
+		const codeunit_sequence_view name = "slime"_cuqv;
+		EXPECT_EQ(format("[{}]"_cuqv, name + ':' + formatted("{:x}"_cuqv, 255)), "[slime:ff]"_cuqv);
+	}
+}
+
+TEST(concatenation, format_once)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const counted_argument argument;
+	const codeunit_sequence_view name = "slime"_cuqv;
+	const codeunit_sequence result = name + ' ' + formatted("<{}>"_cuqv, argument) + ' ' + name + '!';
+	EXPECT_EQ(result, "slime <counted> slime!"_cuqv);
+	EXPECT_EQ(argument.count, 1);
+}
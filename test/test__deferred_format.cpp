@@ -0,0 +1,120 @@
+
+#include "pch.h"
+
+#include "deferred_format.h"
+
+#include <thread>
+#include <vector>
+
+using namespace ostr;
+
+TEST(deferred_format, render)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    deferred_format_queue queue{ 1024, deferred_producer_mode::single };
+    {
+        // Strings are copied into the record, so they are not required to live until rendering.
+        const codeunit_sequence name{ "繁星明" };
+        EXPECT_TRUE(queue.push(OPEN_STRING_FORMAT_MOLD("{} hit {} for {} damage ({:x}).\n"), name, "slime", 42, 255));
+        EXPECT_TRUE(queue.push(OPEN_STRING_FORMAT_MOLD("{1:.2f} {0}\n"), name.view(), 1.5));
+        EXPECT_TRUE(queue.push(OPEN_STRING_FORMAT_MOLD("{{no arguments}}\n")));
+    }
+    codeunit_sequence result;
+    format_sink sink{ result };
+    EXPECT_EQ(queue.render(sink), 3);
+    EXPECT_EQ(result, "繁星明 hit slime for 42 damage (ff).\n1.50 繁星明\n{no arguments}\n"_cuqv);
+    EXPECT_EQ(queue.render(sink), 0);
+    EXPECT_EQ(queue.dropped(), 0);
+}
+
+TEST(deferred_format, wide_string)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    deferred_format_queue queue{ 1024, deferred_producer_mode::single };
+    {
+        // Wide strings are encoded when they are captured, the buffer is gone before rendering.
+        wchar_t buffer[16] = L"繁星 😙";
+        const wchar_t* pointer = buffer;
+        const wide_text wide{ L"wide" };
+        EXPECT_TRUE(queue.push(OPEN_STRING_FORMAT_MOLD("{} {} {}\n"), pointer, buffer, wide));
+        buffer[0] = L'x';
+    }
+    {
+        const wchar_t* empty = nullptr;
+        EXPECT_TRUE(queue.push(OPEN_STRING_FORMAT_MOLD("[{}]\n"), empty));
+    }
+    codeunit_sequence result;
+    format_sink sink{ result };
+    EXPECT_EQ(queue.render(sink), 2);
+    EXPECT_EQ(result, "繁星 😙 繁星 😙 wide\n[]\n"_cuqv);
+}
+
+TEST(deferred_format, overflow)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    codeunit_sequence result;
+    format_sink sink{ result };
+    deferred_format_queue queue{ 256, deferred_producer_mode::single, deferred_overflow_policy::drop };
+    EXPECT_EQ(queue.capacity(), 256);
+    u64 pushed = 0;
+    while(queue.push(OPEN_STRING_FORMAT_MOLD("{},"), pushed))
+        ++pushed;
+    EXPECT_EQ(queue.dropped(), 1);
+    EXPECT_EQ(queue.render(sink), pushed);
+
+    // Records wrap around the end of the buffer many times.
+    result.empty();
+    codeunit_sequence expected;
+    for(u64 i = 0; i < 1000; ++i)
+    {
+        EXPECT_TRUE(queue.push(OPEN_STRING_FORMAT_MOLD("{}{},"), i, i % 3 == 0 ? "abcdefghijklmnopqrstuvwxyz" : ""));
+        format_to(expected, "{}{},"_cuqv, i, i % 3 == 0 ? "abcdefghijklmnopqrstuvwxyz" : "");
+        if(i % 2 == 0)
+            queue.render(sink);
+    }
+    queue.render(sink);
+    EXPECT_EQ(result, expected);
+
+    // Records larger than half of the buffer never fit.
+    codeunit_sequence large;
+    large.append('x', 200);
+    EXPECT_FALSE(queue.push(OPEN_STRING_FORMAT_MOLD("{}"), large));
+    EXPECT_EQ(queue.dropped(), 2);
+}
+
+TEST(deferred_format, multiple_producers)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    static constexpr u64 thread_count = 4;
+    static constexpr u64 record_count = 10000;
+    std::vector<u64> counts(thread_count, 0);
+    format_sink sink{ &counts, [](void* destination, const char* data, const u64 size)
+    {
+        // Each record is rendered by a single write of the thread index.
+        std::vector<u64>& thread_counts = *static_cast<std::vector<u64>*>(destination);
+        ASSERT_EQ(size, 1);
+        ++thread_counts[static_cast<u64>(data[0] - '0')];
+    } };
+    deferred_format_queue queue{ 4096, deferred_producer_mode::multiple, deferred_overflow_policy::block };
+    {
+        deferred_format_worker worker{ queue, sink, std::chrono::microseconds{ 10 } };
+        std::vector<std::thread> producers;
+        for(u64 t = 0; t < thread_count; ++t)
+        {
+            producers.emplace_back([&queue, t]
+            {
+                for(u64 i = 0; i < record_count; ++i)
+                    queue.push(OPEN_STRING_FORMAT_MOLD("{}"), t);
+            });
+        }
+        for(std::thread& producer : producers)
+            producer.join();
+    }
+    EXPECT_EQ(queue.dropped(), 0);
+    for(const u64 count : counts)
+        EXPECT_EQ(count, record_count);
+}
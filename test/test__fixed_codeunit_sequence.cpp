@@ -0,0 +1,177 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+
+#include "fixed_codeunit_sequence.h"
+
+#include <cstring>
+
+using namespace ostr;
+
+static_assert(std::is_trivially_copyable_v<fixed_codeunit_sequence<15>>);
+static_assert(std::is_trivially_copyable_v<fixed_codeunit_sequence<300, fixed_overflow_policy::check>>);
+static_assert(!std::is_trivially_copyable_v<fixed_codeunit_sequence<15, fixed_overflow_policy::heap>>);
+static_assert(sizeof(fixed_codeunit_sequence<15>) == 17);
+
+TEST(fixed_codeunit_sequence, construct)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		const fixed_codeunit_sequence<16> sequence;
+		EXPECT_TRUE(sequence.is_empty());
+		EXPECT_EQ(sequence.capacity(), 16);
+		EXPECT_STREQ(sequence.c_str(), "");
+	}
+	{
+		const fixed_codeunit_sequence<16> sequence("Hello World!");
+		EXPECT_EQ(sequence.size(), 12);
+		EXPECT_EQ(sequence, "Hello World!"_cuqv);
+		const codeunit_sequence_view view = sequence;
+		EXPECT_EQ(view, "Hello World!"_cuqv);
+	}
+	{
+		// Copies are plain copies of bytes.
+		fixed_codeunit_sequence<16> sequence("Hello");
+		fixed_codeunit_sequence<16> copied;
+		std::memcpy(&copied, &sequence, sizeof(sequence));
+		sequence.append(" World!");
+		EXPECT_EQ(copied, "Hello"_cuqv);
+		EXPECT_EQ(sequence, "Hello World!"_cuqv);
+	}
+}
+
+TEST(fixed_codeunit_sequence, append)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		fixed_codeunit_sequence<32> sequence;
+		sequence.append("Hello").append(' ').append("World"_cuqv).append(codepoint{ U'🌍' }).append('!', 3);
+		EXPECT_EQ(sequence, "Hello World🌍!!!"_cuqv);
+		sequence += "~";
+		EXPECT_EQ(sequence, "Hello World🌍!!!~"_cuqv);
+		sequence.append(sequence.subview(0, 5));
+		EXPECT_EQ(sequence, "Hello World🌍!!!~Hello"_cuqv);
+	}
+	{
+		// Truncation never cuts a codepoint, and later appends are dropped to keep a prefix.
+		fixed_codeunit_sequence<8> sequence("Hello");
+		sequence.append("🌍");
+		EXPECT_EQ(sequence, "Hello"_cuqv);
+		sequence.append("é!");
+		EXPECT_EQ(sequence, "Hello"_cuqv);
+		sequence = "Hello"_cuqv;
+		sequence.append("é!");
+		EXPECT_EQ(sequence, "Helloé!"_cuqv);
+		sequence.append('?', 10);
+		EXPECT_EQ(sequence, "Helloé!"_cuqv);
+		EXPECT_EQ(sequence.size(), 8);
+	}
+	{
+		fixed_codeunit_sequence<5> sequence("abcd");
+		sequence.append("繁").append("x").append('y');
+		EXPECT_EQ(sequence, "abcd"_cuqv);
+		sequence.empty();
+		sequence.append("x");
+		EXPECT_EQ(sequence, "x"_cuqv);
+	}
+	{
+		fixed_codeunit_sequence<4, fixed_overflow_policy::heap> sequence("Hi");
+		EXPECT_FALSE(sequence.is_spilled());
+		sequence.append(", this is a very long sequence.");
+		EXPECT_TRUE(sequence.is_spilled());
+		EXPECT_EQ(sequence, "Hi, this is a very long sequence."_cuqv);
+		sequence.append(sequence.view());
+		EXPECT_EQ(sequence, "Hi, this is a very long sequence.Hi, this is a very long sequence."_cuqv);
+
+		const fixed_codeunit_sequence<4, fixed_overflow_policy::heap> copied = sequence;
+		EXPECT_EQ(copied, sequence.view());
+		fixed_codeunit_sequence<4, fixed_overflow_policy::heap> moved = std::move(sequence);
+		EXPECT_EQ(moved, copied.view());
+		moved = fixed_codeunit_sequence<4, fixed_overflow_policy::heap>("Ok");
+		EXPECT_EQ(moved, "Ok"_cuqv);
+	}
+}
+
+TEST(fixed_codeunit_sequence, search)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const fixed_codeunit_sequence<32> sequence("This is a sequence.");
+	EXPECT_EQ(sequence.index_of("is"_cuqv), 2);
+	EXPECT_EQ(sequence.last_index_of("is"_cuqv), 5);
+	EXPECT_EQ(sequence.count("is"_cuqv), 2);
+	EXPECT_TRUE(sequence.starts_with("This"_cuqv));
+	EXPECT_TRUE(sequence.ends_with("sequence."_cuqv));
+	EXPECT_EQ(sequence.subview(10, 8), "sequence"_cuqv);
+
+	std::vector<codeunit_sequence_view> pieces;
+	EXPECT_EQ(sequence.split(" "_cuqv, pieces), 4);
+	const std::vector<codeunit_sequence_view> expected{ "This"_cuqv, "is"_cuqv, "a"_cuqv, "sequence."_cuqv };
+	EXPECT_EQ(pieces, expected);
+}
+
+TEST(fixed_codeunit_sequence, replace)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		fixed_codeunit_sequence<64> sequence("This is a sequence, is it?");
+		sequence.replace("was"_cuqv, "is"_cuqv, 5);
+		EXPECT_EQ(sequence, "This was a sequence, was it?"_cuqv);
+		sequence.replace("an array"_cuqv, 9, 10);
+		EXPECT_EQ(sequence, "This was an array, was it?"_cuqv);
+		sequence.replace(""_cuqv, "was "_cuqv);
+		EXPECT_EQ(sequence, "This an array, it?"_cuqv);
+	}
+	{
+		fixed_codeunit_sequence<12> sequence("a-b-c-d");
+		sequence.replace("---"_cuqv, "-"_cuqv);
+		EXPECT_EQ(sequence, "a---b---c---"_cuqv);
+	}
+	{
+		fixed_codeunit_sequence<4, fixed_overflow_policy::heap> sequence("a-b-c-d");
+		sequence.replace("---"_cuqv, "-"_cuqv);
+		EXPECT_EQ(sequence, "a---b---c---d"_cuqv);
+	}
+}
+
+TEST(fixed_codeunit_sequence, trim)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		fixed_codeunit_sequence<32> sequence("  \t Hello World! \t ");
+		EXPECT_EQ(sequence.view_trim_start(), "Hello World! \t "_cuqv);
+		EXPECT_EQ(sequence.view_trim_end(), "  \t Hello World!"_cuqv);
+		sequence.self_trim();
+		EXPECT_EQ(sequence, "Hello World!"_cuqv);
+		sequence.self_remove_prefix("Hello "_cuqv).self_remove_suffix("!"_cuqv);
+		EXPECT_EQ(sequence, "World"_cuqv);
+		sequence.reverse();
+		EXPECT_EQ(sequence, "dlroW"_cuqv);
+	}
+	{
+		fixed_codeunit_sequence<8> sequence(" \t ");
+		sequence.self_trim();
+		EXPECT_TRUE(sequence.is_empty());
+	}
+}
+
+TEST(fixed_codeunit_sequence, format)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		fixed_codeunit_sequence<32> sequence("x = ");
+		format_to(sequence, OPEN_STRING_FORMAT_MOLD("{}, y = {:.2f}"), 42, 1.5);
+		EXPECT_EQ(sequence, "x = 42, y = 1.50"_cuqv);
+		EXPECT_EQ(format("[{}]"_cuqv, sequence), "[x = 42, y = 1.50]"_cuqv);
+		EXPECT_EQ(codeunit_sequence::build(sequence, "!"), "x = 42, y = 1.50!"_cuqv);
+	}
+	{
+		fixed_codeunit_sequence<8> sequence;
+		format_to(sequence, "{} {}"_cuqv, 12345, 67890);
+		EXPECT_EQ(sequence, "12345 67"_cuqv);
+	}
+	{
+		fixed_codeunit_sequence<8> sequence;
+		format_to(sequence, "{}{}"_cuqv, "繁星明", "ab");
+		EXPECT_EQ(sequence, "繁星"_cuqv);
+	}
+}
@@ -0,0 +1,55 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+
+#include "fixed_text.h"
+
+using namespace ostr;
+
+static_assert(std::is_trivially_copyable_v<fixed_text<31>>);
+
+TEST(fixed_text, construct)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		const fixed_text<32> t("Hello 🌏!");
+		EXPECT_EQ(t.size(), 8);
+		EXPECT_EQ(t.raw().size(), 11);
+		const text_view view = t;
+		EXPECT_EQ(view, "Hello 🌏!"_txtv);
+	}
+	{
+		// Truncation never cuts a codepoint.
+		const fixed_text<8> t("我爱你们");
+		EXPECT_EQ(t, "我爱"_txtv);
+		EXPECT_EQ(t.size(), 2);
+	}
+}
+
+TEST(fixed_text, modify)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		fixed_text<64> t(" 我 very 😘あなた! ");
+		t.self_trim();
+		EXPECT_EQ(t, "我 very 😘あなた!"_txtv);
+		EXPECT_EQ(t.index_of("😘"_txtv), 7);
+		EXPECT_EQ(t.read_at(7), codepoint{ U'😘' });
+		t.write_at(7, codepoint{ U'😊' });
+		EXPECT_EQ(t, "我 very 😊あなた!"_txtv);
+		t.replace("love"_txtv, "very"_txtv);
+		EXPECT_EQ(t, "我 love 😊あなた!"_txtv);
+		t.subtext(7, 4);
+		EXPECT_EQ(t, "😊あなた"_txtv);
+		t.reverse();
+		EXPECT_EQ(t, "たなあ😊"_txtv);
+	}
+	{
+		fixed_text<32> t("a, b,, c");
+		sequence<text_view> pieces;
+		EXPECT_EQ(t.split(","_txtv, pieces), 4);
+		EXPECT_EQ(pieces.size(), 3);
+		EXPECT_EQ(text::join(pieces, "|"_txtv), "a| b| c"_txtv);
+		EXPECT_EQ(format("{}!"_cuqv, t), "a, b,, c!"_cuqv);
+	}
+}
@@ -3,12 +3,54 @@
 
 #include "format.h"
 
+#include <charconv>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
 #include <limits>
+#include <random>
+#include <string>
 
 using namespace ostr;
 
 #define EXPECT_CHECKED_WITH_MESSAGE(statement, expected_message)
 
+namespace
+{
+    struct test_point
+    {
+        int x;
+        int y;
+    };
+
+    struct test_legacy_point
+    {
+        int x;
+        int y;
+    };
+}
+
+template<>
+struct ostr::argument_formatter<test_point>
+{
+    static void produce(format_sink& sink, const test_point& value, const codeunit_sequence_view& specification)
+    {
+        format_to(sink, "({}, {})"_cuqv, value.x, value.y);
+    }
+};
+
+template<>
+struct ostr::argument_formatter<test_legacy_point>
+{
+    static codeunit_sequence produce(const test_legacy_point& value, const codeunit_sequence_view& specification)
+    {
+        return format("({}, {})"_cuqv, value.x, value.y);
+    }
+};
+
 TEST(format, built_in_types)
 {
     SCOPED_DETECT_MEMORY_LEAK()
@@ -27,12 +69,21 @@ TEST(format, built_in_types)
     EXPECT_EQ("3.14"_cuqv, format("{}"_cuqv, 3.14f));
     EXPECT_EQ("3.1"_cuqv, format("{:.1f}"_cuqv, 3.14f));
     EXPECT_EQ("-3.14000"_cuqv, format("{:.5f}"_cuqv, -3.14f));
-    EXPECT_EQ("-100"_cuqv, format("{}"_cuqv, -99.999999999));
+    EXPECT_EQ("-99.999999999"_cuqv, format("{}"_cuqv, -99.999999999));
+    EXPECT_EQ("100"_cuqv, format("{}"_cuqv, 100.0));
+    EXPECT_EQ("0.1"_cuqv, format("{}"_cuqv, 0.1));
+    EXPECT_EQ("1e+100"_cuqv, format("{}"_cuqv, 1e100));
+    EXPECT_EQ("3.1400001049"_cuqv, format("{:.10f}"_cuqv, 3.14f));
+    EXPECT_EQ("3.14e+00"_cuqv, format("{:.2e}"_cuqv, 3.14));
+    EXPECT_EQ("1.5e-07"_cuqv, format("{:e}"_cuqv, 1.5e-7));
+    EXPECT_EQ("0.00000015"_cuqv, format("{:f}"_cuqv, 1.5e-7));
+    EXPECT_EQ("3.1"_cuqv, format("{:.2g}"_cuqv, 3.14));
+    EXPECT_EQ("1.8p+1"_cuqv, format("{:a}"_cuqv, 3.0));
+    EXPECT_EQ("nan"_cuqv, format("{}"_cuqv, std::numeric_limits<f64>::quiet_NaN()));
     EXPECT_EQ("60.004"_cuqv, format("{}"_cuqv, 60.004));
     EXPECT_EQ("inf"_cuqv, format("{}"_cuqv, std::numeric_limits<f32>::infinity()));
     EXPECT_EQ("-inf"_txtv, format("{}"_txtv, -std::numeric_limits<f64>::infinity()));
     EXPECT_EQ("nan"_cuqv, format("{}"_cuqv, std::numeric_limits<f32>::quiet_NaN()));
-    EXPECT_CHECKED_WITH_MESSAGE(format("{:.10f}"_cuqv, 3.14f), "Too high precision for float type [10]!");
 
     // pointer
     EXPECT_EQ("nullptr"_cuqv, format("{}"_cuqv, nullptr));
@@ -78,3 +129,280 @@ TEST(format, format_exception)
     EXPECT_CHECKED_WITH_MESSAGE(format("{abc}"_cuqv, 123), "Invalid format index [abc]!");      // named argument is not allowed.
     EXPECT_CHECKED_WITH_MESSAGE(format("{:.1fa}"_cuqv, 3.14f), "Invalid format specification [.1fa]!");
 }
+
+TEST(format, compiled_format_mold)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    constexpr auto mold = OPEN_STRING_FORMAT_MOLD("{{{}}} is {:#x}, {}!");
+    static_assert(decltype(mold)::plan.argument_count == 3);
+    static_assert(decltype(mold)::plan.steps.size() == 8);
+    EXPECT_EQ("{abc} is 0xff, 3.14!"_cuqv, format(mold, "abc"_cuqv, 255, 3.14));
+
+    EXPECT_EQ("My name is 繁星明 and I'm 25 years old."_cuqv, format(OPEN_STRING_FORMAT_MOLD("My name is {1} and I'm {0} years old."), 25, "繁星明"_cuqv));
+    EXPECT_EQ("-0xff"_cuqv, format(OPEN_STRING_FORMAT_MOLD("{:#x}"), -255));
+    EXPECT_EQ("{}"_cuqv, format(OPEN_STRING_FORMAT_MOLD("{{}}")));
+    EXPECT_EQ(""_cuqv, format(OPEN_STRING_FORMAT_MOLD("")));
+
+    // Invalid format molds and insufficient arguments fail to compile, like:
+    // format(OPEN_STRING_FORMAT_MOLD("{}{ {}"), 3);
+    // format(OPEN_STRING_FORMAT_MOLD("{} {0}"), 3);
+    // format(OPEN_STRING_FORMAT_MOLD("{}{}"), 3);
+}
+
+TEST(format, format_to)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    // append after an existing sequence
+    codeunit_sequence result("Point: ");
+    EXPECT_EQ("Point: (1, -2)"_cuqv, format_to(result, "{}"_cuqv, test_point{ 1, -2 }));
+    format_to(result, OPEN_STRING_FORMAT_MOLD(" and {}"), test_legacy_point{ 3, 4 });
+    EXPECT_EQ("Point: (1, -2) and (3, 4)"_cuqv, result);
+
+    // output iterators
+    char buffer[32] = { };
+    const char* last = format_to(buffer, "{:#x}|{:04}"_cuqv, 255, 7);
+    EXPECT_EQ("0xff|0007"_cuqv, codeunit_sequence_view(buffer, last));
+    std::string standard;
+    format_to(std::back_inserter(standard), "{} {}"_cuqv, "繁星明"_cuqv, 3.5);
+    EXPECT_EQ("繁星明 3.5", standard);
+
+    // a sink without a write function only counts code units
+    format_sink counter{ nullptr, nullptr };
+    format_to(counter, "{}-{:b}"_cuqv, 12345, 5);
+    EXPECT_EQ(counter.size(), 9);
+
+    // floats acquired again and again from a growing sequence reallocate geometrically
+    codeunit_sequence floats;
+    format_sink float_sink{ floats };
+    u64 reallocation_count = 0;
+    for(u64 i = 0; i < 4096; ++i)
+    {
+        const char* data = floats.data();
+        format_to(float_sink, "{}"_cuqv, 0.1 * static_cast<f64>(i));
+        reallocation_count += floats.data() != data ? 1 : 0;
+    }
+    EXPECT_LE(reallocation_count, 20);
+    EXPECT_TRUE(floats.starts_with("00.10.20.30"_cuqv));
+
+    // the minimum value formats without overflow
+    EXPECT_EQ("-9223372036854775808"_cuqv, format("{}"_cuqv, std::numeric_limits<i64>::min()));
+}
+
+TEST(format, format_to_n)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    {
+        char buffer[16] = { };
+        const format_to_n_result result = format_to_n(buffer, sizeof(buffer), "{} and {}"_cuqv, test_point{ 1, -2 }, test_legacy_point{ 3, 4 });
+        EXPECT_EQ(result.size, "(1, -2) and (3, 4)"_cuqv.size());
+        EXPECT_EQ("(1, -2) and (3, "_cuqv, codeunit_sequence_view(buffer, result.out));
+    }
+    {
+        // "繁" takes 3 code units, a cut codepoint is dropped as a whole.
+        char buffer[8] = { };
+        for(u64 capacity = 0; capacity <= 7; ++capacity)
+        {
+            const format_to_n_result result = format_to_n(buffer, capacity, OPEN_STRING_FORMAT_MOLD("{}!"), "繁星");
+            EXPECT_EQ(result.size, 7);
+            EXPECT_EQ(static_cast<u64>(result.out - buffer), capacity / 3 * 3 + (capacity == 7 ? 1 : 0));
+        }
+    }
+
+    const auto message = format_inline<11>("{}: {:04x}, {}"_cuqv, "繁星明", 255, 1.5);
+    EXPECT_EQ("繁星明: "_cuqv, message.view());
+    EXPECT_STREQ("繁星明: ", message.c_str());
+    EXPECT_EQ(message.formatted_size(), "繁星明: 00ff, 1.5"_cuqv.size());
+    EXPECT_TRUE(message.is_truncated());
+    EXPECT_FALSE(format_inline<32>("{}"_cuqv, 42).is_truncated());
+
+    // High precisions are filled with zeros beyond the exact digits, instead of formatting into the heap.
+    char expected[2048] = { };
+    std::snprintf(expected, sizeof(expected), "%.1100f", 0.1);
+    EXPECT_EQ(codeunit_sequence_view{ expected }, format("{:.1100f}"_cuqv, 0.1));
+    std::snprintf(expected, sizeof(expected), "%.1000e", -5e-324);
+    EXPECT_EQ(codeunit_sequence_view{ expected }, format("{:.1000e}"_cuqv, -5e-324));
+    std::snprintf(expected, sizeof(expected), "%.400f", 1e308);
+    EXPECT_EQ(codeunit_sequence_view{ expected }, format("{:.400f}"_cuqv, 1e308));
+    std::snprintf(expected, sizeof(expected), "%.1000g", 0.1);
+    EXPECT_EQ(codeunit_sequence_view{ expected }, format("{:.1000g}"_cuqv, 0.1));
+    std::snprintf(expected, sizeof(expected), "%.200a", 0.1f);
+    EXPECT_EQ(codeunit_sequence_view{ expected }.subview(2), format("{:.200a}"_cuqv, 0.1f));
+}
+
+TEST(format, formatted_size)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    EXPECT_EQ(formatted_size("{}"_cuqv, 0), 1);
+    EXPECT_EQ(formatted_size("{:#010x}|{:b}"_cuqv, 255, -5), format("{:#010x}|{:b}"_cuqv, 255, -5).size());
+    EXPECT_EQ(formatted_size("{} and {}"_cuqv, test_point{ 1, -2 }, test_legacy_point{ 3, 4 }), "(1, -2) and (3, 4)"_cuqv.size());
+    EXPECT_EQ(formatted_size(OPEN_STRING_FORMAT_MOLD("{}: {:.3f}"), "繁星明", -3.14f), "繁星明: -3.140"_cuqv.size());
+
+    // more steps than kept on stack
+    EXPECT_EQ("0,1,2,3,4,5,6,7,8,9,0,1,2,3,4,5,6,7,8,9"_cuqv,
+        format("{0},{1},{2},{3},{4},{5},{6},{7},{8},{9},{0},{1},{2},{3},{4},{5},{6},{7},{8},{9}"_cuqv, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+
+    // reserved size is exact for integers and strings, an upper bound for floats
+    EXPECT_EQ(details::measure_integer(static_cast<i64>(-255), "#08x"_cuqv), "-0x000000ff"_cuqv.size());
+    EXPECT_EQ(details::measure_integer(static_cast<u64>(65), "c"_cuqv), 1);
+    EXPECT_GE(details::measure_float(-99.5, ""_cuqv), "-99.5"_cuqv.size());
+    EXPECT_GE(details::measure_float(9.99, ".1"_cuqv), "10.0"_cuqv.size());
+    EXPECT_GE(details::measure_float(-1e300, "f"_cuqv), formatted_size("{:f}"_cuqv, -1e300));
+    EXPECT_GE(details::measure_float(-1.2345e-300, "f"_cuqv), formatted_size("{:f}"_cuqv, -1.2345e-300));
+    EXPECT_GE(details::measure_float(1e300, ".200f"_cuqv), formatted_size("{:.200f}"_cuqv, 1e300));
+}
+
+TEST(format, integer_bases)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    // Compare with std::to_chars over values around every power of two and of ten.
+    const auto expect_same = [](const u64 value)
+    {
+        static constexpr std::array<std::pair<int, const char*>, 4> bases {{ { 10, "{}" }, { 16, "{:x}" }, { 8, "{:o}" }, { 2, "{:b}" } }};
+        for(const auto& [ base, mold ] : bases)
+        {
+            char expected[72] = { };
+            char* last = std::to_chars(expected, expected + 70, value, base).ptr;
+            EXPECT_EQ(codeunit_sequence_view(expected, last), format(codeunit_sequence_view{ mold }, value));
+            const auto signed_value = static_cast<i64>(value);
+            last = std::to_chars(expected, expected + 70, signed_value, base).ptr;
+            EXPECT_EQ(codeunit_sequence_view(expected, last), format(codeunit_sequence_view{ mold }, signed_value));
+        }
+    };
+    expect_same(0);
+    for(u64 bit = 0; bit < 64; ++bit)
+    {
+        const u64 power = 1ull << bit;
+        expect_same(power - 1);
+        expect_same(power);
+        expect_same(power + 1);
+    }
+    u64 power_of_10 = 1;
+    for(u64 i = 0; i < 20; ++i, power_of_10 *= 10)
+    {
+        expect_same(power_of_10 - 1);
+        expect_same(power_of_10);
+    }
+    expect_same(std::numeric_limits<u64>::max());
+
+    // padding and prefixes
+    EXPECT_EQ("0x00000000ff"_cuqv, format("{:#010x}"_cuqv, 255u));
+    EXPECT_EQ("   42"_cuqv, format("{: 5}"_cuqv, 42u));
+    EXPECT_EQ("-0b00101"_cuqv, format("{:#05b}"_cuqv, -5));
+    EXPECT_EQ("0o17"_cuqv, format("{:#o}"_cuqv, 15));
+    EXPECT_EQ("A"_cuqv, format("{:c}"_cuqv, 65));
+}
+
+TEST(format, float_round_trip)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    // Shortest representations of random bit patterns must read back to the same bits.
+    const auto expect_round_trip = [](const auto value, const codeunit_sequence_view& mold)
+    {
+        using float_type = std::decay_t<decltype(value)>;
+        if(std::isnan(value) || std::isinf(value))
+            return;
+        const codeunit_sequence formatted = format(mold, value);
+        // strtod reads hexadecimal floats with "0x" only, after the sign.
+        codeunit_sequence readable = formatted;
+        if(mold == "{:a}"_cuqv)
+            readable = std::signbit(value) ? codeunit_sequence::build("-0x"_cuqv, formatted.subview(1)) : codeunit_sequence::build("0x"_cuqv, formatted);
+        char* last = nullptr;
+        float_type parsed = 0;
+        if constexpr (std::is_same_v<float_type, f32>)
+            parsed = std::strtof(readable.c_str(), &last);
+        else
+            parsed = std::strtod(readable.c_str(), &last);
+        EXPECT_EQ(last, readable.c_str() + readable.size());
+        EXPECT_EQ(std::memcmp(&parsed, &value, sizeof(float_type)), 0) << formatted.c_str();
+        // format reserves the bound of measure_float once, the specification of "{:e}" is "e".
+        const codeunit_sequence_view specification = mold.size() > 2 ? mold.subview(2, mold.size() - 3) : codeunit_sequence_view{ };
+        EXPECT_LE(formatted.size(), details::measure_float(value, specification)) << formatted.c_str();
+    };
+    std::mt19937_64 engine{ 42 };
+    for(u64 i = 0; i < 20000; ++i)
+    {
+        const u64 bits = engine();
+        f64 value64 = 0;
+        std::memcpy(&value64, &bits, sizeof(f64));
+        f32 value32 = 0;
+        std::memcpy(&value32, &bits, sizeof(f32));
+        for(const codeunit_sequence_view& mold : { "{}"_cuqv, "{:e}"_cuqv, "{:a}"_cuqv })
+        {
+            expect_round_trip(value64, mold);
+            expect_round_trip(value32, mold);
+        }
+    }
+    expect_round_trip(std::numeric_limits<f64>::denorm_min(), "{}"_cuqv);
+    expect_round_trip(std::numeric_limits<f64>::max(), "{:f}"_cuqv);
+    expect_round_trip(-std::numeric_limits<f32>::min(), "{:f}"_cuqv);
+}
+
+TEST(format, float_portable)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    // The writer used without floating to_chars must give the same strings as format.
+    struct float_case
+    {
+        codeunit_sequence_view mold;
+        char type;
+        u64 precision;
+    };
+    static constexpr u64 shortest = global_constant::SIZE_INVALID;
+    const std::array<float_case, 9> cases
+    {{
+        { "{}"_cuqv, 0, shortest }, { "{:e}"_cuqv, 'e', shortest }, { "{:f}"_cuqv, 'f', shortest },
+        { "{:g}"_cuqv, 'g', shortest }, { "{:a}"_cuqv, 'a', shortest }, { "{:.3f}"_cuqv, 'f', 3 },
+        { "{:.12e}"_cuqv, 'e', 12 }, { "{:.4g}"_cuqv, 'g', 4 }, { "{:.0f}"_cuqv, 'f', 0 },
+    }};
+    const auto expect_same = [](const auto value, const float_case& tested)
+    {
+        if(std::isnan(value) || std::isinf(value))
+            return;
+        // Hexadecimal subnormal f32 are normalized by printf, which is the same value in other digits.
+        if(std::is_same_v<decltype(value), const f32> && tested.type == 'a' && std::fpclassify(value) == FP_SUBNORMAL)
+            return;
+        std::array<char, 2048> buffer;
+        const char* last = details::write_float_portable(buffer.data(), buffer.data() + buffer.size(), value, tested.type, tested.precision);
+        ASSERT_NE(last, nullptr);
+        EXPECT_EQ(format(tested.mold, value), codeunit_sequence_view(buffer.data(), last)) << tested.mold.data();
+    };
+    const auto expect_all_same = [&]
+    {
+        std::mt19937_64 engine{ 7 };
+        for(u64 i = 0; i < 2000; ++i)
+        {
+            const u64 bits = engine();
+            f64 value64 = 0;
+            std::memcpy(&value64, &bits, sizeof(f64));
+            f32 value32 = 0;
+            std::memcpy(&value32, &bits, sizeof(f32));
+            for(const float_case& tested : cases)
+            {
+                expect_same(value64, tested);
+                expect_same(value32, tested);
+            }
+        }
+        for(const f64 value : { 0.0, -0.0, 1.0, 0.1, 1e-4, 1e-5, 123456.0, 1234567.0, 1e15, 1e16, 1.5e300, 5e-324 })
+            for(const float_case& tested : cases)
+                expect_same(value, tested);
+        for(const f32 value : { 0.0f, 1.0f, 0.1f, 1e-5f, 1e6f, 1.5e7f, 123456789.0f, 3.4e38f })
+            for(const float_case& tested : cases)
+                expect_same(value, tested);
+    };
+    expect_all_same();
+    // The decimal point of the current locale is replaced, for locales installed.
+    for(const char* name : { "de_DE.UTF-8", "fr_FR.UTF-8", "ru_RU.UTF-8" })
+    {
+        if(!std::setlocale(LC_NUMERIC, name))
+            continue;
+        expect_all_same();
+        std::setlocale(LC_NUMERIC, "C");
+    }
+}
@@ -0,0 +1,109 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+
+#include "gap_buffer.h"
+
+using namespace ostr;
+
+TEST(gap_buffer, construct)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		gap_buffer buffer;
+		EXPECT_TRUE(buffer.is_empty());
+		EXPECT_EQ(buffer, ""_txtv);
+		EXPECT_TRUE(buffer.view().is_empty());
+	}
+	{
+		gap_buffer buffer("Hello 🌏!");
+		EXPECT_EQ(buffer.size(), 8);
+		EXPECT_EQ(buffer.raw_size(), 11);
+		EXPECT_EQ(buffer.cursor(), 0);
+		EXPECT_TRUE(buffer.is_contiguous());
+		EXPECT_EQ(buffer.view(), "Hello 🌏!"_txtv);
+		EXPECT_EQ(buffer.read_at(6), codepoint{ U'🌏' });
+		EXPECT_EQ(buffer[7], codepoint{ U'!' });
+
+		buffer.set_cursor(6).insert("big "_txtv);
+		gap_buffer copied = buffer;
+		EXPECT_EQ(copied, "Hello big 🌏!"_txtv);
+		EXPECT_EQ(copied.cursor(), 10);
+		gap_buffer moved = std::move(buffer);
+		EXPECT_EQ(moved, "Hello big 🌏!"_txtv);
+		EXPECT_TRUE(buffer.is_empty());
+		copied = moved;
+		EXPECT_EQ(copied.to_text(), "Hello big 🌏!");
+	}
+}
+
+TEST(gap_buffer, edit)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		gap_buffer buffer;
+		buffer.insert("我爱你"_txtv);
+		EXPECT_EQ(buffer.cursor(), 3);
+		buffer.erase_before();
+		buffer.insert(codepoint{ U'们' });
+		EXPECT_EQ(buffer, "我爱们"_txtv);
+		buffer.move_cursor(-2).insert("不"_txtv);
+		EXPECT_EQ(buffer, "我不爱们"_txtv);
+		EXPECT_EQ(buffer.cursor(), 2);
+		EXPECT_FALSE(buffer.is_contiguous());
+		const std::array<text_view, 2> segments = buffer.segments();
+		EXPECT_EQ(segments[0], "我不"_txtv);
+		EXPECT_EQ(segments[1], "爱们"_txtv);
+		EXPECT_TRUE(buffer.starts_with("我不爱"_txtv));
+		EXPECT_TRUE(buffer.ends_with("不爱们"_txtv));
+		EXPECT_FALSE(buffer.ends_with("我爱们"_txtv));
+		buffer.erase_after(5);
+		EXPECT_EQ(buffer, "我不"_txtv);
+		buffer.move_cursor(-100).erase_before().erase_after();
+		EXPECT_EQ(buffer, "不"_txtv);
+		EXPECT_EQ(buffer.cursor(), 0);
+		buffer.set_cursor(100).insert("!"_txtv);
+		EXPECT_EQ(buffer.view().index_of("!"_txtv), 1);
+		EXPECT_TRUE(buffer.is_contiguous());
+	}
+	{
+		// Typing at moving positions, compared with text.
+		text expected;
+		for(u64 i = 0; i < 1000; ++i)
+			expected += "繁星 stars 🌟\n";
+		gap_buffer buffer{ expected.view() };
+		u64 state = 7;
+		for(u64 i = 0; i < 2000; ++i)
+		{
+			state = state * 6364136223846793005ull + 1442695040888963407ull;
+			const i64 delta = static_cast<i64>(state >> 60) - 8;
+			buffer.move_cursor(delta);
+			const u64 cursor = buffer.cursor();
+			const text_view view = expected.view();
+			if(i % 3 == 2)
+			{
+				buffer.erase_before(2);
+				const u64 from = cursor - minimum(cursor, 2);
+				expected = text::build(view.subview(0, from), view.subview(cursor));
+			}
+			else
+			{
+				const text_view typed = i % 2 ? "é"_txtv : "k"_txtv;
+				buffer.insert(typed);
+				expected = text::build(view.subview(0, cursor), typed, view.subview(cursor));
+			}
+			ASSERT_EQ(buffer.size(), expected.size());
+		}
+		EXPECT_EQ(buffer.read_at(buffer.cursor()), expected.read_at(buffer.cursor()));
+		EXPECT_EQ(buffer, expected.view());
+		EXPECT_EQ(buffer.view(), expected.view());
+	}
+}
+
+TEST(gap_buffer, format)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	gap_buffer buffer("left right");
+	buffer.set_cursor(5).insert("and "_txtv);
+	EXPECT_EQ(format("<{}>"_cuqv, buffer), "<left and right>"_cuqv);
+}
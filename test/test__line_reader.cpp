@@ -0,0 +1,87 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+#include "scoped_temporary_file.h"
+
+#include "line_reader.h"
+#include "format.h"
+
+#include <cstdio>
+#include <random>
+
+using namespace ostr;
+
+static std::vector<codeunit_sequence> read_lines(const codeunit_sequence_view& content, const u64 buffer_size, const bool by_descriptor)
+{
+	const scoped_temporary_file file{ "ostr_line_reader"_cuqv, content };
+	std::FILE* stream = std::fopen(file.path.c_str(), "rb");
+#if _WIN64
+	const int descriptor = _fileno(stream);
+#else
+	const int descriptor = fileno(stream);
+#endif
+	line_reader reader = by_descriptor ? line_reader{ descriptor, buffer_size } : line_reader{ stream, buffer_size };
+	std::vector<codeunit_sequence> lines;
+	for(const codeunit_sequence_view& line : reader.lines())
+		lines.emplace_back(line);
+	EXPECT_EQ(reader.status(), line_reader_status::end_of_file);
+	EXPECT_EQ(reader.get_line_count(), lines.size());
+	std::fclose(stream);
+	return lines;
+}
+
+TEST(line_reader, read)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	for(const bool by_descriptor : { false, true })
+	{
+		EXPECT_TRUE(read_lines(""_cuqv, 16, by_descriptor).empty());
+		{
+			const std::vector<codeunit_sequence> lines = read_lines("\n"_cuqv, 16, by_descriptor);
+			ASSERT_EQ(lines.size(), 1);
+			EXPECT_EQ(lines[0], ""_cuqv);
+		}
+		{
+			// Carriage returns are only stripped before line feeds, the last line has no line feed.
+			const std::vector<codeunit_sequence> lines = read_lines("Hello\r\n\r\n繁星明 🌏\rx\nlast"_cuqv, 16, by_descriptor);
+			ASSERT_EQ(lines.size(), 4);
+			EXPECT_EQ(lines[0], "Hello"_cuqv);
+			EXPECT_EQ(lines[1], ""_cuqv);
+			EXPECT_EQ(lines[2], "繁星明 🌏\rx"_cuqv);
+			EXPECT_EQ(lines[3], "last"_cuqv);
+		}
+		{
+			// Lines straddling buffers, and lines longer than the buffer.
+			const std::vector<codeunit_sequence> lines = read_lines("short\nthis line is much longer than the buffer of 16\r\nend\r\n"_cuqv, 16, by_descriptor);
+			ASSERT_EQ(lines.size(), 3);
+			EXPECT_EQ(lines[0], "short"_cuqv);
+			EXPECT_EQ(lines[1], "this line is much longer than the buffer of 16"_cuqv);
+			EXPECT_EQ(lines[2], "end"_cuqv);
+		}
+	}
+}
+
+TEST(line_reader, random)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	std::mt19937 engine{ 42 }; // NOLINT(cert-msc51-cpp)
+	std::uniform_int_distribution<u32> length_distribution{ 0, 200 };
+	std::uniform_int_distribution<u32> codeunit_distribution{ 0, 63 };
+	codeunit_sequence content;
+	std::vector<codeunit_sequence> expected;
+	for(u32 i = 0; i < 1000; ++i)
+	{
+		codeunit_sequence line;
+		const u32 length = length_distribution(engine);
+		for(u32 j = 0; j < length; ++j)
+			line.append(static_cast<char>('0' + codeunit_distribution(engine)));
+		content.append(line);
+		content.append(i % 3 == 0 ? "\r\n"_cuqv : "\n"_cuqv);
+		expected.push_back(std::move(line));
+	}
+	for(const u64 buffer_size : std::initializer_list<u64>{ 16, 100, 4096, line_reader::BUFFER_SIZE_DEFAULT })
+	{
+		EXPECT_EQ(read_lines(content.view(), buffer_size, false), expected);
+		EXPECT_EQ(read_lines(content.view(), buffer_size, true), expected);
+	}
+}
@@ -0,0 +1,74 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+#include "scoped_temporary_file.h"
+
+#include "mapped_text.h"
+
+#include <cstdio>
+
+using namespace ostr;
+
+TEST(mapped_text, open)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		mapped_text mapped;
+		EXPECT_EQ(mapped.status(), mapped_text_status::closed);
+		EXPECT_FALSE(mapped.is_open());
+		EXPECT_TRUE(mapped.raw().is_empty());
+		EXPECT_EQ(mapped.open("ostr_mapped_text_does_not_exist.txt"), mapped_text_status::open_failed);
+	}
+	{
+		const scoped_temporary_file file{ "ostr_mapped_text"_cuqv, ""_cuqv };
+		const mapped_text mapped{ file.path.c_str() };
+		EXPECT_EQ(mapped.status(), mapped_text_status::succeeded);
+		EXPECT_TRUE(mapped.is_empty());
+	}
+	{
+		const scoped_temporary_file file{ "ostr_mapped_text"_cuqv, "Hello 繁星明 🌏!\nsecond line\n"_cuqv };
+		mapped_text_options options;
+		options.access = mapped_access_hint::sequential;
+		options.will_need = true;
+		options.huge_pages = true;
+		mapped_text mapped{ file.path.c_str(), options };
+		ASSERT_TRUE(mapped.is_open());
+		// Algorithms of views work on it directly.
+		const codeunit_sequence_view raw = mapped;
+		EXPECT_EQ(raw, "Hello 繁星明 🌏!\nsecond line\n"_cuqv);
+		EXPECT_EQ(mapped.raw().index_of("line"_cuqv), 29);
+		EXPECT_EQ(mapped.view().size(), 25);
+		EXPECT_EQ(mapped.view().index_of("🌏"_txtv), 10);
+		EXPECT_EQ(static_cast<text_view>(mapped).split("\n"_txtv)[0], "Hello 繁星明 🌏!"_txtv);
+
+		mapped_text moved = std::move(mapped);
+		EXPECT_EQ(mapped.status(), mapped_text_status::closed);
+		EXPECT_TRUE(moved.raw().ends_with("second line\n"_cuqv));
+		moved.close();
+		EXPECT_FALSE(moved.is_open());
+		EXPECT_EQ(moved.data(), nullptr);
+	}
+}
+
+TEST(mapped_text, validate)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	mapped_text_options options;
+	options.validate_utf8 = true;
+	options.strip_bom = true;
+	{
+		const scoped_temporary_file file{ "ostr_mapped_text"_cuqv, "\xef\xbb\xbf" "繁星 in a file long enough to skip words of ASCII"_cuqv };
+		const mapped_text mapped{ file.path.c_str(), options };
+		EXPECT_EQ(mapped.status(), mapped_text_status::succeeded);
+		EXPECT_TRUE(mapped.raw().starts_with("繁星"_cuqv));
+		const mapped_text unstripped{ file.path.c_str() };
+		EXPECT_EQ(unstripped.size(), mapped.size() + 3);
+	}
+	{
+		const scoped_temporary_file file{ "ostr_mapped_text"_cuqv, "valid ASCII prefix of some words, then \xed\xa0\x80 surrogate"_cuqv };
+		const mapped_text mapped{ file.path.c_str(), options };
+		EXPECT_EQ(mapped.status(), mapped_text_status::invalid_utf8);
+		EXPECT_TRUE(mapped.is_open());
+		EXPECT_EQ(mapped.get_invalid_offset(), 39);
+	}
+}
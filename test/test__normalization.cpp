@@ -0,0 +1,185 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+
+#include "normalization.h"
+
+#include <random>
+
+using namespace ostr;
+
+static constexpr std::array<normalization_form, 4> normalization_forms
+{
+	normalization_form::nfc, normalization_form::nfd, normalization_form::nfkc, normalization_form::nfkd,
+};
+
+// The same as normalizing the whole source, but through a normalizer taking chunks of the given size.
+static codeunit_sequence normalize_by_chunks(const codeunit_sequence_view& source, const normalization_form form, const u64 chunk_size)
+{
+	normalizer stream{ form };
+	codeunit_sequence result;
+	for(u64 i = 0; i < source.size(); i += chunk_size)
+		stream.normalize_to(result, source.subview(i, chunk_size));
+	stream.finish(result);
+	return result;
+}
+
+TEST(normalization, quick_check)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	for(const normalization_form form : normalization_forms)
+	{
+		EXPECT_EQ(quick_check_normalization(""_cuqv, form), normalization_check::yes);
+		EXPECT_EQ(quick_check_normalization("Hello, World! 0123456789"_cuqv, form), normalization_check::yes);
+		EXPECT_EQ(quick_check_normalization("漢字とカタカナ"_cuqv, form), normalization_check::yes);
+		EXPECT_EQ(quick_check_normalization("😀 a\u0316\u035C"_cuqv, form), normalization_check::yes);
+		// Combining marks out of the canonical order.
+		EXPECT_EQ(quick_check_normalization("a\u0301\u0323"_cuqv, form), normalization_check::no);
+	}
+	EXPECT_EQ(quick_check_normalization("Zoë Ångström"_cuqv, normalization_form::nfc), normalization_check::yes);
+	EXPECT_EQ(quick_check_normalization("Zoë Ångström"_cuqv, normalization_form::nfd), normalization_check::no);
+	EXPECT_EQ(quick_check_normalization("Zoe\u0308"_cuqv, normalization_form::nfc), normalization_check::maybe);
+	EXPECT_EQ(quick_check_normalization("Zoe\u0308"_cuqv, normalization_form::nfd), normalization_check::yes);
+	EXPECT_EQ(quick_check_normalization("a\u0323\u0301"_cuqv, normalization_form::nfc), normalization_check::maybe);
+	EXPECT_EQ(quick_check_normalization("a\u0323\u0301"_cuqv, normalization_form::nfd), normalization_check::yes);
+	EXPECT_EQ(quick_check_normalization("\u212B"_cuqv, normalization_form::nfc), normalization_check::no);
+	EXPECT_EQ(quick_check_normalization("한국어"_cuqv, normalization_form::nfc), normalization_check::yes);
+	EXPECT_EQ(quick_check_normalization("한국어"_cuqv, normalization_form::nfkd), normalization_check::no);
+	EXPECT_EQ(quick_check_normalization("\u1100\u1161"_cuqv, normalization_form::nfkc), normalization_check::maybe);
+	EXPECT_EQ(quick_check_normalization("ﬁ"_cuqv, normalization_form::nfc), normalization_check::yes);
+	EXPECT_EQ(quick_check_normalization("ﬁ"_cuqv, normalization_form::nfkc), normalization_check::no);
+	EXPECT_EQ(quick_check_normalization("ＡＢＣ"_cuqv, normalization_form::nfkd), normalization_check::no);
+	// Ill-formed code units are kept as they are.
+	EXPECT_EQ(quick_check_normalization("a\xff" "b\xc3"_cuqv, normalization_form::nfc), normalization_check::yes);
+
+	EXPECT_TRUE(is_normalized("Zoë"_txtv, normalization_form::nfc));
+	EXPECT_FALSE(is_normalized("Zoe\u0308"_txtv, normalization_form::nfc));
+	EXPECT_TRUE(is_normalized("\u00EA\u0308"_txtv, normalization_form::nfc));
+	EXPECT_FALSE(is_normalized("e\u0302\u0308"_txtv, normalization_form::nfc));
+	EXPECT_TRUE(is_normalized("\u1100"_txtv, normalization_form::nfc));
+	EXPECT_FALSE(is_normalized("\u1100\u1161"_txtv, normalization_form::nfc));
+}
+
+TEST(normalization, text_view)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	// Examples of UAX #15.
+	EXPECT_EQ(normalize("\u212B"_txtv, normalization_form::nfc), "Å"_txtv);
+	EXPECT_EQ(normalize("\u212B"_txtv, normalization_form::nfd), "A\u030A"_txtv);
+	EXPECT_EQ(normalize("ḋ\u0323"_txtv, normalization_form::nfc), "ḍ\u0307"_txtv);
+	EXPECT_EQ(normalize("ḋ\u0323"_txtv, normalization_form::nfd), "d\u0323\u0307"_txtv);
+	EXPECT_EQ(normalize("ẛ\u0323"_txtv, normalization_form::nfc), "ẛ\u0323"_txtv);
+	EXPECT_EQ(normalize("ẛ\u0323"_txtv, normalization_form::nfd), "ſ\u0323\u0307"_txtv);
+	EXPECT_EQ(normalize("ẛ\u0323"_txtv, normalization_form::nfkc), "ṩ"_txtv);
+	EXPECT_EQ(normalize("ẛ\u0323"_txtv, normalization_form::nfkd), "s\u0323\u0307"_txtv);
+	EXPECT_EQ(normalize("ﬁ ① ＡＢＣ ｶ"_txtv, normalization_form::nfkc), "fi 1 ABC カ"_txtv);
+	EXPECT_EQ(normalize("ﬁ ① ＡＢＣ"_txtv, normalization_form::nfc), "ﬁ ① ＡＢＣ"_txtv);
+	// Hangul syllables are decomposed and composed algorithmically.
+	EXPECT_EQ(normalize("한국"_txtv, normalization_form::nfd), "\u1112\u1161\u11AB\u1100\u116E\u11A8"_txtv);
+	EXPECT_EQ(normalize("\u1112\u1161\u11AB\u1100\u116E\u11A8"_txtv, normalization_form::nfc), "한국"_txtv);
+	EXPECT_EQ(normalize("한\u11AB"_txtv, normalization_form::nfc), "한\u11AB"_txtv);
+	// Singletons and composition exclusions are never composed.
+	EXPECT_EQ(normalize("\u0958 \uF900"_txtv, normalization_form::nfc), "\u0915\u093C \u8C48"_txtv);
+	EXPECT_EQ(normalize(""_txtv, normalization_form::nfc), ""_txtv);
+	// Texts equal after normalization, e.g. player names typed on different platforms.
+	EXPECT_EQ(normalize("Zoë Ångström"_txtv, normalization_form::nfc), normalize("Zoe\u0308 A\u030Angstro\u0308m"_txtv, normalization_form::nfc));
+	EXPECT_EQ(normalize("Zoë Ångström"_txtv, normalization_form::nfd), normalize("Zoe\u0308 \u212Bngstro\u0308m"_txtv, normalization_form::nfd));
+	// Ill-formed code units are kept.
+	EXPECT_EQ(normalize(text_view{ "e\xff\xcc\x81" "A\xcc\x8a\xe4" }, normalization_form::nfc).raw(), "e\xff\xcc\x81" "\xc3\x85\xe4"_cuqv);
+	EXPECT_EQ(normalize(text_view{ "\x80\xcc\x81" "\xed\xa0\x80\xcc\x81" }, normalization_form::nfd).raw(), "\x80\xcc\x81" "\xed\xa0\x80\xcc\x81"_cuqv);
+	{
+		codeunit_sequence destination{ "Name: " };
+		normalize_to(destination, "Jose\u0301 Mu\u0308ller"_cuqv, normalization_form::nfc);
+		EXPECT_EQ(destination, "Name: José Müller"_cuqv);
+	}
+}
+
+TEST(normalization, text)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		const text t{ "Cafe\u0301 cre\u0300me" };
+		EXPECT_EQ(t.normalize(normalization_form::nfc), "Café crème"_txtv);
+		EXPECT_FALSE(t.is_normalized(normalization_form::nfc));
+		EXPECT_TRUE(t.is_normalized(normalization_form::nfd));
+		EXPECT_TRUE(t.normalize(normalization_form::nfc).is_normalized(normalization_form::nfc));
+	}
+	{
+		// Normalized text is kept in its buffer.
+		text t{ "A normalized text long enough to be allocated: Café, 漢字, 한국어" };
+		const char* data = t.c_str();
+		t.self_normalize(normalization_form::nfc);
+		EXPECT_EQ(t, "A normalized text long enough to be allocated: Café, 漢字, 한국어"_txtv);
+		EXPECT_EQ(t.c_str(), data);
+		t.self_normalize(normalization_form::nfd);
+		EXPECT_EQ(t, "A normalized text long enough to be allocated: Cafe\u0301, 漢字, \u1112\u1161\u11AB\u1100\u116E\u11A8\u110B\u1165"_txtv);
+		t.self_normalize(normalization_form::nfc);
+		EXPECT_EQ(t, "A normalized text long enough to be allocated: Café, 漢字, 한국어"_txtv);
+	}
+}
+
+TEST(normalization, normalizer)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const codeunit_sequence_view document = "Cafe\u0301 \u1112\u1161\u11AB ḋ\u0323 ﬁ \u212B a\u0301\u0323\u0302\u0307 漢字 \xff"_cuqv;
+	for(const normalization_form form : normalization_forms)
+	{
+		codeunit_sequence expected;
+		normalize_to(expected, document, form);
+		// Chunks split codepoints and segments at every position.
+		for(u64 chunk_size = 1; chunk_size <= document.size(); ++chunk_size)
+			ASSERT_EQ(normalize_by_chunks(document, form, chunk_size), expected) << chunk_size;
+	}
+	{
+		normalizer stream{ normalization_form::nfc };
+		EXPECT_EQ(stream.get_form(), normalization_form::nfc);
+		codeunit_sequence result;
+		stream.normalize_to(result, "Cafe"_cuqv);
+		// The last starter may compose with the next chunk, so it is kept.
+		EXPECT_EQ(result, "Caf"_cuqv);
+		EXPECT_EQ(stream.get_pending_size(), 1);
+		stream.normalize_to(result, "\xcc"_cuqv);
+		EXPECT_EQ(result, "Caf"_cuqv);
+		stream.normalize_to(result, "\x81 bar"_cuqv);
+		EXPECT_EQ(result, "Café ba"_cuqv);
+		stream.finish(result);
+		EXPECT_EQ(result, "Café bar"_cuqv);
+		EXPECT_EQ(stream.get_pending_size(), 0);
+		// The normalizer is ready for another document after finishing one.
+		stream.normalize_to(result, "\u0301"_cuqv);
+		stream.finish(result);
+		EXPECT_EQ(result, "Café bar\u0301"_cuqv);
+	}
+}
+
+TEST(normalization, random)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	// Starters composing with the combining marks after them, marks of different classes and codepoints of every size.
+	const std::array<text_view, 16> pieces
+	{
+		"a"_txtv, "e"_txtv, " "_txtv, "\u0301"_txtv, "\u0323"_txtv, "\u0308"_txtv, "é"_txtv, "ḋ"_txtv,
+		"\u1100"_txtv, "\u1161"_txtv, "\u11A8"_txtv, "가"_txtv, "漢"_txtv, "ﬁ"_txtv, "\u212B"_txtv, "😀"_txtv,
+	};
+	std::mt19937 engine{ 42 };
+	for(u64 i = 0; i < 2000; ++i)
+	{
+		text source;
+		for(u64 j = engine() % 16; j > 0; --j)
+			source.append(pieces[engine() % pieces.size()]);
+		const codeunit_sequence_view raw = source.view().raw();
+		const text nfd = normalize(source.view(), normalization_form::nfd);
+		const text nfc = normalize(source.view(), normalization_form::nfc);
+		ASSERT_EQ(normalize(nfd.view(), normalization_form::nfc), nfc) << source;
+		ASSERT_EQ(normalize(nfc.view(), normalization_form::nfd), nfd) << source;
+		for(const normalization_form form : normalization_forms)
+		{
+			const text normalized = normalize(source.view(), form);
+			ASSERT_EQ(normalize(normalized.view(), form), normalized) << source;
+			ASSERT_TRUE(is_normalized(normalized.view(), form)) << source;
+			ASSERT_EQ(is_normalized(source.view(), form), normalized == source) << source;
+			ASSERT_NE(quick_check_normalization(raw, form) == normalization_check::yes && normalized != source, true) << source;
+			ASSERT_EQ(normalize_by_chunks(raw, form, engine() % 7 + 1), normalized.view().raw()) << source;
+		}
+	}
+}
@@ -0,0 +1,167 @@
+
+#include "pch.h"
+
+#include "parse.h"
+#include "format.h"
+#include "text_view.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace ostr;
+
+TEST(parse, integer)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    {
+        const parse_result<i32> result = parse_integer<i32>("-123abc"_cuqv);
+        EXPECT_TRUE(result.succeeded());
+        EXPECT_EQ(result.value, -123);
+        EXPECT_EQ(result.consumed, 4);
+    }
+    EXPECT_EQ(parse_integer<i32>("+42"_cuqv).value, 42);
+    EXPECT_EQ(parse_integer<u8>("255"_cuqv).value, 255);
+    EXPECT_EQ(parse_integer<u8>("256"_cuqv).status, parse_status::overflow);
+    EXPECT_EQ(parse_integer<u8>("256"_cuqv).consumed, 3);
+    EXPECT_EQ(parse_integer<i8>("-128"_cuqv).value, -128);
+    EXPECT_EQ(parse_integer<i8>("128"_cuqv).status, parse_status::overflow);
+    EXPECT_EQ(parse_integer<u32>("-1"_cuqv).status, parse_status::invalid);
+    EXPECT_EQ(parse_integer<i32>(""_cuqv).status, parse_status::invalid);
+    EXPECT_EQ(parse_integer<i32>("-"_cuqv).status, parse_status::invalid);
+    EXPECT_EQ(parse_integer<i32>(" 1"_cuqv).status, parse_status::invalid);
+
+    // limits of 64 bits
+    EXPECT_EQ(parse_integer<u64>("18446744073709551615"_cuqv).value, std::numeric_limits<u64>::max());
+    EXPECT_EQ(parse_integer<u64>("18446744073709551616"_cuqv).status, parse_status::overflow);
+    EXPECT_EQ(parse_integer<u64>("99999999999999999999"_cuqv).status, parse_status::overflow);
+    EXPECT_EQ(parse_integer<u64>("000000000000000000000018446744073709551615"_cuqv).value, std::numeric_limits<u64>::max());
+    EXPECT_EQ(parse_integer<i64>("-9223372036854775808"_cuqv).value, std::numeric_limits<i64>::min());
+    EXPECT_EQ(parse_integer<i64>("9223372036854775808"_cuqv).status, parse_status::overflow);
+
+    // bases
+    EXPECT_EQ(parse_integer<u32>("ff"_cuqv, 16).value, 255u);
+    EXPECT_EQ(parse_integer<u32>("FFg"_cuqv, 16).consumed, 2);
+    EXPECT_EQ(parse_integer<i32>("-101"_cuqv, 2).value, -5);
+    EXPECT_EQ(parse_integer<u64>("777"_cuqv, 8).value, 511u);
+    EXPECT_EQ(parse_integer<u64>("zz"_cuqv, 36).value, 1295u);
+    EXPECT_EQ(parse_integer<u64>("10000000000000000"_cuqv, 16).status, parse_status::overflow);
+
+    // Compare with std::from_chars around every power of ten, which crosses the blocks of 8 digits.
+    u64 power_of_10 = 1;
+    for(u64 i = 0; i < 20; ++i, power_of_10 *= 10)
+    {
+        for(const u64 value : { power_of_10 - 1, power_of_10, power_of_10 + 1, power_of_10 * 9 / 7 })
+        {
+            char buffer[32] = { };
+            const char* last = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+            const parse_result<u64> result = parse_integer<u64>(codeunit_sequence_view(buffer, last));
+            EXPECT_TRUE(result.succeeded());
+            EXPECT_EQ(result.value, value);
+            EXPECT_EQ(result.consumed, static_cast<u64>(last - buffer));
+        }
+    }
+}
+
+TEST(parse, float)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    EXPECT_EQ(parse_float<f64>("3.14"_cuqv).value, 3.14);
+    EXPECT_EQ(parse_float<f64>("-1.5e3,"_cuqv).value, -1500.0);
+    EXPECT_EQ(parse_float<f64>("-1.5e3,"_cuqv).consumed, 6);
+    EXPECT_EQ(parse_float<f64>("+.5"_cuqv).value, 0.5);
+    EXPECT_EQ(parse_float<f64>("1e"_cuqv).consumed, 1);
+    EXPECT_EQ(parse_float<f64>("1e+x"_cuqv).consumed, 1);
+    EXPECT_EQ(parse_float<f32>("0.1"_cuqv).value, 0.1f);
+    EXPECT_EQ(parse_float<f64>("0.000000000000000000000000000001"_cuqv).value, 1e-30);
+    EXPECT_EQ(parse_float<f64>("123456789012345678901234567890"_cuqv).value, 123456789012345678901234567890.0);
+    EXPECT_EQ(parse_float<f64>("-Infinity"_cuqv).value, -std::numeric_limits<f64>::infinity());
+    EXPECT_EQ(parse_float<f64>("inf"_cuqv).consumed, 3);
+    EXPECT_TRUE(std::isnan(parse_float<f64>("NaN"_cuqv).value));
+    EXPECT_EQ(parse_float<f64>("1e400"_cuqv).status, parse_status::overflow);
+    EXPECT_EQ(parse_float<f32>("1e39"_cuqv).status, parse_status::overflow);
+    EXPECT_TRUE(parse_float<f64>("1e-400"_cuqv).succeeded());
+    EXPECT_EQ(parse_float<f64>("1e-400"_cuqv).value, 0.0);
+    EXPECT_TRUE(std::signbit(parse_float<f64>("-1e-400"_cuqv).value));
+    EXPECT_EQ(parse_float<f32>("1e-50"_cuqv).value, 0.0f);
+    EXPECT_EQ(parse_float<f64>("4.9406564584124654e-324"_cuqv).value, std::numeric_limits<f64>::denorm_min());
+    EXPECT_EQ(parse_float<f64>("1e-400,"_cuqv).consumed, 6);
+    EXPECT_EQ(parse_float<f64>("."_cuqv).status, parse_status::invalid);
+    EXPECT_EQ(parse_float<f64>("e5"_cuqv).status, parse_status::invalid);
+
+    // Shortest representations of random bit patterns must read back to the same bits.
+    std::mt19937_64 engine{ 42 };
+    for(u64 i = 0; i < 20000; ++i)
+    {
+        const u64 bits = engine();
+        f64 value64 = 0;
+        std::memcpy(&value64, &bits, sizeof(f64));
+        f32 value32 = 0;
+        std::memcpy(&value32, &bits, sizeof(f32));
+        if(!std::isnan(value64))
+        {
+            const codeunit_sequence formatted = format("{}"_cuqv, value64);
+            const f64 parsed = parse_float<f64>(formatted.view()).value;
+            EXPECT_EQ(std::memcmp(&parsed, &value64, sizeof(f64)), 0) << formatted.c_str();
+        }
+        if(!std::isnan(value32))
+        {
+            const codeunit_sequence formatted = format("{:e}"_cuqv, value32);
+            const f32 parsed = parse_float<f32>(formatted.view()).value;
+            EXPECT_EQ(std::memcmp(&parsed, &value32, sizeof(f32)), 0) << formatted.c_str();
+        }
+    }
+}
+
+TEST(parse, delimited)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    {
+        i32 numbers[8] = { };
+        const parse_delimited_result result = parse_delimited("1,-2,30,400"_cuqv, ',', numbers, 8);
+        EXPECT_EQ(result.status, parse_status::succeeded);
+        EXPECT_EQ(result.count, 4);
+        EXPECT_EQ(result.consumed, 11);
+        EXPECT_EQ(numbers[3], 400);
+    }
+    {
+        // stops when out is full
+        u16 numbers[2] = { };
+        const parse_delimited_result result = parse_delimited("1 2 3"_cuqv, ' ', numbers, 2);
+        EXPECT_EQ(result.count, 2);
+        EXPECT_EQ(result.consumed, 4);
+    }
+    {
+        // stops at the first failure
+        f64 numbers[8] = { };
+        const parse_delimited_result result = parse_delimited("1.5;2x;3"_cuqv, ';', numbers, 8);
+        EXPECT_EQ(result.status, parse_status::invalid);
+        EXPECT_EQ(result.count, 1);
+        EXPECT_EQ(result.consumed, 4);
+        EXPECT_EQ(numbers[0], 1.5);
+    }
+    {
+        u8 numbers[8] = { };
+        const parse_delimited_result result = parse_delimited("1,256"_cuqv, ',', numbers, 8);
+        EXPECT_EQ(result.status, parse_status::overflow);
+        EXPECT_EQ(result.count, 1);
+    }
+}
+
+TEST(parse, text_view)
+{
+    SCOPED_DETECT_MEMORY_LEAK()
+
+    EXPECT_EQ("-42"_txtv.try_as_integer(), -42);
+    EXPECT_EQ("2a"_txtv.try_as_integer<u8>(16), 42);
+    EXPECT_FALSE("42 "_txtv.try_as_integer().has_value());
+    EXPECT_FALSE("4294967296"_txtv.try_as_integer().has_value());
+    EXPECT_EQ("4294967296"_txtv.try_as_integer<i64>(), 4294967296);
+    EXPECT_EQ("2.5"_txtv.try_as_float(), 2.5);
+    EXPECT_FALSE("2.5f"_txtv.try_as_float().has_value());
+}
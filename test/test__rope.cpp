@@ -0,0 +1,193 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+
+#include "rope.h"
+
+using namespace ostr;
+
+// Text of count lines mixing code units of all the lengths.
+static text make_document(const u64 count)
+{
+	codeunit_sequence document;
+	for(u64 i = 0; i < count; ++i)
+		format_to(document, "{}: The quick 狐狸 jumps over the lazy 🐶.\n"_cuqv, i);
+	return text{ std::move(document) };
+}
+
+// Deterministic generator, so that failures are reproducible.
+static u64 next_random(u64& state)
+{
+	state = state * 6364136223846793005ull + 1442695040888963407ull;
+	return state >> 33;
+}
+
+static void expect_chunks_valid(const rope& r)
+{
+	u64 raw_size = 0;
+	u64 size = 0;
+	for(const text_view chunk : r.chunks())
+	{
+		EXPECT_FALSE(chunk.is_empty());
+		EXPECT_LE(chunk.raw().size(), details::ROPE_LEAF_SIZE_MAXIMUM);
+		// Chunks never cut a codepoint.
+		EXPECT_NE(unicode::parse_utf8_length(*chunk.raw().data()), 0);
+		raw_size += chunk.raw().size();
+		size += chunk.size();
+	}
+	EXPECT_EQ(raw_size, r.raw_size());
+	EXPECT_EQ(size, r.size());
+}
+
+TEST(rope, construct)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		const rope r;
+		EXPECT_TRUE(r.is_empty());
+		EXPECT_EQ(r.size(), 0);
+		EXPECT_EQ(r.chunks().begin(), r.chunks().end());
+		EXPECT_EQ(r, ""_txtv);
+	}
+	{
+		const rope r("Hello 🌏!");
+		EXPECT_EQ(r.size(), 8);
+		EXPECT_EQ(r.raw_size(), 11);
+		EXPECT_EQ(r, "Hello 🌏!"_txtv);
+		EXPECT_EQ(r.read_at(6), codepoint{ U'🌏' });
+		EXPECT_EQ(r[7], codepoint{ U'!' });
+	}
+	{
+		const text document = make_document(2000);
+		const rope r(document);
+		EXPECT_EQ(r.size(), document.size());
+		EXPECT_EQ(r.raw_size(), document.raw().size());
+		EXPECT_EQ(r, document.view());
+		EXPECT_EQ(r.to_text(), document);
+		expect_chunks_valid(r);
+		EXPECT_EQ(r.read_at(13), codepoint{ U'狐' });
+		EXPECT_EQ(r.read_at(document.size() - 2), codepoint{ U'.' });
+	}
+	{
+		rope r(make_document(500));
+		const rope copied = r;
+		r.erase(0, 100);
+		EXPECT_EQ(copied, make_document(500).view());
+		EXPECT_NE(copied, r);
+		r = copied;
+		EXPECT_EQ(r, copied);
+		const rope moved = std::move(r);
+		EXPECT_EQ(moved, copied);
+		EXPECT_TRUE(r.is_empty());
+	}
+}
+
+TEST(rope, insert_erase)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		rope r;
+		r.insert(0, "world"_txtv);
+		r.insert(0, "Hello "_txtv);
+		r.append("!"_txtv);
+		r.insert(5, ", 繁星明"_txtv);
+		EXPECT_EQ(r, "Hello, 繁星明 world!"_txtv);
+		r.erase(5, 5);
+		EXPECT_EQ(r, "Hello world!"_txtv);
+		r.erase(5);
+		EXPECT_EQ(r, "Hello"_txtv);
+		r.erase(0);
+		EXPECT_TRUE(r.is_empty());
+	}
+	{
+		// Insert a large text in the middle.
+		rope r(make_document(100));
+		const text inserted = make_document(300);
+		r.insert(50, inserted.view());
+		const text expected = text::build(make_document(100).subview(0, 50), inserted, make_document(100).subview(50));
+		EXPECT_EQ(r, expected.view());
+		expect_chunks_valid(r);
+	}
+	{
+		// Random edits compared with text.
+		text expected = make_document(1000);
+		rope r(expected);
+		u64 state = 42;
+		for(u64 i = 0; i < 3000; ++i)
+		{
+			const u64 index = next_random(state) % (expected.size() + 1);
+			const text_view view = expected.view();
+			if(next_random(state) % 2 == 0)
+			{
+				static constexpr std::array<text_view, 4> pieces{ "a"_txtv, "星"_txtv, " 🐉 dragon "_txtv, "\n"_txtv };
+				const text_view piece = pieces[next_random(state) % pieces.size()];
+				r.insert(index, piece);
+				expected = text::build(view.subview(0, index), piece, view.subview(index));
+			}
+			else
+			{
+				// Erase across leaves sometimes.
+				const u64 size = next_random(state) % 8 == 0 ? next_random(state) % 3000 : next_random(state) % 16;
+				r.erase(index, size);
+				expected = text::build(view.subview(0, index), index + size < expected.size() ? view.subview(index + size) : ""_txtv);
+			}
+			ASSERT_EQ(r.size(), expected.size());
+			if(i % 500 == 0)
+			{
+				const u64 read_index = next_random(state) % expected.size();
+				EXPECT_EQ(r.read_at(read_index), expected.read_at(read_index));
+			}
+		}
+		EXPECT_EQ(r, expected.view());
+		expect_chunks_valid(r);
+	}
+}
+
+TEST(rope, split_append)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		rope r("Hello 繁星明!");
+		rope rest = r.split(6);
+		EXPECT_EQ(r, "Hello "_txtv);
+		EXPECT_EQ(rest, "繁星明!"_txtv);
+		EXPECT_TRUE(r.split(100).is_empty());
+		rope all = rest.split(0);
+		EXPECT_TRUE(rest.is_empty());
+		r += std::move(all);
+		EXPECT_EQ(r, "Hello 繁星明!"_txtv);
+	}
+	{
+		const text document = make_document(3000);
+		for(const u64 index : { u64(1), u64(1000), document.size() / 3, document.size() - 1 })
+		{
+			rope r(document);
+			rope rest = r.split(index);
+			EXPECT_EQ(r.size(), index);
+			EXPECT_EQ(r, document.subview(0, index));
+			EXPECT_EQ(rest, document.subview(index));
+			expect_chunks_valid(r);
+			expect_chunks_valid(rest);
+			r.append(std::move(rest));
+			EXPECT_EQ(r, document.view());
+			expect_chunks_valid(r);
+		}
+	}
+	{
+		// Ropes of very different heights.
+		rope r("tiny");
+		r.append(rope{ make_document(5000) });
+		r.append(rope{ "tail" });
+		EXPECT_EQ(r, text::build("tiny"_txtv, make_document(5000), "tail"_txtv).view());
+		expect_chunks_valid(r);
+	}
+}
+
+TEST(rope, format)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const rope r(make_document(200));
+	const codeunit_sequence formatted = format("[{}]"_cuqv, r);
+	EXPECT_EQ(formatted.size(), r.raw_size() + 2);
+	EXPECT_EQ(text_view{ formatted.view().subview(1, r.raw_size()) }, r.to_text());
+}
@@ -0,0 +1,105 @@
+
+#include "pch.h"
+
+#include "string_builder.h"
+
+#include <cstdio>
+
+using namespace ostr;
+
+TEST(string_builder, append)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		string_builder builder;
+		EXPECT_TRUE(builder.is_empty());
+		EXPECT_TRUE(builder.finish().is_empty());
+	}
+	{
+		string_builder builder;
+		builder.append("Hello").append(' ').append("World"_cuqv).append(codepoint{ U'🌍' }).append('!', 3);
+		builder.append_formatted(OPEN_STRING_FORMAT_MOLD(" {} + {:.1f}"), 42, 0.5);
+		EXPECT_EQ(builder.size(), 27);
+		EXPECT_EQ(builder.chunk_count(), 1);
+		EXPECT_EQ(builder.finish(), "Hello World🌍!!! 42 + 0.5"_cuqv);
+		EXPECT_TRUE(builder.is_empty());
+	}
+	{
+		// Code units never move, so a large output spans many chunks.
+		string_builder builder;
+		codeunit_sequence expected;
+		for(u64 i = 0; i < 20000; ++i)
+		{
+			builder.append_formatted("line {}: {}\n"_cuqv, i, "繁星明"_cuqv);
+			format_to(expected, "line {}: {}\n"_cuqv, i, "繁星明"_cuqv);
+		}
+		builder.append('x', 10000);
+		expected.append('x', 10000);
+		EXPECT_GT(builder.chunk_count(), 3);
+		EXPECT_EQ(builder.size(), expected.size());
+		EXPECT_EQ(builder.finish(), expected);
+	}
+}
+
+TEST(string_builder, reserve)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	string_builder builder{ 100000 };
+	for(u64 i = 0; i < 10000; ++i)
+		builder.append("0123456789");
+	EXPECT_EQ(builder.chunk_count(), 1);
+	builder.reserve(50000);
+	builder.append('a', 50000);
+	EXPECT_EQ(builder.chunk_count(), 2);
+	EXPECT_EQ(builder.size(), 150000);
+
+	// Chunks are kept for reuse after empty.
+	builder.empty();
+	EXPECT_TRUE(builder.is_empty());
+	builder.append("reused");
+	const std::vector<codeunit_sequence> chunks = builder.finish_chunks();
+	ASSERT_EQ(chunks.size(), 1);
+	EXPECT_EQ(chunks[0], "reused"_cuqv);
+	EXPECT_EQ(builder.chunk_count(), 0);
+}
+
+TEST(string_builder, finish_chunks)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	string_builder builder;
+	builder.append('a', 5000).append('b', 20000);
+	const u64 chunk_count = builder.chunk_count();
+	const std::vector<codeunit_sequence> chunks = builder.finish_chunks();
+	EXPECT_EQ(chunks.size(), chunk_count);
+	codeunit_sequence joined;
+	for(const codeunit_sequence& chunk : chunks)
+		joined.append(chunk);
+	codeunit_sequence expected;
+	expected.append('a', 5000).append('b', 20000);
+	EXPECT_EQ(joined, expected);
+}
+
+#if !_WIN64
+TEST(string_builder, write_to)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	string_builder builder;
+	codeunit_sequence expected;
+	for(u64 i = 0; i < 5000; ++i)
+	{
+		builder.append_formatted("{},"_cuqv, i * i);
+		format_to(expected, "{},"_cuqv, i * i);
+	}
+	std::FILE* file = std::tmpfile();
+	ASSERT_NE(file, nullptr);
+	EXPECT_TRUE(builder.write_to(fileno(file)));
+	std::rewind(file);
+	codeunit_sequence read;
+	char buffer[4096];
+	u64 count = 0;
+	while((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+		read.append(codeunit_sequence_view{ buffer, count });
+	std::fclose(file);
+	EXPECT_EQ(read, expected);
+}
+#endif
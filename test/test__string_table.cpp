@@ -0,0 +1,92 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+
+#include "string_table.h"
+
+#include <list>
+
+using namespace ostr;
+
+TEST(string_table, append)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	string_table table;
+	EXPECT_TRUE(table.is_empty());
+	EXPECT_EQ(table.append("ui/menu/start"_cuqv), 0);
+	EXPECT_EQ(table.append(""_cuqv), 1);
+	EXPECT_EQ(table.append("繁星明 🌏"_txtv), 2);
+	EXPECT_EQ(table.size(), 3);
+	EXPECT_EQ(table.codeunit_size(), 13 + 14);
+	EXPECT_EQ(table[0], "ui/menu/start"_cuqv);
+	EXPECT_EQ(table.raw_at(1), ""_cuqv);
+	EXPECT_EQ(table.view_at(2), "繁星明 🌏"_txtv);
+	EXPECT_EQ(table.view_at(2).size(), 5);
+	EXPECT_EQ(table.size_at(2), 14);
+
+	std::vector<codeunit_sequence> strings;
+	for(const codeunit_sequence_view string : table)
+		strings.emplace_back(string);
+	EXPECT_EQ(strings, (std::vector<codeunit_sequence>{ codeunit_sequence{ "ui/menu/start" }, codeunit_sequence{ }, codeunit_sequence{ "繁星明 🌏" } }));
+
+	// Strings of the table itself, while the buffer is moved by growing.
+	for(u64 i = 0; i < 8; ++i)
+		table.append(table[table.size() - 1]);
+	EXPECT_EQ(table.size(), 11);
+	for(u64 i = 2; i < table.size(); ++i)
+		EXPECT_EQ(table[i], "繁星明 🌏"_cuqv);
+	table.append(table[0].subview(2, 5));
+	EXPECT_EQ(table[11], "/menu"_cuqv);
+
+	table.empty();
+	EXPECT_TRUE(table.is_empty());
+	EXPECT_EQ(table.codeunit_size(), 0);
+}
+
+TEST(string_table, build)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const std::vector<codeunit_sequence> strings{ codeunit_sequence{ "textures/rock.png" }, codeunit_sequence{ "textures/grass.png" }, codeunit_sequence{ "sky" } };
+	const string_table table = string_table::build(strings);
+	ASSERT_EQ(table.size(), 3);
+	EXPECT_EQ(table[1], "textures/grass.png"_cuqv);
+	// Multi-pass ranges are measured first, so the table is allocated exactly.
+	EXPECT_EQ(table.memory_size(), 17 + 18 + 3 + 4 * sizeof(u32));
+
+	const std::list<const char*> literals{ "a", "bc", "def" };
+	const large_string_table large = large_string_table::build(literals.begin(), literals.end());
+	ASSERT_EQ(large.size(), 3);
+	EXPECT_EQ(large[2], "def"_cuqv);
+}
+
+TEST(string_table, bulk)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const std::vector<codeunit_sequence_view> strings{ "apple"_cuqv, "app"_cuqv, ""_cuqv, "banana"_cuqv, "apple"_cuqv, "繁星"_cuqv };
+	const string_table table = string_table::build(strings);
+
+	std::vector<u64> hashes;
+	table.hash_all(hashes);
+	ASSERT_EQ(hashes.size(), strings.size());
+	for(u64 i = 0; i < strings.size(); ++i)
+		EXPECT_EQ(hashes[i], hash_sequence_crc64(strings[i].data(), strings[i].size()));
+	EXPECT_EQ(hashes[0], hashes[4]);
+
+	std::vector<i32> results;
+	table.compare_all("apple"_cuqv, results);
+	ASSERT_EQ(results.size(), strings.size());
+	EXPECT_EQ(results[0], 0);
+	EXPECT_LT(results[1], 0);
+	EXPECT_LT(results[2], 0);
+	EXPECT_GT(results[3], 0);
+	EXPECT_EQ(results[4], 0);
+	EXPECT_GT(results[5], 0);
+
+	EXPECT_EQ(table.index_of("apple"_cuqv), 0);
+	EXPECT_EQ(table.index_of("apple"_cuqv, 1), 4);
+	EXPECT_EQ(table.index_of(""_cuqv), 2);
+	EXPECT_EQ(table.index_of("繁星"_cuqv), 5);
+	EXPECT_EQ(table.index_of("cherry"_cuqv), global_constant::INDEX_INVALID);
+	EXPECT_TRUE(table.contains("banana"_cuqv));
+	EXPECT_FALSE(table.contains("banan"_cuqv));
+}
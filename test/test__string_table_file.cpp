@@ -0,0 +1,110 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+#include "scoped_temporary_file.h"
+
+#include "string_table_file.h"
+
+#include <cstdio>
+
+using namespace ostr;
+
+TEST(string_table_file, lookup)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const scoped_temporary_file file{ "ostr_string_table"_cuqv };
+	{
+		string_table_file_writer writer;
+		EXPECT_EQ(writer.add("menu.start"_cuqv, "Start"_cuqv), 0);
+		EXPECT_EQ(writer.add("menu.quit"_cuqv, "退出 🚪"_cuqv), 1);
+		EXPECT_EQ(writer.add("menu.empty"_cuqv, ""_cuqv), 2);
+		for(u64 i = 0; i < 1000; ++i)
+		{
+			const codeunit_sequence key = format("item.{}.name"_cuqv, i);
+			const codeunit_sequence value = format("Item {}"_cuqv, i);
+			writer.add(key.view(), value.view());
+		}
+		EXPECT_EQ(writer.size(), 1003);
+		EXPECT_EQ(writer.write(file.path.c_str()), string_table_file_status::succeeded);
+	}
+	string_table_file_options options;
+	options.verify_checksum = true;
+	const string_table_file table{ file.path.c_str(), options };
+	ASSERT_EQ(table.status(), string_table_file_status::succeeded);
+	ASSERT_EQ(table.size(), 1003);
+	EXPECT_EQ(table.find("menu.start"_cuqv), "Start"_txtv);
+	EXPECT_EQ(table.find("menu.quit"_cuqv), "退出 🚪"_txtv);
+	EXPECT_EQ(table.find("menu.quit"_cuqv).size(), 4);
+	EXPECT_EQ(table.index_of("menu.empty"_cuqv), 2);
+	EXPECT_TRUE(table.value_at(2).is_empty());
+	EXPECT_EQ(table.key_at(1), "menu.quit"_txtv);
+	for(u64 i = 0; i < 1000; ++i)
+	{
+		const codeunit_sequence key = format("item.{}.name"_cuqv, i);
+		ASSERT_EQ(table.index_of(key.view()), i + 3);
+		EXPECT_EQ(table.find(key.view()).raw(), format("Item {}"_cuqv, i));
+	}
+	EXPECT_EQ(table.index_of("item.1000.name"_cuqv), global_constant::INDEX_INVALID);
+	EXPECT_EQ(table.find("menu.missing"_cuqv, "fallback"_txtv), "fallback"_txtv);
+	EXPECT_TRUE(table.value_at(1003).is_empty());
+}
+
+TEST(string_table_file, write_failures)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const scoped_temporary_file file{ "ostr_string_table"_cuqv };
+	{
+		string_table_file_writer writer;
+		writer.add("a"_cuqv, "1"_cuqv);
+		writer.add("a"_cuqv, "2"_cuqv);
+		EXPECT_EQ(writer.write(file.path.c_str()), string_table_file_status::duplicate_key);
+	}
+	{
+		string_table_file_writer writer;
+		writer.add("a"_cuqv, "\xed\xa0\x80"_cuqv);
+		EXPECT_EQ(writer.write(file.path.c_str()), string_table_file_status::invalid_utf8);
+	}
+	{
+		const string_table_file_writer writer;
+		EXPECT_EQ(writer.write(file.path.c_str()), string_table_file_status::succeeded);
+		const string_table_file table{ file.path.c_str() };
+		EXPECT_TRUE(table.is_open());
+		EXPECT_EQ(table.size(), 0);
+		EXPECT_EQ(table.index_of("a"_cuqv), global_constant::INDEX_INVALID);
+	}
+}
+
+TEST(string_table_file, open_failures)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const scoped_temporary_file file{ "ostr_string_table"_cuqv };
+	string_table_file table;
+	EXPECT_EQ(table.status(), string_table_file_status::closed);
+	EXPECT_EQ(table.open("ostr_string_table_does_not_exist.bin"), string_table_file_status::open_failed);
+
+	string_table_file_writer writer;
+	writer.add("key"_cuqv, "value"_cuqv);
+	ASSERT_EQ(writer.write(file.path.c_str()), string_table_file_status::succeeded);
+	const codeunit_sequence content = file.read();
+	const auto open_modified = [&](const u64 index, const char codeunit, const bool verify_checksum)
+	{
+		// A mapped file can not be rewritten on some platforms.
+		table.close();
+		codeunit_sequence modified = content;
+		modified[index] = codeunit;
+		std::FILE* stream = std::fopen(file.path.c_str(), "wb");
+		std::fwrite(modified.data(), 1, modified.size(), stream);
+		std::fclose(stream);
+		string_table_file_options options;
+		options.verify_checksum = verify_checksum;
+		return table.open(file.path.c_str(), options);
+	};
+	EXPECT_EQ(open_modified(0, 'X', false), string_table_file_status::invalid_format);
+	EXPECT_EQ(open_modified(8, '\x02', false), string_table_file_status::unsupported_version);
+	EXPECT_EQ(open_modified(16, '\x02', false), string_table_file_status::invalid_format);
+	// The last code unit of the value, which is only caught by the checksum.
+	EXPECT_EQ(open_modified(content.size() - 1, 'E', false), string_table_file_status::succeeded);
+	EXPECT_EQ(table.find("key"_cuqv), "valuE"_txtv);
+	EXPECT_EQ(open_modified(content.size() - 1, 'E', true), string_table_file_status::checksum_mismatch);
+	EXPECT_FALSE(table.is_open());
+}
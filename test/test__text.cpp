@@ -199,3 +199,17 @@ TEST(text, trim)
 		EXPECT_EQ(t.self_trim("你 😙\t"_txtv), "好"_txtv);
 	}
 }
+
+TEST(text, compare)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const text hello{ "你好" };
+	const text world{ "世界" };
+	EXPECT_LT(world, hello);
+	EXPECT_GT(hello, world.view());
+	EXPECT_LE(hello, "你好"_txtv);
+	EXPECT_GE(hello, text{ "你好" });
+	EXPECT_LT(text{ "\U0000FFFF" }, "\U00010000"_txtv);
+	EXPECT_EQ(hello.compare("你好"_txtv), 0);
+	EXPECT_EQ(hello.compare(world), 1);
+}
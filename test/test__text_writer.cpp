@@ -0,0 +1,106 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+#include "scoped_temporary_file.h"
+
+#include "text_writer.h"
+
+#include <cstdio>
+
+using namespace ostr;
+
+// Temporary file written through a descriptor.
+struct scoped_output_file
+{
+	scoped_output_file()
+		: stream(std::fopen(this->file.path.c_str(), "wb"))
+	{ }
+
+	~scoped_output_file()
+	{
+		std::fclose(this->stream);
+	}
+
+	[[nodiscard]] int descriptor() const
+	{
+#if _WIN64
+		return _fileno(this->stream);
+#else
+		return fileno(this->stream);
+#endif
+	}
+
+	[[nodiscard]] codeunit_sequence read() const
+	{
+		return this->file.read();
+	}
+
+	scoped_temporary_file file{ "ostr_text_writer"_cuqv };
+	std::FILE* stream;
+};
+
+TEST(text_writer, write)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const scoped_output_file file;
+	{
+		text_writer writer{ file.descriptor(), text_flush_policy::when_full, 16 };
+		writer << "Hello"_cuqv << ' ' << "繁星明"_txtv << codepoint{ "🌏" };
+		// The buffer holds 15 code units besides the null terminator, the emoji does not fit.
+		EXPECT_EQ(writer.get_buffered_size(), 4);
+		EXPECT_EQ(file.read(), "Hello 繁星明"_cuqv);
+		writer.write('-', 20);
+		writer.write_formatted("[{}:{:x}]"_cuqv, 42, 255);
+		// Larger than the buffer, written together with the buffer.
+		writer.write("a line much longer than the buffer of the writer\n"_cuqv);
+		EXPECT_EQ(writer.get_buffered_size(), 0);
+		writer.write("tail");
+		EXPECT_TRUE(writer.flush());
+		EXPECT_FALSE(writer.has_failed());
+	}
+	EXPECT_EQ(file.read(), "Hello 繁星明🌏--------------------[42:ff]a line much longer than the buffer of the writer\ntail"_cuqv);
+}
+
+TEST(text_writer, policy)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		const scoped_output_file file;
+		text_writer writer{ file.descriptor(), text_flush_policy::on_line_feed };
+		writer.write("first ");
+		EXPECT_EQ(writer.get_buffered_size(), 6);
+		writer.write_formatted("{} line\n{}"_cuqv, "formatted"_cuqv, 2);
+		EXPECT_EQ(writer.get_buffered_size(), 0);
+		EXPECT_EQ(file.read(), "first formatted line\n2"_cuqv);
+	}
+	{
+		const scoped_output_file file;
+		text_writer writer{ file.descriptor(), text_flush_policy::immediate };
+		writer.write_formatted("{}-{}"_cuqv, 1, 2);
+		EXPECT_EQ(writer.get_buffered_size(), 0);
+		EXPECT_EQ(file.read(), "1-2"_cuqv);
+	}
+	{
+		text_writer writer{ -1 };
+		writer.write("dropped");
+		EXPECT_FALSE(writer.flush());
+		EXPECT_TRUE(writer.has_failed());
+	}
+}
+
+TEST(text_writer, background_flush)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	const scoped_output_file file;
+	text_writer writer{ file.descriptor() };
+	writer.start_background_flush(std::chrono::milliseconds{ 1 });
+	for(u64 i = 0; i < 1000; ++i)
+		writer.write_formatted("{}\n"_cuqv, i);
+	for(u32 attempt = 0; attempt < 1000 && writer.get_buffered_size() > 0; ++attempt)
+		std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+	writer.stop_background_flush();
+	const codeunit_sequence content = file.read();
+	EXPECT_TRUE(content.view().starts_with("0\n1\n2\n"_cuqv));
+	EXPECT_TRUE(content.view().ends_with("998\n999\n"_cuqv));
+	EXPECT_EQ(writer.get_buffered_size(), 0);
+}
@@ -0,0 +1,112 @@
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+
+#include "unicode.h"
+
+#include <cstring>
+
+using namespace ostr;
+
+TEST(unicode, validate_utf8)
+{
+	EXPECT_EQ(unicode::parse_valid_utf8_length("a", 1), 1);
+	EXPECT_EQ(unicode::parse_valid_utf8_length("é", 2), 2);
+	EXPECT_EQ(unicode::parse_valid_utf8_length("繁", 3), 3);
+	EXPECT_EQ(unicode::parse_valid_utf8_length("🌏", 4), 4);
+	EXPECT_EQ(unicode::parse_valid_utf8_length("🌏", 3), 0);
+	// Continuation, overlong, surrogate and beyond U+10FFFF.
+	EXPECT_EQ(unicode::parse_valid_utf8_length("\x80", 1), 0);
+	EXPECT_EQ(unicode::parse_valid_utf8_length("\xc0\xaf", 2), 0);
+	EXPECT_EQ(unicode::parse_valid_utf8_length("\xe0\x80\xaf", 3), 0);
+	EXPECT_EQ(unicode::parse_valid_utf8_length("\xed\xa0\x80", 3), 0);
+	EXPECT_EQ(unicode::parse_valid_utf8_length("\xf4\x90\x80\x80", 4), 0);
+	EXPECT_EQ(unicode::parse_valid_utf8_length("\xf4\x8f\xbf\xbf", 4), 4);
+	static_assert(unicode::find_invalid_utf8("Hello 繁星 🌏", 17) == 17);
+	static_assert(unicode::find_invalid_utf8("Hello \xff 🌏", 11) == 6);
+
+	// Ascii is skipped by words at runtime, up to an ill-formed code unit at every offset.
+	std::array<char, 40> text{ };
+	text.fill('a');
+	EXPECT_EQ(unicode::find_invalid_utf8(text.data(), text.size()), text.size());
+	for(u64 offset = 0; offset < text.size(); ++offset)
+	{
+		text[offset] = '\xff';
+		EXPECT_EQ(unicode::find_invalid_utf8(text.data(), text.size()), offset);
+		text[offset] = 'a';
+	}
+	// A sequence across words, and one truncated by the end.
+	std::memcpy(text.data() + 6, "🌏", 4);
+	EXPECT_EQ(unicode::find_invalid_utf8(text.data(), text.size()), text.size());
+	EXPECT_EQ(unicode::find_invalid_utf8(text.data(), 8), 6);
+}
+
+TEST(unicode, decode_utf8)
+{
+	// Every well-formed codepoint decodes to itself, on the inline paths and the checked one.
+	for(char32_t cp = 0x80; cp <= 0x10ffff; ++cp)
+	{
+		if(cp >= unicode::utf16::LEADING_SURROGATE_MINIMUM && cp <= unicode::utf16::TRAILING_SURROGATE_MAXIMUM)
+			continue;
+		const std::array<char, unicode::UTF8_SEQUENCE_MAXIMUM_LENGTH> utf8 = unicode::utf32_to_utf8(cp);
+		const u64 length = unicode::parse_utf8_length(cp);
+		char32_t decoded = 0;
+		ASSERT_EQ(unicode::decode_utf8(utf8.data(), length, decoded), length);
+		ASSERT_EQ(decoded, cp);
+		ASSERT_EQ(unicode::decode_utf8(utf8.data(), length - 1, decoded), 0);
+	}
+	char32_t decoded = 0;
+	EXPECT_EQ(unicode::decode_utf8("a", 1, decoded), 1);
+	EXPECT_EQ(decoded, U'a');
+	// Continuation, overlong, surrogate and beyond U+10FFFF.
+	EXPECT_EQ(unicode::decode_utf8("\x80", 1, decoded), 0);
+	EXPECT_EQ(unicode::decode_utf8("\xc1\xbf", 2, decoded), 0);
+	EXPECT_EQ(unicode::decode_utf8("\xe0\x9f\xbf", 3, decoded), 0);
+	EXPECT_EQ(unicode::decode_utf8("\xed\xa0\x80", 3, decoded), 0);
+	EXPECT_EQ(unicode::decode_utf8("\xf4\x90\x80\x80", 4, decoded), 0);
+	EXPECT_EQ(unicode::decode_utf8("\xe4\xb8\x41", 3, decoded), 0);
+	EXPECT_TRUE(unicode::is_utf8_continuation('\xbf'));
+	EXPECT_FALSE(unicode::is_utf8_continuation('\xc0'));
+	EXPECT_FALSE(unicode::is_utf8_continuation('a'));
+}
+
+TEST(unicode, codepoint_boundary)
+{
+	// "a", "é", "繁" and "🌏" start at 0, 1, 3 and 6.
+	static constexpr const char* text = "aé繁🌏";
+	static_assert(unicode::count_utf8_codepoints(text, 10) == 4);
+	static_assert(unicode::count_utf8_codepoints(text, 7) == 4);
+	static_assert(unicode::find_utf8_codepoint_offset(text, 10, 2) == 3);
+	static_assert(unicode::find_utf8_codepoint_offset(text, 10, 3) == 6);
+	static_assert(unicode::find_utf8_codepoint_offset(text, 10, 4) == 10);
+	constexpr std::array<u64, 11> boundaries{ 0, 1, 1, 3, 3, 3, 6, 6, 6, 6, 10 };
+	for(u64 offset = 0; offset < boundaries.size(); ++offset)
+		EXPECT_EQ(unicode::find_utf8_codepoint_boundary(text, 10, offset), boundaries[offset]) << offset;
+	EXPECT_EQ(unicode::find_utf8_codepoint_boundary(text, 10, 20), 10);
+	// Stray continuations are cut anywhere, instead of looking back further than a sequence.
+	EXPECT_EQ(unicode::find_utf8_codepoint_boundary("a\x80\x80\x80\x80\x80", 6, 5), 5);
+	EXPECT_EQ(unicode::find_utf8_codepoint_boundary("a\x80\x80\x80\x80\x80", 6, 3), 0);
+	EXPECT_EQ(unicode::count_utf8_codepoints("a\x80\x80" "b", 4), 2);
+}
+
+TEST(unicode, utf16_surrogate)
+{
+	// U+1F600 is the surrogate pair D83D DE00, checked with explicit code units on every platform.
+	static constexpr std::array<char16_t, 2> grinning{ 0xD83D, 0xDE00 };
+	static_assert(unicode::utf16::parse_utf16_length(grinning[0]) == 2);
+	static_assert(unicode::utf16_to_utf32(grinning.data(), 2) == U'\U0001F600');
+	static_assert(unicode::utf32_to_utf16(U'\U0001F600')[0] == 0xD83D && unicode::utf32_to_utf16(U'\U0001F600')[1] == 0xDE00);
+	EXPECT_EQ(unicode::utf16_to_utf32(u"\U0001F600", 2), U'\U0001F600');
+	// The first and the last codepoints of surrogate pairs, and the last one of a single code unit.
+	EXPECT_EQ(unicode::utf32_to_utf16(U'\U00010000'), (std::array<char16_t, 2>{ 0xD800, 0xDC00 }));
+	EXPECT_EQ(unicode::utf32_to_utf16(U'\U0010FFFF'), (std::array<char16_t, 2>{ 0xDBFF, 0xDFFF }));
+	EXPECT_EQ(unicode::utf32_to_utf16(U'\uFFFF'), (std::array<char16_t, 2>{ 0xFFFF, 0 }));
+	static constexpr std::array<char16_t, 2> first{ 0xD800, 0xDC00 };
+	static constexpr std::array<char16_t, 2> last{ 0xDBFF, 0xDFFF };
+	EXPECT_EQ(unicode::utf16_to_utf32(first.data(), 2), U'\U00010000');
+	EXPECT_EQ(unicode::utf16_to_utf32(last.data(), 2), U'\U0010FFFF');
+	const char16_t single = 0xFFFF;
+	EXPECT_EQ(unicode::utf16_to_utf32(&single, 1), U'\uFFFF');
+	// Through UTF-8, both ways.
+	EXPECT_EQ(unicode::utf16_to_utf8(grinning.data(), 2), (std::array<char, 4>{ '\xF0', '\x9F', '\x98', '\x80' }));
+	EXPECT_EQ(unicode::utf8_to_utf16("\xF0\x9F\x98\x80", 4), grinning);
+}
@@ -0,0 +1,122 @@
+
+// ReSharper disable StringLiteralTypo
+#include "pch.h"
+
+#include "view_sort.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace ostr;
+
+TEST(view_sort, compare)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	static_assert("abc"_cuqv.compare("abd"_cuqv) < 0);
+	static_assert("abc"_cuqv < "abcd"_cuqv);
+	static_assert("b"_cuqv > "abcd"_cuqv);
+	static_assert("你好"_cuqv == "你好"_cuqv);
+	EXPECT_EQ("abc"_cuqv.compare("abc"_cuqv), 0);
+	EXPECT_EQ(""_cuqv.compare(""_cuqv), 0);
+	EXPECT_LT(""_cuqv.compare("a"_cuqv), 0);
+	EXPECT_GT("a"_cuqv.compare(""_cuqv), 0);
+	EXPECT_TRUE("abc"_cuqv <= "abc"_cuqv);
+	EXPECT_TRUE("abc"_cuqv >= "abc"_cuqv);
+	EXPECT_FALSE("abc"_cuqv < "abc"_cuqv);
+	// Code units are compared as unsigned, which is the order of codepoints.
+	EXPECT_LT("z"_cuqv, "é"_cuqv);
+	EXPECT_LT("\x7f"_cuqv, "\x80"_cuqv);
+	EXPECT_LT("你"_txtv, "好"_txtv);
+	EXPECT_LT("\U0000FFFF"_txtv, "\U00010000"_txtv);
+	EXPECT_GT("😀"_txtv.compare("你好"_txtv), 0);
+}
+
+TEST(view_sort, sort)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		std::vector<codeunit_sequence_view> views{ "textures/rock.png"_cuqv, "sky"_cuqv, ""_cuqv, "textures/grass.png"_cuqv, "textures"_cuqv, "天空"_cuqv, "sky"_cuqv };
+		sort_views(views);
+		EXPECT_EQ(views, (std::vector<codeunit_sequence_view>{ ""_cuqv, "sky"_cuqv, "sky"_cuqv, "textures"_cuqv, "textures/grass.png"_cuqv, "textures/rock.png"_cuqv, "天空"_cuqv }));
+	}
+	{
+		std::vector<text_view> views{ "😀"_txtv, "你好"_txtv, "a"_txtv };
+		sort_views(views);
+		EXPECT_EQ(views, (std::vector<text_view>{ "a"_txtv, "你好"_txtv, "😀"_txtv }));
+	}
+	{
+		std::vector<codeunit_sequence_view> views;
+		sort_views(views);
+		sort_views_parallel(views);
+		EXPECT_TRUE(views.empty());
+	}
+}
+
+// Paths sharing long prefixes, duplicates, prefixes of each other and code units of the upper half.
+static std::vector<codeunit_sequence> generate_paths(const u64 count, const u32 seed)
+{
+	std::mt19937 engine{ seed };
+	const std::array<codeunit_sequence_view, 6> directories{ "assets/"_cuqv, "textures/"_cuqv, "terrain/"_cuqv, "纹理/"_cuqv, "a"_cuqv, ""_cuqv };
+	std::vector<codeunit_sequence> paths;
+	paths.reserve(count);
+	for(u64 i = 0; i < count; ++i)
+	{
+		codeunit_sequence path;
+		const u32 depth = engine() % 6;
+		for(u32 level = 0; level < depth; ++level)
+			path.append(directories[engine() % directories.size()]);
+		if(engine() % 4 != 0)
+			path.append(format("{}.png"_cuqv, engine() % (count / 2 + 1)));
+		if(engine() % 16 == 0)
+			path.append(codeunit_sequence_view{ static_cast<char>(0x80 | engine() % 0x40) });
+		paths.push_back(path);
+	}
+	return paths;
+}
+
+template<class View>
+static void expect_sorted(const std::vector<codeunit_sequence>& paths, const bool parallel, const u32 thread_count)
+{
+	std::vector<View> views;
+	views.reserve(paths.size());
+	for(const codeunit_sequence& path : paths)
+		views.push_back(View{ path.view() });
+	std::vector<View> expected = views;
+	std::sort(expected.begin(), expected.end());
+	if(parallel)
+		sort_views_parallel(views, thread_count);
+	else
+		sort_views(views);
+	ASSERT_EQ(views.size(), expected.size());
+	for(u64 i = 0; i < views.size(); ++i)
+		ASSERT_EQ(views[i], expected[i]) << "at " << i;
+}
+
+TEST(view_sort, random)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	for(const u64 count : { 10, 100, 5000, 200000 })
+	{
+		const std::vector<codeunit_sequence> paths = generate_paths(count, static_cast<u32>(count));
+		expect_sorted<codeunit_sequence_view>(paths, false, 0);
+		expect_sorted<text_view>(paths, false, 0);
+		expect_sorted<codeunit_sequence_view>(paths, true, 0);
+		expect_sorted<codeunit_sequence_view>(paths, true, 3);
+		expect_sorted<text_view>(paths, true, 8);
+	}
+}
+
+TEST(view_sort, degenerate)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	// Each view is a prefix of the next one, and all the views are equal.
+	codeunit_sequence long_path;
+	long_path.append('x', 3000);
+	std::vector<codeunit_sequence> paths;
+	for(u64 i = 0; i < 3000; ++i)
+		paths.emplace_back(long_path.view().subview(0, (i * 7919) % 3000));
+	for(u64 i = 0; i < 100000; ++i)
+		paths.emplace_back("assets/textures/terrain/rock.png"_cuqv);
+	expect_sorted<codeunit_sequence_view>(paths, false, 0);
+	expect_sorted<codeunit_sequence_view>(paths, true, 4);
+}
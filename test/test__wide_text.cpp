@@ -2,6 +2,7 @@
 #include "pch.h"
 
 #include "wide_text.h"
+#include "text.h"
 
 using namespace ostr;
 
@@ -27,3 +28,44 @@ TEST(wide_text, construct)
 		}
 	}
 }
+
+TEST(wide_text, decode)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		const wide_text wt{ L"Hello 你好 😙!" };
+		codeunit_sequence decoded;
+		wt.decode(decoded);
+		EXPECT_EQ(decoded, "Hello 你好 😙!"_cuqv);
+		EXPECT_EQ(text::from_wide(L"Hello 你好 😙!"), "Hello 你好 😙!"_txtv);
+	}
+	{
+		// Long enough to cross several transcoding blocks, with non-ascii at block boundaries.
+		constexpr codeunit_sequence_view origin = "The quick brown 狐狸 jumps over the lazy 🐶, 繁星明 said: 😙😙😙 and ascii again."_cuqv;
+		const wide_text wt{ origin };
+		codeunit_sequence decoded("prefix ");
+		details::append_wide(decoded, wt.data(), wt.size());
+		EXPECT_EQ(decoded, codeunit_sequence::build("prefix "_cuqv, origin));
+		EXPECT_EQ(details::get_utf8_size(wt.data(), wt.size()), origin.size());
+	}
+	{
+		const wide_text wt{ L"" };
+		EXPECT_EQ(wt.size(), 0);
+		EXPECT_EQ(text::from_wide(L""), ""_txtv);
+	}
+}
+
+TEST(wide_text, format)
+{
+	SCOPED_DETECT_MEMORY_LEAK()
+	{
+		const wchar_t* name = L"繁星明";
+		EXPECT_EQ(format("My name is {}!"_cuqv, name), "My name is 繁星明!"_cuqv);
+		EXPECT_EQ(format("{} {}"_cuqv, L"😙", wide_text{ L"abc" }), "😙 abc"_cuqv);
+	}
+	{
+		// longer than the block encoded on stack
+		const wide_text long_wide{ L"繁星明 😀 Open String 繁星明 😀 Open String 繁星明 😀 Open String 繁星明 😀 Open String" };
+		EXPECT_EQ(format("[{}]"_cuqv, long_wide), "[繁星明 😀 Open String 繁星明 😀 Open String 繁星明 😀 Open String 繁星明 😀 Open String]"_cuqv);
+	}
+}
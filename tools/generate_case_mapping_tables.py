@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""
+Generates source/case_mapping_tables.h, the case mapping tables of source/case_mapping.cpp.
+
+Mappings are the full, unconditional ones of the Unicode Character Database: UnicodeData.txt with SpecialCasing.txt for
+lower and upper case, and the C and F entries of CaseFolding.txt for case folding. They are read through the unicodedata
+module of the running Python, so the tables follow its UCD version, which is recorded in the generated file.
+
+Usage: python3 tools/generate_case_mapping_tables.py [output]
+"""
+
+import os
+import sys
+import unicodedata
+
+# Codepoints of a block share one entry of the first stage.
+BLOCK_SHIFT = 7
+BLOCK_SIZE = 1 << BLOCK_SHIFT
+# Mapped values from this one on are indices of special mappings, values below are deltas of a single codepoint.
+SPECIAL_BASE = 0x200000
+MAPPING_MAXIMUM_LENGTH = 3
+
+
+def get_mappings(cp):
+	c = chr(cp)
+	return c.lower(), c.upper(), c.casefold()
+
+
+def main():
+	output = sys.argv[1] if len(sys.argv) > 1 else os.path.join(os.path.dirname(__file__), '..', 'source', 'case_mapping_tables.h')
+
+	specials = []
+	special_indices = {}
+	records = [(0, 0, 0)]
+	record_indices = {(0, 0, 0): 0}
+	codepoint_records = []
+	limit = 0
+
+	for cp in range(0x110000):
+		if 0xD800 <= cp <= 0xDFFF:
+			codepoint_records.append(0)
+			continue
+		values = []
+		for mapped in get_mappings(cp):
+			assert len(mapped) <= MAPPING_MAXIMUM_LENGTH
+			if len(mapped) == 1:
+				values.append(ord(mapped) - cp)
+			else:
+				sequence = tuple(ord(m) for m in mapped)
+				if sequence not in special_indices:
+					special_indices[sequence] = len(specials)
+					specials.append(sequence)
+				values.append(SPECIAL_BASE + special_indices[sequence])
+		record = tuple(values)
+		if record not in record_indices:
+			record_indices[record] = len(records)
+			records.append(record)
+		codepoint_records.append(record_indices[record])
+		if record != (0, 0, 0):
+			limit = cp + 1
+
+	# Lead code units of 2 and 3 code units, none of whose codepoints is mapped. Leads 0xc0 and 0xc1 are always ill-formed.
+	unmapped_leads = 0b11
+	for lead in range(0xC2, 0xF0):
+		first = (lead - 0xC0) << 6 if lead < 0xE0 else (lead - 0xE0) << 12
+		count = 1 << 6 if lead < 0xE0 else 1 << 12
+		if all(codepoint_records[cp] == 0 for cp in range(first, first + count)):
+			unmapped_leads |= 1 << (lead - 0xC0)
+
+	block_count = (limit + BLOCK_SIZE - 1) // BLOCK_SIZE
+	blocks = []
+	block_indices_of = {}
+	block_indices = []
+	for b in range(block_count):
+		block = tuple(codepoint_records[b * BLOCK_SIZE:(b + 1) * BLOCK_SIZE])
+		if block not in block_indices_of:
+			block_indices_of[block] = len(blocks)
+			blocks.append(block)
+		block_indices.append(block_indices_of[block])
+	assert len(blocks) <= 0x100 and len(records) <= 0x10000
+
+	def rows(values, width, per_row):
+		lines = []
+		for i in range(0, len(values), per_row):
+			lines.append('\t\t\t' + ' '.join('{:>{}},'.format(v, width) for v in values[i:i + per_row]))
+		return '\n'.join(lines)
+
+	record_indices_flat = [r for block in blocks for r in block]
+	size = len(block_indices) + len(record_indices_flat) * 2 + len(records) * 12 + len(specials) * 12
+
+	with open(output, 'w', newline='\n') as f:
+		f.write('\n')
+		f.write('// Generated by tools/generate_case_mapping_tables.py from the Unicode Character Database {}, do not edit.\n'.format(unicodedata.unidata_version))
+		f.write('// {} blocks, {} records and {} special mappings, {} bytes in total.\n'.format(len(blocks), len(records), len(specials), size))
+		f.write('#pragma once\n')
+		f.write('#include "common/basic_types.h"\n\n')
+		f.write('#include <array>\n\n')
+		f.write('namespace ostr\n{\n\tnamespace details\n\t{\n')
+		f.write('\t\tinline constexpr u64 CASE_MAPPING_BLOCK_SHIFT = {};\n'.format(BLOCK_SHIFT))
+		f.write('\t\tinline constexpr char32_t CASE_MAPPING_LIMIT = 0x{:X};\n'.format(block_count * BLOCK_SIZE))
+		f.write('\t\tinline constexpr i32 CASE_MAPPING_SPECIAL_BASE = 0x{:X};\n'.format(SPECIAL_BASE))
+		f.write('\t\t// Bit c - 0xc0 is set when no codepoint starting with the lead code unit c is mapped, for leads of 2 and 3 code units.\n')
+		f.write('\t\tinline constexpr u64 CASE_MAPPING_UNMAPPED_LEADS = 0x{:016X};\n\n'.format(unmapped_leads))
+		f.write('\t\t// Index of the block in CASE_MAPPING_RECORD_INDICES of each block of codepoints.\n')
+		f.write('\t\tinline constexpr std::array<u8, {}> CASE_MAPPING_BLOCK_INDICES\n\t\t{{\n'.format(len(block_indices)))
+		f.write(rows(block_indices, 3, 32) + '\n\t\t};\n\n')
+		f.write('\t\t// Index in CASE_MAPPING_RECORDS of each codepoint of a block.\n')
+		f.write('\t\tinline constexpr std::array<u16, {}> CASE_MAPPING_RECORD_INDICES\n\t\t{{\n'.format(len(record_indices_flat)))
+		f.write(rows(record_indices_flat, 3, 32) + '\n\t\t};\n\n')
+		f.write('\t\t// Lower case, upper case and case folding of codepoints, as deltas or special mappings.\n')
+		f.write('\t\tinline constexpr std::array<std::array<i32, 3>, {}> CASE_MAPPING_RECORDS\n\t\t{{{{\n'.format(len(records)))
+		for record in records:
+			f.write('\t\t\t{{ {} }},\n'.format(', '.join('0x{:X}'.format(v) if v >= SPECIAL_BASE else str(v) for v in record)))
+		f.write('\t\t}};\n\n')
+		f.write('\t\t// Mappings to more than one codepoint, ending with 0 when shorter than 3 codepoints.\n')
+		f.write('\t\tinline constexpr std::array<std::array<char32_t, 3>, {}> CASE_MAPPING_SPECIALS\n\t\t{{{{\n'.format(len(specials)))
+		for special in specials:
+			padded = list(special) + [0] * (MAPPING_MAXIMUM_LENGTH - len(special))
+			f.write('\t\t\t{{ {} }},\n'.format(', '.join('0x{:04X}'.format(v) if v else '0' for v in padded)))
+		f.write('\t\t}};\n')
+		f.write('\t}\n}\n')
+
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+"""
+Generates source/normalization_tables.h, the normalization tables of source/normalization.cpp.
+
+Decompositions, canonical combining classes and compositions are the ones of UnicodeData.txt, with the composition
+exclusions of CompositionExclusions.txt, and quick check values are the ones of DerivedNormalizationProps.txt.
+They are read through the unicodedata module of the running Python, so the tables follow its UCD version, which is
+recorded in the generated file. Hangul syllables are decomposed and composed algorithmically, they are not in the tables.
+
+Usage: python3 tools/generate_normalization_tables.py [output]
+"""
+
+import os
+import sys
+import unicodedata
+
+# Codepoints of a block share one entry of the first stage.
+BLOCK_SHIFT = 7
+BLOCK_SIZE = 1 << BLOCK_SHIFT
+
+HANGUL_SYLLABLE_FIRST = 0xAC00
+HANGUL_SYLLABLE_LAST = 0xD7A3
+HANGUL_VOWELS = range(0x1161, 0x1176)
+HANGUL_TRAILINGS = range(0x11A8, 0x11C3)
+
+# Flags of records, the same as the ones of source/normalization.cpp.
+NFD_NO = 1 << 0
+NFKD_NO = 1 << 1
+NFC_NO = 1 << 2
+NFC_MAYBE = 1 << 3
+NFKC_NO = 1 << 4
+NFKC_MAYBE = 1 << 5
+CANONICAL_NON_STARTER = 1 << 6
+COMPATIBILITY_NON_STARTER = 1 << 7
+
+# No and maybe flags of each normalization form, in the order of normalization_form.
+FORM_FLAGS = [
+	(NFC_NO, NFC_MAYBE),
+	(NFD_NO, 0),
+	(NFKC_NO, NFKC_MAYBE),
+	(NFKD_NO, 0),
+]
+
+
+def is_hangul_syllable(cp):
+	return HANGUL_SYLLABLE_FIRST <= cp <= HANGUL_SYLLABLE_LAST
+
+
+def main():
+	output = sys.argv[1] if len(sys.argv) > 1 else os.path.join(os.path.dirname(__file__), '..', 'source', 'normalization_tables.h')
+
+	# Primary composites, whose single level canonical decomposition is a pair composed back by NFC.
+	compositions = {}
+	for cp in range(0x110000):
+		if 0xD800 <= cp <= 0xDFFF or is_hangul_syllable(cp):
+			continue
+		decomposition = unicodedata.decomposition(chr(cp))
+		if not decomposition or decomposition.startswith('<'):
+			continue
+		pair = [int(d, 16) for d in decomposition.split()]
+		if len(pair) == 2 and unicodedata.normalize('NFC', chr(pair[0]) + chr(pair[1])) == chr(cp):
+			compositions[(pair[0], pair[1])] = cp
+	combining_backward = {second for (_, second) in compositions} | set(HANGUL_VOWELS) | set(HANGUL_TRAILINGS)
+
+	decompositions = [0]
+	decomposition_indices = {(): 0}
+
+	def add_decomposition(text):
+		sequence = tuple(ord(c) for c in text)
+		if sequence not in decomposition_indices:
+			decomposition_indices[sequence] = len(decompositions)
+			decompositions.append(len(sequence))
+			decompositions.extend(sequence)
+		return decomposition_indices[sequence]
+
+	records = [(0, 0, 0, 0)]
+	record_indices = {(0, 0, 0, 0): 0}
+	codepoint_records = []
+	limit = 0
+
+	for cp in range(0x110000):
+		if 0xD800 <= cp <= 0xDFFF:
+			codepoint_records.append(0)
+			continue
+		c = chr(cp)
+		ccc = unicodedata.combining(c)
+		nfd = unicodedata.normalize('NFD', c)
+		nfkd = unicodedata.normalize('NFKD', c)
+		flags = 0
+		if nfd != c:
+			flags |= NFD_NO
+		if nfkd != c:
+			flags |= NFKD_NO
+		if unicodedata.normalize('NFC', c) != c:
+			flags |= NFC_NO
+		elif cp in combining_backward:
+			flags |= NFC_MAYBE
+		if unicodedata.normalize('NFKC', c) != c:
+			flags |= NFKC_NO
+		elif cp in combining_backward:
+			flags |= NFKC_MAYBE
+		if unicodedata.combining(nfd[0]) != 0:
+			flags |= CANONICAL_NON_STARTER
+		if unicodedata.combining(nfkd[0]) != 0:
+			flags |= COMPATIBILITY_NON_STARTER
+		canonical = 0
+		compatibility = 0
+		if not is_hangul_syllable(cp):
+			if nfd != c:
+				canonical = add_decomposition(nfd)
+			if nfkd != c:
+				compatibility = add_decomposition(nfkd)
+		record = (ccc, flags, canonical, compatibility)
+		if record not in record_indices:
+			record_indices[record] = len(records)
+			records.append(record)
+		codepoint_records.append(record_indices[record])
+		if record != (0, 0, 0, 0):
+			limit = cp + 1
+
+	# Blocks of 64 codepoints sharing the code units before the last one, all of whose codepoints are starters passing the quick check of a form.
+	# Blocks of 2 code units are indexed by their lead code unit, the ones of 3 code units by the lead and the second code unit.
+	inert_leads = []
+	inert_blocks = []
+	for (no, maybe) in FORM_FLAGS:
+		def is_inert(first):
+			return all(records[codepoint_records[cp]][0] == 0 and (records[codepoint_records[cp]][1] & (no | maybe)) == 0 for cp in range(first, first + 64))
+		# Leads 0xc0 and 0xc1 are always ill-formed.
+		leads = 0b11
+		for lead in range(0xC2, 0xE0):
+			if is_inert((lead - 0xC0) << 6):
+				leads |= 1 << (lead - 0xC0)
+		inert_leads.append(leads)
+		blocks_of_leads = []
+		for lead in range(0xE0, 0xF0):
+			seconds = 0
+			for second in range(0x40):
+				if is_inert(((lead - 0xE0) << 12) | (second << 6)):
+					seconds |= 1 << second
+			blocks_of_leads.append(seconds)
+		inert_blocks.append(blocks_of_leads)
+
+	block_count = (limit + BLOCK_SIZE - 1) // BLOCK_SIZE
+	blocks = []
+	block_indices_of = {}
+	block_indices = []
+	for b in range(block_count):
+		block = tuple(codepoint_records[b * BLOCK_SIZE:(b + 1) * BLOCK_SIZE])
+		if block not in block_indices_of:
+			block_indices_of[block] = len(blocks)
+			blocks.append(block)
+		block_indices.append(block_indices_of[block])
+	assert len(blocks) <= 0x10000 and len(records) <= 0x10000 and len(decompositions) <= 0x10000
+
+	def rows(values, width, per_row):
+		lines = []
+		for i in range(0, len(values), per_row):
+			lines.append('\t\t\t' + ' '.join('{:>{}},'.format(v, width) for v in values[i:i + per_row]))
+		return '\n'.join(lines)
+
+	record_indices_flat = [r for block in blocks for r in block]
+	composition_list = sorted(compositions.items())
+	size = len(inert_leads) * 8 + len(inert_blocks) * 16 * 8 + len(block_indices) * 2 + len(record_indices_flat) * 2 + len(records) * 6 + len(decompositions) * 4 + len(composition_list) * 12
+
+	with open(output, 'w', newline='\n') as f:
+		f.write('\n')
+		f.write('// Generated by tools/generate_normalization_tables.py from the Unicode Character Database {}, do not edit.\n'.format(unicodedata.unidata_version))
+		f.write('// {} blocks, {} records, {} code units of decompositions and {} compositions, {} bytes in total.\n'.format(len(blocks), len(records), len(decompositions), len(composition_list), size))
+		f.write('#pragma once\n')
+		f.write('#include "common/basic_types.h"\n\n')
+		f.write('#include <array>\n\n')
+		f.write('namespace ostr\n{\n\tnamespace details\n\t{\n')
+		f.write('\t\tstruct normalization_record\n\t\t{\n')
+		f.write('\t\t\t// Canonical combining class.\n\t\t\tu8 ccc;\n')
+		f.write('\t\t\t// Quick check values and whether decompositions start with a non-starter.\n\t\t\tu8 flags;\n')
+		f.write('\t\t\t// Indices in NORMALIZATION_DECOMPOSITIONS of the full decompositions, 0 for codepoints not decomposed.\n')
+		f.write('\t\t\tu16 canonical;\n\t\t\tu16 compatibility;\n\t\t};\n\n')
+		f.write('\t\tstruct normalization_composition\n\t\t{\n\t\t\tchar32_t first;\n\t\t\tchar32_t second;\n\t\t\tchar32_t composite;\n\t\t};\n\n')
+		f.write('\t\tinline constexpr u64 NORMALIZATION_BLOCK_SHIFT = {};\n'.format(BLOCK_SHIFT))
+		f.write('\t\tinline constexpr char32_t NORMALIZATION_LIMIT = 0x{:X};\n'.format(block_count * BLOCK_SIZE))
+		f.write('\t\t// Bit c - 0xc0 is set when all codepoints starting with the lead code unit c of 2 code units are starters passing the quick check,\n')
+		f.write('\t\t// indexed by normalization_form.\n')
+		f.write('\t\tinline constexpr std::array<u64, 4> NORMALIZATION_INERT_LEADS\n\t\t{\n')
+		for leads in inert_leads:
+			f.write('\t\t\t0x{:016X},\n'.format(leads))
+		f.write('\t\t};\n\n')
+		f.write('\t\t// Bit s & 0x3f of element c - 0xe0 is set when all codepoints starting with the lead code unit c of 3 code units\n')
+		f.write('\t\t// and the second code unit s are starters passing the quick check, indexed by normalization_form.\n')
+		f.write('\t\tinline constexpr std::array<std::array<u64, 16>, 4> NORMALIZATION_INERT_BLOCKS\n\t\t{{\n')
+		for blocks_of_leads in inert_blocks:
+			f.write('\t\t\t{\n')
+			for i in range(0, 16, 4):
+				f.write('\t\t\t\t' + ' '.join('0x{:016X},'.format(b) for b in blocks_of_leads[i:i + 4]) + '\n')
+			f.write('\t\t\t},\n')
+		f.write('\t\t}};\n\n')
+		f.write('\t\t// Index of the block in NORMALIZATION_RECORD_INDICES of each block of codepoints.\n')
+		f.write('\t\tinline constexpr std::array<u16, {}> NORMALIZATION_BLOCK_INDICES\n\t\t{{\n'.format(len(block_indices)))
+		f.write(rows(block_indices, 3, 32) + '\n\t\t};\n\n')
+		f.write('\t\t// Index in NORMALIZATION_RECORDS of each codepoint of a block.\n')
+		f.write('\t\tinline constexpr std::array<u16, {}> NORMALIZATION_RECORD_INDICES\n\t\t{{\n'.format(len(record_indices_flat)))
+		f.write(rows(record_indices_flat, 4, 32) + '\n\t\t};\n\n')
+		f.write('\t\tinline constexpr std::array<normalization_record, {}> NORMALIZATION_RECORDS\n\t\t{{{{\n'.format(len(records)))
+		for record in records:
+			f.write('\t\t\t{{ {}, 0x{:02X}, {}, {} }},\n'.format(*record))
+		f.write('\t\t}};\n\n')
+		f.write('\t\t// Decompositions as their count of codepoints followed by the codepoints.\n')
+		f.write('\t\tinline constexpr std::array<char32_t, {}> NORMALIZATION_DECOMPOSITIONS\n\t\t{{\n'.format(len(decompositions)))
+		f.write(rows(['0x{:04X}'.format(d) if d > 0x20 else str(d) for d in decompositions], 7, 16) + '\n\t\t};\n\n')
+		f.write('\t\t// Primary composites, ordered by the pairs they are composed from.\n')
+		f.write('\t\tinline constexpr std::array<normalization_composition, {}> NORMALIZATION_COMPOSITIONS\n\t\t{{{{\n'.format(len(composition_list)))
+		for (first, second), composite in composition_list:
+			f.write('\t\t\t{{ 0x{:04X}, 0x{:04X}, 0x{:04X} }},\n'.format(first, second, composite))
+		f.write('\t\t}};\n')
+		f.write('\t}\n}\n')
+
+
+if __name__ == '__main__':
+	main()
@@ -3,7 +3,7 @@ set_warnings("all", "error")
 set_languages("c++17")
 
 add_requires("gtest")
--- add_requires("benchmark")
+add_requires("benchmark")
 
 add_cxxflags("cl::/utf-8", {force = true})
 
@@ -11,6 +11,10 @@ target("OpenString")
     set_kind("static")
     add_includedirs("include")
     add_files("source/*.cpp")
+    -- Deferred formatting renders records on a background thread
+    if is_plat("linux") then
+        add_syslinks("pthread", {public = true})
+    end
 target_end()
 
 target("test")
@@ -21,13 +25,13 @@ target("test")
     add_deps("OpenString")
 target_end()
 
--- target("benchmark")
---     set_kind("binary")
---     add_cxflags(cxflags, {force = true})
---     add_packages("benchmark")
---     add_includedirs("include")
---     add_deps("OpenString")
---     add_files("benchmark/*.cpp")
+target("benchmark")
+    set_kind("binary")
+    add_packages("benchmark")
+    add_includedirs("include")
+    add_deps("OpenString")
+    add_files("benchmark/*.cpp")
+target_end()
 
 --
 -- If you want to known more usage about xmake, please see https://xmake.io